@@ -0,0 +1,29 @@
+#include "bench_utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace TinySTL {
+namespace Bench {
+
+void report(const std::string &name, size_t ops, double seconds) {
+  double ns_per_op = ops == 0 ? 0 : seconds * 1e9 / ops;
+  double mops = seconds == 0 ? 0 : ops / seconds / 1e6;
+  printf("  %-48s %12.2f ns/op %12.2f Mops/s\n", name.c_str(), ns_per_op, mops);
+}
+
+size_t max_n(size_t default_n) {
+  const char *env = getenv("TINYSTL_BENCH_MAX_N");
+  if (env == nullptr)
+    return default_n;
+  auto n = strtoull(env, nullptr, 10);
+  return n == 0 ? default_n : static_cast<size_t>(n);
+}
+
+std::vector<BenchCase> &registry() {
+  static std::vector<BenchCase> cases;
+  return cases;
+}
+
+}
+}
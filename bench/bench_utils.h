@@ -0,0 +1,56 @@
+#ifndef TINYSTL_BENCH_BENCH_UTILS_H_
+#define TINYSTL_BENCH_BENCH_UTILS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TinySTL {
+namespace Bench {
+
+// 防止被测的计算结果被编译器优化掉
+template<typename T>
+inline void do_not_optimize(const T &val) {
+  asm volatile("" : : "r,m"(val) : "memory");
+}
+
+class Timer {
+ private:
+  std::chrono::steady_clock::time_point start;
+
+ public:
+  Timer() : start(std::chrono::steady_clock::now()) {}
+  void reset() { start = std::chrono::steady_clock::now(); }
+  double seconds() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+};
+
+// 输出一行结果：ns/op 和 Mops/s
+void report(const std::string &name, size_t ops, double seconds);
+
+// 规模上限，可以通过环境变量 TINYSTL_BENCH_MAX_N 调整，避免在小机器上跑太久
+size_t max_n(size_t default_n);
+
+using bench_func = void (*)();
+struct BenchCase {
+  const char *name;
+  bench_func func;
+};
+std::vector<BenchCase> &registry();
+
+struct Registrar {
+  Registrar(const char *name, bench_func func) { registry().push_back(BenchCase{name, func}); }
+};
+
+}
+}
+
+// 用法和 gtest 的 TEST 类似：TINYSTL_BENCH(ListBench, Traverse) { ... }
+#define TINYSTL_BENCH(group, name) \
+  static void group##_##name##_bench(); \
+  static ::TinySTL::Bench::Registrar group##_##name##_registrar(#group "." #name, group##_##name##_bench); \
+  static void group##_##name##_bench()
+
+#endif //TINYSTL_BENCH_BENCH_UTILS_H_
@@ -0,0 +1,69 @@
+#include <malloc.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/btree_map.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 当前 malloc 出去的总字节数，用来估算每个元素的内存占用（包括 malloc 自身的开销）
+static size_t heap_in_use() { return mallinfo2().uordblks; }
+
+// 随机插入 n 个 key，输出每个元素占用的内存，再随机查找 n 次
+template<typename Map>
+static void bench_ordered_map(const std::string &name, const std::vector<uint64_t> &keys,
+                              const std::vector<uint64_t> &lookups) {
+  size_t n = keys.size();
+  size_t heap_before = heap_in_use();
+  Map m;
+  Timer timer;
+  for (size_t i = 0; i != n; ++i)
+    m[keys[i]] = i;
+  report(name + " insert", n, timer.seconds());
+  std::printf("    %.1f bytes/element\n", static_cast<double>(heap_in_use() - heap_before) / n);
+
+  timer.reset();
+  uint64_t sum = 0;
+  for (size_t i = 0; i != n; ++i)
+    sum += m.lower_bound(lookups[i]) != m.end();
+  do_not_optimize(sum);
+  report(name + " lower_bound", n, timer.seconds());
+}
+
+TINYSTL_BENCH(BtreeMapBench, RandomKeys) {
+  auto max = max_n(1 << 22);
+  std::mt19937_64 gen(1);
+  for (size_t n = 1000000; n <= max && n <= 100000000; n *= 10) {
+    std::vector<uint64_t> keys(n), lookups(n);
+    for (size_t i = 0; i != n; ++i) {
+      keys[i] = gen();
+      lookups[i] = gen();
+    }
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+    bench_ordered_map<btree_map<uint64_t, uint64_t>>("btree_map" + suffix, keys, lookups);
+    bench_ordered_map<std::map<uint64_t, uint64_t>>("std::map" + suffix, keys, lookups);
+
+    // 有序数据 O(n) 建树
+    std::sort(keys.begin(), keys.end());
+    std::vector<pair<uint64_t, uint64_t>> sorted;
+    sorted.reserve(n);
+    for (size_t i = 0; i != n; ++i)
+      sorted.push_back(pair<uint64_t, uint64_t>(keys[i], i));
+    Timer timer;
+    btree_map<uint64_t, uint64_t> bulk;
+    bulk.assign_sorted(sorted.begin(), sorted.end());
+    report("btree_map assign_sorted" + suffix, n, timer.seconds());
+    std::printf("    %.1f bytes/element (bytes_used)\n", static_cast<double>(bulk.bytes_used()) / n);
+  }
+}
+
+}
+}
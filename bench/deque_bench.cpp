@@ -0,0 +1,111 @@
+#include <deque>
+#include <random>
+#include <string>
+
+#include "../src/deque.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+struct Struct24 {
+  long long a, b, c;
+  Struct24() : a(0), b(0), c(0) {}
+  explicit Struct24(long long v) : a(v), b(v + 1), c(v + 2) {}
+};
+inline long long value_of(int v) { return v; }
+inline long long value_of(const Struct24 &v) { return v.b; }
+
+static vector<size_t> random_indexes(size_t n, size_t count) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<size_t> dist(0, n - 1);
+  vector<size_t> res;
+  res.reserve(count);
+  for (size_t i = 0; i != count; ++i)
+    res.push_back(dist(gen));
+  return res;
+}
+
+// 通过 operator[] 随机访问
+template<typename Container>
+static void bench_random_access(const std::string &name, size_t n, const vector<size_t> &indexes) {
+  using value_type = typename Container::value_type;
+  Container c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(value_type(static_cast<int>(i)));
+  Timer timer;
+  long long sum = 0;
+  for (auto i : indexes)
+    sum += value_of(c[i]);
+  do_not_optimize(sum);
+  report(name, indexes.size(), timer.seconds());
+}
+
+// 顺序访问，但每次都通过 begin() + i 计算迭代器
+template<typename Container>
+static void bench_iterator_offset(const std::string &name, size_t n, size_t rounds) {
+  using value_type = typename Container::value_type;
+  Container c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(value_type(static_cast<int>(i)));
+  Timer timer;
+  long long sum = 0;
+  for (size_t r = 0; r != rounds; ++r) {
+    auto first = c.begin();
+    for (size_t i = 0; i != n; ++i)
+      sum += value_of(*(first + i));
+  }
+  do_not_optimize(sum);
+  report(name, n * rounds, timer.seconds());
+}
+
+// 一端进一端出，队列长度保持在 depth 左右
+template<typename Container>
+static void bench_fifo(const std::string &name, size_t n, size_t depth) {
+  Container c;
+  for (size_t i = 0; i != depth; ++i)
+    c.push_back(static_cast<int>(i));
+  Timer timer;
+  long long sum = 0;
+  for (size_t i = 0; i != n; ++i) {
+    c.push_back(static_cast<int>(i));
+    sum += c.front();
+    c.pop_front();
+  }
+  do_not_optimize(sum);
+  report(name, n, timer.seconds());
+}
+
+TINYSTL_BENCH(DequeBench, Fifo) {
+  auto n = max_n(1 << 24);
+  bench_fifo<deque<int>>("deque<int>", n, 1000);
+  bench_fifo<std::deque<int>>("std::deque<int>", n, 1000);
+}
+
+TINYSTL_BENCH(DequeBench, RandomAccessInt) {
+  auto n = max_n(1 << 16);
+  auto indexes = random_indexes(n, 1 << 22);
+  bench_random_access<deque<int>>("deque<int>", n, indexes);
+  bench_random_access<std::deque<int>>("std::deque<int>", n, indexes);
+  bench_random_access<vector<int>>("vector<int>", n, indexes);
+}
+
+TINYSTL_BENCH(DequeBench, RandomAccessStruct24) {
+  auto n = max_n(1 << 16);
+  auto indexes = random_indexes(n, 1 << 22);
+  bench_random_access<deque<Struct24>>("deque<Struct24>", n, indexes);
+  bench_random_access<std::deque<Struct24>>("std::deque<Struct24>", n, indexes);
+  bench_random_access<vector<Struct24>>("vector<Struct24>", n, indexes);
+}
+
+TINYSTL_BENCH(DequeBench, IteratorOffset) {
+  auto n = max_n(1 << 16);
+  bench_iterator_offset<deque<int>>("deque<int>", n, 64);
+  bench_iterator_offset<std::deque<int>>("std::deque<int>", n, 64);
+  bench_iterator_offset<deque<Struct24>>("deque<Struct24>", n, 64);
+  bench_iterator_offset<std::deque<Struct24>>("std::deque<Struct24>", n, 64);
+}
+
+}
+}
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/algorithm.h"
+#include "../src/eytzinger_index.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 随机查找 lookups 中的每个 key，把结果累加起来防止被优化掉
+template<typename Search>
+static void bench_search(const std::string &name, const std::vector<uint32_t> &lookups, Search search) {
+  Timer timer;
+  uint64_t sum = 0;
+  for (auto key : lookups)
+    sum += search(key);
+  do_not_optimize(sum);
+  report(name, lookups.size(), timer.seconds());
+}
+
+// 数据量从 L1 内（4K 个 uint32_t = 16KB）到远大于 LLC
+TINYSTL_BENCH(EytzingerIndexBench, LowerBound) {
+  auto max = max_n(1 << 24);
+  const size_t queries = 1 << 20;
+  std::mt19937 gen(1);
+  for (size_t n = 1 << 12; n <= max; n <<= 3) {
+    vector<uint32_t> sorted(n, 0);
+    for (size_t i = 0; i != n; ++i)
+      sorted[i] = static_cast<uint32_t>(gen());
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<uint32_t> lookups(queries);
+    for (auto &key : lookups)
+      key = static_cast<uint32_t>(gen());
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+
+    const uint32_t *first = sorted.begin(), *last = sorted.end();
+    bench_search("std::lower_bound" + suffix, lookups,
+                 [first, last](uint32_t key) { return std::lower_bound(first, last, key) - first; });
+    bench_search("TinySTL::lower_bound" + suffix, lookups,
+                 [first, last](uint32_t key) { return TinySTL::lower_bound(first, last, key) - first; });
+
+    Timer timer;
+    eytzinger_index<uint32_t> eytzinger(sorted);
+    report("eytzinger_index build" + suffix, n, timer.seconds());
+    bench_search("eytzinger_index" + suffix, lookups,
+                 [&eytzinger](uint32_t key) { return eytzinger.lower_bound(key); });
+
+    timer.reset();
+    blocked_index<uint32_t> blocked(sorted);
+    report("blocked_index build" + suffix, n, timer.seconds());
+    bench_search("blocked_index" + suffix, lookups,
+                 [&blocked](uint32_t key) { return blocked.lower_bound(key); });
+  }
+}
+
+}
+}
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "../src/parallel_algorithm.h"
+#include "../src/vector_parallel.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 按 first_touch 初始化时的划分并行求和：第 p 块由第 p 个工作线程扫描（绑定了 CPU，见 scheduler.h）
+static double static_partition_sum(const vector<double> &v) {
+  scheduler &sched = scheduler::instance();
+  size_t parts = sched.worker_count();
+  size_t n = v.size();
+  if (parts == 0)
+    return TinySTL::accumulate(v.begin(), v.end(), 0.0);
+  uintptr_t base = reinterpret_cast<uintptr_t>(v.begin());
+  vector<double> partial(parts, 0.0);
+  on_each_worker([&](size_t p) {
+    size_t lo = __first_touch_boundary(base, n, sizeof(double), parts, p);
+    size_t hi = __first_touch_boundary(base, n, sizeof(double), parts, p + 1);
+    double sum = 0;
+    for (size_t i = lo; i != hi; ++i)
+      sum += v[i];
+    partial[p] = sum;
+  }, sched);
+  return TinySTL::accumulate(partial.begin(), partial.end(), 0.0);
+}
+
+// 不同方式初始化后扫描若干遍，结果为每个元素的扫描时间（GB/s 可由 8 / ns 换算）
+template<typename Construct>
+static void bench_scan(const std::string &name, size_t n, const Construct &construct) {
+  const int rounds = 5;
+  Timer timer;
+  vector<double> v = construct(n);
+  report(name + " construct", n, timer.seconds());
+  timer.reset();
+  double sum = 0;
+  for (int r = 0; r != rounds; ++r)
+    sum += static_partition_sum(v);
+  do_not_optimize(sum);
+  report(name + " scan", n * rounds, timer.seconds());
+}
+
+TINYSTL_BENCH(FirstTouchBench, Scan) {
+  auto n = max_n(1 << 27);
+  scheduler &sched = scheduler::instance();
+  std::printf("  numa nodes: %zu, threads: %zu, worker 0 pinned to cpu %d\n", scheduler::numa_nodes(), sched.size(),
+              sched.worker_count() == 0 ? -1 : sched.worker_cpu(0));
+  bench_scan("serial", n, [](size_t n) { return vector<double>(n, 1.0); });
+  bench_scan("par", n, [](size_t n) { return make_vector<double>(execution::par, n, 1.0); });
+  bench_scan("first_touch", n, [](size_t n) { return make_vector<double>(execution::first_touch, n, 1.0); });
+}
+
+}
+}
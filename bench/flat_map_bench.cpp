@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/btree_map.h"
+#include "../src/flat_map.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 只读查找：n 个随机 key 建好表后随机查找 n 次
+template<typename Map>
+static void bench_lookup(const std::string &name, const Map &m, const std::vector<uint64_t> &lookups) {
+  Timer timer;
+  uint64_t sum = 0;
+  for (size_t i = 0; i != lookups.size(); ++i)
+    sum += m.lower_bound(lookups[i]) != m.end();
+  do_not_optimize(sum);
+  report(name + " lower_bound", lookups.size(), timer.seconds());
+}
+
+TINYSTL_BENCH(FlatMapBench, Lookup) {
+  auto max = max_n(1 << 22);
+  std::mt19937_64 gen(1);
+  for (size_t n = 1000; n <= max; n *= 32) {
+    std::vector<pair<uint64_t, uint64_t>> items(n);
+    std::vector<uint64_t> lookups(n);
+    for (size_t i = 0; i != n; ++i) {
+      items[i] = pair<uint64_t, uint64_t>(gen(), i);
+      lookups[i] = gen();
+    }
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+    flat_map<uint64_t, uint64_t> flat(items.begin(), items.end());
+    btree_map<uint64_t, uint64_t> btree;
+    std::map<uint64_t, uint64_t> std_m;
+    for (auto &p : items) {
+      btree[p.first] = p.second;
+      std_m[p.first] = p.second;
+    }
+    bench_lookup("flat_map" + suffix, flat, lookups);
+    bench_lookup("btree_map" + suffix, btree, lookups);
+    bench_lookup("std::map" + suffix, std_m, lookups);
+  }
+}
+
+// 往已有 n 个元素的表里分 10 批插入 n 个随机元素：批量归并 vs 逐个插入
+TINYSTL_BENCH(FlatMapBench, BatchInsert) {
+  auto max = max_n(1 << 20);
+  std::mt19937_64 gen(2);
+  for (size_t n = 1000; n <= max; n *= 32) {
+    std::vector<pair<uint64_t, uint64_t>> base(n), extra(n);
+    for (size_t i = 0; i != n; ++i) {
+      base[i] = pair<uint64_t, uint64_t>(gen(), i);
+      extra[i] = pair<uint64_t, uint64_t>(gen(), i);
+    }
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+    size_t batch = n / 10;
+
+    flat_map<uint64_t, uint64_t> bulk(base.begin(), base.end());
+    Timer timer;
+    for (size_t i = 0; i != n; i += batch)
+      bulk.insert(extra.begin() + i, extra.begin() + (i + batch < n ? i + batch : n));
+    report("flat_map batched insert" + suffix, n, timer.seconds());
+
+    // 逐个插入是 O(n^2)，太大时跳过
+    if (n <= 100000) {
+      flat_map<uint64_t, uint64_t> single(base.begin(), base.end());
+      timer.reset();
+      for (auto &p : extra)
+        single.insert(p);
+      report("flat_map single insert" + suffix, n, timer.seconds());
+    }
+
+    std::map<uint64_t, uint64_t> std_m;
+    for (auto &p : base)
+      std_m.insert(std::make_pair(p.first, p.second));
+    timer.reset();
+    for (auto &p : extra)
+      std_m.insert(std::make_pair(p.first, p.second));
+    report("std::map insert" + suffix, n, timer.seconds());
+  }
+}
+
+}
+}
@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../src/function.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 捕获 Words 个 uint64_t 的 lambda：libstdc++ 的 std::function 只内联 16 字节的捕获
+template<size_t Words>
+struct Capture {
+  uint64_t data[Words];
+  uint64_t operator()(uint64_t x) const { return x + data[0] + data[Words - 1]; }
+};
+
+// 构造、析构 n 个包装：模拟把回调放进任务队列再取出
+template<typename Function, size_t Words>
+static void bench_construct(const std::string &name, size_t n) {
+  Capture<Words> c;
+  for (size_t i = 0; i != Words; ++i)
+    c.data[i] = i;
+  std::vector<Function> tasks;
+  tasks.reserve(n);
+  Timer timer;
+  for (size_t i = 0; i != n; ++i) {
+    c.data[0] = i;
+    tasks.push_back(Function(c));
+  }
+  uint64_t sum = 0;
+  for (auto &task : tasks)
+    sum += task(1);
+  tasks.clear();
+  do_not_optimize(sum);
+  report(name + " (" + std::to_string(Words * 8) + "B capture)", n, timer.seconds());
+}
+
+TINYSTL_BENCH(FunctionBench, ConstructInvoke) {
+  auto n = max_n(1 << 20);
+  bench_construct<std::function<uint64_t(uint64_t)>, 2>("std::function", n);
+  bench_construct<function<uint64_t(uint64_t)>, 2>("TinySTL::function", n);
+  bench_construct<std::function<uint64_t(uint64_t)>, 5>("std::function", n);
+  bench_construct<function<uint64_t(uint64_t)>, 5>("TinySTL::function", n);
+  bench_construct<unique_function<uint64_t(uint64_t)>, 5>("TinySTL::unique_function", n);
+  bench_construct<std::function<uint64_t(uint64_t)>, 12>("std::function", n);
+  bench_construct<function<uint64_t(uint64_t)>, 12>("TinySTL::function", n);
+}
+
+// 反复调用同一个包装
+template<typename Function>
+static void bench_invoke(const std::string &name, size_t n) {
+  uint64_t k = 3;
+  Function f = [k](uint64_t x) { return x * k + 1; };
+  do_not_optimize(f);
+  Timer timer;
+  uint64_t x = 0;
+  for (size_t i = 0; i != n; ++i)
+    x = f(x);
+  do_not_optimize(x);
+  report(name, n, timer.seconds());
+}
+
+TINYSTL_BENCH(FunctionBench, Invoke) {
+  auto n = max_n(1 << 24);
+  bench_invoke<std::function<uint64_t(uint64_t)>>("std::function invoke", n);
+  bench_invoke<function<uint64_t(uint64_t)>>("TinySTL::function invoke", n);
+}
+
+}
+}
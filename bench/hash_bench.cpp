@@ -0,0 +1,111 @@
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../src/hash.h"
+#include "../src/unordered_flat_set.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 反复哈希同一段 len 字节的数据，额外打印吞吐量
+template<typename Hash>
+static void bench_bytes(const std::string &name, const std::string &data, size_t rounds, Hash hf) {
+  size_t acc = 0;
+  Timer timer;
+  for (size_t i = 0; i != rounds; ++i) {
+    acc += hf(data);
+    do_not_optimize(acc);
+  }
+  double seconds = timer.seconds();
+  report(name, rounds, seconds);
+  std::printf("    %.2f GB/s\n", static_cast<double>(data.size()) * rounds / seconds / 1e9);
+}
+
+TINYSTL_BENCH(HashBench, Throughput) {
+  auto total = max_n(1 << 20) * 256;
+  std::mt19937 gen(1);
+  for (size_t len : {8, 16, 32, 64, 256, 1024, 64 * 1024}) {
+    std::string data(len, '\0');
+    for (auto &c : data)
+      c = static_cast<char>(gen());
+    size_t rounds = total / len;
+    std::string suffix = " (len=" + std::to_string(len) + ")";
+    bench_bytes("std::hash<std::string>" + suffix, data, rounds, std::hash<std::string>());
+    bench_bytes("TinySTL::hash<std::string>" + suffix, data, rounds, hash<std::string>());
+  }
+}
+
+// 不同分布的 key 在哈希表常用的低 k 位上的碰撞：理想情况下最满的桶约为平均值的几倍
+template<typename Key, typename Hash>
+static void report_collisions(const std::string &name, const std::vector<Key> &keys, Hash hf) {
+  const size_t bits = 16;
+  std::vector<size_t> buckets(static_cast<size_t>(1) << bits);
+  std::unordered_set<size_t> full;
+  for (auto &k : keys) {
+    size_t h = hf(k);
+    full.insert(h);
+    ++buckets[h & (buckets.size() - 1)];
+  }
+  size_t max_bucket = 0, used = 0;
+  for (size_t c : buckets) {
+    max_bucket = c > max_bucket ? c : max_bucket;
+    used += c != 0;
+  }
+  std::printf("  %-48s full collisions %6zu, low 16 bits: max bucket %4zu, used %5zu / %zu\n", name.c_str(),
+              keys.size() - full.size(), max_bucket, used, buckets.size());
+}
+
+TINYSTL_BENCH(HashBench, Collisions) {
+  auto n = max_n(1 << 16);
+  std::vector<uint64_t> ints;
+  std::vector<uint64_t> strided;
+  std::vector<std::string> words;
+  std::vector<std::string> urls;
+  for (size_t i = 0; i != n; ++i) {
+    ints.push_back(i);
+    strided.push_back(i << 16);
+    words.push_back("k" + std::to_string(i));
+    urls.push_back("https://example.com/api/v1/users/" + std::to_string(i) + "/profile");
+  }
+  report_collisions("std::hash sequential ints", ints, std::hash<uint64_t>());
+  report_collisions("TinySTL::hash sequential ints", ints, hash<uint64_t>());
+  report_collisions("std::hash ints << 16", strided, std::hash<uint64_t>());
+  report_collisions("TinySTL::hash ints << 16", strided, hash<uint64_t>());
+  report_collisions("std::hash short strings", words, std::hash<std::string>());
+  report_collisions("TinySTL::hash short strings", words, hash<std::string>());
+  report_collisions("std::hash urls", urls, std::hash<std::string>());
+  report_collisions("TinySTL::hash urls", urls, hash<std::string>());
+}
+
+// 区间插入：逐个插入对比分批计算哈希值、预取起始组
+TINYSTL_BENCH(HashBench, FlatSetRangeInsert) {
+  auto n = max_n(1 << 20);
+  std::mt19937_64 gen(2);
+  std::vector<uint64_t> keys(n);
+  for (auto &k : keys)
+    k = gen();
+  Timer timer;
+  {
+    unordered_flat_set<uint64_t> s;
+    s.reserve(n);
+    for (auto k : keys)
+      s.insert(k);
+    do_not_optimize(s.size());
+  }
+  report("unordered_flat_set insert one by one", n, timer.seconds());
+  timer.reset();
+  {
+    unordered_flat_set<uint64_t> s;
+    s.insert(keys.begin(), keys.end());
+    do_not_optimize(s.size());
+  }
+  report("unordered_flat_set insert(first, last)", n, timer.seconds());
+}
+
+}
+}
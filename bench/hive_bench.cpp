@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "../src/hive.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+struct Particle {
+  double pos[3];
+  double vel[3];
+};
+
+// 对象池负载：n 个对象，随机删除再插入 n / 2 次（按保存的迭代器删除），然后遍历更新全部对象
+TINYSTL_BENCH(HiveBench, Churn) {
+  auto n = max_n(1 << 18);
+  std::mt19937 gen(1);
+  Particle p = {};
+
+  Timer timer;
+  {
+    hive<Particle> h;
+    std::vector<hive<Particle>::iterator> its;
+    for (size_t i = 0; i != n; ++i)
+      its.push_back(h.insert(p));
+    for (size_t i = 0; i != n / 2; ++i) {
+      size_t j = gen() % its.size();
+      h.erase(its[j]);
+      its[j] = h.insert(p);
+    }
+    for (auto &x : h)
+      x.pos[0] += x.vel[0];
+    do_not_optimize(h.size());
+  }
+  report("hive", n, timer.seconds());
+
+  timer.reset();
+  {
+    std::list<Particle> l;
+    std::vector<std::list<Particle>::iterator> its;
+    for (size_t i = 0; i != n; ++i)
+      its.push_back(l.insert(l.end(), p));
+    for (size_t i = 0; i != n / 2; ++i) {
+      size_t j = gen() % its.size();
+      l.erase(its[j]);
+      its[j] = l.insert(l.end(), p);
+    }
+    for (auto &x : l)
+      x.pos[0] += x.vel[0];
+    do_not_optimize(l.size());
+  }
+  report("std::list", n, timer.seconds());
+
+  // vector 没有稳定的句柄，按下标删除，后面的元素整体前移；规模缩小到 1/16，否则太慢
+  size_t m = n / 16;
+  timer.reset();
+  {
+    vector<Particle> v;
+    for (size_t i = 0; i != m; ++i)
+      v.push_back(p);
+    for (size_t i = 0; i != m / 2; ++i) {
+      v.erase(v.begin() + gen() % v.size());
+      v.push_back(p);
+    }
+    for (auto &x : v)
+      x.pos[0] += x.vel[0];
+    do_not_optimize(v.size());
+  }
+  report("vector (n / 16)", m, timer.seconds());
+}
+
+// 删除一半后的遍历：跳跃字段整段跳过空位
+TINYSTL_BENCH(HiveBench, IterateAfterErase) {
+  auto n = max_n(1 << 20);
+  std::mt19937 gen(2);
+  hive<uint64_t> h;
+  std::list<uint64_t> l;
+  std::vector<hive<uint64_t>::iterator> hits;
+  std::vector<std::list<uint64_t>::iterator> lits;
+  for (size_t i = 0; i != n; ++i) {
+    hits.push_back(h.insert(i));
+    lits.push_back(l.insert(l.end(), i));
+  }
+  for (size_t i = 0; i != n; ++i) {
+    if (gen() % 2 == 0) {
+      h.erase(hits[i]);
+      l.erase(lits[i]);
+    }
+  }
+
+  const int rounds = 10;
+  uint64_t sum = 0;
+  Timer timer;
+  for (int r = 0; r != rounds; ++r)
+    for (auto x : h)
+      sum += x;
+  do_not_optimize(sum);
+  report("hive iterate", h.size() * rounds, timer.seconds());
+  timer.reset();
+  for (int r = 0; r != rounds; ++r)
+    for (auto x : l)
+      sum += x;
+  do_not_optimize(sum);
+  report("std::list iterate", l.size() * rounds, timer.seconds());
+}
+
+}
+}
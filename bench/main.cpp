@@ -0,0 +1,16 @@
+#include <cstdio>
+#include <cstring>
+
+#include "bench_utils.h"
+
+// 用法：TinySTLBench [名字过滤串]，只运行名字中包含过滤串的 benchmark
+int main(int argc, char **argv) {
+  const char *filter = argc > 1 ? argv[1] : "";
+  for (auto &bench : TinySTL::Bench::registry()) {
+    if (strstr(bench.name, filter) == nullptr)
+      continue;
+    printf("[%s]\n", bench.name);
+    bench.func();
+  }
+  return 0;
+}
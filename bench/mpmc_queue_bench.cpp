@@ -0,0 +1,106 @@
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../src/__concurrent.h"
+#include "../src/mpmc_queue.h"
+#include "../src/queue.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// pairs 个生产者、pairs 个消费者，一共传递 n 条消息
+static void bench_mpmc(const std::string &name, size_t n, size_t pairs) {
+  mpmc_queue<uint64_t> q(1024);
+  size_t per_thread = n / pairs;
+  std::vector<std::thread> threads;
+  std::vector<uint64_t> sums(pairs, 0);
+  Timer timer;
+  for (size_t p = 0; p != pairs; ++p) {
+    threads.emplace_back([&q, per_thread] {
+      for (uint64_t i = 0; i != per_thread; ++i)
+        q.push(i);
+    });
+  }
+  for (size_t c = 0; c != pairs; ++c) {
+    threads.emplace_back([&q, &sums, c, per_thread] {
+      uint64_t sum = 0, val;
+      for (size_t i = 0; i != per_thread; ++i) {
+        q.pop(val);
+        sum += val;
+      }
+      sums[c] = sum;
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  double seconds = timer.seconds();
+  do_not_optimize(sums);
+  report(name, per_thread * pairs, seconds);
+  auto stats = q.stats();
+  std::printf("    push_retries=%zu pop_retries=%zu push_full=%zu pop_empty=%zu\n",
+              stats.push_retries, stats.pop_retries, stats.push_full, stats.pop_empty);
+}
+
+// 对照组：queue<deque> 外面套一把锁
+static void bench_mutex_queue(const std::string &name, size_t n, size_t pairs) {
+  queue<uint64_t> q;
+  std::mutex mutex;
+  size_t per_thread = n / pairs;
+  std::vector<std::thread> threads;
+  std::vector<uint64_t> sums(pairs, 0);
+  Timer timer;
+  for (size_t p = 0; p != pairs; ++p) {
+    threads.emplace_back([&q, &mutex, per_thread] {
+      for (uint64_t i = 0; i != per_thread; ++i) {
+        std::lock_guard<std::mutex> lock(mutex);
+        q.push(i);
+      }
+    });
+  }
+  for (size_t c = 0; c != pairs; ++c) {
+    threads.emplace_back([&q, &mutex, &sums, c, per_thread] {
+      uint64_t sum = 0;
+      __backoff backoff;
+      for (size_t received = 0; received != per_thread;) {
+        bool got = false;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!q.empty()) {
+            sum += q.front();
+            q.pop();
+            got = true;
+          }
+        }
+        if (got) {
+          ++received;
+          backoff.reset();
+        } else {
+          backoff.pause();
+        }
+      }
+      sums[c] = sum;
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  double seconds = timer.seconds();
+  do_not_optimize(sums);
+  report(name, per_thread * pairs, seconds);
+}
+
+TINYSTL_BENCH(MpmcQueueBench, Scaling) {
+  auto n = max_n(1 << 22);
+  for (size_t pairs : {1, 2, 4, 8, 16, 32}) {
+    std::string suffix = " (" + std::to_string(pairs) + "P" + std::to_string(pairs) + "C)";
+    bench_mpmc("mpmc_queue" + suffix, n, pairs);
+    bench_mutex_queue("mutex + queue<deque>" + suffix, n, pairs);
+  }
+}
+
+}
+}
@@ -0,0 +1,69 @@
+#include <random>
+#include <string>
+
+#include "../src/parallel_algorithm.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 同一个操作分别用 seq、par 跑一遍。并行的线程数由 TINYSTL_NUM_THREADS 决定，
+// 改变它多跑几次就能得到扩展性曲线：TINYSTL_NUM_THREADS=1,2,4,... ./TinySTLBench
+template<typename Function>
+static void bench_policies(const std::string &name, size_t n, const Function &f) {
+  {
+    Timer timer;
+    f(execution::seq);
+    report(name + " seq", n, timer.seconds());
+  }
+  {
+    Timer timer;
+    f(execution::par);
+    report(name + " par (" + std::to_string(scheduler::instance().size()) + " threads)", n, timer.seconds());
+  }
+}
+
+TINYSTL_BENCH(ParallelAlgorithmBench, FillCopy) {
+  auto n = max_n(1 << 26);
+  vector<int> src(n, 1), dst(n, 0);
+  bench_policies("fill", n, [&](const auto &policy) { TinySTL::fill(policy, dst.begin(), dst.end(), 3); });
+  bench_policies("copy", n, [&](const auto &policy) { TinySTL::copy(policy, src.begin(), src.end(), dst.begin()); });
+  int *raw = static_cast<int *>(::operator new(n * sizeof(int)));
+  bench_policies("uninitialized_fill_n", n, [&](const auto &policy) {
+    TinySTL::uninitialized_fill_n(policy, raw, n, 5);
+  });
+  ::operator delete(raw);
+}
+
+TINYSTL_BENCH(ParallelAlgorithmBench, TransformReduce) {
+  auto n = max_n(1 << 24);
+  vector<double> v(n, 1.5), w(n, 0.0);
+  bench_policies("transform", n, [&](const auto &policy) {
+    TinySTL::transform(policy, v.begin(), v.end(), w.begin(), [](double x) { return x * x + 1.0; });
+  });
+  bench_policies("reduce", n, [&](const auto &policy) {
+    double sum = TinySTL::reduce(policy, w.begin(), w.end(), 0.0);
+    do_not_optimize(sum);
+  });
+}
+
+TINYSTL_BENCH(ParallelAlgorithmBench, SortHeap) {
+  auto n = max_n(1 << 23);
+  std::mt19937 rng(1);
+  vector<unsigned> origin(n);
+  for (auto &x : origin)
+    x = rng();
+  vector<unsigned> v;
+  bench_policies("sort", n, [&](const auto &policy) {
+    v = origin;
+    TinySTL::sort(policy, v.begin(), v.end());
+  });
+  bench_policies("make_heap", n, [&](const auto &policy) {
+    v = origin;
+    TinySTL::make_heap(policy, v.begin(), v.end());
+  });
+}
+
+}
+}
@@ -0,0 +1,67 @@
+#include <string>
+#include <vector>
+
+#include "../src/scheduler.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+static long fib(int n) {
+  return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+static long parallel_fib(int n, scheduler &sched) {
+  if (n < 20)
+    return fib(n);
+  long x, y;
+  task_group g(sched);
+  g.spawn([&x, n, &sched] { x = parallel_fib(n - 1, sched); });
+  y = parallel_fib(n - 2, sched);
+  g.sync();
+  return x + y;
+}
+
+// fork-join：递归 spawn，主要看任务创建和窃取的开销
+TINYSTL_BENCH(SchedulerBench, Fib) {
+  const int n = 30;
+  {
+    Timer timer;
+    long res = fib(n);
+    do_not_optimize(res);
+    report("fib(30) serial", 1, timer.seconds());
+  }
+  for (size_t threads : {1, 2, 4, 8}) {
+    scheduler sched(threads);
+    Timer timer;
+    long res = parallel_fib(n, sched);
+    do_not_optimize(res);
+    report("fib(30) task_group (" + std::to_string(threads) + " threads)", 1, timer.seconds());
+  }
+}
+
+// 数据并行：对一个大数组逐元素计算
+TINYSTL_BENCH(SchedulerBench, ParallelFor) {
+  auto n = max_n(1 << 24);
+  std::vector<double> v(n, 1.0);
+  {
+    Timer timer;
+    for (size_t i = 0; i != n; ++i)
+      v[i] = v[i] * 1.0001 + 0.5;
+    do_not_optimize(v[n / 2]);
+    report("loop serial", n, timer.seconds());
+  }
+  for (size_t threads : {1, 2, 4, 8}) {
+    scheduler sched(threads);
+    Timer timer;
+    parallel_for(size_t(0), n, [&v](size_t lo, size_t hi) {
+      for (size_t i = lo; i != hi; ++i)
+        v[i] = v[i] * 1.0001 + 0.5;
+    }, size_t(0), sched);
+    do_not_optimize(v[n / 2]);
+    report("parallel_for (" + std::to_string(threads) + " threads)", n, timer.seconds());
+  }
+}
+
+}
+}
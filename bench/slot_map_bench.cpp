@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <list>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/slot_map.h"
+#include "../src/unordered_flat_map.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 实体表的典型负载：n 个 64 字节的实体，按句柄随机删除一半再插入一半，然后全表遍历、按句柄随机访问
+struct Entity {
+  uint64_t data[8];
+};
+
+TINYSTL_BENCH(SlotMapBench, EntityTable) {
+  auto n = max_n(1 << 18);
+  std::mt19937 gen(1);
+  Entity e = {};
+
+  Timer timer;
+  {
+    slot_map<Entity> m;
+    std::vector<slot_map<Entity>::key_type> keys;
+    for (size_t i = 0; i != n; ++i)
+      keys.push_back(m.insert(e));
+    for (size_t i = 0; i != n / 2; ++i) {
+      size_t j = gen() % keys.size();
+      m.erase(keys[j]);
+      keys[j] = m.insert(e);
+    }
+    uint64_t sum = 0;
+    for (auto &x : m)
+      sum += x.data[0];
+    for (size_t i = 0; i != n; ++i)
+      sum += m[keys[gen() % keys.size()]].data[1];
+    do_not_optimize(sum);
+  }
+  report("slot_map", n, timer.seconds());
+
+  // 以自增 id 为句柄的哈希表
+  timer.reset();
+  {
+    unordered_flat_map<uint64_t, Entity> m;
+    std::vector<uint64_t> keys;
+    uint64_t next_id = 0;
+    for (size_t i = 0; i != n; ++i) {
+      m.insert(TinySTL::make_pair(next_id, e));
+      keys.push_back(next_id++);
+    }
+    for (size_t i = 0; i != n / 2; ++i) {
+      size_t j = gen() % keys.size();
+      m.erase(keys[j]);
+      m.insert(TinySTL::make_pair(next_id, e));
+      keys[j] = next_id++;
+    }
+    uint64_t sum = 0;
+    for (auto &x : m)
+      sum += x.second.data[0];
+    for (size_t i = 0; i != n; ++i)
+      sum += m.find(keys[gen() % keys.size()])->second.data[1];
+    do_not_optimize(sum);
+  }
+  report("unordered_flat_map<id, Entity>", n, timer.seconds());
+
+  // 以迭代器为句柄的链表
+  timer.reset();
+  {
+    std::list<Entity> m;
+    std::vector<std::list<Entity>::iterator> keys;
+    for (size_t i = 0; i != n; ++i)
+      keys.push_back(m.insert(m.end(), e));
+    for (size_t i = 0; i != n / 2; ++i) {
+      size_t j = gen() % keys.size();
+      m.erase(keys[j]);
+      keys[j] = m.insert(m.end(), e);
+    }
+    uint64_t sum = 0;
+    for (auto &x : m)
+      sum += x.data[0];
+    for (size_t i = 0; i != n; ++i)
+      sum += keys[gen() % keys.size()]->data[1];
+    do_not_optimize(sum);
+  }
+  report("std::list<Entity>", n, timer.seconds());
+}
+
+// 单独的遍历：slot_map 是连续数组，链表在删除、插入后节点分散
+TINYSTL_BENCH(SlotMapBench, Iterate) {
+  auto n = max_n(1 << 20);
+  std::mt19937 gen(2);
+  slot_map<uint64_t> m;
+  std::list<uint64_t> l;
+  std::vector<slot_map<uint64_t>::key_type> keys;
+  std::vector<std::list<uint64_t>::iterator> its;
+  for (size_t i = 0; i != n; ++i) {
+    keys.push_back(m.insert(i));
+    its.push_back(l.insert(l.end(), i));
+  }
+  for (size_t i = 0; i != n / 2; ++i) {
+    size_t j = gen() % n;
+    m.erase(keys[j]);
+    keys[j] = m.insert(i);
+    l.erase(its[j]);
+    its[j] = l.insert(l.end(), i);
+  }
+
+  const int rounds = 10;
+  Timer timer;
+  uint64_t sum = 0;
+  for (int r = 0; r != rounds; ++r)
+    for (auto x : m)
+      sum += x;
+  do_not_optimize(sum);
+  report("slot_map iterate", n * rounds, timer.seconds());
+  timer.reset();
+  for (int r = 0; r != rounds; ++r)
+    for (auto x : l)
+      sum += x;
+  do_not_optimize(sum);
+  report("std::list iterate", n * rounds, timer.seconds());
+}
+
+}
+}
@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <vector>
+
+#include "../src/soa_vector.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 64 字节的记录，热循环只用其中一个字段
+struct Record {
+  double price;
+  double qty;
+  uint64_t id;
+  uint64_t ts;
+  double extra[4];
+};
+
+TINYSTL_BENCH(SoaVectorBench, SumOneField) {
+  auto n = max_n(1 << 20);
+  std::vector<Record> sv;
+  vector<Record> v;
+  soa_vector<double, double, uint64_t, uint64_t> soa;
+  for (size_t i = 0; i != n; ++i) {
+    Record r = {i * 0.5, 1.0, i, i, {0, 0, 0, 0}};
+    sv.push_back(r);
+    v.push_back(r);
+    soa.push_back(r.price, r.qty, r.id, r.ts);
+  }
+
+  const int rounds = 20;
+  double sum = 0;
+  Timer timer;
+  for (int r = 0; r != rounds; ++r)
+    for (auto &x : sv)
+      sum += x.price;
+  do_not_optimize(sum);
+  report("std::vector<Record>", n * rounds, timer.seconds());
+
+  timer.reset();
+  for (int r = 0; r != rounds; ++r)
+    for (auto &x : v)
+      sum += x.price;
+  do_not_optimize(sum);
+  report("vector<Record>", n * rounds, timer.seconds());
+
+  timer.reset();
+  for (int r = 0; r != rounds; ++r)
+    for (double x : soa.column<0>())
+      sum += x;
+  do_not_optimize(sum);
+  report("soa_vector column", n * rounds, timer.seconds());
+}
+
+// 构造：所有列一起扩容
+TINYSTL_BENCH(SoaVectorBench, PushBack) {
+  auto n = max_n(1 << 20);
+  Timer timer;
+  {
+    vector<Record> v;
+    for (size_t i = 0; i != n; ++i) {
+      Record r = {i * 0.5, 1.0, i, i, {0, 0, 0, 0}};
+      v.push_back(r);
+    }
+    do_not_optimize(v.size());
+  }
+  report("vector<Record>", n, timer.seconds());
+
+  timer.reset();
+  {
+    soa_vector<double, double, uint64_t, uint64_t> soa;
+    for (size_t i = 0; i != n; ++i)
+      soa.push_back(i * 0.5, 1.0, static_cast<uint64_t>(i), static_cast<uint64_t>(i));
+    do_not_optimize(soa.size());
+  }
+  report("soa_vector", n, timer.seconds());
+}
+
+}
+}
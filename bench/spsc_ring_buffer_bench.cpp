@@ -0,0 +1,152 @@
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../src/__concurrent.h"
+#include "../src/queue.h"
+#include "../src/spsc_ring_buffer.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 一个生产者线程、一个消费者线程，逐个传递 n 条消息
+static void bench_spsc_single(const std::string &name, size_t n) {
+  spsc_ring_buffer<uint64_t> rb(4096);
+  Timer timer;
+  std::thread producer([&rb, n] {
+    for (uint64_t i = 0; i != n; ++i)
+      rb.push_back(i);
+  });
+  uint64_t sum = 0;
+  __backoff backoff;
+  for (size_t received = 0; received != n;) {
+    uint64_t val;
+    if (rb.try_pop(val)) {
+      sum += val;
+      ++received;
+      backoff.reset();
+    } else {
+      backoff.pause();
+    }
+  }
+  producer.join();
+  do_not_optimize(sum);
+  report(name, n, timer.seconds());
+}
+
+// 批量传递，每批最多 batch 条
+static void bench_spsc_batch(const std::string &name, size_t n, size_t batch) {
+  spsc_ring_buffer<uint64_t> rb(4096);
+  Timer timer;
+  std::thread producer([&rb, n, batch] {
+    uint64_t buf[256];
+    __backoff backoff;
+    for (uint64_t i = 0; i < n;) {
+      size_t len = 0;
+      for (; len != batch && i + len < n; ++len)
+        buf[len] = i + len;
+      size_t pushed = rb.push_n(buf, len);
+      i += pushed;
+      if (pushed == 0)
+        backoff.pause();
+      else
+        backoff.reset();
+    }
+  });
+  uint64_t sum = 0;
+  uint64_t buf[256];
+  __backoff backoff;
+  for (size_t received = 0; received != n;) {
+    size_t len = rb.pop_n(buf, batch);
+    for (size_t i = 0; i != len; ++i)
+      sum += buf[i];
+    received += len;
+    if (len == 0)
+      backoff.pause();
+    else
+      backoff.reset();
+  }
+  producer.join();
+  do_not_optimize(sum);
+  report(name, n, timer.seconds());
+}
+
+// 对照组：queue<deque> 外面套一把锁
+static void bench_mutex_queue(const std::string &name, size_t n) {
+  queue<uint64_t> q;
+  std::mutex mutex;
+  Timer timer;
+  std::thread producer([&q, &mutex, n] {
+    for (uint64_t i = 0; i != n; ++i) {
+      std::lock_guard<std::mutex> lock(mutex);
+      q.push(i);
+    }
+  });
+  uint64_t sum = 0;
+  __backoff backoff;
+  for (size_t received = 0; received != n;) {
+    bool got = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!q.empty()) {
+        sum += q.front();
+        q.pop();
+        got = true;
+      }
+    }
+    if (got) {
+      ++received;
+      backoff.reset();
+    } else {
+      backoff.pause();
+    }
+  }
+  producer.join();
+  do_not_optimize(sum);
+  report(name, n, timer.seconds());
+}
+
+// 延迟：两个环形队列来回传递一条消息，结果为一次往返的时间
+static void bench_spsc_ping_pong(const std::string &name, size_t rounds) {
+  spsc_ring_buffer<uint64_t> ping(64), pong(64);
+  std::thread echo([&ping, &pong, rounds] {
+    __backoff backoff;
+    for (size_t i = 0; i != rounds; ++i) {
+      uint64_t val;
+      while (!ping.try_pop(val))
+        backoff.pause();
+      backoff.reset();
+      pong.push_back(val);
+    }
+  });
+  Timer timer;
+  __backoff backoff;
+  for (uint64_t i = 0; i != rounds; ++i) {
+    ping.push_back(i);
+    uint64_t val;
+    while (!pong.try_pop(val))
+      backoff.pause();
+    backoff.reset();
+  }
+  double seconds = timer.seconds();
+  echo.join();
+  report(name, rounds, seconds);
+}
+
+TINYSTL_BENCH(SpscRingBufferBench, Throughput) {
+  auto n = max_n(1 << 24);
+  bench_spsc_single("spsc_ring_buffer push_back/try_pop", n);
+  bench_spsc_batch("spsc_ring_buffer push_n/pop_n (16)", n, 16);
+  bench_spsc_batch("spsc_ring_buffer push_n/pop_n (256)", n, 256);
+  bench_mutex_queue("mutex + queue<deque>", n);
+}
+
+TINYSTL_BENCH(SpscRingBufferBench, PingPongLatency) {
+  auto rounds = max_n(1 << 18);
+  bench_spsc_ping_pong("spsc_ring_buffer round trip", rounds);
+}
+
+}
+}
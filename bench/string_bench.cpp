@@ -0,0 +1,86 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/string.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 构造 n 个长度为 len 的 key 再全部析构：len 超过 15 后 std::string 每个都要一次 malloc，
+// TinySTL::string 在 23 以内不分配，127 以内从 __alloc 的内存池分配
+template<typename String>
+static void bench_construct(const std::string &name, const std::vector<std::string> &src) {
+  Timer timer;
+  {
+    std::vector<String> keys;
+    keys.reserve(src.size());
+    for (auto &s : src)
+      keys.push_back(String(s.data(), s.size()));
+    do_not_optimize(keys.back()[0]);
+  }
+  report(name, src.size(), timer.seconds());
+}
+
+TINYSTL_BENCH(StringBench, ShortKeys) {
+  auto n = max_n(1 << 20);
+  std::mt19937 gen(1);
+  for (size_t len : {8, 20, 32, 64}) {
+    std::vector<std::string> src(n);
+    for (auto &s : src) {
+      s.resize(len);
+      for (auto &c : s)
+        c = static_cast<char>('a' + gen() % 26);
+    }
+    std::string suffix = " (len=" + std::to_string(len) + ")";
+    bench_construct<std::string>("std::string construct" + suffix, src);
+    bench_construct<string>("TinySTL::string construct" + suffix, src);
+  }
+}
+
+// vector 逐个 push_back 到 n 个：扩容时 std::vector<std::string> 逐个移动构造，vector<string> 直接 memcpy
+TINYSTL_BENCH(StringBench, VectorGrowth) {
+  auto n = max_n(1 << 20);
+  std::string key(40, 'k');
+  Timer timer;
+  {
+    std::vector<std::string> v;
+    for (size_t i = 0; i != n; ++i)
+      v.push_back(key);
+    do_not_optimize(v.size());
+  }
+  report("std::vector<std::string> push_back", n, timer.seconds());
+  timer.reset();
+  {
+    vector<string> v;
+    string k(key.data(), key.size());
+    for (size_t i = 0; i != n; ++i)
+      v.push_back(k);
+    do_not_optimize(v.size());
+  }
+  report("vector<string> push_back", n, timer.seconds());
+}
+
+TINYSTL_BENCH(StringBench, Find) {
+  auto n = max_n(1 << 20);
+  std::string text(4096, 'a');
+  text += "needle";
+  string t(text.data(), text.size());
+  Timer timer;
+  size_t sum = 0;
+  for (size_t i = 0; i != n / 64; ++i)
+    sum += text.find("needle");
+  do_not_optimize(sum);
+  report("std::string find (4KB)", n / 64, timer.seconds());
+  timer.reset();
+  for (size_t i = 0; i != n / 64; ++i)
+    sum += t.find("needle");
+  do_not_optimize(sum);
+  report("TinySTL::string find (4KB)", n / 64, timer.seconds());
+}
+
+}
+}
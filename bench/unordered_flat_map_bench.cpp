@@ -0,0 +1,61 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/unordered_flat_map.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 插入 n 个随机 key，再分别查找 n 个存在的、n 个不存在的 key，最后全部删除
+template<typename Map>
+static void bench_map(const std::string &name, const std::vector<uint64_t> &keys,
+                      const std::vector<uint64_t> &misses) {
+  size_t n = keys.size();
+  Map m;
+  Timer timer;
+  for (size_t i = 0; i != n; ++i)
+    m[keys[i]] = i;
+  report(name + " insert", n, timer.seconds());
+
+  timer.reset();
+  uint64_t sum = 0;
+  for (size_t i = 0; i != n; ++i)
+    sum += m.find(keys[i])->second;
+  do_not_optimize(sum);
+  report(name + " find hit", n, timer.seconds());
+
+  timer.reset();
+  size_t found = 0;
+  for (size_t i = 0; i != n; ++i)
+    found += m.count(misses[i]);
+  do_not_optimize(found);
+  report(name + " find miss", n, timer.seconds());
+
+  timer.reset();
+  for (size_t i = 0; i != n; ++i)
+    m.erase(keys[i]);
+  report(name + " erase", n, timer.seconds());
+}
+
+TINYSTL_BENCH(UnorderedFlatMapBench, RandomKeys) {
+  auto max = max_n(1 << 24);
+  std::mt19937_64 gen(1);
+  for (size_t n = 1000; n <= max && n <= 100000000; n *= 10) {
+    // 奇数 key 插入，偶数 key 用来查找失败的情况
+    std::vector<uint64_t> keys(n), misses(n);
+    for (size_t i = 0; i != n; ++i) {
+      keys[i] = gen() | 1;
+      misses[i] = gen() & ~uint64_t(1);
+    }
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+    bench_map<unordered_flat_map<uint64_t, uint64_t>>("unordered_flat_map" + suffix, keys, misses);
+    bench_map<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map" + suffix, keys, misses);
+  }
+}
+
+}
+}
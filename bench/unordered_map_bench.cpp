@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../src/unordered_map.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+// 逐个插入 n 个随机 key，全部查找一遍，再全部删除
+template<typename Map>
+static void bench_node_map(const std::string &name, const std::vector<uint64_t> &keys) {
+  size_t n = keys.size();
+  Map m;
+  Timer timer;
+  for (size_t i = 0; i != n; ++i)
+    m[keys[i]] = i;
+  report(name + " insert", n, timer.seconds());
+
+  timer.reset();
+  uint64_t sum = 0;
+  for (size_t i = 0; i != n; ++i)
+    sum += m.find(keys[i])->second;
+  do_not_optimize(sum);
+  report(name + " find", n, timer.seconds());
+
+  timer.reset();
+  for (size_t i = 0; i != n; ++i)
+    m.erase(keys[i]);
+  report(name + " erase", n, timer.seconds());
+}
+
+// 区间插入：TinySTL 先 reserve 一次，std 逐个插入时多次 rehash
+template<typename Map, typename Pair>
+static void bench_bulk_insert(const std::string &name, const std::vector<Pair> &values) {
+  Timer timer;
+  Map m;
+  m.insert(values.begin(), values.end());
+  do_not_optimize(m.size());
+  report(name + " bulk insert", values.size(), timer.seconds());
+}
+
+TINYSTL_BENCH(UnorderedMapBench, RandomKeys) {
+  auto max = max_n(1 << 22);
+  std::mt19937_64 gen(1);
+  for (size_t n = 1000; n <= max; n *= 10) {
+    std::vector<uint64_t> keys(n);
+    std::vector<pair<const uint64_t, uint64_t>> values;
+    std::vector<std::pair<const uint64_t, uint64_t>> std_values;
+    for (size_t i = 0; i != n; ++i) {
+      keys[i] = gen();
+      values.push_back(pair<const uint64_t, uint64_t>(keys[i], i));
+      std_values.push_back(std::pair<const uint64_t, uint64_t>(keys[i], i));
+    }
+    std::string suffix = " (n=" + std::to_string(n) + ")";
+    bench_node_map<unordered_map<uint64_t, uint64_t>>("unordered_map" + suffix, keys);
+    bench_node_map<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map" + suffix, keys);
+    bench_bulk_insert<unordered_map<uint64_t, uint64_t>>("unordered_map" + suffix, values);
+    bench_bulk_insert<std::unordered_map<uint64_t, uint64_t>>("std::unordered_map" + suffix, std_values);
+  }
+}
+
+}
+}
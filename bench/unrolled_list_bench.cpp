@@ -0,0 +1,96 @@
+#include <string>
+
+#include "../src/list.h"
+#include "../src/unrolled_list.h"
+#include "../src/vector.h"
+#include "bench_utils.h"
+
+namespace TinySTL {
+namespace Bench {
+
+template<typename Container>
+static void bench_push_back(const std::string &name, size_t n) {
+  Timer timer;
+  Container c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(static_cast<int>(i));
+  do_not_optimize(c.size());
+  report(name, n, timer.seconds());
+}
+
+template<typename Container>
+static void bench_traverse(const std::string &name, size_t n, size_t rounds) {
+  Container c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(static_cast<int>(i));
+  Timer timer;
+  long long sum = 0;
+  for (size_t r = 0; r != rounds; ++r) {
+    for (auto it = c.begin(); it != c.end(); ++it)
+      sum += *it;
+  }
+  do_not_optimize(sum);
+  report(name, n * rounds, timer.seconds());
+}
+
+// 边遍历边在迭代器附近插入：每隔一个元素插入一个
+static void bench_list_insert_near(const std::string &name, size_t n) {
+  list<int> c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(static_cast<int>(i));
+  Timer timer;
+  for (auto it = c.begin(); it != c.end(); ++it)
+    c.insert(it, -1);
+  do_not_optimize(c.size());
+  report(name, n, timer.seconds());
+}
+
+static void bench_unrolled_list_insert_near(const std::string &name, size_t n) {
+  unrolled_list<int> c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(static_cast<int>(i));
+  Timer timer;
+  for (auto it = c.begin(); it != c.end(); ++it) {
+    // 插入会使同一节点的迭代器失效，使用返回值继续
+    it = c.insert(it, -1);
+    ++it;
+  }
+  do_not_optimize(c.size());
+  report(name, n, timer.seconds());
+}
+
+static void bench_vector_insert_near(const std::string &name, size_t n) {
+  vector<int> c;
+  for (size_t i = 0; i != n; ++i)
+    c.push_back(static_cast<int>(i));
+  Timer timer;
+  for (size_t i = 0; i < c.size(); i += 2)
+    c.insert(c.begin() + i, -1);
+  do_not_optimize(c.size());
+  report(name, n, timer.seconds());
+}
+
+TINYSTL_BENCH(UnrolledListBench, PushBack) {
+  auto n = max_n(1 << 22);
+  bench_push_back<list<int>>("list<int>", n);
+  bench_push_back<unrolled_list<int>>("unrolled_list<int>", n);
+  bench_push_back<vector<int>>("vector<int>", n);
+}
+
+TINYSTL_BENCH(UnrolledListBench, Traverse) {
+  auto n = max_n(1 << 22);
+  bench_traverse<list<int>>("list<int>", n, 10);
+  bench_traverse<unrolled_list<int>>("unrolled_list<int>", n, 10);
+  bench_traverse<vector<int>>("vector<int>", n, 10);
+}
+
+TINYSTL_BENCH(UnrolledListBench, InsertNearIterator) {
+  auto n = max_n(1 << 20);
+  bench_list_insert_near("list<int>", n);
+  bench_unrolled_list_insert_near("unrolled_list<int>", n);
+  // vector 是 O(n^2)，规模小一些
+  bench_vector_insert_near("vector<int> (n / 16)", n / 16);
+}
+
+}
+}
@@ -0,0 +1,619 @@
+#ifndef TINYSTL_SRC___BTREE_H_
+#define TINYSTL_SRC___BTREE_H_
+
+/**
+ * B 树，btree_map、btree_set 的底层实现。
+ *
+ * 和红黑树相比，每个节点存放多个有序的元素（约占 BtreeAux::__target_node_bytes 字节，几个缓存行），
+ * 树高是 log_{N+1}(n)，查找时访问的节点少、每个节点内的元素连续，缓存友好；每个元素也不用额外的 3 个指针。
+ *
+ * 节点：
+ *  - 叶子节点：父指针、在父节点中的下标、元素个数，以及最多 node_values 个元素；
+ *  - 内部节点：在叶子节点的基础上多了 node_values + 1 个孩子指针，
+ *    第 i 个孩子中的元素都小于 values[i]，大于 values[i - 1]。
+ * 除根节点外，每个节点至少有 min_values 个元素。
+ *
+ * 插入：找到叶子节点，放不下时从中间分裂，中间的元素上移到父节点，父节点满了就先分裂父节点。
+ * 删除：内部节点的元素用前驱（左子树的最大元素）替换，转化为删除叶子节点的元素；
+ *       删除后元素太少时，先尝试向兄弟节点借一个，借不到就和兄弟节点合并，再检查父节点。
+ *
+ * 注意：
+ *  1. 元素在节点内、节点间移动，插入、删除之后所有迭代器、指针、引用都会失效。
+ *  2. 元素的移动都是“移动构造 + 析构”，不要求赋值运算符（pair<const Key, T> 不能赋值）。
+ *  3. 节点通过 allocator 申请；不超过 128 字节的节点走 __alloc 的内存池，更大的节点由 __alloc 转交 malloc。
+ */
+
+#include <cstddef>
+#include <iterator>
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace BtreeAux {
+// 叶子节点的目标大小
+const size_t __target_node_bytes = 256;
+// 每个节点至少放这么多元素，否则退化成二叉树
+const size_t __min_node_values = 3;
+}
+
+template<typename Value, size_t N>
+struct __btree_node {
+  __btree_node *parent;
+  unsigned short position; // 在父节点 children 中的下标
+  unsigned short count;    // 元素个数
+  bool leaf;
+  alignas(Value) unsigned char storage[N * sizeof(Value)];
+
+  Value *values() { return reinterpret_cast<Value *>(storage); }
+  Value &value(size_t i) { return values()[i]; }
+};
+
+template<typename Value, size_t N>
+struct __btree_internal_node : public __btree_node<Value, N> {
+  __btree_node<Value, N> *children[N + 1];
+};
+
+/// 根据元素大小决定每个节点放多少个元素
+template<typename Value>
+struct __btree_node_values {
+  static const size_t __fit = (BtreeAux::__target_node_bytes - 2 * sizeof(void *)) / sizeof(Value);
+  static const size_t value = __fit < BtreeAux::__min_node_values ? BtreeAux::__min_node_values : __fit;
+};
+
+template<typename Value, typename Ref, typename Ptr, size_t N>
+struct __btree_iterator {
+  typedef bidirectional_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+  typedef __btree_node<Value, N> node;
+  typedef __btree_iterator<Value, Value &, Value *, N> iterator;
+
+  // end() 为 (root, root->count)，空树为 (nullptr, 0)
+  node *cur;
+  size_t pos;
+
+  __btree_iterator() : cur(nullptr), pos(0) {}
+  __btree_iterator(node *n, size_t p) : cur(n), pos(p) {}
+  // iterator 可以转换为 const_iterator，反过来则被排除。写成模板，iterator 自己仍使用隐式的拷贝构造、拷贝赋值
+  template<typename R, typename P, typename = typename __enable_if<__is_same_type<R, Value &>::value>::type>
+  __btree_iterator(const __btree_iterator<Value, R, P, N> &it) : cur(it.cur), pos(it.pos) {}
+
+  reference operator*() const { return cur->value(pos); }
+  pointer operator->() const { return &cur->value(pos); }
+  // 内部节点：右子树的最左叶子；叶子节点：下一个元素，走完了就回到父节点
+  __btree_iterator &operator++() {
+    if (!cur->leaf) {
+      cur = static_cast<__btree_internal_node<Value, N> *>(cur)->children[pos + 1];
+      while (!cur->leaf)
+        cur = static_cast<__btree_internal_node<Value, N> *>(cur)->children[0];
+      pos = 0;
+      return *this;
+    }
+    ++pos;
+    while (pos == cur->count && cur->parent != nullptr) {
+      pos = cur->position;
+      cur = cur->parent;
+    }
+    return *this;
+  }
+  __btree_iterator &operator--() {
+    if (!cur->leaf) {
+      cur = static_cast<__btree_internal_node<Value, N> *>(cur)->children[pos];
+      while (!cur->leaf)
+        cur = static_cast<__btree_internal_node<Value, N> *>(cur)->children[cur->count];
+      pos = cur->count - 1;
+      return *this;
+    }
+    while (pos == 0 && cur->parent != nullptr) {
+      pos = cur->position;
+      cur = cur->parent;
+    }
+    --pos;
+    return *this;
+  }
+  __btree_iterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  __btree_iterator operator--(int) {
+    auto tmp = *this;
+    --*this;
+    return tmp;
+  }
+  friend bool operator==(const __btree_iterator &x, const __btree_iterator &y) {
+    return x.cur == y.cur && x.pos == y.pos;
+  }
+  friend bool operator!=(const __btree_iterator &x, const __btree_iterator &y) { return !(x == y); }
+};
+
+template<typename Value, typename Key, typename ExtractKey, typename Compare, typename Alloc>
+class __btree {
+ public:
+  static const size_t node_values = __btree_node_values<Value>::value;
+  static const size_t min_values = (node_values - 1) / 2;
+
+  using value_type = Value;
+  using key_type = Key;
+  using key_compare = Compare;
+  using pointer = Value *;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = __btree_iterator<Value, Value &, Value *, node_values>;
+  using const_iterator = __btree_iterator<Value, const Value &, const Value *, node_values>;
+
+ protected:
+  using node = __btree_node<Value, node_values>;
+  using internal_node = __btree_internal_node<Value, node_values>;
+  using leaf_allocator = allocator<node>;
+  using internal_allocator = allocator<internal_node>;
+  using data_allocator = Alloc;
+
+  node *root;
+  node *leftmost; // 最小元素所在的叶子节点，begin() 为 O(1)
+  // 比较函数通常是空类，和元素个数放在一起，由 EBO 省掉它的空间
+  __compressed_pair<size_type, key_compare> size_comp;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  explicit __btree(const key_compare &c = key_compare()) : root(nullptr), leftmost(nullptr), size_comp(0, c) {}
+  __btree(const __btree &x) : __btree(x.comp()) {
+    if (x.root == nullptr)
+      return;
+    root = copy_subtree(x.root, nullptr, 0);
+    leftmost = root;
+    while (!leftmost->leaf)
+      leftmost = child(leftmost, 0);
+    num_elements() = x.num_elements();
+  }
+  __btree(__btree &&x) : __btree(x.comp()) { swap(*this, x); }
+  __btree &operator=(__btree x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~__btree() { clear(); }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return num_elements(); }
+  bool empty() const { return num_elements() == 0; }
+  key_compare key_comp() const { return comp(); }
+  /// 树高，空树为 0
+  size_type height() const {
+    size_type h = 0;
+    for (node *x = root; x != nullptr; x = x->leaf ? nullptr : child(x, 0))
+      ++h;
+    return h;
+  }
+  /// 所有节点占用的字节数
+  size_type bytes_used() const { return root == nullptr ? 0 : subtree_bytes(root); }
+
+  const_iterator begin() const { return const_cast<__btree *>(this)->begin(); }
+  const_iterator end() const { return const_cast<__btree *>(this)->end(); }
+  const_iterator find(const key_type &key) const { return const_cast<__btree *>(this)->find(key); }
+  const_iterator lower_bound(const key_type &key) const { return const_cast<__btree *>(this)->lower_bound(key); }
+  const_iterator upper_bound(const key_type &key) const { return const_cast<__btree *>(this)->upper_bound(key); }
+  size_type count(const key_type &key) const { return find(key) == end() ? 0 : 1; }
+
+  /*************** 迭代器 ************/
+  iterator begin() { return root == nullptr ? end() : iterator(leftmost, 0); }
+  iterator end() { return root == nullptr ? iterator() : iterator(root, root->count); }
+
+  /*************** 查找 ************/
+  /// 第一个不小于 key 的元素
+  iterator lower_bound(const key_type &key) {
+    iterator res = end();
+    for (node *x = root; x != nullptr;) {
+      size_type i = node_lower_bound(x, key);
+      if (i < x->count) {
+        res = iterator(x, i);
+        // 相等的元素只有一个，不用再往下找
+        if (!comp()(key, get_key(x->value(i))))
+          return res;
+      }
+      x = x->leaf ? nullptr : child(x, i);
+    }
+    return res;
+  }
+  /// 第一个大于 key 的元素
+  iterator upper_bound(const key_type &key) {
+    iterator res = end();
+    for (node *x = root; x != nullptr;) {
+      size_type i = node_upper_bound(x, key);
+      if (i < x->count)
+        res = iterator(x, i);
+      x = x->leaf ? nullptr : child(x, i);
+    }
+    return res;
+  }
+  iterator find(const key_type &key) {
+    iterator it = lower_bound(key);
+    if (it == end() || comp()(key, get_key(*it)))
+      return end();
+    return it;
+  }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) { return try_emplace_key(get_key(val), val); }
+  pair<iterator, bool> insert(value_type &&val) { return try_emplace_key(get_key(val), TinySTL::move(val)); }
+  /// key 不存在时用 value_type(args...) 构造新元素，存在时什么也不做
+  template<typename... Args>
+  pair<iterator, bool> try_emplace_key(const key_type &key, Args &&... args) {
+    if (root == nullptr) {
+      root = leftmost = new_leaf();
+      root->parent = nullptr;
+      root->position = 0;
+    }
+    node *x = root;
+    size_type i;
+    while (true) {
+      i = node_lower_bound(x, key);
+      if (i < x->count && !comp()(key, get_key(x->value(i))))
+        return pair<iterator, bool>(iterator(x, i), false);
+      if (x->leaf)
+        break;
+      x = child(x, i);
+    }
+    return pair<iterator, bool>(emplace_at(x, i, TinySTL::forward<Args>(args)...), true);
+  }
+  /// 返回被删除元素的下一个元素
+  iterator erase(const_iterator pos) {
+    // 删除会在节点间移动元素，记下 key 之后重新查找
+    key_type key = get_key(*pos);
+    erase_at(pos.cur, pos.pos);
+    return lower_bound(key);
+  }
+  size_type erase_key(const key_type &key) {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    erase_at(it.cur, it.pos);
+    return 1;
+  }
+  void clear() {
+    if (root != nullptr)
+      destroy_subtree(root);
+    root = leftmost = nullptr;
+    num_elements() = 0;
+  }
+  /**
+   * 用严格递增的 [first, last) 替换现有元素，O(n)。
+   * 自底向上按中序依次构造，每个节点尽量装满，兄弟节点之间元素个数至多差 1。
+   */
+  template<typename ForwardIterator>
+  void assign_sorted(ForwardIterator first, ForwardIterator last) {
+    clear();
+    size_type n = static_cast<size_type>(std::distance(first, last));
+    if (n == 0)
+      return;
+    size_type h = 0;
+    while (subtree_capacity(h) < n)
+      ++h;
+    root = build_subtree(h, n, first);
+    root->parent = nullptr;
+    root->position = 0;
+    leftmost = root;
+    while (!leftmost->leaf)
+      leftmost = child(leftmost, 0);
+    num_elements() = n;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(__btree &x, __btree &y) {
+    TinySTL::swap(x.root, y.root);
+    TinySTL::swap(x.leftmost, y.leftmost);
+    TinySTL::swap(x.num_elements(), y.num_elements());
+    TinySTL::swap(x.comp(), y.comp());
+  }
+  friend bool operator==(const __btree &x, const __btree &y) {
+    if (x.size() != y.size())
+      return false;
+    for (auto it1 = x.begin(), it2 = y.begin(); it1 != x.end(); ++it1, ++it2) {
+      if (!(*it1 == *it2))
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const __btree &x, const __btree &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  size_type &num_elements() { return size_comp.first(); }
+  const size_type &num_elements() const { return size_comp.first(); }
+  key_compare &comp() { return size_comp.second(); }
+  const key_compare &comp() const { return size_comp.second(); }
+  // 取 key 的函数对象都是无状态的，不必存成员
+  static const key_type &get_key(const value_type &val) { return ExtractKey()(val); }
+  static node *child(node *x, size_type i) { return static_cast<internal_node *>(x)->children[i]; }
+  static void set_child(node *x, size_type i, node *c) {
+    static_cast<internal_node *>(x)->children[i] = c;
+    c->parent = x;
+    c->position = static_cast<unsigned short>(i);
+  }
+  static node *new_leaf() {
+    node *x = leaf_allocator::allocate();
+    x->count = 0;
+    x->leaf = true;
+    return x;
+  }
+  static node *new_internal() {
+    node *x = internal_allocator::allocate();
+    x->count = 0;
+    x->leaf = false;
+    return x;
+  }
+  // 只释放节点，元素已经析构或移走
+  static void delete_node(node *x) {
+    if (x->leaf)
+      leaf_allocator::deallocate(x);
+    else
+      internal_allocator::deallocate(static_cast<internal_node *>(x));
+  }
+  // 移动构造到 dst，再析构 src
+  static void relocate(Value *dst, Value *src) {
+    new(dst) Value(TinySTL::move(*src));
+    data_allocator::destroy(src);
+  }
+
+  size_type node_lower_bound(node *x, const key_type &key) const {
+    size_type lo = 0, hi = x->count;
+    while (lo < hi) {
+      size_type mid = (lo + hi) / 2;
+      if (comp()(get_key(x->value(mid)), key))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  }
+  size_type node_upper_bound(node *x, const key_type &key) const {
+    size_type lo = 0, hi = x->count;
+    while (lo < hi) {
+      size_type mid = (lo + hi) / 2;
+      if (comp()(key, get_key(x->value(mid))))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  }
+
+  /// 在叶子节点 x 的位置 i 构造新元素
+  template<typename... Args>
+  iterator emplace_at(node *x, size_type i, Args &&... args) {
+    if (x->count == node_values) {
+      split(x);
+      // 中间元素上移后，i 在右半边时转到新节点
+      if (i > x->count) {
+        i -= x->count + 1;
+        x = child(x->parent, x->position + 1);
+      }
+    }
+    for (size_type j = x->count; j > i; --j)
+      relocate(&x->value(j), &x->value(j - 1));
+    try {
+      new(&x->value(i)) Value(TinySTL::forward<Args>(args)...);
+    } catch (...) {
+      for (size_type j = i; j < x->count; ++j)
+        relocate(&x->value(j), &x->value(j + 1));
+      throw;
+    }
+    ++x->count;
+    ++num_elements();
+    return iterator(x, i);
+  }
+  /// 满节点 x 从中间分裂：左半边留在 x，右半边移到新节点，中间元素上移到父节点
+  void split(node *x) {
+    if (x == root) {
+      node *r = new_internal();
+      r->parent = nullptr;
+      r->position = 0;
+      set_child(r, 0, x);
+      root = r;
+    } else if (x->parent->count == node_values) {
+      split(x->parent);
+    }
+    node *p = x->parent;
+    const size_type mid = node_values / 2;
+    node *y = x->leaf ? new_leaf() : new_internal();
+    y->count = static_cast<unsigned short>(node_values - mid - 1);
+    for (size_type j = 0; j != y->count; ++j)
+      relocate(&y->value(j), &x->value(mid + 1 + j));
+    if (!x->leaf) {
+      for (size_type j = 0; j <= y->count; ++j)
+        set_child(y, j, child(x, mid + 1 + j));
+    }
+    size_type pos = x->position;
+    for (size_type j = p->count; j > pos; --j) {
+      relocate(&p->value(j), &p->value(j - 1));
+      set_child(p, j + 1, child(p, j));
+    }
+    relocate(&p->value(pos), &x->value(mid));
+    set_child(p, pos + 1, y);
+    ++p->count;
+    x->count = static_cast<unsigned short>(mid);
+  }
+
+  void erase_at(node *x, size_type i) {
+    data_allocator::destroy(&x->value(i));
+    if (!x->leaf) {
+      // 用前驱填上空位，转化为删除叶子节点的最后一个元素
+      node *l = child(x, i);
+      while (!l->leaf)
+        l = child(l, l->count);
+      relocate(&x->value(i), &l->value(l->count - 1));
+      x = l;
+    } else {
+      for (size_type j = i; j + 1 < x->count; ++j)
+        relocate(&x->value(j), &x->value(j + 1));
+    }
+    --x->count;
+    --num_elements();
+    rebalance(x);
+  }
+  /// x 的元素少于 min_values 时，向兄弟节点借一个，借不到就合并，合并后再检查父节点
+  void rebalance(node *x) {
+    while (true) {
+      if (x == root) {
+        if (x->count == 0) {
+          if (x->leaf) {
+            root = leftmost = nullptr;
+          } else {
+            root = child(x, 0);
+            root->parent = nullptr;
+            root->position = 0;
+          }
+          delete_node(x);
+        }
+        return;
+      }
+      if (x->count >= min_values)
+        return;
+      node *p = x->parent;
+      size_type pos = x->position;
+      if (pos > 0 && child(p, pos - 1)->count > min_values) {
+        rotate_right(child(p, pos - 1), x, p, pos - 1);
+        return;
+      }
+      if (pos < p->count && child(p, pos + 1)->count > min_values) {
+        rotate_left(x, child(p, pos + 1), p, pos);
+        return;
+      }
+      if (pos > 0)
+        merge_nodes(child(p, pos - 1), x, p, pos - 1);
+      else
+        merge_nodes(x, child(p, pos + 1), p, pos);
+      x = p;
+    }
+  }
+  /// 左兄弟的最大元素上移到父节点，父节点的分隔元素下移到 right 的最前面
+  void rotate_right(node *left, node *right, node *p, size_type sep) {
+    for (size_type j = right->count; j > 0; --j)
+      relocate(&right->value(j), &right->value(j - 1));
+    relocate(&right->value(0), &p->value(sep));
+    relocate(&p->value(sep), &left->value(left->count - 1));
+    if (!right->leaf) {
+      for (size_type j = right->count + 1; j > 0; --j)
+        set_child(right, j, child(right, j - 1));
+      set_child(right, 0, child(left, left->count));
+    }
+    --left->count;
+    ++right->count;
+  }
+  /// 右兄弟的最小元素上移到父节点，父节点的分隔元素下移到 left 的最后面
+  void rotate_left(node *left, node *right, node *p, size_type sep) {
+    relocate(&left->value(left->count), &p->value(sep));
+    relocate(&p->value(sep), &right->value(0));
+    for (size_type j = 0; j + 1 < right->count; ++j)
+      relocate(&right->value(j), &right->value(j + 1));
+    if (!left->leaf) {
+      set_child(left, left->count + 1, child(right, 0));
+      for (size_type j = 0; j < right->count; ++j)
+        set_child(right, j, child(right, j + 1));
+    }
+    ++left->count;
+    --right->count;
+  }
+  /// left、分隔元素、right 合并到 left，释放 right
+  void merge_nodes(node *left, node *right, node *p, size_type sep) {
+    size_type base = left->count;
+    relocate(&left->value(base), &p->value(sep));
+    for (size_type j = 0; j != right->count; ++j)
+      relocate(&left->value(base + 1 + j), &right->value(j));
+    if (!left->leaf) {
+      for (size_type j = 0; j <= right->count; ++j)
+        set_child(left, base + 1 + j, child(right, j));
+    }
+    left->count = static_cast<unsigned short>(base + 1 + right->count);
+    for (size_type j = sep; j + 1 < p->count; ++j) {
+      relocate(&p->value(j), &p->value(j + 1));
+      set_child(p, j + 1, child(p, j + 2));
+    }
+    --p->count;
+    delete_node(right);
+  }
+
+  void destroy_subtree(node *x) {
+    for (size_type i = 0; i != x->count; ++i)
+      data_allocator::destroy(&x->value(i));
+    if (!x->leaf) {
+      for (size_type i = 0; i <= x->count; ++i)
+        destroy_subtree(child(x, i));
+    }
+    delete_node(x);
+  }
+  node *copy_subtree(node *x, node *parent, size_type position) {
+    node *y = x->leaf ? new_leaf() : new_internal();
+    y->parent = parent;
+    y->position = static_cast<unsigned short>(position);
+    for (size_type i = 0; i != x->count; ++i) {
+      data_allocator::construct(&y->value(i), x->value(i));
+      ++y->count;
+    }
+    if (!x->leaf) {
+      for (size_type i = 0; i <= x->count; ++i)
+        set_child(y, i, copy_subtree(child(x, i), y, i));
+    }
+    return y;
+  }
+  size_type subtree_bytes(node *x) const {
+    if (x->leaf)
+      return sizeof(node);
+    size_type res = sizeof(internal_node);
+    for (size_type i = 0; i <= x->count; ++i)
+      res += subtree_bytes(child(x, i));
+    return res;
+  }
+  /// 高为 h（叶子为 0）的子树最多放多少个元素：(N + 1)^(h + 1) - 1
+  static size_type subtree_capacity(size_type h) {
+    size_type res = node_values;
+    for (size_type i = 0; i != h; ++i)
+      res = res * (node_values + 1) + node_values;
+    return res;
+  }
+  /// 从 it 依次取 n 个元素构造高为 h 的子树
+  template<typename ForwardIterator>
+  node *build_subtree(size_type h, size_type n, ForwardIterator &it) {
+    if (h == 0) {
+      node *x = new_leaf();
+      for (size_type i = 0; i != n; ++i, ++it) {
+        data_allocator::construct(&x->value(i), *it);
+        ++x->count;
+      }
+      return x;
+    }
+    node *x = new_internal();
+    // k 个孩子，k - 1 个分隔元素，剩下的元素平均分给孩子
+    size_type sub = subtree_capacity(h - 1);
+    size_type k = (n + 1 + sub) / (sub + 1);
+    size_type rest = n - (k - 1);
+    for (size_type c = 0; c != k; ++c) {
+      size_type cn = rest / k + (c < rest % k ? 1 : 0);
+      set_child(x, c, build_subtree(h - 1, cn, it));
+      if (c + 1 != k) {
+        data_allocator::construct(&x->value(c), *it);
+        ++it;
+        ++x->count;
+      }
+    }
+    return x;
+  }
+};
+
+template<typename Value, typename Key, typename ExtractKey, typename Compare, typename Alloc>
+const size_t __btree<Value, Key, ExtractKey, Compare, Alloc>::node_values;
+template<typename Value, typename Key, typename ExtractKey, typename Compare, typename Alloc>
+const size_t __btree<Value, Key, ExtractKey, Compare, Alloc>::min_values;
+
+}
+
+#endif //TINYSTL_SRC___BTREE_H_
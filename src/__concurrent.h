@@ -0,0 +1,57 @@
+#ifndef TINYSTL_SRC___CONCURRENT_H_
+#define TINYSTL_SRC___CONCURRENT_H_
+
+/**
+ * 并发容器的公共工具：缓存行大小、预取、自旋等待时的 CPU 提示和退避。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+namespace TinySTL {
+
+// 大多数 x86、ARM 处理器的缓存行大小。不同线程频繁写的变量要放在不同的缓存行上，避免伪共享
+const size_t __cache_line_size = 64;
+
+// 提示 CPU 把 addr 所在的缓存行读进来。只是提示，地址无效也不会出错
+inline void __prefetch(uintptr_t addr) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(reinterpret_cast<const void *>(addr));
+#else
+  (void) addr;
+#endif
+}
+
+// 自旋等待时调用，x86 上是 pause 指令，降低功耗并让出超线程的执行资源
+inline void __cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+// 自旋等待的退避：先自旋若干次，之后每次都让出时间片。
+// 线程数多于 CPU 核数时，一直自旋会占满对方需要的时间片
+class __backoff {
+ private:
+  static const int spin_limit = 64;
+  int count;
+
+ public:
+  __backoff() : count(0) {}
+  void pause() {
+    if (count < spin_limit) {
+      ++count;
+      __cpu_relax();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  void reset() { count = 0; }
+};
+
+}
+
+#endif //TINYSTL_SRC___CONCURRENT_H_
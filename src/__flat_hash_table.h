@@ -0,0 +1,541 @@
+#ifndef TINYSTL_SRC___FLAT_HASH_TABLE_H_
+#define TINYSTL_SRC___FLAT_HASH_TABLE_H_
+
+/**
+ * 开放寻址哈希表（Swiss table），unordered_flat_map、unordered_flat_set 的底层实现。
+ *
+ * 布局：元素直接存放在槽位数组中，另有一个控制字节数组，每个槽位对应一个控制字节：
+ *  - __empty（0x80）：空槽位；
+ *  - __deleted（0xFE）：墓碑，删除后留下，查找时不能在此停下；
+ *  - __sentinel（0xFF）：位于 ctrl[cap]，迭代到这里结束；
+ *  - 0 ~ 127：已占用，值为哈希值的低 7 位（H2）。
+ * 槽位数 cap 形如 2^k - 1，加上哨兵正好是 2^k 个控制字节组成的环；末尾再复制一份前 15 个控制字节，
+ * 这样从任意位置开始都能一次读出连续的 16 个控制字节（一组）。
+ *
+ * 查找：用哈希值的高位（H1）定位起始组，SSE2 一条比较指令找出组内 H2 相同的槽位，逐个比较 key；
+ * 组内有空槽位则说明 key 不存在，否则按二次探测跳到下一组。
+ *
+ * 删除：如果该槽位前后的空槽位说明从来没有探测序列越过它，直接置为空，否则留下墓碑。
+ * 墓碑在扩容或原地重建时清除。
+ *
+ * 注意：
+ *  1. 最大负载因子固定为 7/8。
+ *  2. 插入可能触发扩容，扩容后所有迭代器、指针、引用都会失效。
+ *  3. 哈希函数和 key 比较函数都带 is_transparent 时，find、count、contains、erase 支持异构查找。
+ *  4. 定义 TINYSTL_NO_SIMD 可以关闭 SSE2，改用逐字节比较。
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+
+#if defined(__SSE2__) && !defined(TINYSTL_NO_SIMD)
+#include <emmintrin.h>
+#define TINYSTL_FLAT_HASH_SSE2 1
+#endif
+
+#include "__concurrent.h"
+#include "algorithm.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace FlatHashAux {
+typedef signed char ctrl_t;
+const ctrl_t __empty = -128;
+const ctrl_t __deleted = -2;
+const ctrl_t __sentinel = -1;
+// 每组的控制字节数
+const size_t __group_width = 16;
+// 最小的槽位数，保证一组不会绕环超过一圈
+const size_t __min_capacity = __group_width - 1;
+// 批量插入时一批的元素个数：先算出整批的哈希值并预取各自的起始组，再逐个插入
+const size_t __insert_batch = 16;
+
+inline bool __is_full(ctrl_t c) { return c >= 0; }
+inline bool __is_empty_or_deleted(ctrl_t c) { return c < __sentinel; }
+
+inline size_t __h1(size_t hash) { return hash >> 7; }
+inline ctrl_t __h2(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+
+/// 不小于 n 的、形如 2^k - 1 的槽位数
+inline size_t __normalize_capacity(size_t n) {
+  size_t cap = __min_capacity;
+  while (cap < n)
+    cap = cap * 2 + 1;
+  return cap;
+}
+/// 负载因子 7/8 时最多能放多少个元素
+inline size_t __capacity_to_growth(size_t cap) { return cap - cap / 8; }
+/// 放下 growth 个元素至少需要多少槽位
+inline size_t __growth_to_capacity(size_t growth) {
+  return __normalize_capacity(growth + (growth == 0 ? 0 : (growth - 1) / 7));
+}
+
+inline unsigned __trailing_zeros(uint32_t mask) { return __builtin_ctz(mask); }
+// 16 位掩码的前导零个数
+inline unsigned __leading_zeros16(uint32_t mask) { return __builtin_clz(mask) - 16; }
+}
+
+/// 一组 16 个控制字节，match 系列函数返回位掩码：第 i 位为 1 表示组内第 i 个控制字节满足条件
+class __flat_hash_group {
+ private:
+  typedef FlatHashAux::ctrl_t ctrl_t;
+#ifdef TINYSTL_FLAT_HASH_SSE2
+  __m128i ctrl;
+
+ public:
+  explicit __flat_hash_group(const ctrl_t *pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+  uint32_t match(ctrl_t h2) const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+  }
+  uint32_t match_empty() const { return match(FlatHashAux::__empty); }
+  uint32_t match_empty_or_deleted() const {
+    // 空槽位和墓碑都小于哨兵
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(FlatHashAux::__sentinel), ctrl)));
+  }
+#else
+  ctrl_t ctrl[FlatHashAux::__group_width];
+
+ public:
+  explicit __flat_hash_group(const ctrl_t *pos) { memcpy(ctrl, pos, sizeof(ctrl)); }
+  uint32_t match(ctrl_t h2) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i != FlatHashAux::__group_width; ++i)
+      mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+    return mask;
+  }
+  uint32_t match_empty() const { return match(FlatHashAux::__empty); }
+  uint32_t match_empty_or_deleted() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i != FlatHashAux::__group_width; ++i)
+      mask |= static_cast<uint32_t>(FlatHashAux::__is_empty_or_deleted(ctrl[i])) << i;
+    return mask;
+  }
+#endif
+};
+
+template<typename Value, typename Ref, typename Ptr>
+struct __flat_hash_iterator {
+  typedef forward_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+  typedef __flat_hash_iterator<Value, Value &, Value *> iterator;
+
+  const FlatHashAux::ctrl_t *ctrl;
+  Value *slot;
+
+  __flat_hash_iterator() : ctrl(nullptr), slot(nullptr) {}
+  __flat_hash_iterator(const FlatHashAux::ctrl_t *c, Value *s) : ctrl(c), slot(s) {}
+  // iterator 可以转换为 const_iterator，反过来则被排除。写成模板，iterator 自己仍使用隐式的拷贝构造、拷贝赋值
+  template<typename R, typename P, typename = typename __enable_if<__is_same_type<R, Value &>::value>::type>
+  __flat_hash_iterator(const __flat_hash_iterator<Value, R, P> &it) : ctrl(it.ctrl), slot(it.slot) {}
+
+  reference operator*() const { return *slot; }
+  pointer operator->() const { return slot; }
+  __flat_hash_iterator &operator++() {
+    ++ctrl;
+    ++slot;
+    skip_empty_or_deleted();
+    return *this;
+  }
+  __flat_hash_iterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  // 跳过空槽位和墓碑，停在下一个元素或者末尾的哨兵上
+  void skip_empty_or_deleted() {
+    while (FlatHashAux::__is_empty_or_deleted(*ctrl)) {
+      ++ctrl;
+      ++slot;
+    }
+  }
+  friend bool operator==(const __flat_hash_iterator &x, const __flat_hash_iterator &y) { return x.ctrl == y.ctrl; }
+  friend bool operator!=(const __flat_hash_iterator &x, const __flat_hash_iterator &y) { return x.ctrl != y.ctrl; }
+};
+
+template<typename Value, typename Key, typename ExtractKey, typename Hash, typename KeyEqual, typename Alloc>
+class __flat_hash_table {
+ public:
+  using value_type = Value;
+  using key_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using pointer = Value *;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = __flat_hash_iterator<Value, Value &, Value *>;
+  using const_iterator = __flat_hash_iterator<Value, const Value &, const Value *>;
+
+ protected:
+  using ctrl_t = FlatHashAux::ctrl_t;
+  using ctrl_allocator = allocator<ctrl_t>;
+  using data_allocator = Alloc;
+
+  ctrl_t *ctrl;           // cap + __group_width 个控制字节
+  pointer slots;          // cap 个槽位
+  size_type cap;          // 0 或者 2^k - 1
+  size_type num_elements;
+  // 还能放进多少个元素（墓碑也算占用）。哈希函数、比较函数通常是空类，和它放在一起，由 EBO 省掉它们的空间
+  __compressed_pair<size_type, __compressed_pair<hasher, key_equal>> growth_fns;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  explicit __flat_hash_table(size_type bucket_count = 0, const hasher &hf = hasher(),
+                             const key_equal &eq = key_equal()) :
+      ctrl(nullptr), slots(nullptr), cap(0), num_elements(0),
+      growth_fns(0, __compressed_pair<hasher, key_equal>(hf, eq)) {
+    if (bucket_count != 0)
+      initialize(FlatHashAux::__normalize_capacity(bucket_count));
+  }
+  __flat_hash_table(const __flat_hash_table &x) : __flat_hash_table(0, x.hash_fn(), x.key_eq()) {
+    reserve(x.size());
+    // 元素互不相同，不必再查找
+    for (auto it = x.begin(); it != x.end(); ++it) {
+      size_type h = hash_of(get_key(*it));
+      size_type i = prepare_insert(h);
+      construct_at(i, *it);
+    }
+  }
+  __flat_hash_table(__flat_hash_table &&x) : __flat_hash_table(0, x.hash_fn(), x.key_eq()) { swap(*this, x); }
+  __flat_hash_table &operator=(__flat_hash_table x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~__flat_hash_table() {
+    destroy_elements();
+    deallocate();
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return num_elements; }
+  bool empty() const { return num_elements == 0; }
+  size_type bucket_count() const { return cap; }
+  float load_factor() const { return cap == 0 ? 0.0f : static_cast<float>(num_elements) / cap; }
+  float max_load_factor() const { return 0.875f; }
+  hasher hash_function() const { return hash_fn(); }
+  key_equal key_eq_function() const { return key_eq(); }
+
+  const_iterator begin() const { return const_cast<__flat_hash_table *>(this)->begin(); }
+  const_iterator end() const { return const_cast<__flat_hash_table *>(this)->end(); }
+  template<typename K>
+  const_iterator find(const K &key) const { return const_cast<__flat_hash_table *>(this)->find(key); }
+  template<typename K>
+  size_type count(const K &key) const { return find_index(key, hash_of(key)) == cap ? 0 : 1; }
+
+  /*************** 迭代器 ************/
+  iterator begin() {
+    if (cap == 0)
+      return end();
+    iterator it(ctrl, slots);
+    it.skip_empty_or_deleted();
+    return it;
+  }
+  iterator end() { return cap == 0 ? iterator() : iterator(ctrl + cap, slots + cap); }
+
+  /*************** 查找 ************/
+  template<typename K>
+  iterator find(const K &key) {
+    size_type i = find_index(key, hash_of(key));
+    return i == cap ? end() : iterator_at(i);
+  }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) { return insert_hashed(val, hash_of(get_key(val))); }
+  /// forward 迭代器先按区间长度 reserve，再分批插入，每批先算哈希值、预取起始组，让访存互相重叠
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    insert_range(first, last, iterator_category(first));
+  }
+  /// key 不存在时用 key 和 mapped_type(args...) 分别构造新元素的两个成员，存在时什么也不做
+  template<typename... Args>
+  pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+    size_type h = hash_of(key);
+    size_type i = find_index(key, h);
+    if (i != cap)
+      return pair<iterator, bool>(iterator_at(i), false);
+    i = prepare_insert(h);
+    try {
+      new(slots + i) value_type(__piecewise_construct, key, TinySTL::forward<Args>(args)...);
+    } catch (...) {
+      erase_meta(i);
+      throw;
+    }
+    return pair<iterator, bool>(iterator_at(i), true);
+  }
+  iterator erase(const_iterator pos) {
+    size_type i = pos.ctrl - ctrl;
+    data_allocator::destroy(slots + i);
+    erase_meta(i);
+    iterator next = iterator_at(i);
+    next.skip_empty_or_deleted();
+    return next;
+  }
+  template<typename K>
+  size_type erase_key(const K &key) {
+    size_type i = find_index(key, hash_of(key));
+    if (i == cap)
+      return 0;
+    data_allocator::destroy(slots + i);
+    erase_meta(i);
+    return 1;
+  }
+  // 析构所有元素，保留槽位
+  void clear() {
+    if (cap == 0)
+      return;
+    destroy_elements();
+    reset_ctrl();
+  }
+
+  /*************** 容量 ************/
+  /// 保证再插入 n - size() 个元素都不会扩容
+  void reserve(size_type n) {
+    if (n > num_elements + growth_left())
+      resize(FlatHashAux::__growth_to_capacity(n));
+  }
+  /// 槽位数调整为不小于 n，且能放下现有元素。会顺带清除墓碑
+  void rehash(size_type n) {
+    if (n == 0 && num_elements == 0) {
+      destroy_elements();
+      deallocate();
+      return;
+    }
+    size_type need = FlatHashAux::__growth_to_capacity(num_elements);
+    resize(FlatHashAux::__normalize_capacity(n > need ? n : need));
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(__flat_hash_table &x, __flat_hash_table &y) {
+    TinySTL::swap(x.ctrl, y.ctrl);
+    TinySTL::swap(x.slots, y.slots);
+    TinySTL::swap(x.cap, y.cap);
+    TinySTL::swap(x.num_elements, y.num_elements);
+    TinySTL::swap(x.growth_left(), y.growth_left());
+    TinySTL::swap(x.hash_fn(), y.hash_fn());
+    TinySTL::swap(x.key_eq(), y.key_eq());
+  }
+  // 元素个数相同，且 x 的每个元素都能在 y 中找到相等的元素
+  friend bool operator==(const __flat_hash_table &x, const __flat_hash_table &y) {
+    if (x.size() != y.size())
+      return false;
+    for (auto it = x.begin(); it != x.end(); ++it) {
+      auto other = y.find(x.get_key(*it));
+      if (other == y.end() || !(*other == *it))
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const __flat_hash_table &x, const __flat_hash_table &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  size_type &growth_left() { return growth_fns.first(); }
+  const size_type &growth_left() const { return growth_fns.first(); }
+  hasher &hash_fn() { return growth_fns.second().first(); }
+  const hasher &hash_fn() const { return growth_fns.second().first(); }
+  key_equal &key_eq() { return growth_fns.second().second(); }
+  const key_equal &key_eq() const { return growth_fns.second().second(); }
+  // 取 key 的函数对象都是无状态的，不必存成员
+  static const key_type &get_key(const value_type &val) { return ExtractKey()(val); }
+  template<typename K>
+  size_type hash_of(const K &key) const {
+    return __hash_finish(hash_fn()(key), typename __hash_is_avalanching<hasher>::type());
+  }
+  iterator iterator_at(size_type i) { return iterator(ctrl + i, slots + i); }
+  pair<iterator, bool> insert_hashed(const value_type &val, size_type h) {
+    size_type i = find_index(get_key(val), h);
+    if (i != cap)
+      return pair<iterator, bool>(iterator_at(i), false);
+    i = prepare_insert(h);
+    construct_at(i, val);
+    return pair<iterator, bool>(iterator_at(i), true);
+  }
+
+  template<typename InputIterator>
+  void insert_range(InputIterator first, InputIterator last, input_iterator_tag) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+  template<typename InputIterator>
+  void insert_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+    insert_range(first, last, input_iterator_tag());
+  }
+  template<typename ForwardIterator>
+  void insert_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    reserve(num_elements + static_cast<size_type>(TinySTL::distance(first, last)));
+    insert_batched(first, last);
+  }
+  // 兼容 std 容器的迭代器
+  template<typename ForwardIterator>
+  void insert_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+    reserve(num_elements + static_cast<size_type>(std::distance(first, last)));
+    insert_batched(first, last);
+  }
+  /// 已经 reserve 过，区间非空时 cap != 0
+  template<typename ForwardIterator>
+  void insert_batched(ForwardIterator first, ForwardIterator last) {
+    size_type hashes[FlatHashAux::__insert_batch];
+    while (first != last) {
+      ForwardIterator batch = first;
+      size_type n = 0;
+      for (; n != FlatHashAux::__insert_batch && first != last; ++first, ++n) {
+        hashes[n] = hash_of(get_key(*first));
+        size_type pos = FlatHashAux::__h1(hashes[n]) & cap;
+        __prefetch(reinterpret_cast<uintptr_t>(ctrl + pos));
+        __prefetch(reinterpret_cast<uintptr_t>(slots + pos));
+      }
+      for (size_type k = 0; k != n; ++k, ++batch)
+        insert_hashed(*batch, hashes[k]);
+    }
+  }
+
+  /// 查找 key，返回槽位下标，不存在时返回 cap
+  template<typename K>
+  size_type find_index(const K &key, size_type h) const {
+    if (cap == 0)
+      return cap;
+    ctrl_t h2 = FlatHashAux::__h2(h);
+    size_type pos = FlatHashAux::__h1(h) & cap;
+    size_type step = 0;
+    while (true) {
+      __flat_hash_group group(ctrl + pos);
+      for (uint32_t mask = group.match(h2); mask != 0; mask &= mask - 1) {
+        size_type i = (pos + FlatHashAux::__trailing_zeros(mask)) & cap;
+        if (key_eq()(get_key(slots[i]), key))
+          return i;
+      }
+      if (group.match_empty() != 0)
+        return cap;
+      // 二次探测：每次多跳一组，环长为 2 的幂，保证能访问到每一组
+      step += FlatHashAux::__group_width;
+      pos = (pos + step) & cap;
+    }
+  }
+  /// 探测序列上第一个空槽位或墓碑
+  size_type find_first_non_full(size_type h) const {
+    size_type pos = FlatHashAux::__h1(h) & cap;
+    size_type step = 0;
+    while (true) {
+      uint32_t mask = __flat_hash_group(ctrl + pos).match_empty_or_deleted();
+      if (mask != 0)
+        return (pos + FlatHashAux::__trailing_zeros(mask)) & cap;
+      step += FlatHashAux::__group_width;
+      pos = (pos + step) & cap;
+    }
+  }
+  /// 为哈希值为 h 的新元素找一个槽位并写好控制字节，返回槽位下标，元素由调用者构造
+  size_type prepare_insert(size_type h) {
+    size_type i = cap == 0 ? 0 : find_first_non_full(h);
+    if (growth_left() == 0 && (cap == 0 || ctrl[i] != FlatHashAux::__deleted)) {
+      grow_or_rehash_in_place();
+      i = find_first_non_full(h);
+    }
+    ++num_elements;
+    growth_left() -= ctrl[i] == FlatHashAux::__empty;
+    set_ctrl(i, FlatHashAux::__h2(h));
+    return i;
+  }
+  void construct_at(size_type i, const value_type &val) {
+    try {
+      data_allocator::construct(slots + i, val);
+    } catch (...) {
+      erase_meta(i);
+      throw;
+    }
+  }
+  // 墓碑占了一半以上的额度时原地重建，否则扩容一倍
+  void grow_or_rehash_in_place() {
+    if (cap == 0)
+      resize(FlatHashAux::__min_capacity);
+    else if (num_elements <= FlatHashAux::__capacity_to_growth(cap) / 2)
+      resize(cap);
+    else
+      resize(cap * 2 + 1);
+  }
+  /// 同时写槽位本身的控制字节和末尾的副本
+  void set_ctrl(size_type i, ctrl_t c) {
+    const size_type cloned = FlatHashAux::__group_width - 1;
+    ctrl[i] = c;
+    ctrl[((i - cloned) & cap) + cloned] = c;
+  }
+  /// 元素已析构，更新控制字节：从未有探测序列越过 i 时直接置空，否则留下墓碑
+  void erase_meta(size_type i) {
+    --num_elements;
+    size_type before = (i - FlatHashAux::__group_width) & cap;
+    uint32_t empty_after = __flat_hash_group(ctrl + i).match_empty();
+    uint32_t empty_before = __flat_hash_group(ctrl + before).match_empty();
+    // i 前后连续的非空槽位不足一组，任何探测都会在越过 i 之前遇到空槽位
+    bool was_never_full = empty_before != 0 && empty_after != 0 &&
+        FlatHashAux::__trailing_zeros(empty_after) + FlatHashAux::__leading_zeros16(empty_before)
+            < FlatHashAux::__group_width;
+    set_ctrl(i, was_never_full ? FlatHashAux::__empty : FlatHashAux::__deleted);
+    growth_left() += was_never_full;
+  }
+  void initialize(size_type new_cap) {
+    cap = new_cap;
+    ctrl = ctrl_allocator::allocate(cap + FlatHashAux::__group_width);
+    slots = data_allocator::allocate(cap);
+    reset_ctrl();
+  }
+  void reset_ctrl() {
+    memset(ctrl, static_cast<unsigned char>(FlatHashAux::__empty), cap + FlatHashAux::__group_width);
+    ctrl[cap] = FlatHashAux::__sentinel;
+    num_elements = 0;
+    growth_left() = FlatHashAux::__capacity_to_growth(cap);
+  }
+  /// 换成 new_cap 个槽位，元素移动过去
+  void resize(size_type new_cap) {
+    ctrl_t *old_ctrl = ctrl;
+    pointer old_slots = slots;
+    size_type old_cap = cap;
+    size_type old_size = num_elements;
+    initialize(new_cap);
+    for (size_type i = 0; i != old_cap; ++i) {
+      if (!FlatHashAux::__is_full(old_ctrl[i]))
+        continue;
+      size_type h = hash_of(get_key(old_slots[i]));
+      size_type j = find_first_non_full(h);
+      set_ctrl(j, FlatHashAux::__h2(h));
+      new(slots + j) value_type(TinySTL::move(old_slots[i]));
+      data_allocator::destroy(old_slots + i);
+    }
+    num_elements = old_size;
+    growth_left() -= old_size;
+    if (old_cap != 0) {
+      ctrl_allocator::deallocate(old_ctrl, old_cap + FlatHashAux::__group_width);
+      data_allocator::deallocate(old_slots, old_cap);
+    }
+  }
+  void destroy_elements() {
+    for (size_type i = 0; i != cap; ++i) {
+      if (FlatHashAux::__is_full(ctrl[i]))
+        data_allocator::destroy(slots + i);
+    }
+  }
+  void deallocate() {
+    if (cap == 0)
+      return;
+    ctrl_allocator::deallocate(ctrl, cap + FlatHashAux::__group_width);
+    data_allocator::deallocate(slots, cap);
+    ctrl = nullptr;
+    slots = nullptr;
+    cap = 0;
+    num_elements = 0;
+    growth_left() = 0;
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC___FLAT_HASH_TABLE_H_
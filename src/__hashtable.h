@@ -0,0 +1,389 @@
+#ifndef TINYSTL_SRC___HASHTABLE_H_
+#define TINYSTL_SRC___HASHTABLE_H_
+
+/**
+ * 拉链法哈希表，unordered_map 的底层实现。
+ *
+ * 布局：桶数组是 vector<node *>，大小为 2 的幂，用 hash & (桶数 - 1) 定位桶；每个桶是一条单链表。
+ * 节点里缓存了哈希值：
+ *  1. 查找时先比较哈希值，相同才比较 key，链表上的大部分节点不用调用 key 比较函数；
+ *  2. rehash 时直接用缓存的哈希值重新挂链，不用再算哈希，也不用移动元素。
+ * 节点通过 allocator 申请，小于 128 字节的节点走 __alloc 的内存池，不会每个节点一次 malloc。
+ *
+ * 注意：
+ *  1. 元素存放在节点里，rehash 之后指针、引用仍然有效（迭代器失效）。
+ *  2. 元素个数超过 桶数 * max_load_factor() 时桶数翻倍。
+ */
+
+#include <cstddef>
+#include <iterator>
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+namespace HashtableAux {
+// 第一次插入时的桶数，必须是 2 的幂
+const size_t __initial_bucket_count = 8;
+}
+
+template<typename Value>
+struct __hashtable_node {
+  __hashtable_node *next;
+  size_t hash;
+  Value val;
+};
+
+template<typename Value, typename Key, typename ExtractKey, typename Hash, typename KeyEqual, typename Alloc>
+class __hashtable;
+
+template<typename Value, typename Ref, typename Ptr, typename Table>
+struct __hashtable_iterator {
+  typedef forward_iterator_tag iterator_category;
+  typedef Value value_type;
+  typedef ptrdiff_t difference_type;
+  typedef Ptr pointer;
+  typedef Ref reference;
+  typedef __hashtable_node<Value> node;
+  typedef __hashtable_iterator<Value, Value &, Value *, Table> iterator;
+
+  node *cur;
+  const Table *table;
+
+  __hashtable_iterator() : cur(nullptr), table(nullptr) {}
+  __hashtable_iterator(node *n, const Table *t) : cur(n), table(t) {}
+  // iterator 可以转换为 const_iterator，反过来则被排除。写成模板，iterator 自己仍使用隐式的拷贝构造、拷贝赋值
+  template<typename R, typename P, typename = typename __enable_if<__is_same_type<R, Value &>::value>::type>
+  __hashtable_iterator(const __hashtable_iterator<Value, R, P, Table> &it) : cur(it.cur), table(it.table) {}
+
+  reference operator*() const { return cur->val; }
+  pointer operator->() const { return &cur->val; }
+  // 链表走完了就找下一个非空的桶
+  __hashtable_iterator &operator++() {
+    node *old = cur;
+    cur = cur->next;
+    if (cur == nullptr)
+      cur = table->first_node_from((old->hash & table->bucket_mask()) + 1);
+    return *this;
+  }
+  __hashtable_iterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  friend bool operator==(const __hashtable_iterator &x, const __hashtable_iterator &y) { return x.cur == y.cur; }
+  friend bool operator!=(const __hashtable_iterator &x, const __hashtable_iterator &y) { return x.cur != y.cur; }
+};
+
+template<typename Value, typename Key, typename ExtractKey, typename Hash, typename KeyEqual, typename Alloc>
+class __hashtable {
+ public:
+  using value_type = Value;
+  using key_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using pointer = Value *;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = __hashtable_iterator<Value, Value &, Value *, __hashtable>;
+  using const_iterator = __hashtable_iterator<Value, const Value &, const Value *, __hashtable>;
+
+  template<typename, typename, typename, typename> friend struct __hashtable_iterator;
+
+ protected:
+  using node = __hashtable_node<Value>;
+  using node_allocator = allocator<node>;
+  using data_allocator = Alloc;
+
+  vector<node *> buckets;
+  size_type num_elements;
+  float max_load;
+  hasher hash_fn;
+  key_equal key_eq;
+  ExtractKey get_key;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  explicit __hashtable(size_type bucket_count = 0, const hasher &hf = hasher(), const key_equal &eq = key_equal()) :
+      num_elements(0), max_load(1.0f), hash_fn(hf), key_eq(eq) {
+    if (bucket_count != 0)
+      rehash(bucket_count);
+  }
+  // 逐个桶复制，保持桶内顺序
+  __hashtable(const __hashtable &x) :
+      buckets(x.buckets.size(), static_cast<node *>(nullptr)), num_elements(0), max_load(x.max_load),
+      hash_fn(x.hash_fn), key_eq(x.key_eq) {
+    try {
+      for (size_type i = 0; i != x.buckets.size(); ++i) {
+        node **tail = &buckets[i];
+        for (node *cur = x.buckets[i]; cur != nullptr; cur = cur->next) {
+          *tail = create_node(cur->val, cur->hash);
+          tail = &(*tail)->next;
+          ++num_elements;
+        }
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+  __hashtable(__hashtable &&x) : num_elements(0), max_load(x.max_load), hash_fn(x.hash_fn), key_eq(x.key_eq) {
+    swap(*this, x);
+  }
+  __hashtable &operator=(__hashtable x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~__hashtable() { clear(); }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return num_elements; }
+  bool empty() const { return num_elements == 0; }
+  size_type bucket_count() const { return buckets.size(); }
+  size_type bucket_size(size_type n) const {
+    size_type res = 0;
+    for (node *cur = buckets[n]; cur != nullptr; cur = cur->next)
+      ++res;
+    return res;
+  }
+  float load_factor() const { return buckets.empty() ? 0.0f : static_cast<float>(num_elements) / buckets.size(); }
+  float max_load_factor() const { return max_load; }
+  hasher hash_function() const { return hash_fn; }
+  key_equal key_eq_function() const { return key_eq; }
+
+  const_iterator begin() const { return const_iterator(first_node_from(0), this); }
+  const_iterator end() const { return const_iterator(nullptr, this); }
+  template<typename K>
+  const_iterator find(const K &key) const { return const_iterator(find_node(key, hash_of(key)), this); }
+  template<typename K>
+  size_type count(const K &key) const { return find_node(key, hash_of(key)) == nullptr ? 0 : 1; }
+
+  /*************** 迭代器 ************/
+  iterator begin() { return iterator(first_node_from(0), this); }
+  iterator end() { return iterator(nullptr, this); }
+
+  /*************** 查找 ************/
+  template<typename K>
+  iterator find(const K &key) { return iterator(find_node(key, hash_of(key)), this); }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) {
+    const auto &key = get_key(val);
+    size_type h = hash_of(key);
+    node *n = find_node(key, h);
+    if (n != nullptr)
+      return pair<iterator, bool>(iterator(n, this), false);
+    return pair<iterator, bool>(iterator(link_node(create_node(val, h)), this), true);
+  }
+  /// 先按区间长度 reserve，整个区间最多 rehash 一次
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    insert_range(first, last, iterator_category(first));
+  }
+  /// key 不存在时用 key 和 mapped_type(args...) 分别构造新元素的两个成员，存在时什么也不做
+  template<typename... Args>
+  pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+    size_type h = hash_of(key);
+    node *n = find_node(key, h);
+    if (n != nullptr)
+      return pair<iterator, bool>(iterator(n, this), false);
+    n = node_allocator::allocate();
+    try {
+      new(&n->val) value_type(__piecewise_construct, key, TinySTL::forward<Args>(args)...);
+    } catch (...) {
+      node_allocator::deallocate(n);
+      throw;
+    }
+    n->hash = h;
+    return pair<iterator, bool>(iterator(link_node(n), this), true);
+  }
+  iterator erase(const_iterator pos) {
+    node *target = pos.cur;
+    iterator next(target, this);
+    ++next;
+    node **link = &buckets[target->hash & bucket_mask()];
+    while (*link != target)
+      link = &(*link)->next;
+    *link = target->next;
+    destroy_node(target);
+    --num_elements;
+    return next;
+  }
+  template<typename K>
+  size_type erase_key(const K &key) {
+    if (num_elements == 0)
+      return 0;
+    size_type h = hash_of(key);
+    for (node **link = &buckets[h & bucket_mask()]; *link != nullptr; link = &(*link)->next) {
+      node *cur = *link;
+      if (cur->hash == h && key_eq(get_key(cur->val), key)) {
+        *link = cur->next;
+        destroy_node(cur);
+        --num_elements;
+        return 1;
+      }
+    }
+    return 0;
+  }
+  // 释放所有节点，保留桶数组
+  void clear() {
+    for (size_type i = 0; i != buckets.size(); ++i) {
+      node *cur = buckets[i];
+      while (cur != nullptr) {
+        node *next = cur->next;
+        destroy_node(cur);
+        cur = next;
+      }
+      buckets[i] = nullptr;
+    }
+    num_elements = 0;
+  }
+
+  /*************** 容量 ************/
+  void max_load_factor(float ml) {
+    max_load = ml;
+    reserve(num_elements);
+  }
+  /// 保证再插入 n - size() 个元素都不会 rehash
+  void reserve(size_type n) {
+    if (n > static_cast<size_type>(buckets.size() * max_load))
+      rehash(static_cast<size_type>(n / max_load) + 1);
+  }
+  /// 桶数调整为不小于 n 的 2 的幂，且不违反 max_load_factor()。节点不动，只重新挂链
+  void rehash(size_type n) {
+    size_type need = static_cast<size_type>(num_elements / max_load) + 1;
+    if (n < need)
+      n = need;
+    size_type new_count = HashtableAux::__initial_bucket_count;
+    while (new_count < n)
+      new_count <<= 1;
+    if (new_count == buckets.size())
+      return;
+    vector<node *> new_buckets(new_count, static_cast<node *>(nullptr));
+    size_type mask = new_count - 1;
+    for (size_type i = 0; i != buckets.size(); ++i) {
+      node *cur = buckets[i];
+      while (cur != nullptr) {
+        node *next = cur->next;
+        node *&head = new_buckets[cur->hash & mask];
+        cur->next = head;
+        head = cur;
+        cur = next;
+      }
+    }
+    swap(buckets, new_buckets);
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(__hashtable &x, __hashtable &y) {
+    swap(x.buckets, y.buckets);
+    TinySTL::swap(x.num_elements, y.num_elements);
+    TinySTL::swap(x.max_load, y.max_load);
+    TinySTL::swap(x.hash_fn, y.hash_fn);
+    TinySTL::swap(x.key_eq, y.key_eq);
+  }
+  // 元素个数相同，且 x 的每个元素都能在 y 中找到相等的元素
+  friend bool operator==(const __hashtable &x, const __hashtable &y) {
+    if (x.size() != y.size())
+      return false;
+    for (auto it = x.begin(); it != x.end(); ++it) {
+      auto other = y.find(x.get_key(*it));
+      if (other == y.end() || !(*other == *it))
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const __hashtable &x, const __hashtable &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  template<typename K>
+  size_type hash_of(const K &key) const {
+    return __hash_finish(hash_fn(key), typename __hash_is_avalanching<hasher>::type());
+  }
+  size_type bucket_mask() const { return buckets.size() - 1; }
+  // 从第 n 个桶开始的第一个节点，没有则返回 nullptr
+  node *first_node_from(size_type n) const {
+    for (; n < buckets.size(); ++n) {
+      if (buckets[n] != nullptr)
+        return buckets[n];
+    }
+    return nullptr;
+  }
+  template<typename K>
+  node *find_node(const K &key, size_type h) const {
+    if (num_elements == 0)
+      return nullptr;
+    // 先比较缓存的哈希值，再比较 key
+    for (node *cur = buckets[h & bucket_mask()]; cur != nullptr; cur = cur->next) {
+      if (cur->hash == h && key_eq(get_key(cur->val), key))
+        return cur;
+    }
+    return nullptr;
+  }
+  node *create_node(const value_type &val, size_type h) {
+    node *n = node_allocator::allocate();
+    try {
+      data_allocator::construct(&n->val, val);
+    } catch (...) {
+      node_allocator::deallocate(n);
+      throw;
+    }
+    n->next = nullptr;
+    n->hash = h;
+    return n;
+  }
+  void destroy_node(node *n) {
+    data_allocator::destroy(&n->val);
+    node_allocator::deallocate(n);
+  }
+  /// 把新节点挂到桶的链表头上，必要时先扩容
+  node *link_node(node *n) {
+    if (num_elements + 1 > static_cast<size_type>(buckets.size() * max_load)) {
+      try {
+        rehash(buckets.empty() ? HashtableAux::__initial_bucket_count : buckets.size() * 2);
+      } catch (...) {
+        destroy_node(n);
+        throw;
+      }
+    }
+    node *&head = buckets[n->hash & bucket_mask()];
+    n->next = head;
+    head = n;
+    ++num_elements;
+    return n;
+  }
+  // 单趟迭代器不能先求长度，逐个插入
+  template<typename InputIterator>
+  void insert_range(InputIterator first, InputIterator last, input_iterator_tag) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+  template<typename InputIterator>
+  void insert_range(InputIterator first, InputIterator last, std::input_iterator_tag) {
+    insert_range(first, last, input_iterator_tag());
+  }
+  template<typename ForwardIterator>
+  void insert_range(ForwardIterator first, ForwardIterator last, forward_iterator_tag) {
+    reserve(num_elements + static_cast<size_type>(TinySTL::distance(first, last)));
+    insert_range(first, last, input_iterator_tag());
+  }
+  // 兼容 std 容器的迭代器
+  template<typename ForwardIterator>
+  void insert_range(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+    reserve(num_elements + static_cast<size_type>(std::distance(first, last)));
+    insert_range(first, last, input_iterator_tag());
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC___HASHTABLE_H_
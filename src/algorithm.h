@@ -1 +1 @@
-#ifndef TINYSTL_SRC_ALGORITHM_H_#define TINYSTL_SRC_ALGORITHM_H_#include "functional.h"#include "iterator.h"#include "type_traits.h"namespace TinySTL {/***************** [swap] T(n) = O(1) *********************/// TODO：一次拷贝构造，两次 assignment operator，一次析构，可以说很低效template<typename T>inline voidswap(T &a, T &b) {  T tmp = a;  a = b;  b = tmp;}/***************** [push_heap] T(n) = O(lgn) *********************//// 将 last - 1 元素按 heap 的规则放在适合的位置。/// 说明：如果当前节点大于父节点，交换之。template<typename RandomAccessIterator, typename Compare>inline void// 移动次数为 n，则 ctor: n, assignment operator: 2n, dtor: npush_heap_less_eff(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto cur = last - 1;  auto parent = first + (cur - first + 1) / 2;  while (cur != first && cmp(*parent, *cur)) {    TinySTL::swap(*parent, *cur);    cur = parent;    parent = first + (cur - first + 1) / 2;  }}//template<typename RandomAccessIterator, typename Compare>void// 移动次数为 n，则 ctor: 1, assignment operator: n, dtor: 1. 比上面优化很多// 注意 iterator + offset 和 offset + iterator 写法的区别push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto value = *(last - 1);  auto cur_index = last - first - 1;  auto parent_index = (cur_index - 1) / 2;  while (cur_index > 0 && cmp(*(first + parent_index), value)) {    *(first + cur_index) = *(first + parent_index);    cur_index = parent_index;    parent_index = (cur_index - 1) / 2;  }  *(first + cur_index) = value;}template<typename RandomAccessIterator>voidpush_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::push_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [pop_heap] T(n) = O(lgn) *********************/template<typename RandomAccessIterator, typename Compare>void/// 将 first 与 last - 1交换，并调整 heap。/// 说明： 1.交换 first 和 last - 1，2. 找到新的first元素的适合位置。pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto value = *(last - 1);  *(last - 1) = *first;  // 减一是因为 last - 1已经不是 heap 的元素了  auto len = last - first - 1;  auto cur_index = 0;  auto right_child_index = 2 * cur_index + 2;  auto max_child_index = right_child_index;  while (right_child_index < len) {    max_child_index = cmp(*(first + right_child_index), *(first + (right_child_index - 1))) ?                      right_child_index - 1 :                      right_child_index;    if (*(first + max_child_index) <= value)      break;    *(first + cur_index) = *(first + max_child_index);    cur_index = max_child_index;    right_child_index = 2 * cur_index + 2;  }  // 处理特殊情况，没有右节点，只有左节点  if (right_child_index == len && cmp(value, *(first + right_child_index - 1))) {    max_child_index = right_child_index - 1;    *(first + cur_index) = *(first + max_child_index);    cur_index = max_child_index;  }  *(first + cur_index) = value;}template<typename RandomAccessIterator>voidpop_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::pop_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [make_heap] T(n) = O(n) *********************/template<typename RandomAccessIterator, typename Compare>voidmake_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto len = last - first;  for (auto last_index = len - len + 1; last_index <= len; ++last_index)    TinySTL::push_heap(first, first + last_index, cmp);}template<typename RandomAccessIterator>voidmake_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::make_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [sort_heap] T(n) = O(nlgn) *********************/template<typename RandomAccessIterator, typename Compare>voidsort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  while (last - first > 1)    TinySTL::pop_heap(first, last--);}template<typename RandomAccessIterator>voidsort_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::sort_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [is_heap] T(n) = O(n) *********************//***************** [max] T(n) = O(1) *********************/template<typename T>inline const T &max(const T &a, const T &b) {  return a < b ? b : a;}template<typename T, typename Compare>inline const T &max(const T &a, const T &b, Compare comp) {  return comp(a, b) ? b : a;}/***************** [min] T(n) = O(1) *********************/template<typename T>inline const T &min(const T &a, const T &b) {  return a < b ? a : b;}template<typename T, typename Compare>inline const T &mix(const T &a, const T &b, Compare comp) {  return comp(a, b) ? a : b;}/***************** [fill] T(n) = O(n) *********************/template<typename ForwardIterator, typename T>inline voidfill(ForwardIterator first, ForwardIterator last, const T &val) {  for (; first != last; ++first)    *first = val;}inline voidfill(char *first, char *last, const char &val) {  memset(first, static_cast<unsigned char>(val), last - first);}/***************** [fill-n] T(n) = O(n) *********************/template<typename OutputIterator, typename Size, typename T>inline OutputIteratorfill_n(OutputIterator first, Size n, const T &val) {  for (; n > 0; --n, ++first)    *first = val;  return first;}template<typename Size>inline char *fill_n(char *first, Size n, const char &val) {  memset(first, static_cast<unsigned char>(val), n);  return first + n;}/***************** [copy-backward] T(n) = O(n) *********************/// 出口一：assignment operator: 其他template<typename InputIterator, typename BidirectionalIterator>inline BidirectionalIterator__copy_backward(InputIterator first, InputIterator last, BidirectionalIterator result) {  --last;  --result;  for (auto n = TinySTL::distance(first, last); n > 0; --n, --result, --last)    *result = *last;  return result;}// 出口二：memmove，条件：原生指针 + has_trivial_assignment_operatortemplate<typename T>inline T *__copy_t_backward(const T *first, const T *last, T *result, __true_type) {  auto dist = last - first;  memmove(result - dist, first, sizeof(T) * dist);  return result - dist;}template<typename T>inline T *__copy_t_backward(const T *first, const T *last, T *result, __false_type) {  return TinySTL::__copy_backward(first, last, result);}template<typename InputIterator, typename OutputIterator>struct __copy_dispatch_backward {  OutputIterator operator()(InputIterator first, InputIterator last, OutputIterator result) {    return __copy_backward(first, last, result);  }};template<typename T>struct __copy_dispatch_backward<T *, T *> {  T *operator()(T *first, T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t_backward(first, last, result, t());  }};template<typename T>struct __copy_dispatch_backward<const T *, T *> {  T *operator()(const T *first, const T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t_backward(first, last, result, t());  }};template<typename InputIterator, typename OutputIterator>inline OutputIteratorcopy_backward(InputIterator first, InputIterator last, OutputIterator result) {  return __copy_dispatch_backward<InputIterator, OutputIterator>()(first, last, result);}inline char *copy_backward(const char *first, const char *last, char *result) {  auto dist = last - first;  memmove(result - dist, first, dist);  return result - dist;}/***************** [copy] T(n) = O(n) *********************/// 出口一：assignment operator: 其他template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy(InputIterator first, InputIterator last, OutputIterator result) {  for (auto n = TinySTL::distance(first, last); n > 0; --n, ++result, ++first)    *result = *first;  return result;}// 出口二：memmove，条件：原生指针 + has_trivial_assignment_operatortemplate<typename T>inline T *__copy_t(const T *first, const T *last, T *result, __true_type) {  memmove(result, first, sizeof(T) * (last - first));  return result + (last - first);}template<typename T>inline T *__copy_t(const T *first, const T *last, T *result, __false_type) {  return __copy(first, last, result);}template<typename InputIterator, typename OutputIterator>struct __copy_dispatch {  OutputIterator operator()(InputIterator first, InputIterator last, OutputIterator result) {    return TinySTL::__copy(first, last, result);  }};template<typename T>struct __copy_dispatch<T *, T *> {  T *operator()(T *first, T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t(first, last, result, t());  }};template<typename T>struct __copy_dispatch<const T *, T *> {  T *operator()(const T *first, const T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t(first, last, result, t());  }};template<typename InputIterator, typename OutputIterator>inline OutputIteratorcopy(InputIterator first, InputIterator last, OutputIterator result) {  return __copy_dispatch<InputIterator, OutputIterator>()(first, last, result);}inline char *copy(const char *first, const char *last, char *result) {  memmove(result, first, last - first);  return result + (last - first);}inline wchar_t *copy(const wchar_t *first, const wchar_t *last, wchar_t *result) {  memmove(result, first, sizeof(wchar_t) * (last - first));  return result + (last - first);}}#endif //TINYSTL_SRC_ALGORITHM_H_
\ No newline at end of file
+#ifndef TINYSTL_SRC_ALGORITHM_H_#define TINYSTL_SRC_ALGORITHM_H_#include <cstring>#include "functional.h"#include "iterator.h"#include "type_traits.h"namespace TinySTL {/***************** [segmented iterator] *********************//// 分段迭代器：区间由若干段连续内存拼接而成（如 deque 的迭代器）。/// 容器特化本模板后，copy、fill 等算法会逐段处理，每段都是原生指针区间，从而用上 memmove/memset。/// 特化需提供：segment_iterator、local_iterator，以及 segment(it)、local(it)、begin(seg)、end(seg)、compose(seg, local)。template<typename Iterator>struct __segmented_iterator_traits {  typedef __false_type is_segmented_iterator;};/***************** [swap] T(n) = O(1) *********************/// TODO：一次拷贝构造，两次 assignment operator，一次析构，可以说很低效template<typename T>inline voidswap(T &a, T &b) {  T tmp = a;  a = b;  b = tmp;}/***************** [push_heap] T(n) = O(lgn) *********************//// 将 last - 1 元素按 heap 的规则放在适合的位置。/// 说明：如果当前节点大于父节点，交换之。template<typename RandomAccessIterator, typename Compare>inline void// 移动次数为 n，则 ctor: n, assignment operator: 2n, dtor: npush_heap_less_eff(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto cur = last - 1;  auto parent = first + (cur - first + 1) / 2;  while (cur != first && cmp(*parent, *cur)) {    TinySTL::swap(*parent, *cur);    cur = parent;    parent = first + (cur - first + 1) / 2;  }}//template<typename RandomAccessIterator, typename Compare>void// 移动次数为 n，则 ctor: 1, assignment operator: n, dtor: 1. 比上面优化很多// 注意 iterator + offset 和 offset + iterator 写法的区别push_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto value = *(last - 1);  auto cur_index = last - first - 1;  auto parent_index = (cur_index - 1) / 2;  while (cur_index > 0 && cmp(*(first + parent_index), value)) {    *(first + cur_index) = *(first + parent_index);    cur_index = parent_index;    parent_index = (cur_index - 1) / 2;  }  *(first + cur_index) = value;}template<typename RandomAccessIterator>voidpush_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::push_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [pop_heap] T(n) = O(lgn) *********************/template<typename RandomAccessIterator, typename Compare>void/// 将 first 与 last - 1交换，并调整 heap。/// 说明： 1.交换 first 和 last - 1，2. 找到新的first元素的适合位置。pop_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto value = *(last - 1);  *(last - 1) = *first;  // 减一是因为 last - 1已经不是 heap 的元素了  auto len = last - first - 1;  auto cur_index = 0;  auto right_child_index = 2 * cur_index + 2;  auto max_child_index = right_child_index;  while (right_child_index < len) {    max_child_index = cmp(*(first + right_child_index), *(first + (right_child_index - 1))) ?                      right_child_index - 1 :                      right_child_index;    if (!cmp(value, *(first + max_child_index)))      break;    *(first + cur_index) = *(first + max_child_index);    cur_index = max_child_index;    right_child_index = 2 * cur_index + 2;  }  // 处理特殊情况，没有右节点，只有左节点  if (right_child_index == len && cmp(value, *(first + right_child_index - 1))) {    max_child_index = right_child_index - 1;    *(first + cur_index) = *(first + max_child_index);    cur_index = max_child_index;  }  *(first + cur_index) = value;}template<typename RandomAccessIterator>voidpop_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::pop_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [make_heap] T(n) = O(n) *********************/template<typename RandomAccessIterator, typename Compare>voidmake_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto len = last - first;  for (auto last_index = len - len + 1; last_index <= len; ++last_index)    TinySTL::push_heap(first, first + last_index, cmp);}template<typename RandomAccessIterator>voidmake_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::make_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/// 自顶向下调整：把 hole 处的元素下沉到合适的位置，len 为 heap 的长度。/// hole 的左右子树需已是 heap。并行 make_heap（见 parallel_algorithm.h）逐层调用它。template<typename RandomAccessIterator, typename Distance, typename Compare>void__sift_down(RandomAccessIterator first, Distance hole, Distance len, Compare cmp) {  auto value = *(first + hole);  Distance child = 2 * hole + 1;  while (child < len) {    if (child + 1 < len && cmp(*(first + child), *(first + (child + 1))))      ++child;    if (!cmp(value, *(first + child)))      break;    *(first + hole) = *(first + child);    hole = child;    child = 2 * hole + 1;  }  *(first + hole) = value;}/***************** [sort_heap] T(n) = O(nlgn) *********************/template<typename RandomAccessIterator, typename Compare>voidsort_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  while (last - first > 1)    TinySTL::pop_heap(first, last--, cmp);}template<typename RandomAccessIterator>voidsort_heap(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::sort_heap(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [is_heap] T(n) = O(n) *********************//***************** [sort] T(n) = O(nlgn) *********************//// introsort：快速排序，递归过深时改用堆排序，区间足够小时留给最后的插入排序。// 小于这个长度的区间不再划分const ptrdiff_t __sort_threshold = 16;template<typename Size>inline Size__lg(Size n) {  Size k = 0;  for (; n > 1; n >>= 1)    ++k;  return k;}template<typename T, typename Compare>inline const T &__median(const T &a, const T &b, const T &c, Compare cmp) {  if (cmp(a, b)) {    if (cmp(b, c))      return b;    return cmp(a, c) ? c : a;  }  if (cmp(a, c))    return a;  return cmp(b, c) ? c : b;}// 以 pivot 划分，返回右半边的起点。pivot 取自区间内部，两端的扫描不会越界template<typename RandomAccessIterator, typename T, typename Compare>RandomAccessIterator__unguarded_partition(RandomAccessIterator first, RandomAccessIterator last, const T &pivot, Compare cmp) {  while (true) {    while (cmp(*first, pivot))      ++first;    --last;    while (cmp(pivot, *last))      --last;    if (!(first < last))      return first;    TinySTL::swap(*first, *last);    ++first;  }}template<typename RandomAccessIterator, typename Compare>void__insertion_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  if (first == last)    return;  for (auto i = first + 1; i != last; ++i) {    auto value = *i;    auto j = i;    for (; j != first && cmp(value, *(j - 1)); --j)      *j = *(j - 1);    *j = value;  }}// 划分一次，返回右半边的起点template<typename RandomAccessIterator, typename Compare>inline RandomAccessIterator__partition_by_median(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  auto pivot = TinySTL::__median(*first, *(first + (last - first) / 2), *(last - 1), cmp);  return TinySTL::__unguarded_partition(first, last, pivot, cmp);}template<typename RandomAccessIterator, typename Size, typename Compare>void__introsort_loop(RandomAccessIterator first, RandomAccessIterator last, Size depth_limit, Compare cmp) {  while (last - first > __sort_threshold) {    if (depth_limit == 0) {      TinySTL::make_heap(first, last, cmp);      TinySTL::sort_heap(first, last, cmp);      return;    }    --depth_limit;    auto cut = TinySTL::__partition_by_median(first, last, cmp);    // 递归右半边，循环处理左半边    TinySTL::__introsort_loop(cut, last, depth_limit, cmp);    last = cut;  }}template<typename RandomAccessIterator, typename Compare>inline voidsort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {  if (last - first < 2)    return;  TinySTL::__introsort_loop(first, last, TinySTL::__lg(last - first) * 2, cmp);  TinySTL::__insertion_sort(first, last, cmp);}template<typename RandomAccessIterator>inline voidsort(RandomAccessIterator first, RandomAccessIterator last) {  TinySTL::sort(first, last, typename TinySTL::less<typename iterator_traits<RandomAccessIterator>::value_type>());}/***************** [lower_bound] T(n) = O(lgn) *********************//// 第一个不小于 val 的位置。/// 无分支的二分：每轮只根据比较结果选择 base 或 base + half（编译为 cmov），区间长度的变化与数据无关，/// 不会因为分支预测失败而清空流水线。template<typename RandomAccessIterator, typename T, typename Compare>inline RandomAccessIteratorlower_bound(RandomAccessIterator first, RandomAccessIterator last, const T &val, Compare cmp) {  auto len = last - first;  if (len == 0)    return first;  RandomAccessIterator base = first;  while (len > 1) {    auto half = len / 2;    base = cmp(base[half], val) ? base + half : base;    len -= half;  }  return base + (cmp(*base, val) ? 1 : 0);}template<typename RandomAccessIterator, typename T>inline RandomAccessIteratorlower_bound(RandomAccessIterator first, RandomAccessIterator last, const T &val) {  return TinySTL::lower_bound(first, last, val, TinySTL::less<T>());}/***************** [upper_bound] T(n) = O(lgn) *********************//// 第一个大于 val 的位置，同样是无分支的二分template<typename RandomAccessIterator, typename T, typename Compare>inline RandomAccessIteratorupper_bound(RandomAccessIterator first, RandomAccessIterator last, const T &val, Compare cmp) {  auto len = last - first;  if (len == 0)    return first;  RandomAccessIterator base = first;  while (len > 1) {    auto half = len / 2;    base = cmp(val, base[half]) ? base : base + half;    len -= half;  }  return base + (cmp(val, *base) ? 0 : 1);}template<typename RandomAccessIterator, typename T>inline RandomAccessIteratorupper_bound(RandomAccessIterator first, RandomAccessIterator last, const T &val) {  return TinySTL::upper_bound(first, last, val, TinySTL::less<T>());}/***************** [max] T(n) = O(1) *********************/template<typename T>inline const T &max(const T &a, const T &b) {  return a < b ? b : a;}template<typename T, typename Compare>inline const T &max(const T &a, const T &b, Compare comp) {  return comp(a, b) ? b : a;}/***************** [min] T(n) = O(1) *********************/template<typename T>inline const T &min(const T &a, const T &b) {  return a < b ? a : b;}template<typename T, typename Compare>inline const T &mix(const T &a, const T &b, Compare comp) {  return comp(a, b) ? a : b;}/***************** [fill] T(n) = O(n) *********************/// 出口一：assignment operatortemplate<typename ForwardIterator, typename T>inline void__fill(ForwardIterator first, ForwardIterator last, const T &val) {  for (; first != last; ++first)    *first = val;}// 出口二：memsetinline void__fill(char *first, char *last, const char &val) {  if (first != last)    memset(first, static_cast<unsigned char>(val), last - first);}template<typename ForwardIterator, typename T>inline void__fill_dispatch(ForwardIterator first, ForwardIterator last, const T &val, __false_type) {  TinySTL::__fill(first, last, val);}// 分段迭代器：逐段在原生指针区间上 filltemplate<typename ForwardIterator, typename T>void__fill_dispatch(ForwardIterator first, ForwardIterator last, const T &val, __true_type) {  typedef __segmented_iterator_traits<ForwardIterator> traits;  auto seg_first = traits::segment(first);  auto seg_last = traits::segment(last);  if (seg_first == seg_last) {    TinySTL::__fill(traits::local(first), traits::local(last), val);    return;  }  TinySTL::__fill(traits::local(first), traits::end(seg_first), val);  for (++seg_first; seg_first != seg_last; ++seg_first)    TinySTL::__fill(traits::begin(seg_first), traits::end(seg_first), val);  TinySTL::__fill(traits::begin(seg_last), traits::local(last), val);}template<typename ForwardIterator, typename T>inline voidfill(ForwardIterator first, ForwardIterator last, const T &val) {  typedef typename __segmented_iterator_traits<ForwardIterator>::is_segmented_iterator is_segmented;  TinySTL::__fill_dispatch(first, last, val, is_segmented());}inline voidfill(char *first, char *last, const char &val) {  TinySTL::__fill(first, last, val);}/***************** [fill-n] T(n) = O(n) *********************/// 出口一：assignment operatortemplate<typename OutputIterator, typename Size, typename T>inline OutputIterator__fill_n(OutputIterator first, Size n, const T &val) {  for (; n > 0; --n, ++first)    *first = val;  return first;}// 出口二：memsettemplate<typename Size>inline char *__fill_n(char *first, Size n, const char &val) {  if (n > 0)    memset(first, static_cast<unsigned char>(val), n);  return first + n;}template<typename OutputIterator, typename Size, typename T>inline OutputIterator__fill_n_dispatch(OutputIterator first, Size n, const T &val, __false_type) {  return TinySTL::__fill_n(first, n, val);}// 分段迭代器：每次填满当前段的剩余部分template<typename OutputIterator, typename Size, typename T>OutputIterator__fill_n_dispatch(OutputIterator first, Size n, const T &val, __true_type) {  typedef __segmented_iterator_traits<OutputIterator> traits;  if (n <= 0)    return first;  auto seg = traits::segment(first);  auto local = traits::local(first);  while (true) {    ptrdiff_t len = traits::end(seg) - local;    if (static_cast<ptrdiff_t>(n) < len)      len = static_cast<ptrdiff_t>(n);    local = TinySTL::__fill_n(local, len, val);    n -= len;    if (n <= 0)      return traits::compose(seg, local);    ++seg;    local = traits::begin(seg);  }}template<typename OutputIterator, typename Size, typename T>inline OutputIteratorfill_n(OutputIterator first, Size n, const T &val) {  typedef typename __segmented_iterator_traits<OutputIterator>::is_segmented_iterator is_segmented;  return TinySTL::__fill_n_dispatch(first, n, val, is_segmented());}template<typename Size>inline char *fill_n(char *first, Size n, const char &val) {  return TinySTL::__fill_n(first, n, val);}/***************** [copy-backward] T(n) = O(n) *********************/// 出口一：assignment operator: 其他template<typename InputIterator, typename BidirectionalIterator>inline BidirectionalIterator__copy_backward(InputIterator first, InputIterator last, BidirectionalIterator result) {  for (auto n = TinySTL::distance(first, last); n > 0; --n)    *--result = *--last;  return result;}// 出口二：memmove，条件：原生指针 + has_trivial_assignment_operatortemplate<typename T>inline T *__copy_t_backward(const T *first, const T *last, T *result, __true_type) {  auto dist = last - first;  // 空区间的指针可能是 nullptr，不能传给 memmove  if (dist != 0)    memmove(result - dist, first, sizeof(T) * dist);  return result - dist;}template<typename T>inline T *__copy_t_backward(const T *first, const T *last, T *result, __false_type) {  return TinySTL::__copy_backward(first, last, result);}template<typename InputIterator, typename OutputIterator>struct __copy_dispatch_backward {  OutputIterator operator()(InputIterator first, InputIterator last, OutputIterator result) {    return __copy_backward(first, last, result);  }};template<typename T>struct __copy_dispatch_backward<T *, T *> {  T *operator()(T *first, T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t_backward(first, last, result, t());  }};template<typename T>struct __copy_dispatch_backward<const T *, T *> {  T *operator()(const T *first, const T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t_backward(first, last, result, t());  }};// 分段迭代器：输入、输出都不分段template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy_backward_segmented(InputIterator first, InputIterator last, OutputIterator result, __false_type, __false_type) {  return __copy_dispatch_backward<InputIterator, OutputIterator>()(first, last, result);}// 非随机访问迭代器（包括其他库的迭代器）只能逐个元素处理template<typename InputIterator, typename OutputIterator, typename IteratorTag>inline OutputIterator__copy_backward_to_segmented(InputIterator first, InputIterator last, OutputIterator result, IteratorTag) {  return __copy_dispatch_backward<InputIterator, OutputIterator>()(first, last, result);}// 只有输出分段：从后往前，每次填满当前段的前半部分template<typename InputIterator, typename OutputIterator>OutputIterator__copy_backward_to_segmented(InputIterator first, InputIterator last, OutputIterator result, random_iterator_tag) {  typedef __segmented_iterator_traits<OutputIterator> traits;  typedef typename traits::local_iterator local_iterator;  ptrdiff_t n = last - first;  if (n <= 0)    return result;  auto seg = traits::segment(result);  auto local = traits::local(result);  while (true) {    if (local == traits::begin(seg)) {      --seg;      local = traits::end(seg);    }    ptrdiff_t len = local - traits::begin(seg);    if (n < len)      len = n;    local = __copy_dispatch_backward<InputIterator, local_iterator>()(last - len, last, local);    last -= len;    n -= len;    if (n == 0)      return traits::compose(seg, local);  }}template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy_backward_segmented(InputIterator first, InputIterator last, OutputIterator result, __false_type, __true_type) {  return TinySTL::__copy_backward_to_segmented(first, last, result, iterator_category(first));}// 输入分段：从最后一段开始，逐段拷贝template<typename InputIterator, typename OutputIterator, typename OutputSegmented>OutputIterator__copy_backward_segmented(InputIterator first, InputIterator last, OutputIterator result, __true_type, OutputSegmented) {  typedef __segmented_iterator_traits<InputIterator> traits;  auto seg_first = traits::segment(first);  auto seg_last = traits::segment(last);  if (seg_first == seg_last)    return TinySTL::__copy_backward_segmented(traits::local(first), traits::local(last), result,                                              __false_type(), OutputSegmented());  result = TinySTL::__copy_backward_segmented(traits::begin(seg_last), traits::local(last), result,                                              __false_type(), OutputSegmented());  for (--seg_last; seg_last != seg_first; --seg_last)    result = TinySTL::__copy_backward_segmented(traits::begin(seg_last), traits::end(seg_last), result,                                                __false_type(), OutputSegmented());  return TinySTL::__copy_backward_segmented(traits::local(first), traits::end(seg_first), result,                                            __false_type(), OutputSegmented());}template<typename InputIterator, typename OutputIterator>inline OutputIteratorcopy_backward(InputIterator first, InputIterator last, OutputIterator result) {  typedef typename __segmented_iterator_traits<InputIterator>::is_segmented_iterator input_segmented;  typedef typename __segmented_iterator_traits<OutputIterator>::is_segmented_iterator output_segmented;  return TinySTL::__copy_backward_segmented(first, last, result, input_segmented(), output_segmented());}inline char *copy_backward(const char *first, const char *last, char *result) {  auto dist = last - first;  if (dist != 0)    memmove(result - dist, first, dist);  return result - dist;}/***************** [copy] T(n) = O(n) *********************/// 出口一：assignment operator: 其他template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy(InputIterator first, InputIterator last, OutputIterator result) {  for (auto n = TinySTL::distance(first, last); n > 0; --n, ++result, ++first)    *result = *first;  return result;}// 出口二：memmove，条件：原生指针 + has_trivial_assignment_operatortemplate<typename T>inline T *__copy_t(const T *first, const T *last, T *result, __true_type) {  // 空区间的指针可能是 nullptr（例如空 vector），不能传给 memmove  if (first != last)    memmove(result, first, sizeof(T) * (last - first));  return result + (last - first);}template<typename T>inline T *__copy_t(const T *first, const T *last, T *result, __false_type) {  return __copy(first, last, result);}template<typename InputIterator, typename OutputIterator>struct __copy_dispatch {  OutputIterator operator()(InputIterator first, InputIterator last, OutputIterator result) {    return TinySTL::__copy(first, last, result);  }};template<typename T>struct __copy_dispatch<T *, T *> {  T *operator()(T *first, T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t(first, last, result, t());  }};template<typename T>struct __copy_dispatch<const T *, T *> {  T *operator()(const T *first, const T *last, T *result) {    typedef typename __type_traits<T>::has_trivial_assignment_operator t;    return __copy_t(first, last, result, t());  }};// 分段迭代器：输入、输出都不分段template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy_segmented(InputIterator first, InputIterator last, OutputIterator result, __false_type, __false_type) {  return __copy_dispatch<InputIterator, OutputIterator>()(first, last, result);}// 非随机访问迭代器（包括其他库的迭代器）只能逐个元素处理template<typename InputIterator, typename OutputIterator, typename IteratorTag>inline OutputIterator__copy_to_segmented(InputIterator first, InputIterator last, OutputIterator result, IteratorTag) {  return __copy_dispatch<InputIterator, OutputIterator>()(first, last, result);}// 只有输出分段：每次填满当前段的剩余部分template<typename InputIterator, typename OutputIterator>OutputIterator__copy_to_segmented(InputIterator first, InputIterator last, OutputIterator result, random_iterator_tag) {  typedef __segmented_iterator_traits<OutputIterator> traits;  typedef typename traits::local_iterator local_iterator;  ptrdiff_t n = last - first;  if (n <= 0)    return result;  auto seg = traits::segment(result);  auto local = traits::local(result);  while (true) {    ptrdiff_t len = traits::end(seg) - local;    if (n < len)      len = n;    local = __copy_dispatch<InputIterator, local_iterator>()(first, first + len, local);    first += len;    n -= len;    if (n == 0)      return traits::compose(seg, local);    ++seg;    local = traits::begin(seg);  }}template<typename InputIterator, typename OutputIterator>inline OutputIterator__copy_segmented(InputIterator first, InputIterator last, OutputIterator result, __false_type, __true_type) {  return TinySTL::__copy_to_segmented(first, last, result, iterator_category(first));}// 输入分段：逐段拷贝template<typename InputIterator, typename OutputIterator, typename OutputSegmented>OutputIterator__copy_segmented(InputIterator first, InputIterator last, OutputIterator result, __true_type, OutputSegmented) {  typedef __segmented_iterator_traits<InputIterator> traits;  auto seg_first = traits::segment(first);  auto seg_last = traits::segment(last);  if (seg_first == seg_last)    return TinySTL::__copy_segmented(traits::local(first), traits::local(last), result,                                     __false_type(), OutputSegmented());  result = TinySTL::__copy_segmented(traits::local(first), traits::end(seg_first), result,                                     __false_type(), OutputSegmented());  for (++seg_first; seg_first != seg_last; ++seg_first)    result = TinySTL::__copy_segmented(traits::begin(seg_first), traits::end(seg_first), result,                                       __false_type(), OutputSegmented());  return TinySTL::__copy_segmented(traits::begin(seg_last), traits::local(last), result,                                   __false_type(), OutputSegmented());}template<typename InputIterator, typename OutputIterator>inline OutputIteratorcopy(InputIterator first, InputIterator last, OutputIterator result) {  typedef typename __segmented_iterator_traits<InputIterator>::is_segmented_iterator input_segmented;  typedef typename __segmented_iterator_traits<OutputIterator>::is_segmented_iterator output_segmented;  return TinySTL::__copy_segmented(first, last, result, input_segmented(), output_segmented());}inline char *copy(const char *first, const char *last, char *result) {  if (first != last)    memmove(result, first, last - first);  return result + (last - first);}inline wchar_t *copy(const wchar_t *first, const wchar_t *last, wchar_t *result) {  if (first != last)    memmove(result, first, sizeof(wchar_t) * (last - first));  return result + (last - first);}/***************** [equal] T(n) = O(n) *********************/// 比较 [first1, last1) 与 first2 开始的区间，first2 随之前进// 出口一：operator==template<typename InputIterator1, typename InputIterator2>inline bool__equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2) {  for (; first1 != last1; ++first1, ++first2) {    if (!(*first1 == *first2))      return false;  }  return true;}template<typename InputIterator1, typename InputIterator2>struct __equal_dispatch {  bool operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2) {    return TinySTL::__equal(first1, last1, first2);  }};// 出口二：memcmp，条件：原生指针 + 整数类型（没有填充位，逐字节相等即相等；浮点数的 0.0 与 -0.0 则不行）template<typename T>inline bool__equal_t(const T *first1, const T *last1, const T *first2, __true_type) {  return memcmp(first1, first2, sizeof(T) * (last1 - first1)) == 0;}template<typename T>inline bool__equal_t(const T *first1, const T *last1, const T *first2, __false_type) {  return TinySTL::__equal(first1, last1, first2);}template<typename T, typename Pointer1, typename Pointer2>struct __equal_pointer {  bool operator()(Pointer1 first1, Pointer1 last1, Pointer2 &first2) {    typedef typename __type_traits<T>::is_integer is_integer;    bool res = __equal_t<T>(first1, last1, first2, is_integer());    first2 += last1 - first1;    return res;  }};template<typename T>struct __equal_dispatch<T *, T *> : __equal_pointer<T, T *, T *> {};template<typename T>struct __equal_dispatch<const T *, T *> : __equal_pointer<T, const T *, T *> {};template<typename T>struct __equal_dispatch<T *, const T *> : __equal_pointer<T, T *, const T *> {};template<typename T>struct __equal_dispatch<const T *, const T *> : __equal_pointer<T, const T *, const T *> {};// 分段迭代器：两个区间都不分段template<typename InputIterator1, typename InputIterator2>inline bool__equal_segmented(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2, __false_type, __false_type) {  return __equal_dispatch<InputIterator1, InputIterator2>()(first1, last1, first2);}template<typename InputIterator1, typename InputIterator2, typename IteratorTag>inline bool__equal_to_segmented(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2, IteratorTag) {  return __equal_dispatch<InputIterator1, InputIterator2>()(first1, last1, first2);}// 只有第二个区间分段：按第二个区间的段切分第一个区间template<typename InputIterator1, typename InputIterator2>bool__equal_to_segmented(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2, random_iterator_tag) {  typedef __segmented_iterator_traits<InputIterator2> traits;  typedef typename traits::local_iterator local_iterator;  ptrdiff_t n = last1 - first1;  if (n <= 0)    return true;  auto seg = traits::segment(first2);  auto local = traits::local(first2);  while (true) {    ptrdiff_t len = traits::end(seg) - local;    if (n < len)      len = n;    if (!__equal_dispatch<InputIterator1, local_iterator>()(first1, first1 + len, local))      return false;    first1 += len;    n -= len;    if (n == 0)      break;    ++seg;    local = traits::begin(seg);  }  first2 = traits::compose(seg, local);  return true;}template<typename InputIterator1, typename InputIterator2>inline bool__equal_segmented(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2, __false_type, __true_type) {  return TinySTL::__equal_to_segmented(first1, last1, first2, iterator_category(first1));}// 第一个区间分段：逐段比较template<typename InputIterator1, typename InputIterator2, typename Segmented2>bool__equal_segmented(InputIterator1 first1, InputIterator1 last1, InputIterator2 &first2, __true_type, Segmented2) {  typedef __segmented_iterator_traits<InputIterator1> traits;  auto seg_first = traits::segment(first1);  auto seg_last = traits::segment(last1);  if (seg_first == seg_last)    return TinySTL::__equal_segmented(traits::local(first1), traits::local(last1), first2,                                      __false_type(), Segmented2());  if (!TinySTL::__equal_segmented(traits::local(first1), traits::end(seg_first), first2,                                  __false_type(), Segmented2()))    return false;  for (++seg_first; seg_first != seg_last; ++seg_first) {    if (!TinySTL::__equal_segmented(traits::begin(seg_first), traits::end(seg_first), first2,                                    __false_type(), Segmented2()))      return false;  }  return TinySTL::__equal_segmented(traits::begin(seg_last), traits::local(last1), first2,                                    __false_type(), Segmented2());}template<typename InputIterator1, typename InputIterator2>inline boolequal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2) {  typedef typename __segmented_iterator_traits<InputIterator1>::is_segmented_iterator segmented1;  typedef typename __segmented_iterator_traits<InputIterator2>::is_segmented_iterator segmented2;  return TinySTL::__equal_segmented(first1, last1, first2, segmented1(), segmented2());}template<typename InputIterator1, typename InputIterator2, typename BinaryPredicate>inline boolequal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, BinaryPredicate pred) {  for (; first1 != last1; ++first1, ++first2) {    if (!pred(*first1, *first2))      return false;  }  return true;}/***************** [for_each] T(n) = O(n) *********************/template<typename InputIterator, typename Function>Functionfor_each(InputIterator first, InputIterator last, Function f) {  for (; first != last; ++first)    f(*first);  return f;}/***************** [transform] T(n) = O(n) *********************/template<typename InputIterator, typename OutputIterator, typename UnaryOperation>OutputIteratortransform(InputIterator first, InputIterator last, OutputIterator result, UnaryOperation op) {  for (; first != last; ++first, ++result)    *result = op(*first);  return result;}template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryOperation>OutputIteratortransform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, OutputIterator result,          BinaryOperation op) {  for (; first1 != last1; ++first1, ++first2, ++result)    *result = op(*first1, *first2);  return result;}}#endif //TINYSTL_SRC_ALGORITHM_H_
\ No newline at end of file
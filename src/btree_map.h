@@ -0,0 +1,135 @@
+#ifndef TINYSTL_SRC_BTREE_MAP_H_
+#define TINYSTL_SRC_BTREE_MAP_H_
+
+/**
+ * 基于 B 树的有序 map，实现见 __btree.h。
+ * 接口和 std::map 基本一致，区别：
+ *  1. 插入、删除后所有迭代器、指针、引用都会失效；
+ *  2. assign_sorted 可以从有序区间 O(n) 建树；
+ *  3. erase(iterator) 需要拷贝一次 key。
+ */
+
+#include <stdexcept>
+
+#include "__btree.h"
+#include "allocator.h"
+#include "functional.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+template<typename Key, typename T, typename Compare = less<Key>, typename Alloc = allocator<pair<const Key, T>>>
+class btree_map {
+ protected:
+  using tree_type = __btree<pair<const Key, T>, Key, select1st<pair<const Key, T>>, Compare, Alloc>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = pair<const Key, T>;
+  using key_compare = Compare;
+  using size_type = typename tree_type::size_type;
+  using difference_type = typename tree_type::difference_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+ protected:
+  tree_type tree;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit btree_map(const key_compare &comp = key_compare()) : tree(comp) {}
+  template<typename InputIterator>
+  btree_map(InputIterator first, InputIterator last, const key_compare &comp = key_compare()) : tree(comp) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return tree.size(); }
+  bool empty() const { return tree.empty(); }
+  key_compare key_comp() const { return tree.key_comp(); }
+  size_type height() const { return tree.height(); }
+  size_type bytes_used() const { return tree.bytes_used(); }
+
+  const_iterator begin() const { return tree.begin(); }
+  const_iterator end() const { return tree.end(); }
+  const_iterator cbegin() const { return tree.begin(); }
+  const_iterator cend() const { return tree.end(); }
+  const_iterator find(const key_type &key) const { return tree.find(key); }
+  const_iterator lower_bound(const key_type &key) const { return tree.lower_bound(key); }
+  const_iterator upper_bound(const key_type &key) const { return tree.upper_bound(key); }
+  pair<const_iterator, const_iterator> equal_range(const key_type &key) const {
+    return pair<const_iterator, const_iterator>(tree.lower_bound(key), tree.upper_bound(key));
+  }
+  size_type count(const key_type &key) const { return tree.count(key); }
+  bool contains(const key_type &key) const { return tree.count(key) != 0; }
+  const mapped_type &at(const key_type &key) const {
+    auto it = tree.find(key);
+    if (it == tree.end())
+      throw std::out_of_range("btree_map::at");
+    return it->second;
+  }
+
+  /*************** 访问元素 ************/
+  iterator begin() { return tree.begin(); }
+  iterator end() { return tree.end(); }
+  iterator find(const key_type &key) { return tree.find(key); }
+  iterator lower_bound(const key_type &key) { return tree.lower_bound(key); }
+  iterator upper_bound(const key_type &key) { return tree.upper_bound(key); }
+  pair<iterator, iterator> equal_range(const key_type &key) {
+    return pair<iterator, iterator>(tree.lower_bound(key), tree.upper_bound(key));
+  }
+  mapped_type &at(const key_type &key) {
+    auto it = tree.find(key);
+    if (it == tree.end())
+      throw std::out_of_range("btree_map::at");
+    return it->second;
+  }
+  mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) { return tree.insert(val); }
+  pair<iterator, bool> insert(value_type &&val) { return tree.insert(TinySTL::move(val)); }
+  /// 先构造出元素才知道 key，key 已存在时这个元素被丢弃
+  template<typename... Args>
+  pair<iterator, bool> emplace(Args &&... args) { return insert(value_type(TinySTL::forward<Args>(args)...)); }
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      tree.insert(*first);
+  }
+  /// key 不存在时才构造 mapped_type(args...)，key 和 mapped_type 分别原地构造
+  template<typename... Args>
+  pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+    return tree.try_emplace_key(key, __piecewise_construct, key, TinySTL::forward<Args>(args)...);
+  }
+  /// 用按 key 严格递增的 [first, last) 替换现有元素，O(n)
+  template<typename ForwardIterator>
+  void assign_sorted(ForwardIterator first, ForwardIterator last) { tree.assign_sorted(first, last); }
+  iterator erase(iterator pos) { return tree.erase(pos); }
+  iterator erase(const_iterator pos) { return tree.erase(pos); }
+  size_type erase(const key_type &key) { return tree.erase_key(key); }
+  void clear() { tree.clear(); }
+  /// 把 source 中 key 不在本容器中的元素移过来，其余的留在 source。
+  /// mapped_type 移动构造（key 是 const，仍是拷贝），之后从 source 中删除被移走的元素；key 已存在时不会移动
+  void merge(btree_map &source) {
+    for (auto it = source.begin(); it != source.end();) {
+      if (tree.insert(TinySTL::move(*it)).second)
+        it = source.erase(it);
+      else
+        ++it;
+    }
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(btree_map &x, btree_map &y) { swap(x.tree, y.tree); }
+  friend bool operator==(const btree_map &x, const btree_map &y) { return x.tree == y.tree; }
+  friend bool operator!=(const btree_map &x, const btree_map &y) { return !(x == y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_BTREE_MAP_H_
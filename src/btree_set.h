@@ -0,0 +1,99 @@
+#ifndef TINYSTL_SRC_BTREE_SET_H_
+#define TINYSTL_SRC_BTREE_SET_H_
+
+/**
+ * 基于 B 树的有序 set，实现见 __btree.h。
+ * 接口和 std::set 基本一致，区别同 btree_map。
+ */
+
+#include "__btree.h"
+#include "allocator.h"
+#include "functional.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+template<typename Key, typename Compare = less<Key>, typename Alloc = allocator<Key>>
+class btree_set {
+ protected:
+  using tree_type = __btree<Key, Key, identity<Key>, Compare, Alloc>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using size_type = typename tree_type::size_type;
+  using difference_type = typename tree_type::difference_type;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  // 元素就是 key，不允许通过迭代器修改
+  using iterator = typename tree_type::const_iterator;
+  using const_iterator = typename tree_type::const_iterator;
+
+ protected:
+  tree_type tree;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit btree_set(const key_compare &comp = key_compare()) : tree(comp) {}
+  template<typename InputIterator>
+  btree_set(InputIterator first, InputIterator last, const key_compare &comp = key_compare()) : tree(comp) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return tree.size(); }
+  bool empty() const { return tree.empty(); }
+  key_compare key_comp() const { return tree.key_comp(); }
+  size_type height() const { return tree.height(); }
+  size_type bytes_used() const { return tree.bytes_used(); }
+
+  const_iterator begin() const { return tree.begin(); }
+  const_iterator end() const { return tree.end(); }
+  const_iterator cbegin() const { return tree.begin(); }
+  const_iterator cend() const { return tree.end(); }
+  const_iterator find(const key_type &key) const { return tree.find(key); }
+  const_iterator lower_bound(const key_type &key) const { return tree.lower_bound(key); }
+  const_iterator upper_bound(const key_type &key) const { return tree.upper_bound(key); }
+  pair<const_iterator, const_iterator> equal_range(const key_type &key) const {
+    return pair<const_iterator, const_iterator>(tree.lower_bound(key), tree.upper_bound(key));
+  }
+  size_type count(const key_type &key) const { return tree.count(key); }
+  bool contains(const key_type &key) const { return tree.count(key) != 0; }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) {
+    auto res = tree.insert(val);
+    return pair<iterator, bool>(res.first, res.second);
+  }
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      tree.insert(*first);
+  }
+  /// 用严格递增的 [first, last) 替换现有元素，O(n)
+  template<typename ForwardIterator>
+  void assign_sorted(ForwardIterator first, ForwardIterator last) { tree.assign_sorted(first, last); }
+  iterator erase(const_iterator pos) { return tree.erase(pos); }
+  size_type erase(const key_type &key) { return tree.erase_key(key); }
+  void clear() { tree.clear(); }
+  /// 把 source 中不在本容器中的元素移过来，其余的留在 source
+  void merge(btree_set &source) {
+    for (auto it = source.begin(); it != source.end();) {
+      if (tree.insert(*it).second)
+        it = source.erase(it);
+      else
+        ++it;
+    }
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(btree_set &x, btree_set &y) { swap(x.tree, y.tree); }
+  friend bool operator==(const btree_set &x, const btree_set &y) { return x.tree == y.tree; }
+  friend bool operator!=(const btree_set &x, const btree_set &y) { return !(x == y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_BTREE_SET_H_
@@ -0,0 +1,366 @@
+#ifndef TINYSTL_SRC_COMPACT_LIST_H_
+#define TINYSTL_SRC_COMPACT_LIST_H_
+
+/**
+ * 紧凑链表：所有节点连续地存放在一个 vector 里，前驱、后继用 32 位下标代替指针。
+ * 64 位下 compact_list<uint32_t> 每个元素 12 字节，而 list<uint32_t> 是 24 字节（外加 __alloc 的碎片）。
+ * 删除的节点放进下标 free-list 中复用；compact() 会把节点按遍历顺序重新编号，之后的遍历就是顺序访问内存。
+ * 注意：
+ *  1. 迭代器保存的是下标，节点池扩容不会使迭代器失效，但 compact() 会。
+ *  2. 删除时立即析构元素，空闲节点只保留原始存储，复用时重新构造。
+ *  3. 下标最多用到 2^32 - 3（nil 和空闲标记各占一个），节点数超出时抛出 length_error。
+ */
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "allocator.h"
+#include "iterator.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+// 空闲节点的 prev 是 free_mark，其中没有对象；拷贝、析构节点时只处理有对象的节点
+template<typename T>
+struct __compact_list_node {
+  static const uint32_t free_mark = static_cast<uint32_t>(-2);
+
+  alignas(T) unsigned char storage[sizeof(T)];
+  uint32_t prev;
+  uint32_t next;
+
+  __compact_list_node(const T &val, uint32_t p, uint32_t n) : prev(p), next(n) {
+    __construct::construct(data(), val);
+  }
+  __compact_list_node(const __compact_list_node &x) : prev(free_mark), next(x.next) {
+    if (x.is_live())
+      __construct::construct(data(), *x.data());
+    prev = x.prev;
+  }
+  __compact_list_node &operator=(const __compact_list_node &x) {
+    if (this != &x) {
+      destroy_value();
+      if (x.is_live())
+        __construct::construct(data(), *x.data());
+      prev = x.prev;
+      next = x.next;
+    }
+    return *this;
+  }
+  ~__compact_list_node() { destroy_value(); }
+
+  T *data() { return reinterpret_cast<T *>(storage); }
+  const T *data() const { return reinterpret_cast<const T *>(storage); }
+  bool is_live() const { return prev != free_mark; }
+  void destroy_value() {
+    if (is_live()) {
+      __construct::destroy(data());
+      prev = free_mark;
+    }
+  }
+};
+
+template<typename T>
+const uint32_t __compact_list_node<T>::free_mark;
+
+// 元素可以按位搬移时节点也可以（空闲节点只有原始存储），节点池扩容时直接 memcpy
+template<typename T>
+struct __is_relocatable<__compact_list_node<T>> {
+  typedef typename __is_relocatable<T>::type type;
+};
+
+template<typename List, typename Ref, typename Ptr>
+class __compact_list_iterator : public iterator<bidirectional_iterator_tag, typename List::value_type> {
+ public:
+  using value_type = typename List::value_type;
+  using reference = Ref;
+  using pointer = Ptr;
+  using self_type = __compact_list_iterator;
+  using index_type = typename List::index_type;
+
+  template<typename, typename>
+  friend
+  class compact_list;
+
+ private:
+  List *list;
+  index_type index;
+
+ public:
+  __compact_list_iterator() : list(nullptr), index(List::nil) {}
+  __compact_list_iterator(List *l, index_type i) : list(l), index(i) {}
+
+  friend bool operator==(const self_type &lhs, const self_type &rhs) { return lhs.index == rhs.index; }
+  friend bool operator!=(const self_type &lhs, const self_type &rhs) { return lhs.index != rhs.index; }
+  reference operator*() const { return *list->pool[index].data(); }
+  pointer operator->() const { return &(operator*()); }
+  self_type &operator++() {
+    index = list->next_of(index);
+    return *this;
+  }
+  self_type &operator--() {
+    index = list->prev_of(index);
+    return *this;
+  }
+  self_type operator++(int) {
+    self_type tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  self_type operator--(int) {
+    self_type tmp = *this;
+    --(*this);
+    return tmp;
+  }
+};
+
+template<typename T, typename Alloc = allocator<__compact_list_node<T>>>
+class compact_list {
+ protected:
+  using node = __compact_list_node<T>;
+
+ public:
+  using value_type = T;
+  using index_type = uint32_t;
+  using iterator = __compact_list_iterator<compact_list, T &, T *>;
+  using const_iterator = __compact_list_iterator<const compact_list, const T &, const T *>;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  // 代表哨兵（头节点）的下标，哨兵的链接保存在 head_prev 和 head_next 里
+  static const index_type nil = static_cast<index_type>(-1);
+  // nil 和 node::free_mark 不能用作节点下标
+  static const size_type max_node_count = static_cast<size_type>(node::free_mark);
+
+  template<typename, typename, typename>
+  friend
+  class __compact_list_iterator;
+
+ protected:
+  vector<node, Alloc> pool;
+  index_type head_prev;
+  index_type head_next;
+  // 空闲节点通过 next 串成单链表
+  index_type free_head;
+  size_type node_count;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  compact_list() : pool(), head_prev(nil), head_next(nil), free_head(nil), node_count(0) {}
+  explicit compact_list(size_type n, const value_type &val = value_type()) : compact_list() {
+    typedef typename __type_traits<size_type>::is_integer is_integer;
+    ctor_aux(n, val, is_integer());
+  }
+  template<typename InputIterator>
+  compact_list(InputIterator first, InputIterator last) : compact_list() {
+    typedef typename __type_traits<InputIterator>::is_integer is_integer;
+    ctor_aux(first, last, is_integer());
+  }
+  // Rule of five，下标在拷贝后依然有效，直接拷贝节点池即可
+  compact_list(const compact_list &x) :
+      pool(x.pool), head_prev(x.head_prev), head_next(x.head_next), free_head(x.free_head),
+      node_count(x.node_count) {}
+  compact_list(compact_list &&x) : compact_list() { swap(*this, x); }
+  compact_list &operator=(compact_list x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~compact_list() = default;
+
+  /*************** public const 成员函数 ************/
+  const_iterator begin() const { return const_iterator(this, head_next); }
+  const_iterator end() const { return const_iterator(this, nil); }
+  size_type size() const { return node_count; }
+  bool empty() const { return node_count == 0; }
+  // 节点池的容量（包括空闲节点）
+  size_type capacity() const { return pool.capacity(); }
+  const_reference front() const { return *pool[head_next].data(); }
+  const_reference back() const { return *pool[head_prev].data(); }
+
+  /*************** public 成员函数 ************/
+  iterator begin() { return iterator(this, head_next); }
+  iterator end() { return iterator(this, nil); }
+  reference front() { return *pool[head_next].data(); }
+  reference back() { return *pool[head_prev].data(); }
+  void reserve(size_type n) { pool.reserve(n); }
+
+  /*************** 插入、删除相关 ************/
+  iterator insert(iterator position, const value_type &val) {
+    index_type i = new_node(val);
+    link_before(position.index, i);
+    return iterator(this, i);
+  }
+  void insert(iterator position, size_type n, const value_type &val) {
+    typedef typename __type_traits<size_type>::is_integer is_integer;
+    insert_aux(position, n, val, is_integer());
+  }
+  template<typename InputIterator>
+  void insert(iterator position, InputIterator first, InputIterator last) {
+    typedef typename __type_traits<InputIterator>::is_integer is_integer;
+    insert_aux(position, first, last, is_integer());
+  }
+  void push_front(const value_type &val) { insert(begin(), val); }
+  void push_back(const value_type &val) { insert(end(), val); }
+  void pop_front() { erase(begin()); }
+  void pop_back() { erase(iterator(this, head_prev)); }
+
+  iterator erase(iterator position) {
+    index_type i = position.index;
+    index_type next = next_of(i);
+    unlink(i);
+    delete_node(i);
+    return iterator(this, next);
+  }
+  iterator erase(iterator first, iterator last) {
+    while (first != last)
+      first = erase(first);
+    return last;
+  }
+  void clear() {
+    pool.clear();
+    head_prev = head_next = free_head = nil;
+    node_count = 0;
+  }
+  void remove(const value_type &val) {
+    remove_if([&val](const value_type &x) { return x == val; });
+  }
+  template<typename Predicate>
+  void remove_if(Predicate pred) {
+    auto it = begin();
+    auto last = end();
+    while (it != last) {
+      it = pred(*it) ? erase(it) : ++it;
+    }
+  }
+  // 交换每个节点的前驱和后继即可
+  void reverse() {
+    for (index_type i = head_next; i != nil;) {
+      index_type next = pool[i].next;
+      pool[i].next = pool[i].prev;
+      pool[i].prev = next;
+      i = next;
+    }
+    index_type tmp = head_next;
+    head_next = head_prev;
+    head_prev = tmp;
+  }
+
+  // 按遍历顺序重新编号，丢掉空闲节点，之后的遍历是顺序访问内存。会使所有迭代器失效
+  void compact() {
+    vector<node, Alloc> new_pool;
+    new_pool.reserve(node_count);
+    index_type k = 0;
+    for (index_type i = head_next; i != nil; i = pool[i].next, ++k)
+      new_pool.push_back(node(*pool[i].data(), k - 1, k + 1));
+    if (node_count != 0) {
+      new_pool[0].prev = nil;
+      new_pool[node_count - 1].next = nil;
+      head_next = 0;
+      head_prev = static_cast<index_type>(node_count - 1);
+    }
+    using TinySTL::swap;
+    swap(pool, new_pool);
+    free_head = nil;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(compact_list &x, compact_list &y) {
+    using TinySTL::swap;
+    swap(x.pool, y.pool);
+    swap(x.head_prev, y.head_prev);
+    swap(x.head_next, y.head_next);
+    swap(x.free_head, y.free_head);
+    swap(x.node_count, y.node_count);
+  }
+  friend bool operator==(const compact_list &x, const compact_list &y) {
+    if (x.size() != y.size())
+      return false;
+    auto b1 = x.begin(), b2 = y.begin();
+    auto e1 = x.end();
+    for (; b1 != e1; ++b1, ++b2) {
+      if (*b1 != *b2)
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const compact_list &x, const compact_list &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  index_type next_of(index_type i) const { return i == nil ? head_next : pool[i].next; }
+  index_type prev_of(index_type i) const { return i == nil ? head_prev : pool[i].prev; }
+  void set_next(index_type i, index_type next) {
+    if (i == nil)
+      head_next = next;
+    else
+      pool[i].next = next;
+  }
+  void set_prev(index_type i, index_type prev) {
+    if (i == nil)
+      head_prev = prev;
+    else
+      pool[i].prev = prev;
+  }
+  void link_before(index_type position, index_type i) {
+    index_type prev = prev_of(position);
+    pool[i].prev = prev;
+    pool[i].next = position;
+    set_next(prev, i);
+    set_prev(position, i);
+    ++node_count;
+  }
+  void unlink(index_type i) {
+    set_next(pool[i].prev, pool[i].next);
+    set_prev(pool[i].next, pool[i].prev);
+    --node_count;
+  }
+  // 优先复用空闲节点，在它的原始存储上构造元素；构造失败时空闲链表不变
+  index_type new_node(const value_type &val) {
+    if (free_head != nil) {
+      index_type i = free_head;
+      __construct::construct(pool[i].data(), val);
+      free_head = pool[i].next;
+      pool[i].prev = nil;
+      return i;
+    }
+    if (pool.size() >= max_node_count)
+      throw std::length_error("compact_list: too many nodes for 32-bit index");
+    index_type i = static_cast<index_type>(pool.size());
+    pool.push_back(node(val, nil, nil));
+    return i;
+  }
+  // 立即析构元素，节点放回空闲链表
+  void delete_node(index_type i) {
+    pool[i].destroy_value();
+    pool[i].next = free_head;
+    free_head = i;
+  }
+  void ctor_aux(size_type n, const value_type &val, __true_type) {
+    pool.reserve(n);
+    for (; n > 0; --n)
+      push_back(val);
+  }
+  template<typename InputIterator>
+  void ctor_aux(InputIterator first, InputIterator last, __false_type) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+  void insert_aux(iterator position, size_type n, const value_type &val, __true_type) {
+    for (; n > 0; --n)
+      insert(position, val);
+  }
+  template<typename InputIterator>
+  void insert_aux(iterator position, InputIterator first, InputIterator last, __false_type) {
+    for (; first != last; ++first)
+      insert(position, *first);
+  }
+};
+
+template<typename T, typename Alloc>
+const typename compact_list<T, Alloc>::index_type compact_list<T, Alloc>::nil;
+
+}
+
+#endif //TINYSTL_SRC_COMPACT_LIST_H_
@@ -11,21 +11,27 @@ namespace TinySTL {
 // TODO: 寻找更优的解决方法
 namespace DequeAux {
 
+// 默认一个 node 字节数
 const int __bucket_bytes = 1024;
-/// 一个 buf 可以存几个元素
-inline size_t __bucket_cap(size_t element_size) {
-  // 默认一个 node 字节数
+/// 不超过 n 的最大的 2 的幂，n 为 0 时返回 1
+constexpr size_t __floor_pow2(size_t n) { return n <= 1 ? 1 : 2 * __floor_pow2(n / 2); }
+constexpr size_t __log2(size_t n) { return n <= 1 ? 0 : 1 + __log2(n / 2); }
+/// 一个 buf 可以存几个元素：编译期常量，向下取整为 2 的幂，这样下标运算只需要移位和掩码
+constexpr size_t __bucket_cap(size_t element_size, size_t bucket_bytes = __bucket_bytes) {
   // ok_TODO: 这里没有考虑element_size 为零的情况. C++ 规定 class 或 struct 的sizeof最小结果为1。
-  return __bucket_bytes > element_size ? __bucket_bytes / element_size : 1;
+  return bucket_bytes > element_size ? __floor_pow2(bucket_bytes / element_size) : 1;
 }
 const int __min_map_size = 8;
+// 最多缓存几个空闲的 bucket
+const int __max_spare_buckets = 4;
 }
 
-template<typename T, typename Ref, typename Ptr>
+template<typename T, typename Ref, typename Ptr, size_t BucketBytes = DequeAux::__bucket_bytes>
 class __deque_iterator {
  public:
-  // TODO: 待优化，这个函数会频繁调用，影响运行效率
-  static size_t bucket_cap() { return DequeAux::__bucket_cap(sizeof(T)); }
+  // 编译期常量，且是 2 的幂
+  static constexpr size_t bucket_cap() { return DequeAux::__bucket_cap(sizeof(T), BucketBytes); }
+  static constexpr size_t bucket_shift() { return DequeAux::__log2(bucket_cap()); }
 
   using iterator_category = random_iterator_tag;
   using value_type = T;
@@ -58,7 +64,8 @@ class __deque_iterator {
   difference_type operator-(const self_type &x) const {
     if (node == nullptr || x.node == nullptr)
       return 0;
-    return bucket_cap() * (node - x.node - 1) + (cur - first) + (x.last - x.cur);
+    // bucket_cap() 是 2 的幂，乘法会被编译成移位
+    return difference_type(bucket_cap()) * (node - x.node - 1) + (cur - first) + (x.last - x.cur);
   }
   self_type &operator++() {
     ++cur;
@@ -89,15 +96,16 @@ class __deque_iterator {
   self_type &operator+=(difference_type n) {
     if (n == 0) return *this;
     difference_type offset = n + (cur - first);
-    if (offset >= 0 && offset < bucket_cap())
+    if (offset >= 0 && offset < difference_type(bucket_cap()))
       cur += n;
-    else {
-      difference_type node_offset =
-          offset > 0 ?
-          offset / bucket_cap() :
-          -difference_type((-offset - 1) / bucket_cap()) - 1;
+    else if (offset > 0) {
+      set_node(node + (offset >> bucket_shift()));
+      cur = first + (offset & (bucket_cap() - 1));
+    } else {
+      // 负数不依赖算术右移，先取反再移位
+      difference_type node_offset = -difference_type((-offset - 1) >> bucket_shift()) - 1;
       set_node(node + node_offset);
-      cur = first + (offset - node_offset * bucket_cap());
+      cur = first + (offset - node_offset * difference_type(bucket_cap()));
     }
     return *this;
   }
@@ -119,12 +127,37 @@ class __deque_iterator {
     return (x.node == y.node) ? (x.cur < y.cur) : (x.node < y.node);
   }
 
-  template<typename>
+  template<typename, size_t>
   friend
   class deque;
+  friend struct __segmented_iterator_traits<__deque_iterator>;
+};
+
+// 每个 bucket 是一段连续内存，copy、fill、equal 等算法可以逐个 bucket 处理
+template<typename T, typename Ref, typename Ptr, size_t BucketBytes>
+struct __segmented_iterator_traits<__deque_iterator<T, Ref, Ptr, BucketBytes>> {
+  typedef __true_type is_segmented_iterator;
+  using iterator = __deque_iterator<T, Ref, Ptr, BucketBytes>;
+  using segment_iterator = typename iterator::map_pointer;
+  using local_iterator = Ptr;
+
+  static segment_iterator segment(const iterator &it) { return it.node; }
+  static local_iterator local(const iterator &it) { return it.cur; }
+  static local_iterator begin(segment_iterator seg) { return *seg; }
+  static local_iterator end(segment_iterator seg) { return *seg + iterator::bucket_cap(); }
+  // 落在 bucket 末尾时规范化为下一个 bucket 的开头，与 operator++ 保持一致。
+  // deque 保证 finish.cur 不会落在 bucket 末尾，所以此时下一个 bucket 一定存在。
+  static iterator compose(segment_iterator seg, local_iterator local) {
+    if (local == end(seg)) {
+      ++seg;
+      local = begin(seg);
+    }
+    return iterator(begin(seg), end(seg), local, seg);
+  }
 };
 
-template<typename T>
+// BucketBytes：单个 bucket 的字节数上限，实际容纳的元素个数向下取整为 2 的幂
+template<typename T, size_t BucketBytes = DequeAux::__bucket_bytes>
 class deque {
  public:
   using value_type = T;
@@ -132,9 +165,10 @@ class deque {
   using const_pointer = const T *;
   using reference = T &;
   using const_reference = const T &;
-  using iterator = __deque_iterator<T, T &, T *>;
-  using const_iterator = __deque_iterator<T, const T &, const T *>;
+  using iterator = __deque_iterator<T, T &, T *, BucketBytes>;
+  using const_iterator = __deque_iterator<T, const T &, const T *, BucketBytes>;
   using size_type = size_t;
+  using difference_type = ptrdiff_t;
 
  protected:
   using map_pointer = pointer *;
@@ -146,8 +180,9 @@ class deque {
   iterator finish;
   map_pointer map;
   size_type map_size;
-  // 单个 bucket 能包含多少个元素
-  size_t bucket_cap;
+  // 缓存 pop 时释放的 bucket，供之后 push 时复用。队列式的使用（一端进一端出）在稳定状态下不再申请、归还空间
+  pointer spare_buckets[DequeAux::__max_spare_buckets] = {};
+  size_type spare_count = 0;
 
  public:
   /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
@@ -156,7 +191,7 @@ class deque {
   deque(int n, const value_type &val) {
     init_allocate(n);
     for (auto cur = start.node; cur < finish.node; ++cur)
-      TinySTL::uninitialized_fill(*cur, *cur + bucket_cap, val);
+      TinySTL::uninitialized_fill(*cur, *cur + bucket_cap(), val);
     TinySTL::uninitialized_fill(finish.first, finish.cur, val);
   }
   template<typename InputIterator>
@@ -174,6 +209,7 @@ class deque {
     for (auto cur = start.node; cur != finish.node; ++cur)
       delete_node(*cur);
     delete_node(*(finish.node));
+    release_spare_buckets();
     map_allocator::deallocate(map);
   }
   // oK_TODO：可能需要改, 采用 copy-and-swap idiom
@@ -188,14 +224,21 @@ class deque {
 
   const_iterator begin() const { return to_const_iterator(start); }
   const_iterator end() const { return to_const_iterator(finish); }
-  const_reference operator[](size_type n) const { return *(begin() + n); }
+  const_reference operator[](size_type n) const {
+    size_type offset = n + (start.cur - start.first);
+    return start.node[offset >> iterator::bucket_shift()][offset & (bucket_cap() - 1)];
+  }
   const_reference front() const { return *begin(); }
   const_reference back() const { return *(end() - 1); }
 
   /*************** public 成员函数 ************/
   iterator begin() { return start; }
   iterator end() { return finish; }
-  reference operator[](size_type n) { return *(begin() + n); }
+  // 相对 start 所在 bucket 开头的偏移，用移位和掩码定位，不经过 begin() + n
+  reference operator[](size_type n) {
+    size_type offset = n + (start.cur - start.first);
+    return start.node[offset >> iterator::bucket_shift()][offset & (bucket_cap() - 1)];
+  }
   reference front() { return *begin(); }
   reference back() { return *(end() - 1); }
 
@@ -239,7 +282,7 @@ class deque {
   // clear 的策略是保留一个缓冲区
   void clear() {
     for (auto cur = start.node + 1; cur < finish.node; ++cur) {
-      node_allocator::destroy(*cur, (*cur) + bucket_cap);
+      node_allocator::destroy(*cur, (*cur) + bucket_cap());
       delete_node(*cur);
     }
     if (start.node != finish.node) {
@@ -254,42 +297,112 @@ class deque {
     finish = start;
   }
 
-  // 偷懒不写了
-//  void insert();
-//  void erase();
+  // 归还缓存的空闲 bucket
+  void shrink_to_fit() { release_spare_buckets(); }
+
+  // 插入、删除时只移动 position 前后较短的一侧；trivial 类型的移动走 copy 的逐 bucket memmove
+  iterator insert(iterator position, const value_type &val) {
+    if (position.cur == start.cur) {
+      push_front(val);
+      return start;
+    } else if (position.cur == finish.cur) {
+      push_back(val);
+      return finish - 1;
+    }
+    return insert_aux(position, val);
+  }
+  void insert(iterator position, size_type n, const value_type &val) {
+    typedef typename __type_traits<size_type>::is_integer is_integer;
+    insert_aux(position, n, val, is_integer());
+  }
+  template<typename InputIterator>
+  void insert(iterator position, InputIterator first, InputIterator last) {
+    typedef typename __type_traits<InputIterator>::is_integer is_integer;
+    insert_aux(position, first, last, is_integer());
+  }
+
+  iterator erase(iterator position) {
+    iterator next = position + 1;
+    difference_type index = position - start;
+    if (size_type(index) < size() / 2) {
+      TinySTL::copy_backward(start, position, next);
+      pop_front();
+    } else {
+      TinySTL::copy(next, finish, position);
+      pop_back();
+    }
+    return start + index;
+  }
+  iterator erase(iterator first, iterator last) {
+    if (first == start && last == finish) {
+      clear();
+      return finish;
+    }
+    difference_type n = last - first;
+    difference_type elems_before = first - start;
+    if (size_type(elems_before) < (size() - n) / 2) {
+      // 前面的元素较少，整体后移
+      TinySTL::copy_backward(start, first, last);
+      iterator new_start = start + n;
+      node_allocator::destroy(start, new_start);
+      for (auto cur = start.node; cur < new_start.node; ++cur)
+        delete_node(*cur);
+      start = new_start;
+    } else {
+      // 后面的元素较少，整体前移
+      TinySTL::copy(last, finish, first);
+      iterator new_finish = finish - n;
+      node_allocator::destroy(new_finish, finish);
+      for (auto cur = new_finish.node + 1; cur <= finish.node; ++cur)
+        delete_node(*cur);
+      finish = new_finish;
+    }
+    return start + elems_before;
+  }
  public:
   /*************** 我的朋友 ************/
   friend void swap(deque &x, deque &y) {
-    // ADL
-    using TinySTL::swap;
-    swap(x.start, y.start);
-    swap(x.finish, y.finish);
-    swap(x.map, y.map);
-    swap(x.map_size, y.map_size);
-    swap(x.bucket_cap, y.bucket_cap);
+    // 限定名调用，避免 T 来自 std 时 ADL 找到 std::swap 产生歧义
+    TinySTL::swap(x.start, y.start);
+    TinySTL::swap(x.finish, y.finish);
+    TinySTL::swap(x.map, y.map);
+    TinySTL::swap(x.map_size, y.map_size);
+    // 只交换用到的槽位
+    for (size_type i = 0, n = TinySTL::max(x.spare_count, y.spare_count); i != n; ++i)
+      TinySTL::swap(x.spare_buckets[i], y.spare_buckets[i]);
+    TinySTL::swap(x.spare_count, y.spare_count);
   }
   friend bool operator==(const deque &x, const deque &y) {
-    auto b1 = x.begin(), b2 = y.begin();
-    auto e1 = x.end(), e2 = y.end();
-    for (; b1 != e1 && b2 != e2; ++b1, ++b2) {
-      if (*b1 != *b2)
-        return false;
-    }
-    return b1 == e1 && b2 == e2;
+    // size() 是 O(1) 的，之后逐个 bucket 比较
+    return x.size() == y.size() && TinySTL::equal(x.begin(), x.end(), y.begin());
   }
   friend bool operator!=(const deque &x, const deque &y) { return !(x == y); }
 
   /*************** 辅助函数 ************/
  protected:
-  // 仅申请空间，不做构造
-  pointer new_node() { return node_allocator::allocate(bucket_cap); }
-  // 仅归还空间，不做析构
-  void delete_node(pointer p) { node_allocator::deallocate(p, bucket_cap); }
+  // 单个 bucket 能包含多少个元素
+  static constexpr size_type bucket_cap() { return iterator::bucket_cap(); }
+  // 仅申请空间，不做构造。优先使用缓存的 bucket
+  pointer new_node() {
+    if (spare_count != 0)
+      return spare_buckets[--spare_count];
+    return node_allocator::allocate(bucket_cap());
+  }
+  // 仅归还空间，不做析构。缓存未满时先留着
+  void delete_node(pointer p) {
+    if (spare_count != DequeAux::__max_spare_buckets)
+      spare_buckets[spare_count++] = p;
+    else
+      node_allocator::deallocate(p, bucket_cap());
+  }
+  void release_spare_buckets() {
+    for (; spare_count != 0; --spare_count)
+      node_allocator::deallocate(spare_buckets[spare_count - 1], bucket_cap());
+  }
   // 本函数仅做初始化用途
   void init_allocate(size_type num_elements) {
-    this->bucket_cap = DequeAux::__bucket_cap(sizeof(value_type));
     // 实际需要的节点个数
-    size_type num_nodes = num_elements / bucket_cap + 1;
+    size_type num_nodes = num_elements / bucket_cap() + 1;
     // 实际需要 + 预留
     this->map_size = max(DequeAux::__min_map_size, int(num_nodes + 2));
 
@@ -305,7 +418,7 @@ class deque {
     start.set_node(new_start);
     finish.set_node(new_finish);
     start.cur = start.first;
-    finish.cur = finish.first + num_elements % bucket_cap;
+    finish.cur = finish.first + num_elements % bucket_cap();
   }
   void push_back_aux(const value_type &val) {
     reserve_map_at_back();
@@ -355,6 +468,171 @@ class deque {
     start.node = new_start;
     finish.node = new_start + old_num_nodes - 1;
   }
+  // 在 start 之前预留 n 个元素的空间，返回新的 start（此时还未构造）
+  iterator reserve_elements_at_front(size_type n) {
+    size_type vacancies = start.cur - start.first;
+    if (n > vacancies)
+      new_elements_at_front(n - vacancies);
+    return start - difference_type(n);
+  }
+  // 在 finish 之后预留 n 个元素的空间，返回新的 finish（此时还未构造）。注意 finish.cur 不能落在 bucket 末尾
+  iterator reserve_elements_at_back(size_type n) {
+    size_type vacancies = (finish.last - finish.cur) - 1;
+    if (n > vacancies)
+      new_elements_at_back(n - vacancies);
+    return finish + difference_type(n);
+  }
+  // 一次性预留 map 的空间，再逐个申请 bucket
+  void new_elements_at_front(size_type new_elements) {
+    size_type new_nodes = (new_elements + bucket_cap() - 1) / bucket_cap();
+    reserve_map_at_front(new_nodes);
+    for (size_type i = 1; i <= new_nodes; ++i)
+      *(start.node - i) = new_node();
+  }
+  void new_elements_at_back(size_type new_elements) {
+    size_type new_nodes = (new_elements + bucket_cap() - 1) / bucket_cap();
+    reserve_map_at_back(new_nodes);
+    for (size_type i = 1; i <= new_nodes; ++i)
+      *(finish.node + i) = new_node();
+  }
+  iterator insert_aux(iterator position, const value_type &val) {
+    difference_type index = position - start;
+    value_type val_copy = val;
+    if (size_type(index) < size() / 2) {
+      // 复制一份 front 放到最前面，再把 [start + 1, position) 前移一格
+      push_front(front());
+      iterator front1 = start + 1;
+      iterator front2 = front1 + 1;
+      position = start + index;
+      TinySTL::copy(front2, position + 1, front1);
+    } else {
+      // 复制一份 back 放到最后面，再把 [position, finish - 1) 后移一格
+      push_back(back());
+      iterator back1 = finish - 1;
+      iterator back2 = back1 - 1;
+      position = start + index;
+      TinySTL::copy_backward(position, back2, back1);
+    }
+    *position = val_copy;
+    return position;
+  }
+  template<typename Integer>
+  void insert_aux(iterator position, Integer n, const value_type &val, __true_type) {
+    fill_insert(position, size_type(n), val);
+  }
+  template<typename InputIterator>
+  void insert_aux(iterator position, InputIterator first, InputIterator last, __false_type) {
+    range_insert(position, first, last, size_type(TinySTL::distance(first, last)));
+  }
+  void fill_insert(iterator position, size_type n, const value_type &val) {
+    if (n == 0)
+      return;
+    if (position.cur == start.cur) {
+      iterator new_start = reserve_elements_at_front(n);
+      TinySTL::uninitialized_fill(new_start, start, val);
+      start = new_start;
+      return;
+    } else if (position.cur == finish.cur) {
+      iterator new_finish = reserve_elements_at_back(n);
+      TinySTL::uninitialized_fill(finish, new_finish, val);
+      finish = new_finish;
+      return;
+    }
+    difference_type elems_before = position - start;
+    size_type length = size();
+    value_type val_copy = val;
+    if (size_type(elems_before) < length / 2) {
+      iterator new_start = reserve_elements_at_front(n);
+      iterator old_start = start;
+      // map 可能重新分配过，position 要重新计算
+      position = start + elems_before;
+      if (size_type(elems_before) >= n) {
+        iterator start_n = start + difference_type(n);
+        TinySTL::uninitialized_copy(start, start_n, new_start);
+        start = new_start;
+        TinySTL::copy(start_n, position, old_start);
+        TinySTL::fill(position - difference_type(n), position, val_copy);
+      } else {
+        iterator mid = TinySTL::uninitialized_copy(start, position, new_start);
+        TinySTL::uninitialized_fill(mid, start, val_copy);
+        start = new_start;
+        TinySTL::fill(old_start, position, val_copy);
+      }
+    } else {
+      iterator new_finish = reserve_elements_at_back(n);
+      iterator old_finish = finish;
+      difference_type elems_after = difference_type(length) - elems_before;
+      position = finish - elems_after;
+      if (size_type(elems_after) > n) {
+        iterator finish_n = finish - difference_type(n);
+        TinySTL::uninitialized_copy(finish_n, finish, finish);
+        finish = new_finish;
+        TinySTL::copy_backward(position, finish_n, old_finish);
+        TinySTL::fill(position, position + difference_type(n), val_copy);
+      } else {
+        TinySTL::uninitialized_fill(finish, position + difference_type(n), val_copy);
+        TinySTL::uninitialized_copy(position, finish, position + difference_type(n));
+        finish = new_finish;
+        TinySTL::fill(position, old_finish, val_copy);
+      }
+    }
+  }
+  template<typename InputIterator>
+  void range_insert(iterator position, InputIterator first, InputIterator last, size_type n) {
+    if (n == 0)
+      return;
+    if (position.cur == start.cur) {
+      iterator new_start = reserve_elements_at_front(n);
+      TinySTL::uninitialized_copy(first, last, new_start);
+      start = new_start;
+      return;
+    } else if (position.cur == finish.cur) {
+      iterator new_finish = reserve_elements_at_back(n);
+      TinySTL::uninitialized_copy(first, last, finish);
+      finish = new_finish;
+      return;
+    }
+    difference_type elems_before = position - start;
+    size_type length = size();
+    if (size_type(elems_before) < length / 2) {
+      iterator new_start = reserve_elements_at_front(n);
+      iterator old_start = start;
+      position = start + elems_before;
+      if (size_type(elems_before) >= n) {
+        iterator start_n = start + difference_type(n);
+        TinySTL::uninitialized_copy(start, start_n, new_start);
+        start = new_start;
+        TinySTL::copy(start_n, position, old_start);
+        TinySTL::copy(first, last, position - difference_type(n));
+      } else {
+        InputIterator mid = first;
+        TinySTL::advance(mid, difference_type(n) - elems_before);
+        iterator res = TinySTL::uninitialized_copy(start, position, new_start);
+        TinySTL::uninitialized_copy(first, mid, res);
+        start = new_start;
+        TinySTL::copy(mid, last, old_start);
+      }
+    } else {
+      iterator new_finish = reserve_elements_at_back(n);
+      iterator old_finish = finish;
+      difference_type elems_after = difference_type(length) - elems_before;
+      position = finish - elems_after;
+      if (size_type(elems_after) > n) {
+        iterator finish_n = finish - difference_type(n);
+        TinySTL::uninitialized_copy(finish_n, finish, finish);
+        finish = new_finish;
+        TinySTL::copy_backward(position, finish_n, old_finish);
+        TinySTL::copy(first, last, position);
+      } else {
+        InputIterator mid = first;
+        TinySTL::advance(mid, elems_after);
+        iterator res = TinySTL::uninitialized_copy(mid, last, finish);
+        TinySTL::uninitialized_copy(position, finish, res);
+        finish = new_finish;
+        TinySTL::copy(first, mid, position);
+      }
+    }
+  }
   const_iterator to_const_iterator(iterator it) const { return const_iterator(it.first, it.last, it.cur, it.node); }
 };
 
@@ -0,0 +1,66 @@
+#ifndef TINYSTL_SRC_EXECUTION_H_
+#define TINYSTL_SRC_EXECUTION_H_
+
+/**
+ * 执行策略，作为 parallel_algorithm.h 中算法的第一个参数：
+ *  - seq：在调用线程上串行执行，等同于不带策略的版本；
+ *  - par：分块后交给 scheduler 的线程池并行执行；
+ *  - par_unseq：允许并行且允许向量化，目前与 par 相同（块内调用的串行算法本身交给编译器向量化）；
+ *  - first_touch：用于初始化大块新内存（uninitialized_fill、uninitialized_fill_n，vector_parallel.h 的 make_vector 和 resize）。
+ *    按工作线程数静态均分、以页为边界切块（__first_touch_boundary），第 i 块由第 i 个工作线程写入（on_each_worker）。
+ *    Linux 在第一次写入时才为页分配物理内存，并放在写入线程所在的 NUMA 节点上；工作线程绑定了 CPU 时（见 scheduler.h），
+ *    之后用 on_each_worker 按同样的划分扫描，每个线程访问的就是本地内存。没有绑定时只保证划分一致，不保证节点一致。
+ *    只有一个 NUMA 节点时与 par 相同。其他算法中视同 par。
+ */
+
+#include "type_traits.h"
+
+namespace TinySTL {
+namespace execution {
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+const sequenced_policy seq{};
+const parallel_policy par{};
+const parallel_unsequenced_policy par_unseq{};
+
+struct first_touch_policy {};
+const first_touch_policy first_touch{};
+
+}
+
+template<typename T>
+struct __is_execution_policy {
+  static const bool value = false;
+};
+template<>
+struct __is_execution_policy<execution::sequenced_policy> {
+  static const bool value = true;
+};
+template<>
+struct __is_execution_policy<execution::parallel_policy> {
+  static const bool value = true;
+};
+template<>
+struct __is_execution_policy<execution::parallel_unsequenced_policy> {
+  static const bool value = true;
+};
+template<>
+struct __is_execution_policy<execution::first_touch_policy> {
+  static const bool value = true;
+};
+
+template<typename ExecutionPolicy, typename T = void>
+using __enable_if_policy = typename __enable_if<__is_execution_policy<ExecutionPolicy>::value, T>::type;
+
+// 策略是否允许并行
+inline __false_type __allow_parallel(const execution::sequenced_policy &) { return __false_type(); }
+inline __true_type __allow_parallel(const execution::parallel_policy &) { return __true_type(); }
+inline __true_type __allow_parallel(const execution::parallel_unsequenced_policy &) { return __true_type(); }
+inline __true_type __allow_parallel(const execution::first_touch_policy &) { return __true_type(); }
+
+}
+
+#endif //TINYSTL_SRC_EXECUTION_H_
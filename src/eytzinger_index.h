@@ -0,0 +1,299 @@
+#ifndef TINYSTL_SRC_EYTZINGER_INDEX_H_
+#define TINYSTL_SRC_EYTZINGER_INDEX_H_
+
+/**
+ * 只读的有序 key 数组上的查找索引，一次构建、反复 lower_bound。
+ * 有序数组上的二分，前几次访问跳得很远，数组大于缓存后几乎每次都缺失，且下一次访问的地址要等这次比较完才知道。
+ * 这里换一种内存布局，让查找路径集中、可预取：
+ *
+ *  - eytzinger_index：按二叉树 BFS 顺序存放（下标从 1 开始，k 的孩子是 2k、2k+1）。
+ *    靠近根的几层挤在最前面的几个缓存行里，总是命中；k 往下第 log2(B) 层的子孙正好是连续的 B 个元素
+ *    （B = 一个缓存行能放下的元素个数），可以提前几层预取，把内存延迟和比较重叠起来。
+ *  - blocked_index：B+ 树式的分块布局，每个节点正好一个缓存行（B 个 key，B + 1 个孩子），孩子的位置靠计算得出。
+ *    每层只访问一个缓存行，树高是 log_{B+1}(n)，比二叉树少几倍；所有 key 在叶子层按顺序存放，结果就是排名。
+ *
+ * 两者都是 O(n) 从有序区间构建，查找无分支。lower_bound / upper_bound 返回的是在原有序区间中的下标，
+ * 找不到时返回 size()。
+ */
+
+#include <cstdint>
+
+#include "__alloc.h"
+#include "__concurrent.h"
+#include "__construct.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+namespace EytzingerAux {
+// 一个缓存行能放下的元素个数，至少 2
+template<typename T>
+struct __per_line {
+  static const size_t value = __cache_line_size / sizeof(T) >= 2 ? __cache_line_size / sizeof(T) : 2;
+};
+}
+
+/// 起始地址按缓存行对齐的定长数组，构建后不再改变大小
+template<typename T>
+class __cache_aligned_array {
+ protected:
+  void *raw;
+  size_t raw_bytes;
+  T *start;
+  size_t count;
+
+ public:
+  /**** 生命周期：copy-and-swap ****/
+  __cache_aligned_array() : raw(nullptr), raw_bytes(0), start(nullptr), count(0) {}
+  __cache_aligned_array(size_t n, const T &val) : __cache_aligned_array() {
+    if (n == 0)
+      return;
+    // 多申请一个缓存行，手动对齐
+    raw_bytes = sizeof(T) * n + __cache_line_size;
+    raw = __alloc::allocate(raw_bytes);
+    size_t addr = reinterpret_cast<size_t>(raw);
+    addr = (addr + __cache_line_size - 1) & ~(__cache_line_size - 1);
+    start = reinterpret_cast<T *>(addr);
+    // 委托构造已经完成，这里抛出异常时会调用析构函数，销毁已构造的 count 个元素并释放内存
+    for (; count != n; ++count)
+      __construct::construct(start + count, val);
+  }
+  __cache_aligned_array(const __cache_aligned_array &x) : __cache_aligned_array() {
+    if (x.count == 0)
+      return;
+    __cache_aligned_array tmp(x.count, x[0]);
+    for (size_t i = 1; i != x.count; ++i)
+      tmp[i] = x[i];
+    swap(*this, tmp);
+  }
+  __cache_aligned_array(__cache_aligned_array &&x) noexcept : __cache_aligned_array() { swap(*this, x); }
+  __cache_aligned_array &operator=(__cache_aligned_array x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~__cache_aligned_array() {
+    for (size_t i = 0; i != count; ++i)
+      __construct::destroy(start + i);
+    if (raw != nullptr)
+      __alloc::deallocate(raw, raw_bytes);
+  }
+
+  size_t size() const { return count; }
+  T *data() { return start; }
+  const T *data() const { return start; }
+  T &operator[](size_t i) { return start[i]; }
+  const T &operator[](size_t i) const { return start[i]; }
+
+  friend void swap(__cache_aligned_array &x, __cache_aligned_array &y) {
+    TinySTL::swap(x.raw, y.raw);
+    TinySTL::swap(x.raw_bytes, y.raw_bytes);
+    TinySTL::swap(x.start, y.start);
+    TinySTL::swap(x.count, y.count);
+  }
+};
+
+template<typename T, typename Compare = less<T>>
+class eytzinger_index {
+ public:
+  using value_type = T;
+  using key_compare = Compare;
+  using size_type = size_t;
+
+ protected:
+  // 每次预取往下跳的层数对应的宽度：k 往下 log2(B) 层的子孙是 [k * B, k * B + B)
+  static const size_type prefetch_stride = EytzingerAux::__per_line<T>::value;
+  // keys[k] 是 BFS 顺序的第 k 个节点，keys[0] 不用
+  __cache_aligned_array<T> keys;
+  // ranks[k] 是 keys[k] 在原有序区间中的下标，ranks[0] = n 表示找不到
+  vector<size_type> ranks;
+  size_type n;
+  key_compare comp;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit eytzinger_index(const key_compare &c = key_compare()) : n(0), comp(c) {}
+  /// [first, last) 必须已按 c 排好序
+  template<typename ForwardIterator>
+  eytzinger_index(ForwardIterator first, ForwardIterator last, const key_compare &c = key_compare())
+      : n(TinySTL::distance(first, last)), comp(c) {
+    if (n == 0)
+      return;
+    keys = __cache_aligned_array<T>(n + 1, *first);
+    ranks.resize(n + 1, n);
+    size_type rank = 0;
+    build(first, rank, 1);
+  }
+  explicit eytzinger_index(const vector<T> &sorted, const key_compare &c = key_compare())
+      : eytzinger_index(sorted.begin(), sorted.end(), c) {}
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return n; }
+  bool empty() const { return n == 0; }
+  key_compare key_comp() const { return comp; }
+
+  /// 第一个不小于 key 的元素的下标
+  size_type lower_bound(const T &key) const { return ranks_at(lower_slot(key)); }
+  /// 第一个大于 key 的元素的下标
+  size_type upper_bound(const T &key) const {
+    const T *a = keys.data();
+    size_type k = 1;
+    while (k <= n) {
+      __prefetch(reinterpret_cast<uintptr_t>(a) + k * prefetch_stride * sizeof(T));
+      k = 2 * k + !comp(key, a[k]);
+    }
+    return ranks_at(k >> __builtin_ffsll(static_cast<long long>(~k)));
+  }
+  bool contains(const T &key) const {
+    size_type k = lower_slot(key);
+    return k != 0 && !comp(key, keys[k]);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  /**
+   * 比较结果决定往左（2k）还是往右（2k + 1），没有分支。走出树时 k 的二进制是 "路径 + 一串 1 + 一个 0"：
+   * 最后一次往左（0）的那个节点就是答案，去掉末尾的 1 和那个 0 即可；一直往右（全是 1）时结果为 0，表示找不到。
+   */
+  size_type lower_slot(const T &key) const {
+    const T *a = keys.data();
+    size_type k = 1;
+    while (k <= n) {
+      __prefetch(reinterpret_cast<uintptr_t>(a) + k * prefetch_stride * sizeof(T));
+      k = 2 * k + comp(a[k], key);
+    }
+    return k >> __builtin_ffsll(static_cast<long long>(~k));
+  }
+  size_type ranks_at(size_type k) const { return n == 0 ? 0 : ranks[k]; }
+  // 中序遍历 BFS 树，依次填入有序元素，O(n)
+  template<typename ForwardIterator>
+  ForwardIterator build(ForwardIterator it, size_type &rank, size_type k) {
+    if (k <= n) {
+      it = build(it, rank, 2 * k);
+      keys[k] = *it;
+      ranks[k] = rank++;
+      ++it;
+      it = build(it, rank, 2 * k + 1);
+    }
+    return it;
+  }
+};
+
+/**
+ * 层从叶子往上编号，第 0 层是叶子。每层的节点依次存放，节点 k 的第 i 个孩子是下一层的节点 k * (B + 1) + i。
+ * 叶子层就是原有序数组，末尾用最后一个元素补满一个节点；内部节点的第 i 个 key 是第 i + 1 个孩子子树中最小的 key，
+ * 不存在的孩子也用最后一个元素代替。
+ * 查找时在每个节点里数出小于 key 的个数 i（节点内有序，i 就是该走的孩子），到叶子时 k * B + i 就是结果。
+ * 补位的元素会让 i 偏大，走到不存在的孩子时收回到本层最后一个节点，结果超过 n 时收回到 n。
+ */
+template<typename T, typename Compare = less<T>, size_t B = EytzingerAux::__per_line<T>::value>
+class blocked_index {
+ public:
+  using value_type = T;
+  using key_compare = Compare;
+  using size_type = size_t;
+  static const size_type block_size = B;
+
+ protected:
+  // 所有层连续存放，根在最前面
+  __cache_aligned_array<T> keys;
+  // layer_offset[h] 是第 h 层的第一个元素在 keys 中的下标，layer_blocks[h] 是第 h 层的节点数
+  vector<size_type> layer_offset;
+  vector<size_type> layer_blocks;
+  size_type n;
+  key_compare comp;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit blocked_index(const key_compare &c = key_compare()) : n(0), comp(c) {}
+  /// [first, last) 必须已按 c 排好序
+  template<typename ForwardIterator>
+  blocked_index(ForwardIterator first, ForwardIterator last, const key_compare &c = key_compare())
+      : n(TinySTL::distance(first, last)), comp(c) {
+    if (n != 0)
+      build(first);
+  }
+  explicit blocked_index(const vector<T> &sorted, const key_compare &c = key_compare())
+      : blocked_index(sorted.begin(), sorted.end(), c) {}
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return n; }
+  bool empty() const { return n == 0; }
+  key_compare key_comp() const { return comp; }
+  size_type height() const { return layer_blocks.size(); }
+
+  /// 第一个不小于 key 的元素的下标
+  size_type lower_bound(const T &key) const {
+    return search(key, [this](const T &elem, const T &k) { return comp(elem, k); });
+  }
+  /// 第一个大于 key 的元素的下标
+  size_type upper_bound(const T &key) const {
+    return search(key, [this](const T &elem, const T &k) { return !comp(k, elem); });
+  }
+  bool contains(const T &key) const {
+    size_type i = lower_bound(key);
+    return i != n && !comp(key, keys[layer_offset[0] + i]);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  // before(elem, key) 为真表示结果在 elem 之后
+  template<typename Before>
+  size_type search(const T &key, Before before) const {
+    if (n == 0)
+      return 0;
+    const T *a = keys.data();
+    size_type k = 0;
+    for (size_type h = layer_blocks.size() - 1; h != 0; --h) {
+      const T *node = a + layer_offset[h] + k * B;
+      size_type i = 0;
+      for (size_type j = 0; j != B; ++j)
+        i += before(node[j], key);
+      k = k * (B + 1) + i;
+      k = k < layer_blocks[h - 1] ? k : layer_blocks[h - 1] - 1;
+    }
+    const T *leaf = a + layer_offset[0] + k * B;
+    size_type i = 0;
+    for (size_type j = 0; j != B; ++j)
+      i += before(leaf[j], key);
+    size_type res = k * B + i;
+    return res < n ? res : n;
+  }
+  template<typename ForwardIterator>
+  void build(ForwardIterator first) {
+    layer_blocks.push_back((n + B - 1) / B);
+    while (layer_blocks.back() > 1)
+      layer_blocks.push_back((layer_blocks.back() + B) / (B + 1));
+    size_type total = 0;
+    layer_offset.resize(layer_blocks.size(), 0);
+    for (size_type h = layer_blocks.size(); h-- != 0;) {
+      layer_offset[h] = total;
+      total += layer_blocks[h] * B;
+    }
+    keys = __cache_aligned_array<T>(total, *first);
+    // 叶子层：原有序数组，末尾补最后一个元素
+    T *leaf = keys.data() + layer_offset[0];
+    for (size_type i = 0; i != n; ++i, ++first)
+      leaf[i] = *first;
+    for (size_type i = n; i != layer_blocks[0] * B; ++i)
+      leaf[i] = leaf[n - 1];
+    // 内部层：第 h 层节点 k 的第 i 个 key 是第 h - 1 层节点 k * (B + 1) + i + 1 的子树的最左叶子元素
+    size_type span = 1;  // 第 h - 1 层的一个节点下面有几个叶子节点的跨度，(B + 1)^(h - 1)
+    for (size_type h = 1; h != layer_blocks.size(); ++h) {
+      T *node = keys.data() + layer_offset[h];
+      for (size_type k = 0; k != layer_blocks[h]; ++k) {
+        for (size_type i = 0; i != B; ++i) {
+          size_type pos = (k * (B + 1) + i + 1) * span * B;
+          node[k * B + i] = pos < n ? leaf[pos] : leaf[n - 1];
+        }
+      }
+      span *= B + 1;
+    }
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_EYTZINGER_INDEX_H_
@@ -0,0 +1,337 @@
+#ifndef TINYSTL_SRC_FLAT_MAP_H_
+#define TINYSTL_SRC_FLAT_MAP_H_
+
+/**
+ * 有序数组实现的 map：key 和 value 分别存放在两个按 key 排序的 vector 中。
+ * 适合读多写少的查找表（配置、路由、符号表）：
+ *  - 查找是对 key 数组的无分支二分（见 algorithm.h 的 lower_bound），只访问 key，不会把 value 拉进缓存；
+ *  - 只扫描 key 时（keys()）是连续内存的顺序访问；
+ *  - 没有节点，没有指针，内存占用就是 key、value 本身。
+ *
+ * 单个插入、删除是 O(n) 的（移动后面的元素）。批量插入 insert(first, last) 先把新元素追加到末尾，
+ * 只对新元素排序、去重，再从后往前和原有元素原地归并，总共 O(n + m log m)，而不是 m 次 O(n) 的插入。
+ * 批量插入中途抛出异常时，容器恢复原样。
+ *
+ * 迭代器是随机访问迭代器，解引用得到 pair<const Key &, T &>，不是 value_type 的引用。
+ * 插入、删除后所有迭代器都会失效。
+ */
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "algorithm.h"
+#include "functional.h"
+#include "iterator.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+/// 同时指向 key 数组和 value 数组中相同下标的迭代器
+template<typename Key, typename Mapped>
+struct __flat_map_iterator {
+  typedef random_iterator_tag iterator_category;
+  typedef pair<Key, Mapped> value_type;
+  typedef ptrdiff_t difference_type;
+  typedef pair<const Key &, Mapped &> reference;
+  // operator-> 返回的临时对象
+  struct pointer {
+    reference ref;
+    const reference *operator->() const { return &ref; }
+  };
+
+  const Key *key;
+  Mapped *val;
+
+  __flat_map_iterator() : key(nullptr), val(nullptr) {}
+  __flat_map_iterator(const Key *k, Mapped *v) : key(k), val(v) {}
+  // iterator 可以转换为 const_iterator，反过来则编译不过
+  template<typename M>
+  __flat_map_iterator(const __flat_map_iterator<Key, M> &it) : key(it.key), val(it.val) {}
+
+  reference operator*() const { return reference(*key, *val); }
+  pointer operator->() const { return pointer{**this}; }
+  reference operator[](difference_type n) const { return reference(key[n], val[n]); }
+  __flat_map_iterator &operator++() {
+    ++key;
+    ++val;
+    return *this;
+  }
+  __flat_map_iterator &operator--() {
+    --key;
+    --val;
+    return *this;
+  }
+  __flat_map_iterator operator++(int) {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  __flat_map_iterator operator--(int) {
+    auto tmp = *this;
+    --*this;
+    return tmp;
+  }
+  __flat_map_iterator &operator+=(difference_type n) {
+    key += n;
+    val += n;
+    return *this;
+  }
+  __flat_map_iterator &operator-=(difference_type n) { return *this += -n; }
+  friend __flat_map_iterator operator+(__flat_map_iterator it, difference_type n) { return it += n; }
+  friend __flat_map_iterator operator+(difference_type n, __flat_map_iterator it) { return it += n; }
+  friend __flat_map_iterator operator-(__flat_map_iterator it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const __flat_map_iterator &x, const __flat_map_iterator &y) {
+    return x.key - y.key;
+  }
+  friend bool operator==(const __flat_map_iterator &x, const __flat_map_iterator &y) { return x.key == y.key; }
+  friend bool operator!=(const __flat_map_iterator &x, const __flat_map_iterator &y) { return x.key != y.key; }
+  friend bool operator<(const __flat_map_iterator &x, const __flat_map_iterator &y) { return x.key < y.key; }
+};
+
+template<typename Key, typename T, typename Compare = less<Key>>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = pair<Key, T>;
+  using key_compare = Compare;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using iterator = __flat_map_iterator<Key, T>;
+  using const_iterator = __flat_map_iterator<Key, const T>;
+  using key_container_type = vector<Key>;
+  using mapped_container_type = vector<T>;
+
+ protected:
+  // 比较函数通常是空类，和 key 数组放在一起，由 EBO 省掉它的空间
+  __compressed_pair<key_container_type, key_compare> keys_rep;
+  mapped_container_type mapped_vec;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit flat_map(const key_compare &c = key_compare()) : keys_rep(key_container_type(), c) {}
+  template<typename InputIterator>
+  flat_map(InputIterator first, InputIterator last, const key_compare &c = key_compare()) :
+      keys_rep(key_container_type(), c) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return key_vec().size(); }
+  bool empty() const { return key_vec().empty(); }
+  size_type capacity() const { return key_vec().capacity(); }
+  key_compare key_comp() const { return comp(); }
+  /// 有序的 key 数组，只需要 key 时直接扫描它
+  const key_container_type &keys() const { return key_vec(); }
+  const mapped_container_type &values() const { return mapped_vec; }
+
+  const_iterator begin() const { return const_iterator(key_vec().begin(), mapped_vec.begin()); }
+  const_iterator end() const { return const_iterator(key_vec().end(), mapped_vec.end()); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_iterator lower_bound(const key_type &key) const { return begin() + lower_index(key); }
+  const_iterator upper_bound(const key_type &key) const {
+    return begin() + (TinySTL::upper_bound(key_vec().begin(), key_vec().end(), key, comp()) - key_vec().begin());
+  }
+  const_iterator find(const key_type &key) const { return begin() + find_index(key); }
+  size_type count(const key_type &key) const { return find_index(key) == size() ? 0 : 1; }
+  bool contains(const key_type &key) const { return find_index(key) != size(); }
+  const mapped_type &at(const key_type &key) const {
+    size_type i = find_index(key);
+    if (i == size())
+      throw std::out_of_range("flat_map::at");
+    return mapped_vec[i];
+  }
+
+  /*************** 访问元素 ************/
+  iterator begin() { return iterator(key_vec().begin(), mapped_vec.begin()); }
+  iterator end() { return iterator(key_vec().end(), mapped_vec.end()); }
+  iterator lower_bound(const key_type &key) { return begin() + lower_index(key); }
+  iterator upper_bound(const key_type &key) {
+    return begin() + (TinySTL::upper_bound(key_vec().begin(), key_vec().end(), key, comp()) - key_vec().begin());
+  }
+  iterator find(const key_type &key) { return begin() + find_index(key); }
+  mapped_type &at(const key_type &key) {
+    size_type i = find_index(key);
+    if (i == size())
+      throw std::out_of_range("flat_map::at");
+    return mapped_vec[i];
+  }
+  mapped_type &operator[](const key_type &key) {
+    size_type i = lower_index(key);
+    if (i == size() || comp()(key, key_vec()[i]))
+      insert_at(i, key, mapped_type());
+    return mapped_vec[i];
+  }
+
+  /*************** 插入删除 ************/
+  template<typename Pair>
+  pair<iterator, bool> insert(const Pair &val) {
+    size_type i = lower_index(val.first);
+    if (i != size() && !comp()(val.first, key_vec()[i]))
+      return pair<iterator, bool>(begin() + i, false);
+    insert_at(i, val.first, val.second);
+    return pair<iterator, bool>(begin() + i, true);
+  }
+  /// 批量插入：追加到末尾，只对新元素排序、去重，再原地归并。key 已存在的元素不插入
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    size_type n = size();
+    try {
+      for (; first != last; ++first) {
+        key_vec().push_back(first->first);
+        mapped_vec.push_back(first->second);
+      }
+      merge_tail(n);
+    } catch (...) {
+      truncate(n);
+      throw;
+    }
+  }
+  iterator erase(const_iterator pos) {
+    size_type i = pos.key - key_vec().begin();
+    key_vec().erase(key_vec().begin() + i);
+    mapped_vec.erase(mapped_vec.begin() + i);
+    return begin() + i;
+  }
+  size_type erase(const key_type &key) {
+    size_type i = find_index(key);
+    if (i == size())
+      return 0;
+    erase(begin() + i);
+    return 1;
+  }
+  void clear() {
+    key_vec().clear();
+    mapped_vec.clear();
+  }
+
+  /*************** 容量 ************/
+  void reserve(size_type n) {
+    key_vec().reserve(n);
+    mapped_vec.reserve(n);
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(flat_map &x, flat_map &y) {
+    swap(x.key_vec(), y.key_vec());
+    swap(x.mapped_vec, y.mapped_vec);
+    TinySTL::swap(x.comp(), y.comp());
+  }
+  friend bool operator==(const flat_map &x, const flat_map &y) {
+    return x.key_vec() == y.key_vec() && x.mapped_vec == y.mapped_vec;
+  }
+  friend bool operator!=(const flat_map &x, const flat_map &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  key_container_type &key_vec() { return keys_rep.first(); }
+  const key_container_type &key_vec() const { return keys_rep.first(); }
+  key_compare &comp() { return keys_rep.second(); }
+  const key_compare &comp() const { return keys_rep.second(); }
+  size_type lower_index(const key_type &key) const { return lower_index(key, size()); }
+  // 只在前 n 个元素中查找
+  size_type lower_index(const key_type &key, size_type n) const {
+    return TinySTL::lower_bound(key_vec().begin(), key_vec().begin() + n, key, comp()) - key_vec().begin();
+  }
+  // 不存在时返回 size()
+  size_type find_index(const key_type &key) const {
+    size_type i = lower_index(key);
+    return i != size() && !comp()(key, key_vec()[i]) ? i : size();
+  }
+  void insert_at(size_type i, const key_type &key, const mapped_type &val) {
+    key_vec().insert(key_vec().begin() + i, key);
+    try {
+      mapped_vec.insert(mapped_vec.begin() + i, val);
+    } catch (...) {
+      key_vec().erase(key_vec().begin() + i);
+      throw;
+    }
+  }
+  // 两个数组都截回 n 个元素，只析构末尾的元素，不会抛出异常
+  void truncate(size_type n) {
+    key_vec().erase(key_vec().begin() + n, key_vec().end());
+    mapped_vec.erase(mapped_vec.begin() + n, mapped_vec.end());
+  }
+  /**
+   * [0, n) 有序，[n, n + m) 是新追加的元素：
+   *  1. 对新元素的下标排序（key 相同时保持原顺序，保留先出现的）；
+   *  2. 按顺序去掉重复的、原来已有的 key，剩下的 k 个移动到末尾 [n + m, n + m + k)，
+   *     同时记下每个新元素在原有元素中的插入位置（order 的前 k 项）；
+   *  3. 从后往前把原有元素和新元素移动到最终位置 [0, n + k)，截掉多余的部分。
+   * 比较只发生在 1、2 两步，这时原有元素还没动，抛出异常时 insert 直接截回 n 个元素。
+   */
+  void merge_tail(size_type n) {
+    size_type m = size() - n;
+    if (m == 0)
+      return;
+    vector<size_type> order(m, 0);
+    for (size_type i = 0; i != m; ++i)
+      order[i] = i;
+    const Key *tail = key_vec().begin() + n;
+    const key_compare &c = comp();
+    TinySTL::sort(order.begin(), order.end(), [tail, &c](size_type a, size_type b) {
+      return c(tail[a], tail[b]) || (!c(tail[b], tail[a]) && a < b);
+    });
+    // 预留空间，下面的 push_back 不会扩容
+    reserve(n + 2 * m);
+    size_type k = 0;
+    for (size_type i = 0; i != m; ++i) {
+      size_type j = n + order[i];
+      if (k != 0 && !comp()(key_vec().back(), key_vec()[j]))
+        continue;
+      size_type h = lower_index(key_vec()[j], n);
+      if (h != n && !comp()(key_vec()[j], key_vec()[h]))
+        continue;
+      key_vec().push_back(TinySTL::move(key_vec()[j]));
+      mapped_vec.push_back(TinySTL::move(mapped_vec[j]));
+      order[k++] = h;
+    }
+    typedef typename __bool_type<std::is_nothrow_move_assignable<Key>::value
+                                     && std::is_nothrow_move_assignable<T>::value>::type nothrow_move;
+    merge_run(n, m, k, order, nothrow_move());
+  }
+  // 移动赋值不抛异常：原地从后往前归并，原有元素 i 后移 i 之前插入的新元素个数
+  void merge_run(size_type n, size_type m, size_type k, const vector<size_type> &order, __true_type) {
+    size_type run = n + m, hi = n;
+    for (size_type r = k; r-- != 0;) {
+      size_type h = order[r];
+      for (size_type i = hi; i-- != h;) {
+        key_vec()[i + r + 1] = TinySTL::move(key_vec()[i]);
+        mapped_vec[i + r + 1] = TinySTL::move(mapped_vec[i]);
+      }
+      hi = h;
+      key_vec()[h + r] = TinySTL::move(key_vec()[run + r]);
+      mapped_vec[h + r] = TinySTL::move(mapped_vec[run + r]);
+    }
+    truncate(n + k);
+  }
+  // 否则归并到新的数组再交换，原有元素只拷贝不修改，抛出异常时保持不变
+  void merge_run(size_type n, size_type m, size_type k, const vector<size_type> &order, __false_type) {
+    key_container_type keys;
+    mapped_container_type values;
+    keys.reserve(n + k);
+    values.reserve(n + k);
+    size_type run = n + m, i = 0;
+    for (size_type r = 0; r != k; ++r) {
+      for (; i != order[r]; ++i) {
+        keys.push_back(key_vec()[i]);
+        values.push_back(mapped_vec[i]);
+      }
+      keys.push_back(TinySTL::move(key_vec()[run + r]));
+      values.push_back(TinySTL::move(mapped_vec[run + r]));
+    }
+    for (; i != n; ++i) {
+      keys.push_back(key_vec()[i]);
+      values.push_back(mapped_vec[i]);
+    }
+    swap(key_vec(), keys);
+    swap(mapped_vec, values);
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_FLAT_MAP_H_
@@ -0,0 +1,154 @@
+#ifndef TINYSTL_SRC_FLAT_SET_H_
+#define TINYSTL_SRC_FLAT_SET_H_
+
+/**
+ * 有序数组实现的 set：元素按顺序存放在一个 vector 中，查找用无分支二分。
+ * 取舍和 flat_map 相同：查找、遍历快，内存紧凑；单个插入删除 O(n)，批量插入先追加再归并。
+ * 迭代器就是指向元素的 const 指针，插入、删除后全部失效。
+ */
+
+#include "algorithm.h"
+#include "functional.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+template<typename Key, typename Compare = less<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  // 元素就是 key，不允许通过迭代器修改
+  using iterator = const value_type *;
+  using const_iterator = const value_type *;
+  using container_type = vector<Key>;
+
+ protected:
+  // 比较函数通常是空类，和数组放在一起，由 EBO 省掉它的空间
+  __compressed_pair<container_type, key_compare> rep;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit flat_set(const key_compare &c = key_compare()) : rep(container_type(), c) {}
+  template<typename InputIterator>
+  flat_set(InputIterator first, InputIterator last, const key_compare &c = key_compare()) :
+      rep(container_type(), c) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return vec().size(); }
+  bool empty() const { return vec().empty(); }
+  size_type capacity() const { return vec().capacity(); }
+  key_compare key_comp() const { return comp(); }
+  const container_type &keys() const { return vec(); }
+  const_reference operator[](size_type i) const { return vec()[i]; }
+
+  const_iterator begin() const { return vec().begin(); }
+  const_iterator end() const { return vec().end(); }
+  const_iterator cbegin() const { return vec().begin(); }
+  const_iterator cend() const { return vec().end(); }
+  const_iterator lower_bound(const key_type &key) const {
+    return TinySTL::lower_bound(vec().begin(), vec().end(), key, comp());
+  }
+  const_iterator upper_bound(const key_type &key) const {
+    return TinySTL::upper_bound(vec().begin(), vec().end(), key, comp());
+  }
+  const_iterator find(const key_type &key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp()(key, *it) ? it : end();
+  }
+  size_type count(const key_type &key) const { return find(key) == end() ? 0 : 1; }
+  bool contains(const key_type &key) const { return find(key) != end(); }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) {
+    size_type i = lower_bound(val) - begin();
+    if (i != size() && !comp()(val, vec()[i]))
+      return pair<iterator, bool>(begin() + i, false);
+    vec().insert(vec().begin() + i, val);
+    return pair<iterator, bool>(begin() + i, true);
+  }
+  /// 批量插入：追加到末尾，只对新元素排序、去重，再原地归并
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    size_type n = size();
+    for (; first != last; ++first)
+      vec().push_back(*first);
+    merge_tail(n);
+  }
+  iterator erase(const_iterator pos) {
+    size_type i = pos - begin();
+    vec().erase(vec().begin() + i);
+    return begin() + i;
+  }
+  size_type erase(const key_type &key) {
+    const_iterator it = find(key);
+    if (it == end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+  void clear() { vec().clear(); }
+
+  /*************** 容量 ************/
+  void reserve(size_type n) { vec().reserve(n); }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(flat_set &x, flat_set &y) {
+    swap(x.vec(), y.vec());
+    TinySTL::swap(x.comp(), y.comp());
+  }
+  friend bool operator==(const flat_set &x, const flat_set &y) { return x.vec() == y.vec(); }
+  friend bool operator!=(const flat_set &x, const flat_set &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  container_type &vec() { return rep.first(); }
+  const container_type &vec() const { return rep.first(); }
+  key_compare &comp() { return rep.second(); }
+  const key_compare &comp() const { return rep.second(); }
+  /**
+   * [0, n) 有序，[n, size()) 是新追加的元素：
+   *  1. 新元素排序，就地去掉重复的和原来已有的，剩下的拷到缓冲区；
+   *  2. 截到 n + m，从后往前把原有元素和缓冲区归并到最终位置。
+   */
+  void merge_tail(size_type n) {
+    if (size() == n)
+      return;
+    Key *head_end = vec().begin() + n;
+    TinySTL::sort(head_end, vec().end(), comp());
+    vector<Key> buf;
+    buf.reserve(vec().end() - head_end);
+    for (Key *it = head_end; it != vec().end(); ++it) {
+      if (!buf.empty() && !comp()(buf.back(), *it))
+        continue;
+      const Key *head = TinySTL::lower_bound(vec().begin(), head_end, *it, comp());
+      if (head != head_end && !comp()(*it, *head))
+        continue;
+      buf.push_back(*it);
+    }
+    size_type k = buf.size();
+    vec().erase(vec().begin() + n + k, vec().end());
+    size_type i = n, d = n + k;
+    while (k > 0) {
+      --d;
+      if (i > 0 && comp()(buf[k - 1], vec()[i - 1]))
+        vec()[d] = TinySTL::move(vec()[--i]);
+      else
+        vec()[d] = TinySTL::move(buf[--k]);
+    }
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_FLAT_SET_H_
@@ -0,0 +1,246 @@
+#ifndef TINYSTL_SRC_FUNCTION_H_
+#define TINYSTL_SRC_FUNCTION_H_
+
+/**
+ * function / unique_function：带内联存储的函数包装，代替 std::function。
+ * 单独放在这里，algorithm.h 等通过 functional.h 引入的头文件不必带上 <functional>。
+ */
+
+#include <cstddef>
+#include <functional>
+#include <new>
+
+#include "__alloc.h"
+#include "type_traits.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace FunctionAux {
+// 默认的内联存储大小：能放下 6 个指针大小的捕获，加上虚表指针后 sizeof(function) 正好 64 字节
+const size_t __default_inline_bytes = 48;
+// __alloc 内存池的对齐，对齐要求更高（但不超过 max_align_t）的可调用对象用 operator new 分配
+const size_t __pool_align = 8;
+}
+
+template<typename T>
+T &&__declval() noexcept;
+
+/**
+ * function 和 unique_function 的公共部分：可调用对象不超过 N 字节、移动构造不抛异常时直接放在对象内部，
+ * 否则放在堆上（来自 __alloc 的内存池，和容器一样不是线程安全的），内部只存一个指针。
+ * 每种可调用类型对应一张静态的函数表（调用、拷贝、移动、析构），没有虚函数和 RTTI。
+ * 移动总是 noexcept：内联的对象移动构造不抛异常，堆上的对象只移动指针。
+ */
+template<typename Signature, size_t N>
+class __function_base;
+
+template<typename R, typename... Args, size_t N>
+class __function_base<R(Args...), N> {
+  static_assert(N >= sizeof(void *), "内联存储至少要能放下一个指针");
+
+ protected:
+  typedef R (*invoke_fn)(void *, Args &&...);
+  typedef void (*copy_fn)(void *, const void *);
+  typedef void (*relocate_fn)(void *, void *);
+  typedef void (*destroy_fn)(void *);
+  struct vtable {
+    invoke_fn invoke;
+    copy_fn copy;          // 在 dst 上拷贝一份 src，unique_function 为 nullptr
+    relocate_fn relocate;  // 把 src 移动到 dst 并析构 src，不抛异常
+    destroy_fn destroy;
+  };
+  union storage_type {
+    void *heap;
+    alignas(std::max_align_t) unsigned char buf[N];
+  };
+
+  template<typename F>
+  struct fits_inline {
+    static const bool value = sizeof(F) <= N && alignof(F) <= alignof(std::max_align_t)
+        && noexcept(F(__declval<F>()));
+  };
+
+  // 可调用对象直接放在 storage 里
+  template<typename F>
+  struct inline_ops {
+    static F *get(void *s) { return static_cast<F *>(s); }
+    static const F *get(const void *s) { return static_cast<const F *>(s); }
+    static void construct(void *s, F &&f) { new(s) F(TinySTL::move(f)); }
+    static R invoke(void *s, Args &&... args) { return static_cast<R>((*get(s))(TinySTL::forward<Args>(args)...)); }
+    static void copy(void *dst, const void *src) { new(dst) F(*get(src)); }
+    static void relocate(void *dst, void *src) {
+      new(dst) F(TinySTL::move(*get(src)));
+      get(src)->~F();
+    }
+    static void destroy(void *s) { get(s)->~F(); }
+  };
+  // storage 里只存指向堆上对象的指针
+  template<typename F>
+  struct heap_ops {
+    // C++14 的 operator new 只保证 max_align_t 的对齐
+    static_assert(alignof(F) <= alignof(std::max_align_t), "function 不支持超过 max_align_t 的对齐");
+    static F *get(const void *s) { return static_cast<F *>(static_cast<const storage_type *>(s)->heap); }
+    static F *allocate() {
+      return static_cast<F *>(alignof(F) <= FunctionAux::__pool_align ? __alloc::allocate(sizeof(F))
+                                                                       : ::operator new(sizeof(F)));
+    }
+    static void deallocate(F *p) {
+      if (alignof(F) <= FunctionAux::__pool_align)
+        __alloc::deallocate(p, sizeof(F));
+      else
+        ::operator delete(p);
+    }
+    template<typename Arg>
+    static void construct(void *s, Arg &&f) {
+      F *p = allocate();
+      try {
+        new(p) F(TinySTL::forward<Arg>(f));
+      } catch (...) {
+        deallocate(p);
+        throw;
+      }
+      static_cast<storage_type *>(s)->heap = p;
+    }
+    static R invoke(void *s, Args &&... args) { return static_cast<R>((*get(s))(TinySTL::forward<Args>(args)...)); }
+    static void copy(void *dst, const void *src) { construct(dst, *get(src)); }
+    static void relocate(void *dst, void *src) { static_cast<storage_type *>(dst)->heap = get(src); }
+    static void destroy(void *s) {
+      F *p = get(s);
+      p->~F();
+      deallocate(p);
+    }
+  };
+  template<typename Ops>
+  static constexpr copy_fn copy_of(__true_type) { return &Ops::copy; }
+  template<typename Ops>
+  static constexpr copy_fn copy_of(__false_type) { return nullptr; }
+  // 每种 (可调用类型, 存放方式, 是否可拷贝) 一张表，常量初始化，没有运行期开销
+  template<typename Ops, typename Copyable>
+  static const vtable *table() {
+    static const vtable t = {&Ops::invoke, copy_of<Ops>(Copyable()), &Ops::relocate, &Ops::destroy};
+    return &t;
+  }
+
+  mutable storage_type storage;
+  const vtable *vt;
+
+ protected:
+  /**** 生命周期：只能由 function、unique_function 构造 ****/
+  __function_base() noexcept : vt(nullptr) {}
+  __function_base(__function_base &&x) noexcept : vt(nullptr) { move_from(x); }
+  ~__function_base() { reset(); }
+
+  // f 是按值传入后移动过来的可调用对象
+  template<typename F, typename Copyable>
+  void init(F &&f) { init_aux<F, Copyable>(TinySTL::move(f), typename __bool_type<fits_inline<F>::value>::type()); }
+  template<typename F, typename Copyable>
+  void init_aux(F &&f, __true_type) {
+    inline_ops<F>::construct(&storage, TinySTL::move(f));
+    vt = table<inline_ops<F>, Copyable>();
+  }
+  template<typename F, typename Copyable>
+  void init_aux(F &&f, __false_type) {
+    heap_ops<F>::construct(&storage, TinySTL::move(f));
+    vt = table<heap_ops<F>, Copyable>();
+  }
+
+ public:
+  explicit operator bool() const noexcept { return vt != nullptr; }
+  R operator()(Args... args) const {
+    if (vt == nullptr)
+      throw std::bad_function_call();
+    return vt->invoke(&storage, TinySTL::forward<Args>(args)...);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  void reset() noexcept {
+    if (vt != nullptr) {
+      vt->destroy(&storage);
+      vt = nullptr;
+    }
+  }
+  // 要求自身为空
+  void move_from(__function_base &x) noexcept {
+    if (x.vt != nullptr) {
+      x.vt->relocate(&storage, &x.storage);
+      vt = x.vt;
+      x.vt = nullptr;
+    }
+  }
+  void copy_from(const __function_base &x) {
+    if (x.vt != nullptr) {
+      x.vt->copy(&storage, &x.storage);
+      vt = x.vt;
+    }
+  }
+  void swap_with(__function_base &y) noexcept {
+    __function_base tmp(TinySTL::move(y));
+    y.move_from(*this);
+    move_from(tmp);
+  }
+};
+
+/// 可拷贝的函数包装，要求可调用对象可拷贝。N 是内联存储的字节数
+template<typename Signature, size_t N = FunctionAux::__default_inline_bytes>
+class function;
+
+template<typename R, typename... Args, size_t N>
+class function<R(Args...), N> : public __function_base<R(Args...), N> {
+ public:
+  using result_type = R;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、move ctor、copy-and-swap、dtor ****/
+  function() noexcept {}
+  function(std::nullptr_t) noexcept {}
+  template<typename F, typename = typename __enable_if<!__is_same_type<F, function>::value>::type>
+  function(F f) { this->template init<F, __true_type>(TinySTL::move(f)); }
+  function(const function &x) : __function_base<R(Args...), N>() { this->copy_from(x); }
+  function(function &&x) noexcept : __function_base<R(Args...), N>(TinySTL::move(x)) {}
+  function &operator=(function x) noexcept {
+    swap(*this, x);
+    return *this;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(function &x, function &y) noexcept { x.swap_with(y); }
+  friend bool operator==(const function &x, std::nullptr_t) noexcept { return !x; }
+  friend bool operator!=(const function &x, std::nullptr_t) noexcept { return static_cast<bool>(x); }
+};
+
+/// 只能移动的函数包装，可以存放捕获了 unique_ptr 等只能移动的对象的 lambda
+template<typename Signature, size_t N = FunctionAux::__default_inline_bytes>
+class unique_function;
+
+template<typename R, typename... Args, size_t N>
+class unique_function<R(Args...), N> : public __function_base<R(Args...), N> {
+ public:
+  using result_type = R;
+
+ public:
+  /**** 生命周期：不可拷贝，move ctor、move assignment、dtor ****/
+  unique_function() noexcept {}
+  unique_function(std::nullptr_t) noexcept {}
+  template<typename F, typename = typename __enable_if<!__is_same_type<F, unique_function>::value>::type>
+  unique_function(F f) { this->template init<F, __false_type>(TinySTL::move(f)); }
+  unique_function(const unique_function &) = delete;
+  unique_function(unique_function &&x) noexcept : __function_base<R(Args...), N>(TinySTL::move(x)) {}
+  unique_function &operator=(unique_function &&x) noexcept {
+    unique_function tmp(TinySTL::move(x));
+    swap(*this, tmp);
+    return *this;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(unique_function &x, unique_function &y) noexcept { x.swap_with(y); }
+  friend bool operator==(const unique_function &x, std::nullptr_t) noexcept { return !x; }
+  friend bool operator!=(const unique_function &x, std::nullptr_t) noexcept { return static_cast<bool>(x); }
+};
+
+}
+
+#endif //TINYSTL_SRC_FUNCTION_H_
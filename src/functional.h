@@ -1,27 +1,120 @@
 #ifndef TINYSTL_SRC_FUNCTIONAL_H_
 #define TINYSTL_SRC_FUNCTIONAL_H_
+
+#include <cstddef>
+
+#include "type_traits.h"
+
 namespace TinySTL {
 
-template<typename T>
+template<typename T = void>
 struct less {
   typedef T first_argument_type;
   typedef T second_argument_type;
   typedef bool result_type;
-  result_type operator()(const first_argument_type &x, const second_argument_type &y) {
+  result_type operator()(const first_argument_type &x, const second_argument_type &y) const {
     return x < y;
   }
 };
 
-template<class T>
+template<typename T = void>
+struct greater {
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef bool result_type;
+  result_type operator()(const first_argument_type &x, const second_argument_type &y) const {
+    return y < x;
+  }
+};
+
+template<typename T>
+struct plus {
+  typedef T first_argument_type;
+  typedef T second_argument_type;
+  typedef T result_type;
+  result_type operator()(const first_argument_type &x, const second_argument_type &y) const {
+    return x + y;
+  }
+};
+
+template<class T = void>
 struct equal_to {
   typedef T first_argument_type;
   typedef T second_argument_type;
   typedef bool result_type;
 
-  result_type operator()(const first_argument_type &x, const second_argument_type &y) {
+  result_type operator()(const first_argument_type &x, const second_argument_type &y) const {
     return x == y;
   }
 };
+
+/// 透明比较函数：两个参数可以是不同类型，比如用 string_view 查找 string 的 key，不必先构造临时的 key。
+/// 带 is_transparent，容器据此开启异构查找。都是空类，容器用 __compressed_pair 存放时不占空间
+template<>
+struct less<void> {
+  typedef void is_transparent;
+  template<typename T, typename U>
+  bool operator()(const T &x, const U &y) const { return x < y; }
+};
+
+template<>
+struct greater<void> {
+  typedef void is_transparent;
+  template<typename T, typename U>
+  bool operator()(const T &x, const U &y) const { return y < x; }
+};
+
+template<>
+struct equal_to<void> {
+  typedef void is_transparent;
+  template<typename T, typename U>
+  bool operator()(const T &x, const U &y) const { return x == y; }
+};
+
+/// 从元素中取出 key：set 的元素本身就是 key，map 的元素是 pair<const Key, T>
+template<typename T>
+struct identity {
+  const T &operator()(const T &x) const { return x; }
+};
+
+template<typename Pair>
+struct select1st {
+  const typename Pair::first_type &operator()(const Pair &x) const { return x.first; }
+};
+
+/// 打散哈希值：std::hash 对整数通常是恒等映射，哈希表按 2 的幂取低位、高位时分布很差
+inline size_t __hash_mix(size_t h) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 m = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ull;
+  return static_cast<size_t>(m) ^ static_cast<size_t>(m >> 64);
+#else
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+#endif
+}
+
+/// 哈希函数带 is_avalanching 时输出已经充分打散（如 TinySTL::hash），哈希表不必再调用 __hash_mix
+template<typename Hash, typename = void>
+struct __hash_is_avalanching {
+  typedef __false_type type;
+};
+template<typename Hash>
+struct __hash_is_avalanching<Hash, typename Hash::is_avalanching> {
+  typedef __true_type type;
+};
+
+inline size_t __hash_finish(size_t h, __true_type) { return h; }
+inline size_t __hash_finish(size_t h, __false_type) { return __hash_mix(h); }
+
+/// 哈希函数和比较函数都带 is_transparent 时 type 才存在，哈希表用来开启异构查找
+template<typename Hash, typename KeyEqual,
+    typename = typename Hash::is_transparent, typename = typename KeyEqual::is_transparent>
+struct __transparent_lookup {
+  typedef void type;
+};
+
 }
 
 #endif //TINYSTL_SRC_FUNCTIONAL_H_
@@ -0,0 +1,248 @@
+#ifndef TINYSTL_SRC_HASH_H_
+#define TINYSTL_SRC_HASH_H_
+
+/**
+ * 哈希函数库，哈希容器的默认哈希函数。
+ *  - hash_bytes：字节串哈希。不超过 256 字节时是 wyhash 的做法（64 x 64 -> 128 位乘法后高低位异或），
+ *    短 key 只有两三次乘法；更长的输入走 xxh3 式的 8 路并行累加，有 SSE2 时一次处理两路，
+ *    SIMD 和标量路径结果完全相同。
+ *  - hash_int：整数的强混合，两轮 128 位乘法，输入的每一位都会影响输出的每一位。
+ *  - hash_combine：组合两个哈希值，pair、tuple 的哈希由它逐个组合。
+ *  - hash_many：批量计算，各个 key 之间没有依赖，乘法可以流水起来；哈希表的批量插入用它先算出一批哈希值。
+ *
+ * hash<T> 的输出已经充分打散（带 is_avalanching），哈希表不会再调用 __hash_mix。
+ * 没有特化的类型退回 std::hash<T>，再经过 hash_int 混合。
+ * 结果只在同一程序内稳定，不要持久化。
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+
+#include "string.h"
+#include "string_view.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace HashAux {
+// wyhash 的默认密钥
+const uint64_t __secret0 = 0xa0761d6478bd642full;
+const uint64_t __secret1 = 0xe7037ed1a0b428dbull;
+const uint64_t __secret2 = 0x8ebc6af09c88c6e3ull;
+const uint64_t __secret3 = 0x589965cc75374cc3ull;
+// 超过这个长度走并行累加的长输入路径
+const size_t __long_threshold = 256;
+}
+
+/// 64 x 64 -> 128 位乘法，返回高低 64 位的异或
+inline uint64_t __hash_mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+  uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+  uint64_t c = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  c += lo < t;
+  uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+  return lo ^ hi;
+#endif
+}
+
+inline uint64_t __hash_read8(const unsigned char *p) {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+inline uint64_t __hash_read4(const unsigned char *p) {
+  uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+/// 长输入（超过 __long_threshold）的并行累加，见 impl/hash.cpp。定义 TINYSTL_NO_SIMD 时不用 SSE2
+uint64_t __hash_bytes_long(const unsigned char *p, size_t len, uint64_t seed);
+/// 同上的标量实现，结果和 SSE2 路径相同
+uint64_t __hash_bytes_long_scalar(const unsigned char *p, size_t len, uint64_t seed);
+
+/// 字节串哈希
+inline uint64_t hash_bytes(const void *data, size_t len, uint64_t seed = 0) {
+  const unsigned char *p = static_cast<const unsigned char *>(data);
+  if (len > HashAux::__long_threshold)
+    return __hash_bytes_long(p, len, seed);
+  seed ^= __hash_mum(seed ^ HashAux::__secret0, HashAux::__secret1);
+  uint64_t a, b;
+  if (len <= 16) {
+    if (len >= 4) {
+      // 前后各取两个可能重叠的 4 字节
+      size_t mid = (len >> 3) << 2;
+      a = (__hash_read4(p) << 32) | __hash_read4(p + mid);
+      b = (__hash_read4(p + len - 4) << 32) | __hash_read4(p + len - 4 - mid);
+    } else if (len > 0) {
+      a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      // 三路独立的乘法，互不等待
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = __hash_mum(__hash_read8(p) ^ HashAux::__secret1, __hash_read8(p + 8) ^ seed);
+        see1 = __hash_mum(__hash_read8(p + 16) ^ HashAux::__secret2, __hash_read8(p + 24) ^ see1);
+        see2 = __hash_mum(__hash_read8(p + 32) ^ HashAux::__secret3, __hash_read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = __hash_mum(__hash_read8(p) ^ HashAux::__secret1, __hash_read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    // 最后 16 字节（可能和前面重叠）
+    a = __hash_read8(p + i - 16);
+    b = __hash_read8(p + i - 8);
+  }
+  return __hash_mum(HashAux::__secret1 ^ len, __hash_mum(a ^ HashAux::__secret1, b ^ seed));
+}
+
+/// 整数的强混合
+inline uint64_t hash_int(uint64_t x) {
+  uint64_t h = __hash_mum(x ^ HashAux::__secret0, HashAux::__secret1);
+  return __hash_mum(h ^ HashAux::__secret2, x ^ HashAux::__secret3);
+}
+
+/// 组合两个哈希值，和参数顺序有关
+inline uint64_t hash_combine(uint64_t seed, uint64_t h) {
+  return __hash_mum(seed ^ HashAux::__secret2, h ^ HashAux::__secret3);
+}
+
+/***************** [hash] *********************/
+
+/// 没有特化的类型：std::hash 的结果再混合一次
+template<typename T>
+struct hash {
+  typedef void is_avalanching;
+  size_t operator()(const T &x) const { return static_cast<size_t>(hash_int(std::hash<T>()(x))); }
+};
+
+#define TINYSTL_INTEGER_HASH(T)                                                            \
+  template<>                                                                               \
+  struct hash<T> {                                                                         \
+    typedef void is_avalanching;                                                           \
+    size_t operator()(T x) const { return static_cast<size_t>(hash_int(static_cast<uint64_t>(x))); } \
+  };
+TINYSTL_INTEGER_HASH(bool)
+TINYSTL_INTEGER_HASH(char)
+TINYSTL_INTEGER_HASH(signed char)
+TINYSTL_INTEGER_HASH(unsigned char)
+TINYSTL_INTEGER_HASH(wchar_t)
+TINYSTL_INTEGER_HASH(char16_t)
+TINYSTL_INTEGER_HASH(char32_t)
+TINYSTL_INTEGER_HASH(short)
+TINYSTL_INTEGER_HASH(unsigned short)
+TINYSTL_INTEGER_HASH(int)
+TINYSTL_INTEGER_HASH(unsigned int)
+TINYSTL_INTEGER_HASH(long)
+TINYSTL_INTEGER_HASH(unsigned long)
+TINYSTL_INTEGER_HASH(long long)
+TINYSTL_INTEGER_HASH(unsigned long long)
+#undef TINYSTL_INTEGER_HASH
+
+template<typename T>
+struct hash<T *> {
+  typedef void is_avalanching;
+  size_t operator()(T *p) const { return static_cast<size_t>(hash_int(reinterpret_cast<uintptr_t>(p))); }
+};
+
+// +0.0 和 -0.0 相等，哈希值也要相同
+template<>
+struct hash<float> {
+  typedef void is_avalanching;
+  size_t operator()(float x) const {
+    uint32_t bits = 0;
+    if (x != 0.0f)
+      std::memcpy(&bits, &x, sizeof(x));
+    return static_cast<size_t>(hash_int(bits));
+  }
+};
+template<>
+struct hash<double> {
+  typedef void is_avalanching;
+  size_t operator()(double x) const {
+    uint64_t bits = 0;
+    if (x != 0.0)
+      std::memcpy(&bits, &x, sizeof(x));
+    return static_cast<size_t>(hash_int(bits));
+  }
+};
+
+template<>
+struct hash<string_view> {
+  typedef void is_avalanching;
+  size_t operator()(string_view s) const { return static_cast<size_t>(hash_bytes(s.data(), s.size())); }
+};
+template<>
+struct hash<string> {
+  typedef void is_avalanching;
+  size_t operator()(const string &s) const { return static_cast<size_t>(hash_bytes(s.data(), s.size())); }
+};
+template<>
+struct hash<std::string> {
+  typedef void is_avalanching;
+  size_t operator()(const std::string &s) const { return static_cast<size_t>(hash_bytes(s.data(), s.size())); }
+};
+
+template<typename T1, typename T2>
+struct hash<pair<T1, T2>> {
+  typedef void is_avalanching;
+  size_t operator()(const pair<T1, T2> &x) const {
+    return static_cast<size_t>(hash_combine(hash<T1>()(x.first), hash<T2>()(x.second)));
+  }
+};
+
+// tuple 从第 I 个元素开始逐个组合
+template<size_t I, size_t N>
+struct __tuple_hash {
+  template<typename Tuple>
+  static uint64_t apply(uint64_t seed, const Tuple &t) {
+    typedef typename std::tuple_element<I, Tuple>::type element;
+    return __tuple_hash<I + 1, N>::apply(hash_combine(seed, hash<element>()(std::get<I>(t))), t);
+  }
+};
+template<size_t N>
+struct __tuple_hash<N, N> {
+  template<typename Tuple>
+  static uint64_t apply(uint64_t seed, const Tuple &) { return seed; }
+};
+
+template<typename... Ts>
+struct hash<std::tuple<Ts...>> {
+  typedef void is_avalanching;
+  size_t operator()(const std::tuple<Ts...> &t) const {
+    return static_cast<size_t>(__tuple_hash<0, sizeof...(Ts)>::apply(HashAux::__secret0, t));
+  }
+};
+
+/***************** [hash_many] T(n) = O(n) *********************/
+
+/// out[i] = hf(第 i 个元素)。各次计算互不依赖，乘法可以交错执行
+template<typename InputIterator, typename Hash>
+void hash_many(InputIterator first, InputIterator last, size_t *out, const Hash &hf) {
+  for (; first != last; ++first, ++out)
+    *out = hf(*first);
+}
+template<typename T>
+void hash_many(const T *keys, size_t n, size_t *out) { hash_many(keys, keys + n, out, hash<T>()); }
+
+}
+
+#endif //TINYSTL_SRC_HASH_H_
@@ -0,0 +1,409 @@
+#ifndef TINYSTL_SRC_HIVE_H_
+#define TINYSTL_SRC_HIVE_H_
+
+/**
+ * 分块存放的无序容器（hive / colony），适合频繁插入、删除的大对象池。
+ *
+ * 和 deque 一样把元素分块存放，块的容量从 8 开始翻倍增长，最大 8192，块一旦分配元素就不再移动：
+ * 扩容只是再挂一个新块，删除也不搬动其他元素，所以迭代器、指针、引用一直有效，直到元素本身被删除。
+ * 块按分配顺序串成双向链表（块会从中间释放，不用 deque 的中控数组）。
+ *
+ * 跳跃字段（skip field）：每块有一个 uint16_t 数组，连续的空位组成一段，段首、段尾记录段的长度，
+ * 占用的槽位记为 0。迭代器前进时读下一个槽位的跳跃值，直接跳过整段空位，不用逐个检查。
+ * 删除时和左右相邻的空位段合并，只改段首、段尾两个值，O(1)。
+ *
+ * 空位复用：每块的空位段串成链表（链接存放在空槽位自身的内存中），有空位的块再串成一个链表。
+ * 插入总是取第一个有空位的块的第一个空位段的段首，O(1)。新块初始时整块是一个空位段。
+ *
+ * 内存：块头、元素、跳跃字段一起从 __alloc 分配；块空了就释放，但缓存一个空块，避免在块边界反复插入删除时抖动。
+ *
+ * 注意：
+ *  1. 元素顺序不固定，插入的元素可能出现在任意位置。
+ *  2. 和其他容器一样不是线程安全的。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "__alloc.h"
+#include "algorithm.h"
+#include "iterator.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace HiveAux {
+const size_t __min_block_capacity = 8;
+const size_t __max_block_capacity = 8192;
+// 空位段链表的结尾
+const uint16_t __no_slot = 0xFFFF;
+}
+
+template<typename T>
+struct __hive_block {
+  // 空槽位中存放的空位段链表的链接
+  struct free_links {
+    uint16_t prev;
+    uint16_t next;
+  };
+  static constexpr size_t slot_align = alignof(T) > alignof(free_links) ? alignof(T) : alignof(free_links);
+  static constexpr size_t slot_size =
+      ((sizeof(T) > sizeof(free_links) ? sizeof(T) : sizeof(free_links)) + slot_align - 1) / slot_align * slot_align;
+
+  __hive_block *prev;
+  __hive_block *next;
+  __hive_block *prev_free;  // 有空位的块组成的链表
+  __hive_block *next_free;
+  uint16_t capacity;
+  uint16_t size;
+  uint16_t free_head;  // 第一个空位段的段首
+
+  /// 块头、capacity 个槽位、capacity + 1 个跳跃值（最后一个恒为 0，作为哨兵）一起分配
+  static constexpr size_t header_size() { return (sizeof(__hive_block) + slot_align - 1) / slot_align * slot_align; }
+  static size_t bytes(size_t cap) { return header_size() + cap * slot_size + (cap + 1) * sizeof(uint16_t); }
+  unsigned char *slot(size_t i) { return reinterpret_cast<unsigned char *>(this) + header_size() + i * slot_size; }
+  T *element(size_t i) { return reinterpret_cast<T *>(slot(i)); }
+  free_links &links(size_t i) { return *reinterpret_cast<free_links *>(slot(i)); }
+  uint16_t *skip() { return reinterpret_cast<uint16_t *>(slot(capacity)); }
+};
+
+template<typename T, typename Ref, typename Ptr>
+class __hive_iterator {
+ public:
+  using iterator_category = bidirectional_iterator_tag;
+  using value_type = T;
+  using reference = Ref;
+  using pointer = Ptr;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using block = __hive_block<T>;
+
+ private:
+  block *b;
+  size_t index;
+
+ public:
+  __hive_iterator() : b(nullptr), index(0) {}
+  __hive_iterator(block *blk, size_t i) : b(blk), index(i) {}
+  // iterator 可以转换为 const_iterator，反之不行
+  template<typename R, typename P, typename = typename __enable_if<__is_same_type<R, T &>::value>::type>
+  __hive_iterator(const __hive_iterator<T, R, P> &x) : b(x.b), index(x.index) {}
+
+  reference operator*() const { return *b->element(index); }
+  pointer operator->() const { return b->element(index); }
+
+  // 跳过下一个槽位开始的空位段；到块尾时进入下一块，最后一块的块尾就是 end()
+  __hive_iterator &operator++() {
+    ++index;
+    index += b->skip()[index];
+    if (index == b->capacity && b->next != nullptr) {
+      b = b->next;
+      index = b->skip()[0];
+    }
+    return *this;
+  }
+  __hive_iterator operator++(int) {
+    __hive_iterator tmp = *this;
+    ++*this;
+    return tmp;
+  }
+  // 空位段的段尾也记录了长度，向前同样可以整段跳过
+  __hive_iterator &operator--() {
+    while (true) {
+      size_t i = index;
+      if (i != 0) {
+        --i;
+        size_t run = b->skip()[i];
+        if (run <= i) {
+          index = i - run;
+          return *this;
+        }
+      }
+      b = b->prev;
+      index = b->capacity;
+    }
+  }
+  __hive_iterator operator--(int) {
+    __hive_iterator tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  friend bool operator==(const __hive_iterator &x, const __hive_iterator &y) {
+    return x.b == y.b && x.index == y.index;
+  }
+  friend bool operator!=(const __hive_iterator &x, const __hive_iterator &y) { return !(x == y); }
+
+  template<typename, typename, typename> friend class __hive_iterator;
+  template<typename> friend class hive;
+};
+
+template<typename T>
+class hive {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using pointer = T *;
+  using const_pointer = const T *;
+  using iterator = __hive_iterator<T, T &, T *>;
+  using const_iterator = __hive_iterator<T, const T &, const T *>;
+
+ protected:
+  using block = __hive_block<T>;
+
+  // 从 __alloc 分配的内存池最少按 8 字节对齐，超过 128 字节的块来自 malloc
+  static_assert(alignof(T) <= alignof(std::max_align_t), "hive 不支持超过 max_align_t 的对齐");
+
+  block *head;
+  block *tail;
+  block *free_blocks;  // 有空位的块
+  block *spare;        // 缓存的空块
+  size_type num_elements;
+  size_type total_capacity;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、move ctor、copy-and-swap、dtor ****/
+  hive() : head(nullptr), tail(nullptr), free_blocks(nullptr), spare(nullptr), num_elements(0), total_capacity(0) {}
+  hive(const hive &x) : hive() {
+    try {
+      for (auto it = x.begin(); it != x.end(); ++it)
+        insert(*it);
+    } catch (...) {
+      clear();
+      release_spare();
+      throw;
+    }
+  }
+  hive(hive &&x) : hive() { swap(*this, x); }
+  hive &operator=(hive x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~hive() {
+    clear();
+    release_spare();
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return num_elements; }
+  bool empty() const { return num_elements == 0; }
+  /// 所有块的槽位总数，不含缓存的空块
+  size_type capacity() const { return total_capacity; }
+  const_iterator begin() const { return const_cast<hive *>(this)->begin(); }
+  const_iterator end() const { return const_cast<hive *>(this)->end(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  /*************** 迭代器 ************/
+  // 非空的块至少有一个元素，第一个元素在第一个空位段之后
+  iterator begin() { return head == nullptr ? end() : iterator(head, head->skip()[0]); }
+  iterator end() { return tail == nullptr ? iterator() : iterator(tail, tail->capacity); }
+
+  /*************** 插入删除 ************/
+  iterator insert(const value_type &val) { return emplace(val); }
+  template<typename... Args>
+  iterator emplace(Args &&... args) {
+    if (free_blocks == nullptr)
+      append_block();
+    block *b = free_blocks;
+    uint16_t s = b->free_head;
+    typename block::free_links links = b->links(s);
+    try {
+      new(b->element(s)) T(TinySTL::forward<Args>(args)...);
+    } catch (...) {
+      b->links(s) = links;
+      throw;
+    }
+    uint16_t *skip = b->skip();
+    uint16_t run = skip[s];
+    if (run > 1) {
+      // 段首后移一位，接替原来在链表中的位置
+      uint16_t ns = static_cast<uint16_t>(s + 1);
+      skip[ns] = skip[s + run - 1] = static_cast<uint16_t>(run - 1);
+      b->links(ns) = links;
+      replace_run(b, links, ns);
+    } else {
+      remove_run(b, links);
+      if (b->free_head == HiveAux::__no_slot)
+        unlink_free_block(b);
+    }
+    skip[s] = 0;
+    ++b->size;
+    ++num_elements;
+    return iterator(b, s);
+  }
+  /// 返回被删元素的下一个元素
+  iterator erase(const_iterator pos) {
+    iterator next(pos.b, pos.index);
+    ++next;
+    // 最后一块可能被释放，end() 要重新取
+    bool at_end = next == end();
+    erase_at(pos.b, static_cast<uint16_t>(pos.index));
+    return at_end ? end() : next;
+  }
+  void clear() {
+    block *b = head;
+    while (b != nullptr) {
+      block *next = b->next;
+      uint16_t *skip = b->skip();
+      for (size_type i = skip[0]; i != b->capacity; i += skip[i]) {
+        b->element(i)->~T();
+        ++i;
+      }
+      deallocate_block(b);
+      b = next;
+    }
+    head = tail = free_blocks = nullptr;
+    num_elements = total_capacity = 0;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(hive &x, hive &y) {
+    TinySTL::swap(x.head, y.head);
+    TinySTL::swap(x.tail, y.tail);
+    TinySTL::swap(x.free_blocks, y.free_blocks);
+    TinySTL::swap(x.spare, y.spare);
+    TinySTL::swap(x.num_elements, y.num_elements);
+    TinySTL::swap(x.total_capacity, y.total_capacity);
+  }
+  /// 元素相同即相等，和顺序无关时请先排序再比较
+  friend bool operator==(const hive &x, const hive &y) {
+    if (x.size() != y.size())
+      return false;
+    for (auto i = x.begin(), j = y.begin(); i != x.end(); ++i, ++j) {
+      if (!(*i == *j))
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const hive &x, const hive &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  /// 空位段 s 接替链表中原来的某一段，links 是原来那一段的链接，已经复制到 s
+  static void replace_run(block *b, const typename block::free_links &links, uint16_t s) {
+    if (links.prev == HiveAux::__no_slot)
+      b->free_head = s;
+    else
+      b->links(links.prev).next = s;
+    if (links.next != HiveAux::__no_slot)
+      b->links(links.next).prev = s;
+  }
+  /// 从链表中删除链接为 links 的空位段
+  static void remove_run(block *b, const typename block::free_links &links) {
+    if (links.prev == HiveAux::__no_slot)
+      b->free_head = links.next;
+    else
+      b->links(links.prev).next = links.next;
+    if (links.next != HiveAux::__no_slot)
+      b->links(links.next).prev = links.prev;
+  }
+  static void push_run(block *b, uint16_t s) {
+    b->links(s).prev = HiveAux::__no_slot;
+    b->links(s).next = b->free_head;
+    if (b->free_head != HiveAux::__no_slot)
+      b->links(b->free_head).prev = s;
+    b->free_head = s;
+  }
+
+  void erase_at(block *b, uint16_t i) {
+    b->element(i)->~T();
+    uint16_t *skip = b->skip();
+    // i 左边的空位是某段的段尾，右边的空位是某段的段首，跳跃值就是段长
+    uint16_t left = i == 0 ? 0 : skip[i - 1];
+    uint16_t right = skip[i + 1];
+    bool had_free = b->free_head != HiveAux::__no_slot;
+    if (left == 0 && right == 0) {
+      skip[i] = 1;
+      push_run(b, i);
+    } else if (right == 0) {
+      skip[i - left] = skip[i] = static_cast<uint16_t>(left + 1);
+    } else if (left == 0) {
+      // 右边的段向左扩展，段首变为 i
+      typename block::free_links links = b->links(i + 1);
+      skip[i] = skip[i + right] = static_cast<uint16_t>(right + 1);
+      b->links(i) = links;
+      replace_run(b, links, i);
+    } else {
+      remove_run(b, b->links(i + 1));
+      skip[i - left] = skip[i + right] = static_cast<uint16_t>(left + right + 1);
+    }
+    --b->size;
+    --num_elements;
+    if (!had_free)
+      push_free_block(b);
+    if (b->size == 0)
+      release_block(b);
+  }
+
+  void append_block() {
+    size_type cap = tail == nullptr ? HiveAux::__min_block_capacity : tail->capacity * 2;
+    if (cap > HiveAux::__max_block_capacity)
+      cap = HiveAux::__max_block_capacity;
+    block *b;
+    if (spare != nullptr && spare->capacity >= cap) {
+      b = spare;
+      spare = nullptr;
+    } else {
+      b = static_cast<block *>(__alloc::allocate(block::bytes(cap)));
+      b->capacity = static_cast<uint16_t>(cap);
+    }
+    // 整块是一个空位段
+    uint16_t *skip = b->skip();
+    skip[0] = skip[b->capacity - 1] = b->capacity;
+    skip[b->capacity] = 0;
+    b->size = 0;
+    b->free_head = HiveAux::__no_slot;
+    push_run(b, 0);
+    b->prev = tail;
+    b->next = nullptr;
+    if (tail == nullptr)
+      head = b;
+    else
+      tail->next = b;
+    tail = b;
+    total_capacity += b->capacity;
+    push_free_block(b);
+  }
+  /// 空块从两个链表中摘下，缓存起来或者释放
+  void release_block(block *b) {
+    unlink_free_block(b);
+    (b->prev == nullptr ? head : b->prev->next) = b->next;
+    (b->next == nullptr ? tail : b->next->prev) = b->prev;
+    total_capacity -= b->capacity;
+    if (spare == nullptr || spare->capacity < b->capacity) {
+      release_spare();
+      spare = b;
+    } else {
+      deallocate_block(b);
+    }
+  }
+  void release_spare() {
+    if (spare != nullptr)
+      deallocate_block(spare);
+    spare = nullptr;
+  }
+  static void deallocate_block(block *b) { __alloc::deallocate(b, block::bytes(b->capacity)); }
+
+  void push_free_block(block *b) {
+    b->prev_free = nullptr;
+    b->next_free = free_blocks;
+    if (free_blocks != nullptr)
+      free_blocks->prev_free = b;
+    free_blocks = b;
+  }
+  void unlink_free_block(block *b) {
+    (b->prev_free == nullptr ? free_blocks : b->prev_free->next_free) = b->next_free;
+    if (b->next_free != nullptr)
+      b->next_free->prev_free = b->prev_free;
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_HIVE_H_
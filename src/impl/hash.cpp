@@ -0,0 +1,122 @@
+#include "../hash.h"
+
+#if defined(__SSE2__) && !defined(TINYSTL_NO_SIMD)
+#include <emmintrin.h>
+#define TINYSTL_HASH_SSE2 1
+#endif
+
+namespace TinySTL {
+
+/**
+ * 长输入：xxh3 的做法。8 个 64 位累加器，每次吃进 64 字节（一个 stripe），每路
+ *   key = data ^ secret，acc[i] += lo32(key) * hi32(key)，acc[i ^ 1] += data
+ * 8 路之间没有依赖，32 x 32 -> 64 位乘法在 SSE2 上一条指令算两路。
+ * 每 16 个 stripe（1 KB）打散一次累加器，防止乘法的低位退化；最后两两用 __hash_mum 合并。
+ */
+namespace {
+
+const size_t lanes = 8;
+const size_t stripe_bytes = lanes * 8;
+const size_t stripes_per_block = 16;
+const size_t block_bytes = stripe_bytes * stripes_per_block;
+const uint64_t prime32 = 0x9E3779B1u;
+
+// 密钥由 splitmix64 在编译期生成，每个 stripe 错开一个下标使用
+struct secret_table {
+  uint64_t v[lanes * 2 + 2];
+  constexpr secret_table() : v{} {
+    uint64_t x = HashAux::__secret0;
+    for (size_t i = 0; i != lanes * 2 + 2; ++i) {
+      x += 0x9E3779B97F4A7C15ull;
+      uint64_t z = x;
+      z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+      z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+      v[i] = z ^ (z >> 31);
+    }
+  }
+};
+constexpr secret_table secret;
+
+void accumulate_scalar(uint64_t *acc, const unsigned char *p, const uint64_t *key) {
+  for (size_t i = 0; i != lanes; ++i) {
+    uint64_t data = __hash_read8(p + i * 8);
+    uint64_t k = data ^ key[i];
+    acc[i ^ 1] += data;
+    acc[i] += (k & 0xFFFFFFFFu) * (k >> 32);
+  }
+}
+
+void scramble_scalar(uint64_t *acc, const uint64_t *key) {
+  for (size_t i = 0; i != lanes; ++i)
+    acc[i] = (acc[i] ^ (acc[i] >> 47) ^ key[i]) * prime32;
+}
+
+#ifdef TINYSTL_HASH_SSE2
+void accumulate_sse2(uint64_t *acc, const unsigned char *p, const uint64_t *key) {
+  for (size_t i = 0; i != lanes; i += 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+    __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i * 8));
+    __m128i k = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + i)));
+    // 两路各自的 lo32(k) * hi32(k)
+    __m128i prod = _mm_mul_epu32(k, _mm_shuffle_epi32(k, _MM_SHUFFLE(2, 3, 0, 1)));
+    // data 交换两路后加到对方
+    __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    a = _mm_add_epi64(a, _mm_add_epi64(prod, swapped));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + i), a);
+  }
+}
+
+void scramble_sse2(uint64_t *acc, const uint64_t *key) {
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32));
+  for (size_t i = 0; i != lanes; i += 2) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+    a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+    a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i *>(key + i)));
+    // 64 位乘以 32 位常数：lo * p + (hi * p) << 32
+    __m128i lo = _mm_mul_epu32(a, prime);
+    __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc + i), _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  }
+}
+#endif
+
+template<typename Accumulate, typename Scramble>
+uint64_t hash_long(const unsigned char *p, size_t len, uint64_t seed, Accumulate accumulate, Scramble scramble) {
+  uint64_t acc[lanes];
+  for (size_t i = 0; i != lanes; ++i)
+    acc[i] = secret.v[i] ^ seed;
+  const uint64_t *scramble_key = secret.v + lanes;
+  size_t blocks = (len - 1) / block_bytes;
+  for (size_t b = 0; b != blocks; ++b, p += block_bytes) {
+    for (size_t s = 0; s != stripes_per_block; ++s)
+      accumulate(acc, p + s * stripe_bytes, secret.v + (s & 7));
+    scramble(acc, scramble_key);
+  }
+  // 最后一个块中剩下的完整 stripe，再加上末尾 64 字节（可能和前面重叠）
+  size_t rest = len - blocks * block_bytes;
+  size_t stripes = (rest - 1) / stripe_bytes;
+  for (size_t s = 0; s != stripes; ++s)
+    accumulate(acc, p + s * stripe_bytes, secret.v + (s & 7));
+  accumulate(acc, p + rest - stripe_bytes, secret.v + lanes + 1);
+
+  uint64_t h = len * HashAux::__secret0;
+  for (size_t i = 0; i != lanes; i += 2)
+    h += __hash_mum(acc[i] ^ secret.v[i + 2], acc[i + 1] ^ secret.v[i + 3]);
+  return __hash_mum(h ^ HashAux::__secret1, h ^ (h >> 29) ^ HashAux::__secret2);
+}
+
+}
+
+uint64_t __hash_bytes_long_scalar(const unsigned char *p, size_t len, uint64_t seed) {
+  return hash_long(p, len, seed, accumulate_scalar, scramble_scalar);
+}
+
+uint64_t __hash_bytes_long(const unsigned char *p, size_t len, uint64_t seed) {
+#ifdef TINYSTL_HASH_SSE2
+  return hash_long(p, len, seed, accumulate_sse2, scramble_sse2);
+#else
+  return __hash_bytes_long_scalar(p, len, seed);
+#endif
+}
+
+}
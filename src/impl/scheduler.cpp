@@ -0,0 +1,298 @@
+#include "../scheduler.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace TinySTL {
+
+struct alignas(__cache_line_size) scheduler::worker {
+  work_stealing_deque<__task *> deque;
+  // submit_to 提交的任务，只有本线程会取
+  mpmc_queue<__task *> pinned;
+  std::thread thread;
+  int cpu;  // 绑定的 CPU，-1 表示不绑定
+
+  worker() : pinned(SchedulerAux::__pinned_capacity), cpu(-1) {}
+};
+
+namespace {
+// 当前线程所属的调度器和工作线程编号，非工作线程为 nullptr
+thread_local scheduler *current_scheduler = nullptr;
+thread_local size_t current_index = 0;
+thread_local uint32_t rng_state = 0;
+
+// xorshift，挑选窃取对象用
+uint32_t next_random() {
+  if (rng_state == 0)
+    rng_state = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&rng_state) >> 4) | 1;
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+// 最多考虑这么多个 CPU，与 glibc 的 CPU_SETSIZE 相同
+const size_t max_cpus = 1024;
+
+// 进程可用的 CPU 编号，按编号排列；不支持或读取失败时为空
+size_t allowed_cpus(int *cpus, size_t max_count) {
+  size_t count = 0;
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) != 0)
+    return 0;
+  for (int c = 0; c != CPU_SETSIZE && count != max_count; ++c) {
+    if (CPU_ISSET(c, &set))
+      cpus[count++] = c;
+  }
+#else
+  (void) cpus;
+  (void) max_count;
+#endif
+  return count;
+}
+
+bool pin_enabled() {
+  const char *env = std::getenv("TINYSTL_PIN_THREADS");
+  return env == nullptr || std::strcmp(env, "0") != 0;
+}
+
+void pin_current_thread(int cpu) {
+#if defined(__linux__)
+  if (cpu < 0)
+    return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  // 绑定失败（比如 CPU 被 cgroup 收回）不影响正确性，忽略
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void) cpu;
+#endif
+}
+}
+
+scheduler::scheduler(size_t num_threads) :
+    num_threads(num_threads == 0 ? 1 : num_threads),
+    workers(nullptr),
+    inject(SchedulerAux::__inject_capacity),
+    stop(false),
+    sleepers(0) {
+  size_t n = this->num_threads - 1;
+  if (n == 0)
+    return;
+  // worker 按缓存行对齐，C++14 的 new 不保证，手动对齐
+  void *raw = std::malloc(sizeof(worker) * n + __cache_line_size);
+  if (raw == nullptr)
+    throw std::bad_alloc();
+  uintptr_t addr = (reinterpret_cast<uintptr_t>(raw) + __cache_line_size) & ~(__cache_line_size - 1);
+  // 原始指针存在对齐后地址的前面
+  reinterpret_cast<void **>(addr)[-1] = raw;
+  workers = reinterpret_cast<worker *>(addr);
+  for (size_t i = 0; i != n; ++i)
+    new(&workers[i]) worker();
+  // 工作线程数不超过可用 CPU 数时，第 i 个工作线程绑定第 i 个可用 CPU；调用线程不绑定
+  if (pin_enabled()) {
+    int cpus[max_cpus];
+    if (allowed_cpus(cpus, max_cpus) >= n) {
+      for (size_t i = 0; i != n; ++i)
+        workers[i].cpu = cpus[i];
+    }
+  }
+  // 所有 worker 构造完再启动线程，窃取时会访问别的 worker
+  for (size_t i = 0; i != n; ++i)
+    workers[i].thread = std::thread(&scheduler::worker_loop, this, i);
+}
+
+scheduler::~scheduler() {
+  if (workers == nullptr)
+    return;
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stop.store(true, std::memory_order_release);
+  }
+  sleep_cv.notify_all();
+  size_t n = num_threads - 1;
+  for (size_t i = 0; i != n; ++i)
+    workers[i].thread.join();
+  // 此时不应再有未执行的任务
+  for (size_t i = 0; i != n; ++i)
+    workers[i].~worker();
+  std::free(reinterpret_cast<void **>(workers)[-1]);
+}
+
+scheduler &scheduler::instance() {
+  static scheduler global(default_num_threads());
+  return global;
+}
+
+size_t scheduler::default_num_threads() {
+  const char *env = std::getenv("TINYSTL_NUM_THREADS");
+  if (env != nullptr) {
+    long n = std::strtol(env, nullptr, 10);
+    if (n > 0)
+      return static_cast<size_t>(n);
+  }
+  size_t n = std::thread::hardware_concurrency();
+  return n == 0 ? 1 : n;
+}
+
+size_t scheduler::numa_nodes() {
+  static const size_t nodes = [] {
+    // 格式形如 "0" 或 "0-1,3"
+    FILE *file = std::fopen("/sys/devices/system/node/online", "r");
+    if (file == nullptr)
+      return size_t(1);
+    size_t count = 0;
+    long lo, hi;
+    while (std::fscanf(file, "%ld", &lo) == 1) {
+      hi = lo;
+      int c = std::fgetc(file);
+      if (c == '-') {
+        if (std::fscanf(file, "%ld", &hi) != 1)
+          break;
+        c = std::fgetc(file);
+      }
+      count += static_cast<size_t>(hi - lo + 1);
+      if (c != ',')
+        break;
+    }
+    std::fclose(file);
+    return count == 0 ? size_t(1) : count;
+  }();
+  return nodes;
+}
+
+int scheduler::worker_cpu(size_t index) const { return workers[index].cpu; }
+
+void scheduler::submit(__task *task) {
+  if (current_scheduler == this) {
+    workers[current_index].deque.push_bottom(task);
+  } else if (!inject.try_push(task)) {
+    // 公共队列满了，直接在当前线程执行
+    execute(task);
+    return;
+  }
+  wake_one();
+}
+
+void scheduler::submit_to(size_t index, __task *task) {
+  // 专属队列满了就帮忙执行别的任务，等它腾出位置
+  while (!workers[index].pinned.try_push(task)) {
+    if (!run_one())
+      std::this_thread::yield();
+  }
+  // 只有第 index 个线程能执行，唤醒所有睡眠的线程，保证它被唤醒
+  wake_all();
+}
+
+bool scheduler::run_one() {
+  __task *task;
+  size_t self = current_scheduler == this ? current_index : num_threads - 1;
+  if (!find_task(task, self))
+    return false;
+  execute(task);
+  return true;
+}
+
+void scheduler::execute(__task *task) {
+  task_group *group = task->group;
+  try {
+    task->run();
+  } catch (...) {
+    group->set_exception(std::current_exception());
+  }
+  delete task;
+  // 最后才减计数：减到 0 之后 group 随时可能被析构
+  group->pending.fetch_sub(1, std::memory_order_release);
+}
+
+bool scheduler::find_task(__task *&task, size_t self) {
+  size_t n = num_threads - 1;
+  // 1. 只能由自己执行的任务，然后是自己的队列
+  if (self < n && !workers[self].pinned.empty() && workers[self].pinned.try_pop(task))
+    return true;
+  if (self < n && workers[self].deque.pop_bottom(task))
+    return true;
+  // 2. 公共队列，先看一眼是否为空，避免空队列上的统计计数互相争抢
+  if (!inject.empty() && inject.try_pop(task))
+    return true;
+  // 3. 从随机位置开始，依次尝试窃取其他线程
+  if (n == 0)
+    return false;
+  size_t start = next_random() % n;
+  for (size_t k = 0; k != n; ++k) {
+    size_t victim = (start + k) % n;
+    if (victim != self && workers[victim].deque.steal(task))
+      return true;
+  }
+  return false;
+}
+
+bool scheduler::has_visible_task(size_t self) const {
+  if (!inject.empty() || !workers[self].pinned.empty())
+    return true;
+  for (size_t i = 0; i + 1 < num_threads; ++i) {
+    if (!workers[i].deque.empty())
+      return true;
+  }
+  return false;
+}
+
+void scheduler::wake_one() {
+  // 与 worker_loop 中的 sleepers 自增配对：要么这里看到睡眠者，要么睡眠者看到新任务
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleepers.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    sleep_cv.notify_one();
+  }
+}
+
+void scheduler::wake_all() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleepers.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    sleep_cv.notify_all();
+  }
+}
+
+void scheduler::worker_loop(size_t index) {
+  current_scheduler = this;
+  current_index = index;
+  pin_current_thread(workers[index].cpu);
+  rng_state = static_cast<uint32_t>(index * 2654435761u) | 1;
+  int idle = 0;
+  __backoff backoff;
+  while (!stop.load(std::memory_order_acquire)) {
+    __task *task;
+    if (find_task(task, index)) {
+      execute(task);
+      idle = 0;
+      backoff.reset();
+      continue;
+    }
+    if (++idle < SchedulerAux::__idle_rounds) {
+      backoff.pause();
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!stop.load(std::memory_order_relaxed) && !has_visible_task(index))
+      sleep_cv.wait(lock);
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+    idle = 0;
+    backoff.reset();
+  }
+}
+
+}
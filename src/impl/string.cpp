@@ -0,0 +1,129 @@
+#include "../string.h"
+
+namespace TinySTL {
+
+const string_view::size_type string_view::npos;
+const string::size_type string::npos;
+
+// 按 __alloc 的 8 字节对齐取整后能放下的字符数（算上 '\0'）
+static size_t round_capacity(size_t n) {
+  return ((n + 1 + 7) & ~static_cast<size_t>(7)) - 1;
+}
+
+string::string(size_type n, char c) : string() { append(n, c); }
+
+void string::init(const char *s, size_type n) {
+  if (n <= StringAux::__sso_capacity) {
+    if (n != 0)
+      std::memcpy(rep.s.buf, s, n);
+    set_short_size(n);
+    return;
+  }
+  size_type cap = round_capacity(n);
+  char *p = static_cast<char *>(__alloc::allocate(cap + 1));
+  std::memcpy(p, s, n);
+  p[n] = '\0';
+  set_long(p, n, cap);
+}
+
+string::size_type string::grow_capacity(size_type n) const {
+  size_type doubled = capacity() * 2;
+  return round_capacity(doubled > n ? doubled : n);
+}
+
+void string::reallocate(size_type cap) {
+  size_type n = size();
+  char *p = static_cast<char *>(__alloc::allocate(cap + 1));
+  std::memcpy(p, data(), n + 1);
+  if (is_long())
+    __alloc::deallocate(rep.l.ptr, long_capacity() + 1);
+  set_long(p, n, cap);
+}
+
+void string::shrink_to_fit() {
+  if (!is_long())
+    return;
+  size_type n = size();
+  if (n <= StringAux::__sso_capacity) {
+    // 回到短模式
+    char *old = rep.l.ptr;
+    size_type old_cap = long_capacity();
+    std::memcpy(rep.s.buf, old, n);
+    set_short_size(n);
+    __alloc::deallocate(old, old_cap + 1);
+  } else if (round_capacity(n) < long_capacity()) {
+    reallocate(round_capacity(n));
+  }
+}
+
+string &string::append(const char *s, size_type n) {
+  size_type sz = size();
+  if (n > capacity() - sz) {
+    // s 可能指向旧的内存，先拷贝完再释放
+    size_type cap = grow_capacity(sz + n);
+    char *p = static_cast<char *>(__alloc::allocate(cap + 1));
+    std::memcpy(p, data(), sz);
+    std::memcpy(p + sz, s, n);
+    p[sz + n] = '\0';
+    if (is_long())
+      __alloc::deallocate(rep.l.ptr, long_capacity() + 1);
+    set_long(p, sz + n, cap);
+    return *this;
+  }
+  if (n != 0)
+    std::memcpy(data() + sz, s, n);
+  set_size(sz + n);
+  return *this;
+}
+
+string &string::append(size_type n, char c) {
+  size_type sz = size();
+  if (n > capacity() - sz)
+    reallocate(grow_capacity(sz + n));
+  std::memset(data() + sz, c, n);
+  set_size(sz + n);
+  return *this;
+}
+
+string &string::insert(size_type pos, string_view s) {
+  size_type sz = size();
+  if (pos > sz)
+    throw std::out_of_range("string::insert");
+  // s 指向自身时，移动元素会改写 s，先拷贝一份
+  if (s.data() >= data() && s.data() <= data() + sz) {
+    string tmp(s);
+    return insert(pos, tmp.view());
+  }
+  size_type n = s.size();
+  if (n == 0)
+    return *this;
+  if (n > capacity() - sz)
+    reallocate(grow_capacity(sz + n));
+  char *p = data();
+  std::memmove(p + pos + n, p + pos, sz - pos);
+  std::memcpy(p + pos, s.data(), n);
+  set_size(sz + n);
+  return *this;
+}
+
+string &string::erase(size_type pos, size_type n) {
+  size_type sz = size();
+  if (pos > sz)
+    throw std::out_of_range("string::erase");
+  if (n > sz - pos)
+    n = sz - pos;
+  char *p = data();
+  std::memmove(p + pos, p + pos + n, sz - pos - n);
+  set_size(sz - n);
+  return *this;
+}
+
+void string::resize(size_type n, char c) {
+  size_type sz = size();
+  if (n <= sz)
+    set_size(n);
+  else
+    append(n - sz, c);
+}
+
+}
@@ -0,0 +1,329 @@
+#ifndef TINYSTL_SRC_INTRUSIVE_LIST_H_
+#define TINYSTL_SRC_INTRUSIVE_LIST_H_
+
+/**
+ * 侵入式双向链表：链接（hook）直接嵌在用户对象里，插入不分配空间，容器也不负责对象的生命周期。
+ * 一个对象里放多个 hook，就可以同时挂在多个链表上，例如：
+ *
+ *   struct Connection {
+ *     intrusive_list_hook lru_hook;
+ *     intrusive_list_hook run_hook;
+ *   };
+ *   intrusive_list<Connection, &Connection::lru_hook> lru;
+ *   intrusive_list<Connection, &Connection::run_hook> run_queue;
+ *
+ * 对象可以通过 hook.unlink() 在 O(1) 内从所在链表中摘除，因此链表不缓存元素个数，size() 为 O(n)。
+ * 对象析构前必须先从链表中摘除（hook 析构时会自动摘除）。
+ */
+
+#include "functional.h" // for less<T>
+#include "iterator.h"
+
+namespace TinySTL {
+
+class intrusive_list_hook {
+  template<typename, typename, typename, typename>
+  friend
+  class __intrusive_list_iterator;
+  template<typename T, intrusive_list_hook T::*>
+  friend
+  class intrusive_list;
+
+ private:
+  intrusive_list_hook *prev;
+  intrusive_list_hook *next;
+
+ public:
+  intrusive_list_hook() : prev(nullptr), next(nullptr) {}
+  // hook 标识的是对象在链表中的位置，拷贝对象时不拷贝链接关系
+  intrusive_list_hook(const intrusive_list_hook &) : prev(nullptr), next(nullptr) {}
+  intrusive_list_hook &operator=(const intrusive_list_hook &) { return *this; }
+  ~intrusive_list_hook() { unlink(); }
+
+  bool is_linked() const { return next != nullptr; }
+  // 从所在的链表中摘除，未链接时什么也不做
+  void unlink() {
+    if (!is_linked())
+      return;
+    prev->next = next;
+    next->prev = prev;
+    prev = nullptr;
+    next = nullptr;
+  }
+
+ private:
+  // 仅用于哨兵
+  void init_head() {
+    prev = this;
+    next = this;
+  }
+};
+
+template<typename T, typename Ref, typename Ptr, typename HookOffset>
+class __intrusive_list_iterator : public iterator<bidirectional_iterator_tag, T> {
+ public:
+  using value_type = T;
+  using reference = Ref;
+  using pointer = Ptr;
+  using self_type = __intrusive_list_iterator;
+  using hook_ptr = intrusive_list_hook *;
+
+  template<typename T1, intrusive_list_hook T1::*>
+  friend
+  class intrusive_list;
+
+ private:
+  hook_ptr ptr;
+
+ public:
+  __intrusive_list_iterator() : ptr(nullptr) {}
+  explicit __intrusive_list_iterator(hook_ptr p) : ptr(p) {}
+
+  friend bool operator==(const self_type &lhs, const self_type &rhs) { return lhs.ptr == rhs.ptr; }
+  friend bool operator!=(const self_type &lhs, const self_type &rhs) { return lhs.ptr != rhs.ptr; }
+  reference operator*() const { return *HookOffset::to_value(ptr); }
+  pointer operator->() const { return &(operator*()); }
+  self_type &operator++() {
+    ptr = ptr->next;
+    return *this;
+  }
+  self_type &operator--() {
+    ptr = ptr->prev;
+    return *this;
+  }
+  self_type operator++(int) {
+    self_type tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  self_type operator--(int) {
+    self_type tmp = *this;
+    --(*this);
+    return tmp;
+  }
+};
+
+// 由 hook 的地址反推出对象的地址（类似 offsetof / container_of）
+template<typename T, intrusive_list_hook T::*Hook>
+struct __intrusive_hook_offset {
+  // 在一块真实的存储上取 hook 的地址，不对空指针解引用；只取地址，不构造对象，优化后是常量
+  static size_t offset() {
+    alignas(T) unsigned char buf[sizeof(T)];
+    T *p = reinterpret_cast<T *>(buf);
+    return static_cast<size_t>(reinterpret_cast<unsigned char *>(&(p->*Hook)) - buf);
+  }
+  static T *to_value(intrusive_list_hook *h) {
+    return reinterpret_cast<T *>(reinterpret_cast<char *>(h) - offset());
+  }
+  static intrusive_list_hook *to_hook(T &val) { return &(val.*Hook); }
+};
+
+template<typename T, intrusive_list_hook T::*Hook>
+class intrusive_list {
+ protected:
+  using hook_offset = __intrusive_hook_offset<T, Hook>;
+  using hook_ptr = intrusive_list_hook *;
+
+ public:
+  using value_type = T;
+  using iterator = __intrusive_list_iterator<T, T &, T *, hook_offset>;
+  using const_iterator = __intrusive_list_iterator<T, const T &, const T *, hook_offset>;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+ protected:
+  // 循环双向链表，哨兵内嵌
+  intrusive_list_hook dumpy_head;
+
+ public:
+  /**** 生命周期：不管理对象，因此不可拷贝，只能移动 ****/
+  intrusive_list() noexcept { dumpy_head.init_head(); }
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list &operator=(const intrusive_list &) = delete;
+  intrusive_list(intrusive_list &&x) noexcept : intrusive_list() { swap(*this, x); }
+  intrusive_list &operator=(intrusive_list &&x) noexcept {
+    clear();
+    swap(*this, x);
+    return *this;
+  }
+  // 只摘除元素，不析构对象
+  ~intrusive_list() { clear(); }
+
+  /*************** public const 成员函数 ************/
+  const_iterator begin() const { return const_iterator(dumpy_head.next); }
+  const_iterator end() const { return const_iterator(head()); }
+  size_type size() const { return static_cast<size_type>(TinySTL::distance(begin(), end())); }
+  bool empty() const { return dumpy_head.next == &dumpy_head; }
+  const_reference front() const { return *begin(); }
+  const_reference back() const { return *(--end()); }
+
+  /*************** public 成员函数 ************/
+  iterator begin() { return iterator(dumpy_head.next); }
+  iterator end() { return iterator(head()); }
+  reference front() { return *begin(); }
+  reference back() { return *(--end()); }
+  // 由对象得到指向它的迭代器，O(1)
+  static iterator iterator_to(reference val) { return iterator(hook_offset::to_hook(val)); }
+  static const_iterator iterator_to(const_reference val) {
+    return const_iterator(hook_offset::to_hook(const_cast<reference>(val)));
+  }
+
+  /*************** 插入、删除相关，均为 O(1) 且不分配空间 ************/
+  // 对象不能已经在同一个 hook 对应的其他链表中
+  iterator insert(iterator position, reference val) {
+    hook_ptr h = hook_offset::to_hook(val);
+    link_before(position.ptr, h);
+    return iterator(h);
+  }
+  void push_front(reference val) { insert(begin(), val); }
+  void push_back(reference val) { insert(end(), val); }
+  void pop_front() { dumpy_head.next->unlink(); }
+  void pop_back() { dumpy_head.prev->unlink(); }
+
+  iterator erase(iterator position) {
+    hook_ptr next = position.ptr->next;
+    position.ptr->unlink();
+    return iterator(next);
+  }
+  iterator erase(iterator first, iterator last) {
+    while (first != last)
+      first = erase(first);
+    return last;
+  }
+  // 从链表中摘除 val，与 val 的 hook 调用 unlink() 等价
+  static void remove(reference val) { hook_offset::to_hook(val)->unlink(); }
+  template<typename Predicate>
+  void remove_if(Predicate pred) {
+    auto it = begin();
+    auto last = end();
+    while (it != last) {
+      it = pred(*it) ? erase(it) : ++it;
+    }
+  }
+  void clear() {
+    hook_ptr p = dumpy_head.next;
+    while (p != &dumpy_head) {
+      hook_ptr next = p->next;
+      p->prev = nullptr;
+      p->next = nullptr;
+      p = next;
+    }
+    dumpy_head.init_head();
+  }
+
+  void splice(iterator position, intrusive_list &x) {
+    if (&x != this && !x.empty())
+      transfer(position.ptr, x.dumpy_head.next, x.head());
+  }
+  void splice(iterator position, intrusive_list &, iterator it) {
+    auto last = it;
+    ++last;
+    if (position == it || position == last)
+      return;
+    transfer(position.ptr, it.ptr, last.ptr);
+  }
+  void splice(iterator position, intrusive_list &, iterator first, iterator last) {
+    if (first != last)
+      transfer(position.ptr, first.ptr, last.ptr);
+  }
+
+  template<typename Compare>
+  void merge(intrusive_list &x, Compare comp) {
+    if (&x == this)
+      return;
+    auto it1 = begin();
+    auto it2 = x.begin();
+    auto last1 = end();
+    auto last2 = x.end();
+    while (it1 != last1 && it2 != last2) {
+      if (comp(*it2, *it1)) {
+        auto tmp = it2;
+        ++it2;
+        transfer(it1.ptr, tmp.ptr, it2.ptr);
+      } else {
+        ++it1;
+      }
+    }
+    if (it2 != last2)
+      transfer(last1.ptr, it2.ptr, last2.ptr);
+  }
+  void merge(intrusive_list &x) { merge(x, TinySTL::less<T>()); }
+
+  void reverse() {
+    if (empty() || dumpy_head.next->next == &dumpy_head)
+      return;
+    iterator it = begin();
+    ++it;
+    while (it != end()) {
+      auto tmp = it;
+      ++it;
+      transfer(begin().ptr, tmp.ptr, it.ptr);
+    }
+  }
+
+  template<typename Compare>
+  void sort(Compare comp) {
+    if (empty() || dumpy_head.next->next == &dumpy_head)
+      return;
+    intrusive_list carry;
+    intrusive_list counter[64];
+    int fill = 0;
+    while (!empty()) {
+      carry.splice(carry.begin(), *this, begin());
+      int i = 0;
+      while (i < fill && !counter[i].empty()) {
+        counter[i].merge(carry, comp);
+        swap(carry, counter[i++]);
+      }
+      swap(carry, counter[i]);
+      if (i == fill)
+        ++fill;
+    }
+    for (int i = 1; i < fill; ++i)
+      counter[i].merge(counter[i - 1], comp);
+    swap(*this, counter[fill - 1]);
+  }
+  void sort() { sort(TinySTL::less<T>()); }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(intrusive_list &x, intrusive_list &y) noexcept {
+    // 哨兵在对象内部，借助一个临时的空链表整体搬移
+    intrusive_list tmp;
+    x.transfer_all_to(tmp);
+    y.transfer_all_to(x);
+    tmp.transfer_all_to(y);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  hook_ptr head() { return &dumpy_head; }
+  hook_ptr head() const { return const_cast<hook_ptr>(&dumpy_head); }
+  void transfer_all_to(intrusive_list &y) noexcept {
+    if (!empty())
+      transfer(y.head(), dumpy_head.next, head());
+  }
+  static void link_before(hook_ptr position, hook_ptr h) {
+    h->prev = position->prev;
+    h->next = position;
+    position->prev->next = h;
+    position->prev = h;
+  }
+  // 将 [first, last) 移动到 position 之前
+  static void transfer(hook_ptr position, hook_ptr first, hook_ptr last) {
+    if (position != last) {
+      last->prev->next = position;
+      first->prev->next = last;
+      position->prev->next = first;
+      auto tmp = position->prev;
+      position->prev = last->prev;
+      last->prev = first->prev;
+      first->prev = tmp;
+    }
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_INTRUSIVE_LIST_H_
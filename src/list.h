@@ -8,8 +8,8 @@
 
 namespace TinySTL {
 
-template<typename T>
-struct __list_node {
+// 只包含链接的节点基类，list 的哨兵节点直接内嵌在 list 对象中，不带 T，也不需要分配空间
+struct __list_node_base {
   // 成员变量私有，通过定义 friend class 来访问
   template<typename, typename, typename>
   friend
@@ -19,15 +19,25 @@ struct __list_node {
   class list;
 
  private:
-  T data;
-  __list_node *prev;
-  __list_node *next;
+  __list_node_base *prev;
+  __list_node_base *next;
 
  public:
-  __list_node(const T &d, __list_node *p, __list_node *n) : data(d), prev(p), next(n) {}
-  friend bool operator==(const __list_node &lhs, const __list_node &rhs) {
-    return lhs.data = rhs.data && lhs.prev == rhs.prev && lhs.next == rhs.next;
-  }
+  __list_node_base() : prev(this), next(this) {}
+  __list_node_base(__list_node_base *p, __list_node_base *n) : prev(p), next(n) {}
+};
+
+template<typename T>
+struct __list_node : public __list_node_base {
+  template<typename, typename, typename>
+  friend
+  class __list_iterator;
+  template<typename, typename>
+  friend
+  class list;
+
+ private:
+  T data;
 };
 
 template<typename T, typename Ref, typename Ptr>
@@ -36,6 +46,7 @@ struct __list_iterator : public iterator<bidirectional_iterator_tag, T> {
   using reference = Ref;
   using pointer = Ptr;
   using self_type = __list_iterator<T, Ref, Ptr>;
+  using link_ptr = __list_node_base *;
   using node_ptr = __list_node<T> *;
 
   template<typename T1, typename Alloc>
@@ -43,16 +54,16 @@ struct __list_iterator : public iterator<bidirectional_iterator_tag, T> {
   class list;
 
  private:
-  node_ptr ptr;
+  link_ptr ptr;
 
  public:
   __list_iterator() : ptr(nullptr) {}
-  explicit __list_iterator(node_ptr p) : ptr(p) {}
+  explicit __list_iterator(link_ptr p) : ptr(p) {}
   __list_iterator(const self_type &val) : ptr(val.ptr) {}
 
   friend bool operator==(const self_type &lhs, const self_type &rhs) { return lhs.ptr == rhs.ptr; }
   friend bool operator!=(const self_type &lhs, const self_type &rhs) { return lhs.ptr != rhs.ptr; }
-  reference operator*() { return ptr->data; }
+  reference operator*() { return static_cast<node_ptr>(ptr)->data; }
   pointer operator->() { return &(operator*()); }
   self_type &operator++() {
     ptr = ptr->next;
@@ -77,9 +88,8 @@ template<typename T, typename Alloc=allocator<__list_node<T>>>
 class list {
  protected:
   using node = __list_node<T>;
-  using const_node = __list_node<const T>;
   using node_ptr = node *;
-  using const_node_ptr =  const_node *;
+  using link_ptr = __list_node_base *;
 
  public:
   using value_type = T;
@@ -91,50 +101,51 @@ class list {
 
  protected:
   using data_allocator = Alloc;
-  // 使用循环双向链表
-  node_ptr dumpy_head;
+  // 使用循环双向链表，哨兵节点内嵌在对象里，空 list 不需要分配空间
+  __list_node_base dumpy_head;
+  // 缓存元素个数，size() 为 O(1)
+  size_type node_count;
 
  public:
   /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
-  list() { init_dumpy_head(); };
-  explicit list(size_type n, const value_type &val = value_type()) {
+  list() noexcept : dumpy_head(), node_count(0) {}
+  explicit list(size_type n, const value_type &val = value_type()) : list() {
     typedef typename __type_traits<size_type>::is_integer is_integer;
     ctor_aux(n, val, is_integer());
   }
   template<typename InputIterator>
-  list(InputIterator first, InputIterator last) {
+  list(InputIterator first, InputIterator last) : list() {
     typedef typename __type_traits<InputIterator>::is_integer is_integer;
     ctor_aux(first, last, is_integer());
   }
   // Rule of five
   list(const list &l) : list(l.begin(), l.end()) {}
-  list(list &&x) : list() { swap(*this, x); }
+  list(list &&x) noexcept : list() { swap(*this, x); }
   list &operator=(list l) {
     swap(*this, l);
     return *this;
   }
   ~list() {
-    auto p = dumpy_head->next;
+    auto p = dumpy_head.next;
     auto next_p = p->next;
-    for (; p != dumpy_head; p = next_p) {
+    for (; p != &dumpy_head; p = next_p) {
       next_p = p->next;
-      delete_node(p);
+      delete_node(static_cast<node_ptr>(p));
     }
-    delete_node(dumpy_head);
   }
   /*************** public const member functions ************/
-  const_iterator begin() const { return const_iterator(dumpy_head->next); }
-  const_iterator end() const { return const_iterator(dumpy_head); }
-  size_type size() const { return static_cast<size_type>(TinySTL::distance(begin(), end())); }
-  bool empty() const { return dumpy_head->next == dumpy_head; }
+  const_iterator begin() const { return const_iterator(dumpy_head.next); }
+  const_iterator end() const { return const_iterator(head()); }
+  size_type size() const { return node_count; }
+  bool empty() const { return node_count == 0; }
 
   /*************** public member functions ************/
-  iterator begin() { return iterator(dumpy_head->next); }
-  iterator end() { return iterator(dumpy_head); }
+  iterator begin() { return iterator(dumpy_head.next); }
+  iterator end() { return iterator(head()); }
 
   /*************** 访问元素相关 ************/
-  reference front() { return dumpy_head->next->data; }
-  reference back() { return dumpy_head->prev->data; }
+  reference front() { return static_cast<node_ptr>(dumpy_head.next)->data; }
+  reference back() { return static_cast<node_ptr>(dumpy_head.prev)->data; }
 
   /*************** 插入、删除相关 ************/
   void insert(iterator position, const value_type &val) { __insert(position.ptr, val); }
@@ -147,10 +158,10 @@ class list {
     typedef typename __type_traits<InputIterator>::is_integer is_integer;
     insert_aux(position, first, last, is_integer());
   }
-  void push_front(const value_type &val) { __insert(dumpy_head->next, val); }
-  void pop_front() { __erase(dumpy_head->next); }
-  void push_back(const value_type &val) { __insert(dumpy_head, val); }
-  void pop_back() { __erase(dumpy_head->prev); }
+  void push_front(const value_type &val) { __insert(dumpy_head.next, val); }
+  void pop_front() { __erase(dumpy_head.next); }
+  void push_back(const value_type &val) { __insert(head(), val); }
+  void pop_back() { __erase(dumpy_head.prev); }
 
   iterator erase(iterator position) { return iterator(__erase(position.ptr)); }
   iterator erase(iterator first, iterator last) { return iterator(__erase(first.ptr, last.ptr)); }
@@ -172,25 +183,40 @@ class list {
       it = pred(*it) ? erase(it) : ++it;
     }
   }
+  // 整个 x 移过来，元素个数直接转移，O(1)
   void splice(iterator position, list &x) {
-    splice(position, x, x.begin(), x.end());
+    if (&x == this || x.empty())
+      return;
+    size_type n = x.node_count;
+    transfer(position.ptr, x.dumpy_head.next, x.head());
+    node_count += n;
+    x.node_count = 0;
   }
   void splice(iterator position, list &x, iterator it) {
     auto last = it;
     ++last;
-    splice(position, x, it, last);
+    if (position == it || position == last)
+      return;
+    transfer(position.ptr, it.ptr, last.ptr);
+    ++node_count;
+    --x.node_count;
   }
-  void splice(iterator position, list &, iterator first, iterator last) {
-    node_ptr curr = first.ptr;
-    node_ptr prev = first.ptr->prev;
-    node_ptr next = last.ptr;
-    transfer(position.ptr, curr, next);
-    prev->next = next;
-    next->prev = prev;
+  // 从其他 list 移动一段元素时需要数出个数，O(n)；同一个 list 内部移动为 O(1)
+  void splice(iterator position, list &x, iterator first, iterator last) {
+    if (first == last)
+      return;
+    if (&x != this) {
+      size_type n = static_cast<size_type>(TinySTL::distance(first, last));
+      node_count += n;
+      x.node_count -= n;
+    }
+    transfer(position.ptr, first.ptr, last.ptr);
   }
 
   template<typename Compare>
   void merge(list &x, Compare comp) {
+    if (&x == this)
+      return;
     auto it1 = begin();
     auto it2 = x.begin();
     auto last1 = end();
@@ -206,11 +232,13 @@ class list {
     }
     if (it2 != last2)
       transfer(last1.ptr, it2.ptr, last2.ptr);
+    node_count += x.node_count;
+    x.node_count = 0;
   }
   void merge(list &x) { merge(x, TinySTL::less<T>()); }
 
   void reverse() {
-    if (dumpy_head->next->next == dumpy_head)
+    if (node_count < 2)
       return;
     iterator it = begin();
     ++it;
@@ -223,13 +251,13 @@ class list {
 
   template<typename Compare>
   void sort(Compare comp) {
-    if (dumpy_head->next->next == dumpy_head)
+    if (node_count < 2)
       return;
-    list<T> carry;
-    list<T> counter[64];
+    // 哨兵内嵌之后，这里的 65 个临时 list 都不需要分配空间
+    list carry;
+    list counter[64];
     int fill = 0;
     while (!empty()) {
-      auto size = this->size();
       carry.splice(carry.begin(), *this, begin());
       int i = 0;
       while (i < fill && !counter[i].empty()) {
@@ -247,26 +275,37 @@ class list {
   void sort() { sort(TinySTL::less<T>()); }
  public:
   /*************** 我的朋友 ************/
-  friend void swap(list &x, list &y) {
-    using TinySTL::swap;
-    swap(x.dumpy_head, y.dumpy_head);
-  }
+  // 哨兵节点在对象内部，不能直接交换指针，需要把两边首尾节点重新指向新的哨兵
+  friend void swap(list &x, list &y) noexcept { x.swap_head(y); }
 
   /*************** 辅助函数 ************/
  protected:
-  void init_dumpy_head() {
-    dumpy_head = new_node();
-    dumpy_head->prev = dumpy_head;
-    dumpy_head->next = dumpy_head;
+  link_ptr head() { return &dumpy_head; }
+  link_ptr head() const { return const_cast<link_ptr>(&dumpy_head); }
+  void swap_head(list &y) noexcept {
+    using TinySTL::swap;
+    swap(dumpy_head.prev, y.dumpy_head.prev);
+    swap(dumpy_head.next, y.dumpy_head.next);
+    swap(node_count, y.node_count);
+    relink_head(&y.dumpy_head);
+    y.relink_head(&dumpy_head);
+  }
+  // 交换之后，首尾节点还指向旧的哨兵 old_head，把它们改回自己的哨兵
+  void relink_head(link_ptr old_head) noexcept {
+    if (dumpy_head.next == old_head) {
+      dumpy_head.prev = head();
+      dumpy_head.next = head();
+    } else {
+      dumpy_head.next->prev = head();
+      dumpy_head.prev->next = head();
+    }
   }
   void ctor_aux(size_type n, const value_type &val, __true_type) {
-    init_dumpy_head();
     for (; n > 0; --n)
       push_back(val);
   }
   template<typename InputIterator>
   void ctor_aux(InputIterator first, InputIterator last, __false_type) {
-    init_dumpy_head();
     for (; first != last; ++first)
       push_back(*first);
   }
@@ -281,39 +320,45 @@ class list {
   }
 
  protected:
-  node_ptr new_node(const T &val = T(), node_ptr pre = nullptr, node_ptr next = nullptr) {
+  // 只构造 data，链接由调用者负责
+  node_ptr new_node(const T &val) {
     node_ptr res = data_allocator::allocate();
-    data_allocator::construct(res, node(val, pre, next));
+    data_allocator::construct(&(res->data), val);
     return res;
   }
   void delete_node(node_ptr p) {
     data_allocator::destroy(&(p->data));
     data_allocator::deallocate(p);
   }
-  void __insert(node_ptr position, const value_type &val) {
-    auto tmp_node = new_node(val, position->prev, position);
+  void __insert(link_ptr position, const value_type &val) {
+    node_ptr tmp_node = new_node(val);
+    tmp_node->prev = position->prev;
+    tmp_node->next = position;
     position->prev->next = tmp_node;
     position->prev = tmp_node;
+    ++node_count;
   }
-  node_ptr __erase(node_ptr position) {
+  link_ptr __erase(link_ptr position) {
     position->prev->next = position->next;
     position->next->prev = position->prev;
     auto res = position->next;
-    delete_node(position);
+    delete_node(static_cast<node_ptr>(position));
+    --node_count;
     return res;
   }
-  node_ptr __erase(node_ptr first, node_ptr last) {
+  link_ptr __erase(link_ptr first, link_ptr last) {
     first->prev->next = last;
     last->prev = first->prev;
-    auto next = first->next;
     while (first != last) {
-      delete_node(first);
+      auto next = first->next;
+      delete_node(static_cast<node_ptr>(first));
+      --node_count;
       first = next;
-      next = next->next;
     }
     return last;
   }
-  void transfer(node_ptr position, node_ptr first, node_ptr last) {
+  // 将 [first, last) 移动到 position 之前，不维护 node_count
+  void transfer(link_ptr position, link_ptr first, link_ptr last) {
     if (position != last) {
       last->prev->next = position;
       first->prev->next = last;
@@ -0,0 +1,183 @@
+#ifndef TINYSTL_SRC_MPMC_QUEUE_H_
+#define TINYSTL_SRC_MPMC_QUEUE_H_
+
+/**
+ * 有界多生产者多消费者（MPMC）无锁队列，Dmitry Vyukov 的算法。
+ * 每个槽位带一个序号 sequence：
+ *  - sequence == pos：槽位空闲，等待第 pos 次 push；
+ *  - sequence == pos + 1：槽位已写入，等待第 pos 次 pop；pop 之后置为 pos + capacity，留给下一轮。
+ * 生产者之间、消费者之间只在 enqueue_pos/dequeue_pos 上 CAS 竞争，生产者与消费者之间通过槽位的序号同步。
+ * 槽位数组通过 __alloc 申请并按缓存行对齐；两个下标各占一个缓存行。
+ *
+ * 注意：
+ *  1. 容量向上取整为 2 的幂，至少为 2。
+ *  2. 队列不可拷贝、不可移动；析构时不能有其他线程在访问。
+ *  3. size()、empty() 在并发时只是一个瞬时的近似值。
+ *  4. stats() 统计 CAS 失败重试、队列满、队列空的次数，只在慢路径上计数，用来观察竞争程度。
+ */
+
+#include <atomic>
+
+#include "__alloc.h"
+#include "__concurrent.h"
+#include "__construct.h"
+
+namespace TinySTL {
+
+struct mpmc_queue_stats {
+  size_t push_retries; // push 时 CAS 失败或下标过期的次数
+  size_t pop_retries;  // pop 时 CAS 失败或下标过期的次数
+  size_t push_full;    // try_push 因队列满而失败的次数
+  size_t pop_empty;    // try_pop 因队列空而失败的次数
+};
+
+template<typename T>
+struct __mpmc_queue_slot {
+  std::atomic<size_t> sequence;
+  alignas(T) unsigned char storage[sizeof(T)];
+
+  T *data() { return reinterpret_cast<T *>(storage); }
+};
+
+template<typename T>
+class mpmc_queue {
+ public:
+  using value_type = T;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+ protected:
+  using slot = __mpmc_queue_slot<T>;
+
+ protected:
+  // 构造后只读
+  alignas(__cache_line_size) slot *buffer;
+  size_type mask;
+  void *raw_buffer;
+  size_type raw_bytes;
+  // 生产者之间竞争
+  alignas(__cache_line_size) std::atomic<size_type> enqueue_pos;
+  // 消费者之间竞争
+  alignas(__cache_line_size) std::atomic<size_type> dequeue_pos;
+  // 统计，只在慢路径上累加
+  alignas(__cache_line_size) std::atomic<size_type> push_retries;
+  std::atomic<size_type> pop_retries;
+  std::atomic<size_type> push_full;
+  std::atomic<size_type> pop_empty;
+
+ public:
+  /**** 生命周期：不可拷贝、不可移动 ****/
+  explicit mpmc_queue(size_type capacity) :
+      enqueue_pos(0), dequeue_pos(0), push_retries(0), pop_retries(0), push_full(0), pop_empty(0) {
+    size_type cap = 2;
+    while (cap < capacity)
+      cap <<= 1;
+    mask = cap - 1;
+    // 多申请一个缓存行，手动对齐
+    raw_bytes = sizeof(slot) * cap + __cache_line_size;
+    raw_buffer = __alloc::allocate(raw_bytes);
+    size_t addr = reinterpret_cast<size_t>(raw_buffer);
+    addr = (addr + __cache_line_size - 1) & ~(__cache_line_size - 1);
+    buffer = reinterpret_cast<slot *>(addr);
+    for (size_type i = 0; i != cap; ++i)
+      new(&buffer[i].sequence) std::atomic<size_type>(i);
+  }
+  mpmc_queue(const mpmc_queue &) = delete;
+  mpmc_queue &operator=(const mpmc_queue &) = delete;
+  ~mpmc_queue() {
+    size_type last = enqueue_pos.load(std::memory_order_relaxed);
+    for (size_type pos = dequeue_pos.load(std::memory_order_relaxed); pos != last; ++pos)
+      __construct::destroy(buffer[pos & mask].data());
+    __alloc::deallocate(raw_buffer, raw_bytes);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type capacity() const { return mask + 1; }
+  size_type size() const {
+    size_type d = dequeue_pos.load(std::memory_order_acquire);
+    size_type e = enqueue_pos.load(std::memory_order_acquire);
+    return e > d ? e - d : 0;
+  }
+  bool empty() const { return size() == 0; }
+  mpmc_queue_stats stats() const {
+    return mpmc_queue_stats{push_retries.load(std::memory_order_relaxed),
+                            pop_retries.load(std::memory_order_relaxed),
+                            push_full.load(std::memory_order_relaxed),
+                            pop_empty.load(std::memory_order_relaxed)};
+  }
+  void reset_stats() {
+    push_retries.store(0, std::memory_order_relaxed);
+    pop_retries.store(0, std::memory_order_relaxed);
+    push_full.store(0, std::memory_order_relaxed);
+    pop_empty.store(0, std::memory_order_relaxed);
+  }
+
+  /*************** 入队、出队 ************/
+  bool try_push(const value_type &val) {
+    size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+    slot *s;
+    while (true) {
+      s = &buffer[pos & mask];
+      size_type seq = s->sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+      if (diff == 0) {
+        // 槽位空闲，抢占第 pos 次 push。失败时 pos 会被更新为最新值
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+        push_retries.fetch_add(1, std::memory_order_relaxed);
+      } else if (diff < 0) {
+        // 槽位上一轮的元素还没被取走：队列满
+        push_full.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        // 其他生产者已经抢走了 pos
+        push_retries.fetch_add(1, std::memory_order_relaxed);
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    __construct::construct(s->data(), val);
+    s->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+  bool try_pop(value_type &val) {
+    size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+    slot *s;
+    while (true) {
+      s = &buffer[pos & mask];
+      size_type seq = s->sequence.load(std::memory_order_acquire);
+      ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+        pop_retries.fetch_add(1, std::memory_order_relaxed);
+      } else if (diff < 0) {
+        // 第 pos 次 push 还没完成：队列空
+        pop_empty.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pop_retries.fetch_add(1, std::memory_order_relaxed);
+        pos = dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+    val = *s->data();
+    __construct::destroy(s->data());
+    s->sequence.store(pos + mask + 1, std::memory_order_release);
+    return true;
+  }
+  // 阻塞版本：自旋等待，之后让出时间片
+  void push(const value_type &val) {
+    __backoff backoff;
+    while (!try_push(val))
+      backoff.pause();
+  }
+  void pop(value_type &val) {
+    __backoff backoff;
+    while (!try_pop(val))
+      backoff.pause();
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_MPMC_QUEUE_H_
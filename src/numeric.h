@@ -0,0 +1,47 @@
+#ifndef TINYSTL_SRC_NUMERIC_H_
+#define TINYSTL_SRC_NUMERIC_H_
+
+#include "functional.h"
+#include "iterator.h"
+
+namespace TinySTL {
+
+/***************** [accumulate] T(n) = O(n) *********************/
+/// 从左到右依次累加，保证求值顺序
+template<typename InputIterator, typename T>
+T
+accumulate(InputIterator first, InputIterator last, T init) {
+  for (; first != last; ++first)
+    init = init + *first;
+  return init;
+}
+template<typename InputIterator, typename T, typename BinaryOperation>
+T
+accumulate(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+  for (; first != last; ++first)
+    init = op(init, *first);
+  return init;
+}
+
+/***************** [reduce] T(n) = O(n) *********************/
+/// 与 accumulate 相同，但不保证求值顺序，op 需满足结合律和交换律，从而可以分块并行（见 parallel_algorithm.h）
+template<typename InputIterator, typename T, typename BinaryOperation>
+inline T
+reduce(InputIterator first, InputIterator last, T init, BinaryOperation op) {
+  return TinySTL::accumulate(first, last, init, op);
+}
+template<typename InputIterator, typename T>
+inline T
+reduce(InputIterator first, InputIterator last, T init) {
+  return TinySTL::reduce(first, last, init, TinySTL::plus<T>());
+}
+template<typename InputIterator>
+inline typename iterator_traits<InputIterator>::value_type
+reduce(InputIterator first, InputIterator last) {
+  typedef typename iterator_traits<InputIterator>::value_type T;
+  return TinySTL::reduce(first, last, T(), TinySTL::plus<T>());
+}
+
+}
+
+#endif //TINYSTL_SRC_NUMERIC_H_
@@ -0,0 +1,545 @@
+#ifndef TINYSTL_SRC_PARALLEL_ALGORITHM_H_
+#define TINYSTL_SRC_PARALLEL_ALGORITHM_H_
+
+/**
+ * 带执行策略的算法重载：fill、fill_n、copy、for_each、transform、reduce、sort、make_heap 以及 uninitialized_* 系列。
+ *
+ *   TinySTL::sort(TinySTL::execution::par, v.begin(), v.end());
+ *
+ * 并行的条件：策略为 par 或 par_unseq，所有迭代器都是随机访问迭代器，元素类型都是 POD，
+ * 规模不小于 __min_parallel_size，且 scheduler::instance() 不止一个线程；否则退化为串行版本。
+ * 只并行 POD 是因为非 POD 元素的拷贝、赋值、析构可能经由 __alloc 申请内存（长 string、vector、function 等），
+ * 而 __alloc 的 free-list 不是线程安全的。
+ * 区间被切成若干块交给 scheduler，每块在调用线程之外独立运行对应的串行算法（因此照样能用上 memmove、memset）。
+ * 块的大小至少为 __chunk_bytes，且是缓存行的整数倍，避免相邻两块写同一个缓存行。
+ * first_touch 策略下 uninitialized_fill、uninitialized_fill_n 改为按工作线程数静态均分，第 i 块由第 i 个工作线程写入（见 execution.h）。
+ *
+ * 注意：
+ *  1. for_each、transform 的函数对象会被多个线程同时调用，需自行保证线程安全，且不能经由 __alloc 申请内存。
+ *  2. reduce 的 op 需满足结合律和交换律，各块的部分和的合并顺序不确定。
+ *  3. sort 是并行的快速排序：划分本身串行，两半并行递归，因此前几层的划分会限制加速比。
+ *  4. 任务中抛出的异常在算法返回前重新抛出，此时区间中的元素状态不确定（uninitialized_* 不会析构已构造的元素）。
+ */
+
+#include <cstdint>
+#include <iterator>
+
+#include "__concurrent.h"
+#include "algorithm.h"
+#include "execution.h"
+#include "numeric.h"
+#include "scheduler.h"
+#include "uninitialized.h"
+
+namespace TinySTL {
+
+namespace ParallelAux {
+// 元素个数低于此值时串行执行
+const size_t __min_parallel_size = 1 << 15;
+// 每块至少这么多字节，大致是 L2 缓存的一部分
+const size_t __chunk_bytes = 64 * 1024;
+// 每个线程大约分到多少块，块越多负载越均衡，调度开销也越大
+const size_t __chunks_per_thread = 16;
+// 并行 sort 中小于这个长度的区间不再拆分任务
+const ptrdiff_t __sort_grain = 1 << 14;
+// first_touch 按页切块
+const size_t __page_size = 4096;
+}
+
+/***************** [dispatch] *********************/
+// 只有随机访问迭代器才能切块；std 容器的迭代器带的是 std 的 tag
+inline __true_type __is_random_access(random_iterator_tag) { return __true_type(); }
+inline __true_type __is_random_access(std::random_access_iterator_tag) { return __true_type(); }
+template<typename IteratorTag>
+inline __false_type __is_random_access(IteratorTag) { return __false_type(); }
+
+inline __true_type __and(__true_type, __true_type) { return __true_type(); }
+template<typename Cond1, typename Cond2>
+inline __false_type __and(Cond1, Cond2) { return __false_type(); }
+
+// __alloc 不是线程安全的，只有 POD 元素可以在工作线程上拷贝、赋值
+template<typename Iterator>
+inline typename __type_traits<typename iterator_traits<Iterator>::value_type>::is_POD_type
+__is_pod_value(const Iterator &) {
+  return typename __type_traits<typename iterator_traits<Iterator>::value_type>::is_POD_type();
+}
+template<typename Iterator>
+inline auto
+__is_parallel_iterator(const Iterator &it)
+-> decltype(TinySTL::__and(__is_random_access(iterator_category(it)), __is_pod_value(it))) {
+  return TinySTL::__and(__is_random_access(iterator_category(it)), __is_pod_value(it));
+}
+
+template<typename ExecutionPolicy, typename Iterator>
+inline auto
+__run_parallel(const ExecutionPolicy &policy, const Iterator &it)
+-> decltype(TinySTL::__and(__allow_parallel(policy), __is_parallel_iterator(it))) {
+  return TinySTL::__and(__allow_parallel(policy), __is_parallel_iterator(it));
+}
+template<typename ExecutionPolicy, typename Iterator1, typename Iterator2>
+inline auto
+__run_parallel(const ExecutionPolicy &policy, const Iterator1 &it1, const Iterator2 &it2)
+-> decltype(TinySTL::__and(__run_parallel(policy, it1), __is_parallel_iterator(it2))) {
+  return TinySTL::__and(__run_parallel(policy, it1), __is_parallel_iterator(it2));
+}
+
+/***************** [chunk] *********************/
+/// n 个大小为 elem_size 的元素每块的长度，返回 0 表示应当串行执行
+inline size_t
+__chunk_grain(size_t n, size_t elem_size, const scheduler &sched) {
+  if (n < ParallelAux::__min_parallel_size || sched.size() == 1)
+    return 0;
+  size_t grain = ParallelAux::__chunk_bytes / elem_size;
+  size_t balanced = n / (sched.size() * ParallelAux::__chunks_per_thread);
+  if (grain < balanced)
+    grain = balanced;
+  size_t line = __cache_line_size / elem_size;
+  if (line > 1)
+    grain = (grain + line - 1) / line * line;
+  return grain == 0 ? 1 : grain;
+}
+
+/// 把 [0, n) 切块，对每块调用 f(lo, hi)；不值得并行时直接调用 f(0, n)
+template<typename Function>
+void
+__parallel_chunks(size_t n, size_t elem_size, const Function &f) {
+  scheduler &sched = scheduler::instance();
+  size_t grain = TinySTL::__chunk_grain(n, elem_size, sched);
+  if (grain == 0 || grain >= n) {
+    f(size_t(0), n);
+    return;
+  }
+  size_t chunks = (n + grain - 1) / grain;
+  TinySTL::parallel_for(size_t(0), chunks, [&f, grain, n](size_t lo, size_t hi) {
+    f(lo * grain, hi * grain < n ? hi * grain : n);
+  }, size_t(1), sched);
+}
+
+// 各块的部分结果。用 operator new 而不是 __alloc：调用线程本身也可能是工作线程
+template<typename T>
+class __parallel_buffer {
+ private:
+  T *data;
+  size_t len;
+
+ public:
+  __parallel_buffer(size_t n, const T &val) :
+      data(static_cast<T *>(::operator new(n * sizeof(T)))), len(n) {
+    TinySTL::uninitialized_fill_n(data, n, val);
+  }
+  __parallel_buffer(const __parallel_buffer &) = delete;
+  __parallel_buffer &operator=(const __parallel_buffer &) = delete;
+  ~__parallel_buffer() {
+    __construct::destroy(data, data + len);
+    ::operator delete(data);
+  }
+  T &operator[](size_t i) { return data[i]; }
+};
+
+/***************** [fill] *********************/
+template<typename ForwardIterator, typename T>
+inline void
+__parallel_fill(ForwardIterator first, ForwardIterator last, const T &val, __false_type) {
+  TinySTL::fill(first, last, val);
+}
+template<typename RandomAccessIterator, typename T>
+void
+__parallel_fill(RandomAccessIterator first, RandomAccessIterator last, const T &val, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  TinySTL::__parallel_chunks(last - first, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::fill(first + lo, first + hi, val);
+  });
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename T>
+inline __enable_if_policy<ExecutionPolicy>
+fill(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, const T &val) {
+  TinySTL::__parallel_fill(first, last, val, TinySTL::__run_parallel(policy, first));
+}
+
+/***************** [fill_n] *********************/
+template<typename OutputIterator, typename Size, typename T>
+inline OutputIterator
+__parallel_fill_n(OutputIterator first, Size n, const T &val, __false_type) {
+  return TinySTL::fill_n(first, n, val);
+}
+template<typename RandomAccessIterator, typename Size, typename T>
+inline RandomAccessIterator
+__parallel_fill_n(RandomAccessIterator first, Size n, const T &val, __true_type) {
+  if (n <= 0)
+    return first;
+  TinySTL::__parallel_fill(first, first + n, val, __true_type());
+  return first + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename Size, typename T>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator>
+fill_n(const ExecutionPolicy &policy, ForwardIterator first, Size n, const T &val) {
+  return TinySTL::__parallel_fill_n(first, n, val, TinySTL::__run_parallel(policy, first));
+}
+
+/***************** [copy] *********************/
+template<typename InputIterator, typename OutputIterator>
+inline OutputIterator
+__parallel_copy(InputIterator first, InputIterator last, OutputIterator result, __false_type) {
+  return TinySTL::copy(first, last, result);
+}
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator2
+__parallel_copy(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator2>::value_type value_type;
+  size_t n = last - first;
+  TinySTL::__parallel_chunks(n, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::copy(first + lo, first + hi, result + lo);
+  });
+  return result + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator2>
+copy(const ExecutionPolicy &policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result) {
+  return TinySTL::__parallel_copy(first, last, result, TinySTL::__run_parallel(policy, first, result));
+}
+
+/***************** [for_each] *********************/
+template<typename InputIterator, typename Function>
+inline void
+__parallel_for_each(InputIterator first, InputIterator last, const Function &f, __false_type) {
+  TinySTL::for_each(first, last, f);
+}
+template<typename RandomAccessIterator, typename Function>
+void
+__parallel_for_each(RandomAccessIterator first, RandomAccessIterator last, const Function &f, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  TinySTL::__parallel_chunks(last - first, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::for_each(first + lo, first + hi, f);
+  });
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename Function>
+inline __enable_if_policy<ExecutionPolicy>
+for_each(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, Function f) {
+  TinySTL::__parallel_for_each(first, last, f, TinySTL::__run_parallel(policy, first));
+}
+
+/***************** [transform] *********************/
+template<typename InputIterator, typename OutputIterator, typename UnaryOperation>
+inline OutputIterator
+__parallel_transform(InputIterator first, InputIterator last, OutputIterator result, const UnaryOperation &op,
+                     __false_type) {
+  return TinySTL::transform(first, last, result, op);
+}
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename UnaryOperation>
+RandomAccessIterator2
+__parallel_transform(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result,
+            const UnaryOperation &op, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator2>::value_type value_type;
+  size_t n = last - first;
+  TinySTL::__parallel_chunks(n, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::transform(first + lo, first + hi, result + lo, op);
+  });
+  return result + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename UnaryOperation>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator2>
+transform(const ExecutionPolicy &policy, ForwardIterator1 first, ForwardIterator1 last, ForwardIterator2 result,
+          UnaryOperation op) {
+  return TinySTL::__parallel_transform(first, last, result, op, TinySTL::__run_parallel(policy, first, result));
+}
+
+template<typename InputIterator1, typename InputIterator2, typename OutputIterator, typename BinaryOperation>
+inline OutputIterator
+__parallel_transform(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, OutputIterator result,
+            const BinaryOperation &op, __false_type) {
+  return TinySTL::transform(first1, last1, first2, result, op);
+}
+template<typename RandomAccessIterator1, typename RandomAccessIterator2, typename RandomAccessIterator3,
+    typename BinaryOperation>
+RandomAccessIterator3
+__parallel_transform(RandomAccessIterator1 first1, RandomAccessIterator1 last1, RandomAccessIterator2 first2,
+            RandomAccessIterator3 result, const BinaryOperation &op, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator3>::value_type value_type;
+  size_t n = last1 - first1;
+  TinySTL::__parallel_chunks(n, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::transform(first1 + lo, first1 + hi, first2 + lo, result + lo, op);
+  });
+  return result + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2, typename ForwardIterator3,
+    typename BinaryOperation>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator3>
+transform(const ExecutionPolicy &policy, ForwardIterator1 first1, ForwardIterator1 last1, ForwardIterator2 first2,
+          ForwardIterator3 result, BinaryOperation op) {
+  auto tag = TinySTL::__and(TinySTL::__run_parallel(policy, first1, first2), __is_parallel_iterator(result));
+  return TinySTL::__parallel_transform(first1, last1, first2, result, op, tag);
+}
+
+/***************** [reduce] *********************/
+template<typename InputIterator, typename T, typename BinaryOperation>
+inline T
+__parallel_reduce(InputIterator first, InputIterator last, T init, BinaryOperation op, __false_type) {
+  return TinySTL::reduce(first, last, init, op);
+}
+// 每块从块内第一个元素开始累加，最后按块的顺序把部分结果合并到 init 上
+template<typename RandomAccessIterator, typename T, typename BinaryOperation>
+T
+__parallel_reduce(RandomAccessIterator first, RandomAccessIterator last, T init, BinaryOperation op,
+                  __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  size_t n = last - first;
+  scheduler &sched = scheduler::instance();
+  size_t grain = TinySTL::__chunk_grain(n, sizeof(value_type), sched);
+  if (grain == 0 || grain >= n)
+    return TinySTL::reduce(first, last, init, op);
+  size_t chunks = (n + grain - 1) / grain;
+  __parallel_buffer<T> partial(chunks, init);
+  TinySTL::parallel_for(size_t(0), chunks, [&](size_t lo, size_t hi) {
+    for (size_t c = lo; c != hi; ++c) {
+      auto chunk_first = first + c * grain;
+      auto chunk_last = (c + 1) * grain < n ? first + (c + 1) * grain : last;
+      partial[c] = TinySTL::accumulate(chunk_first + 1, chunk_last, T(*chunk_first), op);
+    }
+  }, size_t(1), sched);
+  for (size_t c = 0; c != chunks; ++c)
+    init = op(init, partial[c]);
+  return init;
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename T, typename BinaryOperation>
+inline __enable_if_policy<ExecutionPolicy, T>
+reduce(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, T init, BinaryOperation op) {
+  // 部分和在工作线程上拷贝，T 也必须是 POD
+  auto tag = TinySTL::__and(TinySTL::__run_parallel(policy, first), typename __type_traits<T>::is_POD_type());
+  return TinySTL::__parallel_reduce(first, last, init, op, tag);
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename T>
+inline __enable_if_policy<ExecutionPolicy, T>
+reduce(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, T init) {
+  return TinySTL::reduce(policy, first, last, init, TinySTL::plus<T>());
+}
+template<typename ExecutionPolicy, typename ForwardIterator>
+inline __enable_if_policy<ExecutionPolicy, typename iterator_traits<ForwardIterator>::value_type>
+reduce(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last) {
+  typedef typename iterator_traits<ForwardIterator>::value_type T;
+  return TinySTL::reduce(policy, first, last, T(), TinySTL::plus<T>());
+}
+
+/***************** [sort] *********************/
+// 划分一次，右半边交给别的线程，自己继续划分左半边；深度用完后剩下的交给串行 introsort 的堆排序
+template<typename RandomAccessIterator, typename Compare>
+void
+__parallel_introsort(RandomAccessIterator first, RandomAccessIterator last, ptrdiff_t depth_limit, Compare cmp,
+                     scheduler &sched) {
+  task_group g(sched);
+  while (last - first > ParallelAux::__sort_grain && depth_limit > 0) {
+    --depth_limit;
+    auto cut = TinySTL::__partition_by_median(first, last, cmp);
+    g.spawn([cut, last, depth_limit, cmp, &sched] {
+      TinySTL::__parallel_introsort(cut, last, depth_limit, cmp, sched);
+    });
+    last = cut;
+  }
+  TinySTL::__introsort_loop(first, last, depth_limit, cmp);
+  TinySTL::__insertion_sort(first, last, cmp);
+  g.sync();
+}
+template<typename RandomAccessIterator, typename Compare>
+inline void
+__parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, __false_type) {
+  TinySTL::sort(first, last, cmp);
+}
+template<typename RandomAccessIterator, typename Compare>
+void
+__parallel_sort(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, __true_type) {
+  scheduler &sched = scheduler::instance();
+  ptrdiff_t n = last - first;
+  if (n < static_cast<ptrdiff_t>(ParallelAux::__min_parallel_size) || sched.size() == 1) {
+    TinySTL::sort(first, last, cmp);
+    return;
+  }
+  TinySTL::__parallel_introsort(first, last, TinySTL::__lg(n) * 2, cmp, sched);
+}
+template<typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+inline __enable_if_policy<ExecutionPolicy>
+sort(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {
+  TinySTL::__parallel_sort(first, last, cmp, TinySTL::__run_parallel(policy, first));
+}
+template<typename ExecutionPolicy, typename RandomAccessIterator>
+inline __enable_if_policy<ExecutionPolicy>
+sort(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  TinySTL::sort(policy, first, last, TinySTL::less<value_type>());
+}
+
+/***************** [make_heap] *********************/
+template<typename RandomAccessIterator, typename Compare>
+inline void
+__parallel_make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, __false_type) {
+  TinySTL::make_heap(first, last, cmp);
+}
+// Floyd 建堆：从最后一层非叶子节点开始逐层向上下沉。同一层的节点的子树互不相交，可以并行
+template<typename RandomAccessIterator, typename Compare>
+void
+__parallel_make_heap(RandomAccessIterator first, RandomAccessIterator last, Compare cmp, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  ptrdiff_t len = last - first;
+  if (len < 2)
+    return;
+  ptrdiff_t last_parent = (len - 2) / 2;
+  // 最后一个非叶子节点所在层的第一个节点
+  ptrdiff_t level_first = 0;
+  while (2 * level_first + 1 <= last_parent)
+    level_first = 2 * level_first + 1;
+  while (true) {
+    ptrdiff_t level_last = 2 * level_first + 1 < last_parent + 1 ? 2 * level_first + 1 : last_parent + 1;
+    TinySTL::__parallel_chunks(level_last - level_first, sizeof(value_type), [&](size_t lo, size_t hi) {
+      for (ptrdiff_t i = level_first + hi; i-- != level_first + static_cast<ptrdiff_t>(lo);)
+        TinySTL::__sift_down(first, i, len, cmp);
+    });
+    if (level_first == 0)
+      break;
+    level_first = (level_first - 1) / 2;
+  }
+}
+template<typename ExecutionPolicy, typename RandomAccessIterator, typename Compare>
+inline __enable_if_policy<ExecutionPolicy>
+make_heap(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last, Compare cmp) {
+  TinySTL::__parallel_make_heap(first, last, cmp, TinySTL::__run_parallel(policy, first));
+}
+template<typename ExecutionPolicy, typename RandomAccessIterator>
+inline __enable_if_policy<ExecutionPolicy>
+make_heap(const ExecutionPolicy &policy, RandomAccessIterator first, RandomAccessIterator last) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  TinySTL::make_heap(policy, first, last, TinySTL::less<value_type>());
+}
+
+/***************** [uninitialized_copy] *********************/
+template<typename InputIterator, typename ForwardIterator>
+inline ForwardIterator
+__parallel_uninitialized_copy(InputIterator first, InputIterator last, ForwardIterator result, __false_type) {
+  return TinySTL::uninitialized_copy(first, last, result);
+}
+template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+RandomAccessIterator2
+__parallel_uninitialized_copy(RandomAccessIterator1 first, RandomAccessIterator1 last, RandomAccessIterator2 result,
+                     __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator2>::value_type value_type;
+  size_t n = last - first;
+  TinySTL::__parallel_chunks(n, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::uninitialized_copy(first + lo, first + hi, result + lo);
+  });
+  return result + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator1, typename ForwardIterator2>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator2>
+uninitialized_copy(const ExecutionPolicy &policy, ForwardIterator1 first, ForwardIterator1 last,
+                   ForwardIterator2 result) {
+  auto tag = TinySTL::__run_parallel(policy, first, result);
+  return TinySTL::__parallel_uninitialized_copy(first, last, result, tag);
+}
+
+/***************** [uninitialized_fill] *********************/
+template<typename ForwardIterator, typename T>
+inline void
+__parallel_uninitialized_fill(ForwardIterator first, ForwardIterator last, const T &x, __false_type) {
+  TinySTL::uninitialized_fill(first, last, x);
+}
+template<typename RandomAccessIterator, typename T>
+void
+__parallel_uninitialized_fill(RandomAccessIterator first, RandomAccessIterator last, const T &x, __true_type) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  TinySTL::__parallel_chunks(last - first, sizeof(value_type), [&](size_t lo, size_t hi) {
+    TinySTL::uninitialized_fill(first + lo, first + hi, x);
+  });
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename T>
+inline __enable_if_policy<ExecutionPolicy>
+uninitialized_fill(const ExecutionPolicy &policy, ForwardIterator first, ForwardIterator last, const T &x) {
+  TinySTL::__parallel_uninitialized_fill(first, last, x, TinySTL::__run_parallel(policy, first));
+}
+
+/***************** [first_touch] *********************/
+/// 把从地址 base 开始的 len 个大小为 elem_size 的元素按 parts 均分，返回第 p 块的起点（元素下标）。
+/// 起点先按均分算出地址，再向下对齐到页首，取从该页首开始的第一个元素。
+/// elem_size 整除页大小时每一页只属于一块；否则跨页边界的元素所在的页会被相邻两块共享
+inline size_t
+__first_touch_boundary(uintptr_t base, size_t len, size_t elem_size, size_t parts, size_t p) {
+  if (p == 0)
+    return 0;
+  if (p >= parts)
+    return len;
+  uintptr_t addr = base + len / parts * p * elem_size;
+  addr = addr / ParallelAux::__page_size * ParallelAux::__page_size;
+  if (addr <= base)
+    return 0;
+  size_t k = (addr - base + elem_size - 1) / elem_size;
+  return k < len ? k : len;
+}
+
+/// 把 [first, first + len) 按工作线程数均分，第 p 块由第 p 个工作线程初始化（on_each_worker，不会被窃取），
+/// 块的边界按 __first_touch_boundary 对齐到页。之后按同样的划分扫描时，每个线程访问的是自己写入的页
+template<typename RandomAccessIterator, typename T>
+void __first_touch_fill_static(RandomAccessIterator first, size_t len, const T &x, scheduler &sched) {
+  typedef typename iterator_traits<RandomAccessIterator>::value_type value_type;
+  size_t parts = sched.worker_count();
+  uintptr_t base = reinterpret_cast<uintptr_t>(&*first);
+  TinySTL::on_each_worker([&](size_t p) {
+    size_t lo = TinySTL::__first_touch_boundary(base, len, sizeof(value_type), parts, p);
+    size_t hi = TinySTL::__first_touch_boundary(base, len, sizeof(value_type), parts, p + 1);
+    TinySTL::uninitialized_fill(first + lo, first + hi, x);
+  }, sched);
+}
+
+/// 只有一个 NUMA 节点时没有远端内存可言，退化为普通的并行初始化
+template<typename ForwardIterator, typename Size, typename T>
+inline ForwardIterator
+__first_touch_fill_n(ForwardIterator first, Size n, const T &x, __false_type) {
+  return TinySTL::uninitialized_fill_n(first, n, x);
+}
+template<typename RandomAccessIterator, typename Size, typename T>
+RandomAccessIterator
+__first_touch_fill_n(RandomAccessIterator first, Size n, const T &x, __true_type) {
+  if (n <= 0)
+    return first;
+  scheduler &sched = scheduler::instance();
+  size_t len = static_cast<size_t>(n);
+  if (scheduler::numa_nodes() <= 1) {
+    TinySTL::__parallel_uninitialized_fill(first, first + len, x, __true_type());
+    return first + len;
+  }
+  if (len < ParallelAux::__min_parallel_size || sched.worker_count() == 0)
+    return TinySTL::uninitialized_fill_n(first, n, x);
+  TinySTL::__first_touch_fill_static(first, len, x, sched);
+  return first + len;
+}
+template<typename ForwardIterator, typename Size, typename T>
+inline ForwardIterator
+uninitialized_fill_n(const execution::first_touch_policy &policy, ForwardIterator first, Size n, const T &x) {
+  return TinySTL::__first_touch_fill_n(first, n, x, TinySTL::__run_parallel(policy, first));
+}
+template<typename ForwardIterator, typename T>
+inline void
+uninitialized_fill(const execution::first_touch_policy &policy, ForwardIterator first, ForwardIterator last,
+                   const T &x) {
+  auto tag = TinySTL::__run_parallel(policy, first);
+  TinySTL::__first_touch_fill_n(first, TinySTL::distance(first, last), x, tag);
+}
+
+/***************** [uninitialized_fill_n] *********************/
+template<typename ForwardIterator, typename Size, typename T>
+inline ForwardIterator
+__parallel_uninitialized_fill_n(ForwardIterator first, Size n, const T &x, __false_type) {
+  return TinySTL::uninitialized_fill_n(first, n, x);
+}
+template<typename RandomAccessIterator, typename Size, typename T>
+inline RandomAccessIterator
+__parallel_uninitialized_fill_n(RandomAccessIterator first, Size n, const T &x, __true_type) {
+  if (n <= 0)
+    return first;
+  TinySTL::__parallel_uninitialized_fill(first, first + n, x, __true_type());
+  return first + n;
+}
+template<typename ExecutionPolicy, typename ForwardIterator, typename Size, typename T>
+inline __enable_if_policy<ExecutionPolicy, ForwardIterator>
+uninitialized_fill_n(const ExecutionPolicy &policy, ForwardIterator first, Size n, const T &x) {
+  return TinySTL::__parallel_uninitialized_fill_n(first, n, x, TinySTL::__run_parallel(policy, first));
+}
+
+}
+
+#endif //TINYSTL_SRC_PARALLEL_ALGORITHM_H_
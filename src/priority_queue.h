@@ -4,6 +4,7 @@
 #include "vector.h"
 #include "functional.h"
 #include "algorithm.h"
+#include "utility.h"
 
 namespace TinySTL {
 template<typename T, typename Sequence = vector<T>, typename Compare = less<typename Sequence::value_type>>
@@ -15,46 +16,53 @@ class priority_queue {
   using const_reference = typename Sequence::const_reference;
 
  protected:
-  Sequence c;
-  Compare comp;
+  // 比较函数通常是空类，和底层容器放在一起，由 EBO 省掉它的空间
+  __compressed_pair<Sequence, Compare> rep;
 
  public:
   /// 生命周期
-  priority_queue() : c() {}
-  explicit priority_queue(const Compare &x) : c(), comp(x) {}
+  priority_queue() : rep() {}
+  explicit priority_queue(const Compare &x) : rep(Sequence(), x) {}
   template<typename InputIterator>
-  priority_queue(InputIterator first, InputIterator last, const Compare &x): c(first, last), comp(x) {
-    make_heap(c.begin(), c.end(), comp);
+  priority_queue(InputIterator first, InputIterator last, const Compare &x): rep(Sequence(first, last), x) {
+    TinySTL::make_heap(c().begin(), c().end(), comp());
   }
   template<typename InputIterator>
-  priority_queue(InputIterator first, InputIterator last): c(first, last), comp() {
-    TinySTL::make_heap(c.begin(), c.end(), comp);
+  priority_queue(InputIterator first, InputIterator last): rep(Sequence(first, last), Compare()) {
+    TinySTL::make_heap(c().begin(), c().end(), comp());
   }
-  priority_queue(const priority_queue &val) : priority_queue(val.c.begin(), val.c.end(), val.comp) {}
+  priority_queue(const priority_queue &val) : priority_queue(val.c().begin(), val.c().end(), val.comp()) {}
   priority_queue(priority_queue &&val) : priority_queue() { swap(*this, val); }
   priority_queue &operator=(priority_queue val) {
     swap(*this, val);
     return *this;
   }
 
-  bool empty() const { return c.empty(); }
-  size_type size() const { return c.size(); }
-  const_reference top() const { return c.front(); }
+  bool empty() const { return c().empty(); }
+  size_type size() const { return c().size(); }
+  const_reference top() const { return c().front(); }
 
   /// 会修改容器的成员函数
   void push(const value_type &val) {
-    c.push_back(val);
-    TinySTL::push_heap(c.begin(), c.end(), comp);
+    c().push_back(val);
+    TinySTL::push_heap(c().begin(), c().end(), comp());
   }
   void pop() {
-    TinySTL::pop_heap(c.begin(), c.end(), comp);
-    c.pop_back();
+    TinySTL::pop_heap(c().begin(), c().end(), comp());
+    c().pop_back();
   }
  public:
   friend void swap(priority_queue &x, priority_queue &y) {
-    TinySTL::swap(x.c, y.c);
-    TinySTL::swap(x.comp, y.comp);
+    TinySTL::swap(x.c(), y.c());
+    TinySTL::swap(x.comp(), y.comp());
   }
+
+  /*************** 辅助函数 ************/
+ protected:
+  Sequence &c() { return rep.first(); }
+  const Sequence &c() const { return rep.first(); }
+  Compare &comp() { return rep.second(); }
+  const Compare &comp() const { return rep.second(); }
 };
 }
 
@@ -0,0 +1,240 @@
+#ifndef TINYSTL_SRC_SCHEDULER_H_
+#define TINYSTL_SRC_SCHEDULER_H_
+
+/**
+ * fork-join 任务调度器：固定大小的线程池，每个工作线程一个 work_stealing_deque。
+ *  - 工作线程 spawn 的任务放进自己的队列底部，执行时也从底部取（深度优先，缓存友好）；
+ *  - 自己的队列空了，就随机挑一个其他线程，从它的队列顶部窃取（偷走的是最早、通常也是最大的任务）；
+ *  - 非工作线程（比如主线程）spawn 的任务放进一个公共的 mpmc_queue，满了就直接在当前线程执行；
+ *  - 长时间找不到任务的工作线程在条件变量上睡眠，有新任务时再唤醒。
+ *
+ * 用法：
+ *
+ *   task_group g;
+ *   g.spawn([&] { left(); });
+ *   right();
+ *   g.sync(); // 等待 g 中的任务全部完成，等待期间当前线程也会执行别的任务
+ *
+ *   parallel_for(0, n, [&](size_t lo, size_t hi) { ... }); // 对 [lo, hi) 子区间并行执行
+ *   on_each_worker([&](size_t i) { ... });                  // 第 i 个工作线程执行 f(i)
+ *
+ * 全局调度器 scheduler::instance() 的线程数由环境变量 TINYSTL_NUM_THREADS 决定，默认为 CPU 核数，
+ * 其中调用 sync 的线程也算一个，实际创建的工作线程比它少一个。
+ * 任务抛出的异常会在 sync 时重新抛出（只保留第一个）。
+ *
+ * 工作线程数不超过进程可用的 CPU 数时（Linux），第 i 个工作线程绑定到第 i 个可用的 CPU，
+ * 设置环境变量 TINYSTL_PIN_THREADS=0 可以关闭。on_each_worker 的任务不会被窃取，
+ * 绑定之后同一个 i 总在同一个 CPU（因而同一个 NUMA 节点）上执行，见 execution::first_touch。
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+#include "mpmc_queue.h"
+#include "work_stealing_deque.h"
+
+namespace TinySTL {
+
+class task_group;
+
+// 任务基类，由 task_group::spawn 创建，执行后由调度器 delete
+class __task {
+ public:
+  task_group *group;
+
+ public:
+  __task() : group(nullptr) {}
+  virtual ~__task() {}
+  virtual void run() = 0;
+};
+
+template<typename Function>
+class __function_task : public __task {
+ private:
+  Function func;
+
+ public:
+  explicit __function_task(const Function &f) : func(f) {}
+  void run() override { func(); }
+};
+
+namespace SchedulerAux {
+// 公共任务队列的容量
+const size_t __inject_capacity = 1024;
+// 工作线程连续找不到任务多少轮之后去睡眠
+const int __idle_rounds = 64;
+// 每个工作线程专属队列（不可窃取）的容量
+const size_t __pinned_capacity = 64;
+}
+
+class scheduler {
+ private:
+  struct worker;
+
+ private:
+  size_t num_threads;
+  worker *workers;         // num_threads - 1 个工作线程
+  mpmc_queue<__task *> inject;
+  std::atomic<bool> stop;
+  // 睡眠、唤醒
+  std::atomic<int> sleepers;
+  std::mutex sleep_mutex;
+  std::condition_variable sleep_cv;
+
+ private:
+  void worker_loop(size_t index);
+  bool find_task(__task *&task, size_t self);
+  bool has_visible_task(size_t self) const;
+  void wake_one();
+  void wake_all();
+
+ public:
+  // num_threads 包括调用 sync 的线程，至少为 1
+  explicit scheduler(size_t num_threads);
+  scheduler(const scheduler &) = delete;
+  scheduler &operator=(const scheduler &) = delete;
+  ~scheduler();
+
+  // 全局调度器，第一次调用时创建
+  static scheduler &instance();
+  // TINYSTL_NUM_THREADS 或 CPU 核数
+  static size_t default_num_threads();
+  // 在线的 NUMA 节点数，读取 /sys/devices/system/node/online，读不到时为 1
+  static size_t numa_nodes();
+
+  size_t size() const { return num_threads; }
+  // 工作线程数，即 size() - 1
+  size_t worker_count() const { return num_threads - 1; }
+  // 第 index 个工作线程绑定的 CPU，没有绑定时为 -1
+  int worker_cpu(size_t index) const;
+  // 提交任务：工作线程放进自己的队列，其他线程放进公共队列
+  void submit(__task *task);
+  // 提交只能由第 index 个工作线程执行的任务，index < worker_count()
+  void submit_to(size_t index, __task *task);
+  // 找一个任务执行，没有找到返回 false。sync 等待时调用
+  bool run_one();
+  // 执行任务并通知所属的 task_group
+  static void execute(__task *task);
+};
+
+class task_group {
+  friend class scheduler;
+
+ private:
+  scheduler &sched;
+  std::atomic<size_t> pending;
+  std::atomic<bool> has_exception;
+  std::exception_ptr exception;
+
+ private:
+  void set_exception(std::exception_ptr e) {
+    bool expected = false;
+    if (has_exception.compare_exchange_strong(expected, true))
+      exception = e;
+  }
+
+ public:
+  explicit task_group(scheduler &s = scheduler::instance()) :
+      sched(s), pending(0), has_exception(false) {}
+  task_group(const task_group &) = delete;
+  task_group &operator=(const task_group &) = delete;
+  // 析构前必须 sync，这里再等一次以防万一，但不再抛出异常
+  ~task_group() {
+    while (pending.load(std::memory_order_acquire) != 0)
+      wait_once();
+  }
+
+  template<typename Function>
+  void spawn(const Function &f) {
+    sched.submit(make_task(f));
+  }
+  // 交给第 index 个工作线程执行，不会被其他线程窃取
+  template<typename Function>
+  void spawn_on(size_t index, const Function &f) {
+    sched.submit_to(index, make_task(f));
+  }
+  // 等待所有任务完成，期间帮忙执行任务
+  void sync() {
+    while (pending.load(std::memory_order_acquire) != 0)
+      wait_once();
+    if (has_exception.load(std::memory_order_acquire)) {
+      has_exception.store(false, std::memory_order_relaxed);
+      std::exception_ptr e = exception;
+      exception = nullptr;
+      std::rethrow_exception(e);
+    }
+  }
+
+ private:
+  template<typename Function>
+  __task *make_task(const Function &f) {
+    __task *task = new __function_task<Function>(f);
+    task->group = this;
+    pending.fetch_add(1, std::memory_order_relaxed);
+    return task;
+  }
+  void wait_once() {
+    if (!sched.run_one())
+      std::this_thread::yield();
+  }
+};
+
+/**
+ * 把 [first, last) 二分到不超过 grain 的子区间，对每个子区间调用 f(lo, hi)。
+ * grain 为 0 时自动选择：每个线程大约分到 8 块。
+ */
+template<typename Index, typename Function>
+void __parallel_for(Index first, Index last, Index grain, const Function &f, scheduler &sched) {
+  task_group g(sched);
+  // 右半边交给别人，自己继续切左半边
+  while (static_cast<size_t>(last - first) > static_cast<size_t>(grain)) {
+    Index mid = first + (last - first) / 2;
+    g.spawn([mid, last, grain, &f, &sched] { __parallel_for(mid, last, grain, f, sched); });
+    last = mid;
+  }
+  f(first, last);
+  g.sync();
+}
+
+template<typename Index, typename Function>
+void parallel_for(Index first, Index last, const Function &f, Index grain = 0,
+                  scheduler &sched = scheduler::instance()) {
+  if (!(first < last))
+    return;
+  size_t n = static_cast<size_t>(last - first);
+  if (grain <= 0) {
+    size_t chunks = sched.size() * 8;
+    grain = static_cast<Index>(n / chunks > 0 ? n / chunks : 1);
+  }
+  if (sched.size() == 1 || n <= static_cast<size_t>(grain)) {
+    f(first, last);
+    return;
+  }
+  __parallel_for(first, last, grain, f, sched);
+}
+
+/**
+ * 第 i 个工作线程执行 f(i)，i 取遍 [0, worker_count())，调用线程只等待。
+ * 用于按线程静态划分的工作：同样的 i 每次都在同一个（绑定了 CPU 的）线程上执行。
+ * 没有工作线程时在调用线程上执行 f(0)。
+ */
+template<typename Function>
+void on_each_worker(const Function &f, scheduler &sched = scheduler::instance()) {
+  size_t n = sched.worker_count();
+  if (n == 0) {
+    f(size_t(0));
+    return;
+  }
+  task_group g(sched);
+  for (size_t i = 0; i != n; ++i)
+    g.spawn_on(i, [&f, i] { f(i); });
+  g.sync();
+}
+
+}
+
+#endif //TINYSTL_SRC_SCHEDULER_H_
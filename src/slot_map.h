@@ -0,0 +1,193 @@
+#ifndef TINYSTL_SRC_SLOT_MAP_H_
+#define TINYSTL_SRC_SLOT_MAP_H_
+
+/**
+ * 带代数（generation）句柄的 slot map：插入返回一个 key，之后用它 O(1) 访问、删除元素。
+ *
+ * 三个数组，都是 TinySTL::vector：
+ *  - values：元素紧密存放，遍历就是扫描连续数组；
+ *  - slots：间接表，key.index 指向其中一项 {元素在 values 中的下标, 代数}；
+ *  - slot_of：values 中每个元素对应的 slot 下标，删除时用来修正被搬动的元素。
+ * 删除时把最后一个元素搬到被删的位置再 pop_back，其他元素不动；空出来的 slot 串成空闲链表，插入时优先复用。
+ *
+ * 代数在 slot 被占用、被释放时各加一，占用中的 slot 代数为奇数。key 记录发放时的代数，
+ * slot 被释放或复用后代数不再相等，旧 key 的查找返回 end()，不会访问到别的元素。
+ *
+ * 注意：
+ *  1. key 在元素被删除前一直有效，不受其他元素插入、删除的影响；迭代器和指针在插入、删除后失效。
+ *  2. 删除会改变遍历顺序（最后一个元素被搬到前面）。
+ *  3. 最多 2^32 - 1 个 slot；同一个 slot 被复用 2^31 次后代数回绕，极旧的 key 理论上会重新有效。
+ */
+
+#include <cstdint>
+#include <stdexcept>
+
+#include "algorithm.h"
+#include "utility.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+namespace SlotMapAux {
+// 空闲链表的结尾
+const uint32_t __null_slot = static_cast<uint32_t>(-1);
+}
+
+template<typename T>
+class slot_map {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using reference = T &;
+  using const_reference = const T &;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  /// 元素的句柄，可以拷贝、比较，和容器对象无关
+  struct key_type {
+    uint32_t index;
+    uint32_t generation;
+
+    friend bool operator==(const key_type &x, const key_type &y) {
+      return x.index == y.index && x.generation == y.generation;
+    }
+    friend bool operator!=(const key_type &x, const key_type &y) { return !(x == y); }
+  };
+
+ protected:
+  struct slot {
+    uint32_t index;       // 占用时是元素在 values 中的下标，空闲时是下一个空闲 slot
+    uint32_t generation;  // 奇数表示占用
+  };
+
+  vector<T> values;
+  vector<uint32_t> slot_of;
+  vector<slot> slots;
+  uint32_t free_head;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、move ctor、copy-and-swap，使用编译器生成的析构 ****/
+  slot_map() : free_head(SlotMapAux::__null_slot) {}
+  slot_map(const slot_map &x) = default;
+  slot_map(slot_map &&x) : slot_map() { swap(*this, x); }
+  slot_map &operator=(slot_map x) {
+    swap(*this, x);
+    return *this;
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return values.size(); }
+  bool empty() const { return values.empty(); }
+  size_type capacity() const { return values.capacity(); }
+  const_iterator begin() const { return values.begin(); }
+  const_iterator end() const { return values.end(); }
+  const_iterator cbegin() const { return values.begin(); }
+  const_iterator cend() const { return values.end(); }
+  /// 迭代器指向的元素的 key
+  key_type key_of(const_iterator it) const {
+    uint32_t s = slot_of[static_cast<size_type>(it - begin())];
+    return key_type{s, slots[s].generation};
+  }
+  bool contains(key_type k) const { return find_index(k) != size(); }
+  const_iterator find(key_type k) const { return begin() + find_index(k); }
+  /// 不检查 key 是否有效
+  const_reference operator[](key_type k) const { return values[slots[k.index].index]; }
+  const_reference at(key_type k) const {
+    size_type i = find_index(k);
+    if (i == size())
+      throw std::out_of_range("slot_map::at");
+    return values[i];
+  }
+
+  /*************** 访问元素 ************/
+  iterator begin() { return values.begin(); }
+  iterator end() { return values.end(); }
+  iterator find(key_type k) { return begin() + find_index(k); }
+  reference operator[](key_type k) { return values[slots[k.index].index]; }
+  reference at(key_type k) {
+    return const_cast<reference>(static_cast<const slot_map &>(*this).at(k));
+  }
+
+  /*************** 插入删除 ************/
+  key_type insert(const value_type &val) {
+    if (free_head == SlotMapAux::__null_slot) {
+      if (slots.size() == SlotMapAux::__null_slot)
+        throw std::length_error("slot_map::insert");
+      slots.push_back(slot{free_head, 0});
+      free_head = static_cast<uint32_t>(slots.size() - 1);
+    }
+    uint32_t s = free_head;
+    // 先放入元素，失败时 slot 留在空闲链表中
+    values.push_back(val);
+    try {
+      slot_of.push_back(s);
+    } catch (...) {
+      values.pop_back();
+      throw;
+    }
+    free_head = slots[s].index;
+    slots[s].index = static_cast<uint32_t>(values.size() - 1);
+    ++slots[s].generation;
+    return key_type{s, slots[s].generation};
+  }
+  /// key 已经失效时什么也不做，返回 0
+  size_type erase(key_type k) {
+    size_type i = find_index(k);
+    if (i == size())
+      return 0;
+    erase_at(i);
+    return 1;
+  }
+  /// 返回的迭代器指向被搬到 pos 处的元素（原来的最后一个元素）
+  iterator erase(const_iterator pos) {
+    size_type i = static_cast<size_type>(pos - begin());
+    erase_at(i);
+    return begin() + i;
+  }
+  void clear() {
+    while (!empty())
+      erase_at(size() - 1);
+  }
+  void reserve(size_type n) {
+    values.reserve(n);
+    slot_of.reserve(n);
+    slots.reserve(n);
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(slot_map &x, slot_map &y) {
+    swap(x.values, y.values);
+    swap(x.slot_of, y.slot_of);
+    swap(x.slots, y.slots);
+    TinySTL::swap(x.free_head, y.free_head);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  /// key 有效时返回元素下标，否则返回 size()
+  size_type find_index(key_type k) const {
+    if (k.index >= slots.size() || slots[k.index].generation != k.generation || (k.generation & 1) == 0)
+      return size();
+    return slots[k.index].index;
+  }
+  /// 最后一个元素搬到 i，释放 i 原来的 slot
+  void erase_at(size_type i) {
+    size_type last = size() - 1;
+    uint32_t s = slot_of[i];
+    if (i != last) {
+      values[i] = TinySTL::move(values[last]);
+      slot_of[i] = slot_of[last];
+      slots[slot_of[i]].index = static_cast<uint32_t>(i);
+    }
+    values.pop_back();
+    slot_of.pop_back();
+    ++slots[s].generation;
+    slots[s].index = free_head;
+    free_head = s;
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_SLOT_MAP_H_
@@ -0,0 +1,335 @@
+#ifndef TINYSTL_SRC_SOA_VECTOR_H_
+#define TINYSTL_SRC_SOA_VECTOR_H_
+
+/**
+ * 按列存放的 vector（struct of arrays）：soa_vector<int, float, double> 的每个字段各占一个连续数组。
+ * 只访问一两个字段的循环只把这几列读进缓存，每列都按 64 字节对齐，编译器可以直接向量化。
+ *
+ *  - column<I>() 返回第 I 列的 soa_span，热循环直接遍历它；
+ *  - operator[] 返回行代理，get<I>() 访问单个字段，也可以和 std::tuple 互相转换、赋值；
+ *  - 所有列放在同一块内存里（来自 __alloc），reserve、扩容时一起重新分配，扩容策略和 vector 相同。
+ *    扩容时可以按位搬移的列（见 __is_relocatable）直接 memcpy，其他列和 vector 一样：
+ *    移动构造不抛异常时移动，否则拷贝构造，之后析构旧元素。
+ *
+ * 注意：扩容后所有 span、指针、行代理都会失效。
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "__alloc.h"
+#include "__construct.h"
+#include "algorithm.h"
+#include "type_traits.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+namespace SoaAux {
+// 每列的起始地址按缓存行对齐，也满足 AVX-512 的对齐要求
+const size_t __column_align = 64;
+// 第一次分配的行数
+const size_t __min_capacity = 16;
+}
+
+/// 一段连续数组的视图（指针 + 长度），soa_vector 的列
+template<typename T>
+class soa_span {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+  using iterator = T *;
+
+ protected:
+  T *ptr;
+  size_type len;
+
+ public:
+  soa_span() : ptr(nullptr), len(0) {}
+  soa_span(T *p, size_type n) : ptr(p), len(n) {}
+
+  iterator begin() const { return ptr; }
+  iterator end() const { return ptr + len; }
+  T *data() const { return ptr; }
+  size_type size() const { return len; }
+  bool empty() const { return len == 0; }
+  T &operator[](size_type i) const { return ptr[i]; }
+};
+
+template<typename... Ts>
+class soa_vector {
+ public:
+  using size_type = size_t;
+  using value_type = std::tuple<Ts...>;
+  template<size_t I>
+  using field_type = typename std::tuple_element<I, value_type>::type;
+  static constexpr size_t column_count = sizeof...(Ts);
+
+  /// 行代理：指向第 i 行，通过 get<I>() 读写字段
+  template<bool Const>
+  class basic_row {
+   protected:
+    typedef typename std::conditional<Const, const soa_vector, soa_vector>::type owner_type;
+    owner_type *owner;
+    size_type index;
+
+   public:
+    basic_row(owner_type *v, size_type i) : owner(v), index(i) {}
+    template<size_t I>
+    typename std::conditional<Const, const field_type<I>, field_type<I>>::type &get() const {
+      return owner->template data<I>()[index];
+    }
+    operator value_type() const { return to_tuple(std::index_sequence_for<Ts...>()); }
+    /// 逐个字段赋值
+    const basic_row &operator=(const value_type &row) const {
+      assign(row, std::index_sequence_for<Ts...>());
+      return *this;
+    }
+    const basic_row &operator=(const basic_row &row) const { return *this = static_cast<value_type>(row); }
+
+   protected:
+    template<size_t... Is>
+    value_type to_tuple(std::index_sequence<Is...>) const { return value_type(get<Is>()...); }
+    template<size_t... Is>
+    void assign(const value_type &row, std::index_sequence<Is...>) const {
+      int expand[] = {0, (get<Is>() = std::get<Is>(row), 0)...};
+      (void) expand;
+    }
+  };
+  using reference = basic_row<false>;
+  using const_reference = basic_row<true>;
+
+ protected:
+  void *raw;
+  void *columns[column_count];
+  size_type num;
+  size_type cap;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、move ctor、copy-and-swap、dtor ****/
+  soa_vector() : raw(nullptr), columns(), num(0), cap(0) {}
+  soa_vector(const soa_vector &x) : soa_vector() {
+    reserve(x.size());
+    for (size_type i = 0; i != x.size(); ++i)
+      push_back(static_cast<value_type>(x[i]));
+  }
+  soa_vector(soa_vector &&x) : soa_vector() { swap(*this, x); }
+  soa_vector &operator=(soa_vector x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~soa_vector() {
+    destroy_columns(columns, num, std::index_sequence_for<Ts...>());
+    deallocate(raw, cap);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return num; }
+  bool empty() const { return num == 0; }
+  size_type capacity() const { return cap; }
+  template<size_t I>
+  const field_type<I> *data() const { return static_cast<const field_type<I> *>(columns[I]); }
+  template<size_t I>
+  soa_span<const field_type<I>> column() const { return soa_span<const field_type<I>>(data<I>(), num); }
+  const_reference operator[](size_type i) const { return const_reference(this, i); }
+  const_reference at(size_type i) const {
+    if (i >= num)
+      throw std::out_of_range("soa_vector::at");
+    return (*this)[i];
+  }
+
+  /*************** 访问元素 ************/
+  template<size_t I>
+  field_type<I> *data() { return static_cast<field_type<I> *>(columns[I]); }
+  template<size_t I>
+  soa_span<field_type<I>> column() { return soa_span<field_type<I>>(data<I>(), num); }
+  reference operator[](size_type i) { return reference(this, i); }
+  reference at(size_type i) {
+    if (i >= num)
+      throw std::out_of_range("soa_vector::at");
+    return (*this)[i];
+  }
+  reference back() { return (*this)[num - 1]; }
+
+  /*************** 修改 ************/
+  void push_back(const value_type &row) {
+    if (num == cap)
+      reallocate(cap + TinySTL::max(cap, SoaAux::__min_capacity));
+    construct_row(num, row, std::integral_constant<size_t, 0>());
+    ++num;
+  }
+  void push_back(const Ts &... fields) { push_back(value_type(fields...)); }
+  void pop_back() {
+    --num;
+    destroy_columns(columns, 1, std::index_sequence_for<Ts...>(), num);
+  }
+  void clear() {
+    destroy_columns(columns, num, std::index_sequence_for<Ts...>());
+    num = 0;
+  }
+  /// 所有列一起重新分配
+  void reserve(size_type n) {
+    if (n > cap)
+      reallocate(n);
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(soa_vector &x, soa_vector &y) {
+    TinySTL::swap(x.raw, y.raw);
+    for (size_t i = 0; i != column_count; ++i)
+      TinySTL::swap(x.columns[i], y.columns[i]);
+    TinySTL::swap(x.num, y.num);
+    TinySTL::swap(x.cap, y.cap);
+  }
+
+  /*************** 辅助函数 ************/
+ protected:
+  static size_type column_bytes(size_type n, size_t elem_size) {
+    return (n * elem_size + SoaAux::__column_align - 1) & ~(SoaAux::__column_align - 1);
+  }
+  /// 一块内存放下 n 行的所有列，多申请一个缓存行用于对齐
+  static size_type total_bytes(size_type n) {
+    size_t sizes[] = {sizeof(Ts)...};
+    size_type bytes = SoaAux::__column_align;
+    for (size_t s : sizes)
+      bytes += column_bytes(n, s);
+    return bytes;
+  }
+  static void deallocate(void *p, size_type n) {
+    if (p != nullptr)
+      __alloc::deallocate(p, total_bytes(n));
+  }
+  /// 按 n 行划分 p 指向的内存，写入各列的起始地址
+  static void layout(void *p, size_type n, void **cols) {
+    size_t sizes[] = {sizeof(Ts)...};
+    size_t addr = reinterpret_cast<size_t>(p);
+    addr = (addr + SoaAux::__column_align - 1) & ~(SoaAux::__column_align - 1);
+    for (size_t i = 0; i != column_count; ++i) {
+      cols[i] = reinterpret_cast<void *>(addr);
+      addr += column_bytes(n, sizes[i]);
+    }
+  }
+
+  /// 在第 i 行构造第 I 列及之后的字段，某个字段抛出异常时析构本行已构造的字段
+  template<size_t I>
+  void construct_row(size_type i, const value_type &row, std::integral_constant<size_t, I>) {
+    __construct::construct(data<I>() + i, std::get<I>(row));
+    try {
+      construct_row(i, row, std::integral_constant<size_t, I + 1>());
+    } catch (...) {
+      __construct::destroy(data<I>() + i);
+      throw;
+    }
+  }
+  void construct_row(size_type, const value_type &, std::integral_constant<size_t, column_count>) {}
+
+  /// 析构各列从 first 开始的 n 个元素
+  template<size_t... Is>
+  static void destroy_columns(void **cols, size_type n, std::index_sequence<Is...>, size_type first = 0) {
+    int expand[] = {0, (destroy_column(static_cast<Ts *>(cols[Is]) + first, n), 0)...};
+    (void) expand;
+  }
+  template<typename T>
+  static void destroy_column(T *p, size_type n) {
+    if (n != 0)
+      __construct::destroy(p, p + n);
+  }
+
+  /// 全部列搬到新内存后再释放旧内存；某一列拷贝构造抛出异常时，撤销已经搬好的列（移动过的列移回去），原来的内容不变
+  void reallocate(size_type new_cap) {
+    void *new_raw = __alloc::allocate(total_bytes(new_cap));
+    void *new_columns[column_count];
+    layout(new_raw, new_cap, new_columns);
+    try {
+      relocate_columns(new_columns, std::integral_constant<size_t, 0>());
+    } catch (...) {
+      __alloc::deallocate(new_raw, total_bytes(new_cap));
+      throw;
+    }
+    release_columns(std::integral_constant<size_t, 0>());
+    deallocate(raw, cap);
+    raw = new_raw;
+    for (size_t i = 0; i != column_count; ++i)
+      columns[i] = new_columns[i];
+    cap = new_cap;
+  }
+  template<size_t I>
+  void relocate_columns(void **dst, std::integral_constant<size_t, I>) {
+    typedef typename __is_relocatable<field_type<I>>::type relocatable;
+    field_type<I> *s = data<I>();
+    field_type<I> *d = static_cast<field_type<I> *>(dst[I]);
+    relocate_column(s, d, relocatable());
+    try {
+      relocate_columns(dst, std::integral_constant<size_t, I + 1>());
+    } catch (...) {
+      unrelocate_column(s, d, relocatable());
+      throw;
+    }
+  }
+  void relocate_columns(void **, std::integral_constant<size_t, column_count>) {}
+  template<size_t I>
+  void release_columns(std::integral_constant<size_t, I>) {
+    release_column(data<I>(), typename __is_relocatable<field_type<I>>::type());
+    release_columns(std::integral_constant<size_t, I + 1>());
+  }
+  void release_columns(std::integral_constant<size_t, column_count>) {}
+
+  // 可以按位搬移：memcpy 过去，旧元素不再析构；失败时新内存里的副本也不用析构
+  template<typename T>
+  void relocate_column(T *src, T *dst, __true_type) {
+    if (num != 0)
+      std::memcpy(static_cast<void *>(dst), static_cast<const void *>(src), num * sizeof(T));
+  }
+  template<typename T>
+  void unrelocate_column(T *, T *, __true_type) {}
+  template<typename T>
+  void release_column(T *, __true_type) {}
+  // 其他类型：全部列成功后再析构旧元素
+  template<typename T>
+  void relocate_column(T *src, T *dst, __false_type) {
+    relocate_column_aux(src, dst, typename __bool_type<std::is_nothrow_move_constructible<T>::value>::type());
+  }
+  template<typename T>
+  void unrelocate_column(T *src, T *dst, __false_type) {
+    unrelocate_column_aux(src, dst, typename __bool_type<std::is_nothrow_move_constructible<T>::value>::type());
+  }
+  template<typename T>
+  void release_column(T *src, __false_type) { destroy_column(src, num); }
+  // 移动构造不抛异常：移动过去；撤销时再移回旧内存
+  template<typename T>
+  void relocate_column_aux(T *src, T *dst, __true_type) {
+    for (size_type i = 0; i != num; ++i)
+      new(static_cast<void *>(dst + i)) T(TinySTL::move(src[i]));
+  }
+  template<typename T>
+  void unrelocate_column_aux(T *src, T *dst, __true_type) {
+    for (size_type i = 0; i != num; ++i) {
+      __construct::destroy(src + i);
+      new(static_cast<void *>(src + i)) T(TinySTL::move(dst[i]));
+    }
+    destroy_column(dst, num);
+  }
+  // 否则拷贝构造，中途抛出异常时析构本列已构造的元素
+  template<typename T>
+  void relocate_column_aux(T *src, T *dst, __false_type) {
+    T *cur = dst;
+    try {
+      for (; cur != dst + num; ++cur, ++src)
+        __construct::construct(cur, *src);
+    } catch (...) {
+      destroy_column(dst, cur - dst);
+      throw;
+    }
+  }
+  template<typename T>
+  void unrelocate_column_aux(T *, T *dst, __false_type) { destroy_column(dst, num); }
+};
+
+}
+
+#endif //TINYSTL_SRC_SOA_VECTOR_H_
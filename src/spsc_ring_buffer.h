@@ -0,0 +1,220 @@
+#ifndef TINYSTL_SRC_SPSC_RING_BUFFER_H_
+#define TINYSTL_SRC_SPSC_RING_BUFFER_H_
+
+/**
+ * 单生产者单消费者（SPSC）的无锁环形队列，容量固定（向上取整为 2 的幂）。
+ * 生产者只写 tail，消费者只写 head，两者放在不同的缓存行上；各自再缓存一份对方的下标，
+ * 只有在看起来满（或空）时才去读对方的缓存行。元素的可见性由 tail/head 的 release-acquire 保证。
+ *
+ * 线程约定：
+ *  1. 生产者线程：try_push、push_back、push_n；消费者线程：try_pop、front、pop_front、pop_n。
+ *  2. 构造、拷贝、赋值、swap、operator== 不是线程安全的，只能在没有并发访问时调用。
+ *  3. 并发时 size()、empty() 只是一个瞬时的近似值。
+ * 提供 front/pop_front/push_back/empty/size，可以直接作为 queue 的 Sequence：
+ *
+ *   queue<int, spsc_ring_buffer<int>> q;
+ *
+ * 注意：push_back 在队列满时会自旋等待消费者，单线程使用时要保证不会超过容量。
+ */
+
+#include <atomic>
+
+#include "__concurrent.h"
+#include "algorithm.h"
+#include "allocator.h"
+#include "uninitialized.h"
+
+namespace TinySTL {
+
+namespace SpscAux {
+// 默认容量，queue 的默认构造会用到
+const size_t __default_capacity = 1024;
+/// 不小于 n 的最小的 2 的幂
+inline size_t __ceil_pow2(size_t n) {
+  size_t res = 1;
+  while (res < n)
+    res <<= 1;
+  return res;
+}
+}
+
+template<typename T, typename Alloc = allocator<T>>
+class spsc_ring_buffer {
+ public:
+  using value_type = T;
+  using pointer = T *;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+ protected:
+  // 下标单调递增（溢出后回绕也没问题），与 mask 按位与得到槽位
+  // 消费者的缓存行
+  alignas(__cache_line_size) std::atomic<size_type> head;
+  size_type cached_tail;
+  // 生产者的缓存行
+  alignas(__cache_line_size) std::atomic<size_type> tail;
+  size_type cached_head;
+  // 构造后只读，两边共享
+  alignas(__cache_line_size) pointer buffer;
+  size_type mask;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  explicit spsc_ring_buffer(size_type capacity = SpscAux::__default_capacity) :
+      head(0), cached_tail(0), tail(0), cached_head(0), buffer(nullptr), mask(0) {
+    size_type cap = SpscAux::__ceil_pow2(capacity);
+    buffer = Alloc::allocate(cap);
+    mask = cap - 1;
+  }
+  // Rule of five，拷贝后的元素从槽位 0 开始存放
+  spsc_ring_buffer(const spsc_ring_buffer &x) : spsc_ring_buffer(x.capacity()) {
+    size_type n = x.size();
+    size_type h = x.head.load(std::memory_order_relaxed);
+    for (size_type i = 0; i != n; ++i)
+      Alloc::construct(buffer + i, x.buffer[(h + i) & x.mask]);
+    tail.store(n, std::memory_order_relaxed);
+    cached_tail = n;
+  }
+  spsc_ring_buffer(spsc_ring_buffer &&x) :
+      head(0), cached_tail(0), tail(0), cached_head(0), buffer(nullptr), mask(0) {
+    swap(*this, x);
+  }
+  spsc_ring_buffer &operator=(spsc_ring_buffer x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~spsc_ring_buffer() {
+    if (buffer == nullptr)
+      return;
+    clear();
+    Alloc::deallocate(buffer, capacity());
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type capacity() const { return buffer == nullptr ? 0 : mask + 1; }
+  size_type size() const {
+    // 先读 head 再读 tail，保证结果不会是“负数”
+    size_type h = head.load(std::memory_order_acquire);
+    return tail.load(std::memory_order_acquire) - h;
+  }
+  bool empty() const {
+    return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_acquire);
+  }
+  bool full() const { return size() == capacity(); }
+  // 仅消费者
+  const_reference front() const { return buffer[head.load(std::memory_order_relaxed) & mask]; }
+
+  /*************** 生产者 ************/
+  bool try_push(const value_type &val) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    if (t - cached_head == capacity()) {
+      cached_head = head.load(std::memory_order_acquire);
+      if (t - cached_head == capacity())
+        return false;
+    }
+    Alloc::construct(buffer + (t & mask), val);
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+  // 满了就自旋等待消费者
+  void push_back(const value_type &val) {
+    __backoff backoff;
+    while (!try_push(val))
+      backoff.pause();
+  }
+  // 尽量放入 [first, first + n)，返回实际放入的个数。整批只发布一次 tail
+  template<typename RandomAccessIterator>
+  size_type push_n(RandomAccessIterator first, size_type n) {
+    size_type t = tail.load(std::memory_order_relaxed);
+    if (capacity() - (t - cached_head) < n)
+      cached_head = head.load(std::memory_order_acquire);
+    size_type free = capacity() - (t - cached_head);
+    if (n > free)
+      n = free;
+    // 至多分成两段连续空间：[index, capacity) 和 [0, ...)
+    size_type index = t & mask;
+    size_type len = min(n, capacity() - index);
+    TinySTL::uninitialized_copy(first, first + len, buffer + index);
+    TinySTL::uninitialized_copy(first + len, first + n, buffer);
+    tail.store(t + n, std::memory_order_release);
+    return n;
+  }
+
+  /*************** 消费者 ************/
+  reference front() { return buffer[head.load(std::memory_order_relaxed) & mask]; }
+  bool try_pop(value_type &val) {
+    size_type h = head.load(std::memory_order_relaxed);
+    if (h == cached_tail) {
+      cached_tail = tail.load(std::memory_order_acquire);
+      if (h == cached_tail)
+        return false;
+    }
+    pointer p = buffer + (h & mask);
+    val = *p;
+    Alloc::destroy(p);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+  // 调用前需保证非空
+  void pop_front() {
+    size_type h = head.load(std::memory_order_relaxed);
+    Alloc::destroy(buffer + (h & mask));
+    head.store(h + 1, std::memory_order_release);
+  }
+  // 尽量取出 n 个写到 result，返回实际取出的个数。整批只发布一次 head
+  template<typename OutputIterator>
+  size_type pop_n(OutputIterator result, size_type n) {
+    size_type h = head.load(std::memory_order_relaxed);
+    if (cached_tail - h < n)
+      cached_tail = tail.load(std::memory_order_acquire);
+    size_type avail = cached_tail - h;
+    if (n > avail)
+      n = avail;
+    size_type index = h & mask;
+    size_type len = min(n, capacity() - index);
+    result = TinySTL::copy(buffer + index, buffer + index + len, result);
+    TinySTL::copy(buffer, buffer + (n - len), result);
+    Alloc::destroy(buffer + index, buffer + index + len);
+    Alloc::destroy(buffer, buffer + (n - len));
+    head.store(h + n, std::memory_order_release);
+    return n;
+  }
+  // 仅在没有并发访问时调用
+  void clear() {
+    while (!empty())
+      pop_front();
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(spsc_ring_buffer &x, spsc_ring_buffer &y) {
+    size_type h = x.head.load(std::memory_order_relaxed);
+    x.head.store(y.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    y.head.store(h, std::memory_order_relaxed);
+    size_type t = x.tail.load(std::memory_order_relaxed);
+    x.tail.store(y.tail.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    y.tail.store(t, std::memory_order_relaxed);
+    TinySTL::swap(x.cached_head, y.cached_head);
+    TinySTL::swap(x.cached_tail, y.cached_tail);
+    TinySTL::swap(x.buffer, y.buffer);
+    TinySTL::swap(x.mask, y.mask);
+  }
+  friend bool operator==(const spsc_ring_buffer &x, const spsc_ring_buffer &y) {
+    size_type n = x.size();
+    if (n != y.size())
+      return false;
+    size_type h1 = x.head.load(std::memory_order_relaxed);
+    size_type h2 = y.head.load(std::memory_order_relaxed);
+    for (size_type i = 0; i != n; ++i) {
+      if (x.buffer[(h1 + i) & x.mask] != y.buffer[(h2 + i) & y.mask])
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const spsc_ring_buffer &x, const spsc_ring_buffer &y) { return !(x == y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_SPSC_RING_BUFFER_H_
@@ -0,0 +1,230 @@
+#ifndef TINYSTL_SRC_STRING_H_
+#define TINYSTL_SRC_STRING_H_
+
+/**
+ * 带短字符串优化（SSO）的字符串，sizeof(string) == 24。
+ *  - 短模式：不超过 23 个字符直接存放在对象内部，最后一个字节存 23 - size()。
+ *    长度正好 23 时这个字节是 0，同时充当结尾的 '\0'。
+ *  - 长模式：{指针, 长度, 容量}，容量的最高位是长模式标记（小端下正好落在最后一个字节的最高位）。
+ *    堆内存来自 __alloc，容量按 8 字节对齐取整，不超过 127 个字符的字符串都从内存池分配。
+ * 两种模式下对象内都没有指向自身的指针，可以按位搬移，vector<string> 扩容时直接 memcpy（见 __is_relocatable）。
+ * 查找、比较转给 string_view，用 memchr、memcmp 实现。
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "__alloc.h"
+#include "string_view.h"
+#include "type_traits.h"
+#include "utility.h"
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "TinySTL::string 的 SSO 布局假定小端字节序"
+#endif
+
+namespace TinySTL {
+
+namespace StringAux {
+// 短模式最多存放的字符数
+const size_t __sso_capacity = 23;
+// 长模式标记，存放在容量的最高位
+const size_t __long_flag = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+}
+
+class string {
+ public:
+  using value_type = char;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = char &;
+  using const_reference = const char &;
+  using pointer = char *;
+  using const_pointer = const char *;
+  using iterator = char *;
+  using const_iterator = const char *;
+  static const size_type npos = string_view::npos;
+
+ protected:
+  struct long_rep {
+    char *ptr;
+    size_type size;
+    size_type cap;  // 不含结尾 '\0'，最高位是长模式标记
+  };
+  struct short_rep {
+    char buf[StringAux::__sso_capacity];
+    unsigned char remain;  // __sso_capacity - size()
+  };
+  union rep_type {
+    long_rep l;
+    short_rep s;
+  };
+  rep_type rep;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、move ctor、copy-and-swap、dtor ****/
+  string() noexcept { set_short_size(0); }
+  string(const char *s) : string(s, std::strlen(s)) {}
+  string(const char *s, size_type n) { init(s, n); }
+  string(size_type n, char c);
+  explicit string(string_view sv) : string(sv.data(), sv.size()) {}
+  template<typename InputIterator>
+  string(InputIterator first, InputIterator last) : string() {
+    init_range(first, last, typename __type_traits<InputIterator>::is_integer());
+  }
+  string(const string &x) : string(x.data(), x.size()) {}
+  // 直接拿走 x 的表示，x 变回空串
+  string(string &&x) noexcept : rep(x.rep) { x.set_short_size(0); }
+  string &operator=(string x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~string() {
+    if (is_long())
+      __alloc::deallocate(rep.l.ptr, long_capacity() + 1);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return is_long() ? rep.l.size : StringAux::__sso_capacity - rep.s.remain; }
+  size_type length() const { return size(); }
+  size_type capacity() const { return is_long() ? long_capacity() : StringAux::__sso_capacity; }
+  bool empty() const { return size() == 0; }
+  const char *data() const { return is_long() ? rep.l.ptr : rep.s.buf; }
+  const char *c_str() const { return data(); }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size(); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+  const_reference operator[](size_type i) const { return data()[i]; }
+  const_reference at(size_type i) const {
+    if (i >= size())
+      throw std::out_of_range("string::at");
+    return data()[i];
+  }
+  const_reference front() const { return data()[0]; }
+  const_reference back() const { return data()[size() - 1]; }
+  operator string_view() const { return string_view(data(), size()); }
+  string_view view() const { return string_view(data(), size()); }
+
+  string substr(size_type pos, size_type n = npos) const { return string(view().substr(pos, n)); }
+  int compare(string_view s) const { return view().compare(s); }
+  bool starts_with(string_view s) const { return view().starts_with(s); }
+  bool ends_with(string_view s) const { return view().ends_with(s); }
+  size_type find(char c, size_type pos = 0) const { return view().find(c, pos); }
+  size_type find(string_view s, size_type pos = 0) const { return view().find(s, pos); }
+  size_type rfind(char c, size_type pos = npos) const { return view().rfind(c, pos); }
+  bool contains(char c) const { return view().contains(c); }
+  bool contains(string_view s) const { return view().contains(s); }
+
+  /*************** 访问元素 ************/
+  char *data() { return is_long() ? rep.l.ptr : rep.s.buf; }
+  iterator begin() { return data(); }
+  iterator end() { return data() + size(); }
+  reference operator[](size_type i) { return data()[i]; }
+  reference at(size_type i) {
+    if (i >= size())
+      throw std::out_of_range("string::at");
+    return data()[i];
+  }
+  reference front() { return data()[0]; }
+  reference back() { return data()[size() - 1]; }
+
+  /*************** 修改 ************/
+  void push_back(char c) {
+    size_type n = size();
+    if (n == capacity()) {
+      append(&c, 1);
+      return;
+    }
+    data()[n] = c;
+    set_size(n + 1);
+  }
+  void pop_back() { set_size(size() - 1); }
+  /// s 可以指向自身
+  string &append(const char *s, size_type n);
+  string &append(size_type n, char c);
+  string &append(string_view s) { return append(s.data(), s.size()); }
+  string &operator+=(string_view s) { return append(s.data(), s.size()); }
+  string &operator+=(char c) {
+    push_back(c);
+    return *this;
+  }
+  string &insert(size_type pos, string_view s);
+  string &erase(size_type pos = 0, size_type n = npos);
+  void resize(size_type n, char c = '\0');
+  void clear() { set_size(0); }
+
+  /*************** 容量 ************/
+  void reserve(size_type n) {
+    if (n > capacity())
+      reallocate(n);
+  }
+  void shrink_to_fit();
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(string &x, string &y) noexcept {
+    rep_type tmp = x.rep;
+    x.rep = y.rep;
+    y.rep = tmp;
+  }
+  friend string operator+(string x, string_view y) { return TinySTL::move(x.append(y)); }
+  friend string operator+(string x, char c) { return TinySTL::move(x += c); }
+  friend bool operator==(const string &x, const string &y) { return x.view() == y.view(); }
+  friend bool operator==(const string &x, const char *y) { return x.view() == string_view(y); }
+  friend bool operator==(const char *x, const string &y) { return string_view(x) == y.view(); }
+  friend bool operator!=(const string &x, const string &y) { return !(x == y); }
+  friend bool operator!=(const string &x, const char *y) { return !(x == y); }
+  friend bool operator!=(const char *x, const string &y) { return !(x == y); }
+  friend bool operator<(const string &x, const string &y) { return x.view() < y.view(); }
+  friend bool operator>(const string &x, const string &y) { return y < x; }
+  friend bool operator<=(const string &x, const string &y) { return !(y < x); }
+  friend bool operator>=(const string &x, const string &y) { return !(x < y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  bool is_long() const { return (rep.s.remain & 0x80) != 0; }
+  size_type long_capacity() const { return rep.l.cap & ~StringAux::__long_flag; }
+  // 设置长度并写入结尾的 '\0'，不检查容量
+  void set_size(size_type n) {
+    if (is_long()) {
+      rep.l.size = n;
+      rep.l.ptr[n] = '\0';
+    } else {
+      set_short_size(n);
+    }
+  }
+  void set_short_size(size_type n) {
+    // n == 23 时 remain 为 0，同时充当 '\0'
+    if (n < StringAux::__sso_capacity)
+      rep.s.buf[n] = '\0';
+    rep.s.remain = static_cast<unsigned char>(StringAux::__sso_capacity - n);
+  }
+  void set_long(char *p, size_type n, size_type cap) {
+    rep.l.ptr = p;
+    rep.l.size = n;
+    rep.l.cap = cap | StringAux::__long_flag;
+  }
+  // 至少能放下 n 个字符的容量：已有容量的两倍，再按 __alloc 的 8 字节对齐取整（算上 '\0'）
+  size_type grow_capacity(size_type n) const;
+  // 按容量 cap 重新分配，保留原有内容
+  void reallocate(size_type cap);
+  void init(const char *s, size_type n);
+  template<typename InputIterator>
+  void init_range(InputIterator first, InputIterator last, __false_type) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+  template<typename Integer>
+  void init_range(Integer n, Integer c, __true_type) { append(static_cast<size_type>(n), static_cast<char>(c)); }
+};
+
+// 没有指向自身的指针，vector 扩容时可以直接 memcpy
+template<>
+struct __is_relocatable<string> {
+  typedef __true_type type;
+};
+
+}
+
+#endif //TINYSTL_SRC_STRING_H_
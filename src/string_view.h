@@ -0,0 +1,130 @@
+#ifndef TINYSTL_SRC_STRING_VIEW_H_
+#define TINYSTL_SRC_STRING_VIEW_H_
+
+/**
+ * 只读的字符区间（指针 + 长度），不持有内存，拷贝代价和两个指针相同。
+ * substr、remove_prefix 等切片操作不拷贝字符；查找、比较直接用 memchr、memcmp。
+ * 不要求以 '\0' 结尾，data() 不能当 C 字符串用。
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace TinySTL {
+
+class string_view {
+ public:
+  using value_type = char;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using const_reference = const char &;
+  using iterator = const char *;
+  using const_iterator = const char *;
+  static const size_type npos = static_cast<size_type>(-1);
+
+ protected:
+  const char *ptr;
+  size_type len;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、析构 ****/
+  constexpr string_view() noexcept : ptr(nullptr), len(0) {}
+  string_view(const char *s) : ptr(s), len(std::strlen(s)) {}
+  constexpr string_view(const char *s, size_type n) : ptr(s), len(n) {}
+
+  /*************** public const 成员函数 ************/
+  constexpr const_iterator begin() const { return ptr; }
+  constexpr const_iterator end() const { return ptr + len; }
+  constexpr size_type size() const { return len; }
+  constexpr size_type length() const { return len; }
+  constexpr bool empty() const { return len == 0; }
+  constexpr const char *data() const { return ptr; }
+  constexpr const_reference operator[](size_type i) const { return ptr[i]; }
+  const_reference front() const { return ptr[0]; }
+  const_reference back() const { return ptr[len - 1]; }
+  const_reference at(size_type i) const {
+    if (i >= len)
+      throw std::out_of_range("string_view::at");
+    return ptr[i];
+  }
+
+  /// 从 pos 开始最多 n 个字符，不拷贝
+  string_view substr(size_type pos, size_type n = npos) const {
+    if (pos > len)
+      throw std::out_of_range("string_view::substr");
+    return string_view(ptr + pos, n < len - pos ? n : len - pos);
+  }
+  int compare(string_view s) const {
+    size_type n = len < s.len ? len : s.len;
+    int res = n == 0 ? 0 : std::memcmp(ptr, s.ptr, n);
+    if (res != 0)
+      return res;
+    return len < s.len ? -1 : (len == s.len ? 0 : 1);
+  }
+  bool starts_with(string_view s) const { return len >= s.len && substr(0, s.len).compare(s) == 0; }
+  bool ends_with(string_view s) const { return len >= s.len && substr(len - s.len).compare(s) == 0; }
+
+  /*************** 查找：找不到时返回 npos ************/
+  size_type find(char c, size_type pos = 0) const {
+    if (pos >= len)
+      return npos;
+    const void *p = std::memchr(ptr + pos, c, len - pos);
+    return p == nullptr ? npos : static_cast<const char *>(p) - ptr;
+  }
+  // 用 memchr 跳到首字符可能匹配的位置，再用 memcmp 比较整个模式串
+  size_type find(string_view s, size_type pos = 0) const {
+    if (s.len == 0)
+      return pos <= len ? pos : npos;
+    if (pos >= len || s.len > len - pos)
+      return npos;
+    const char *cur = ptr + pos;
+    const char *last = ptr + len - s.len + 1;
+    while (cur < last) {
+      cur = static_cast<const char *>(std::memchr(cur, s.ptr[0], last - cur));
+      if (cur == nullptr)
+        return npos;
+      if (std::memcmp(cur, s.ptr, s.len) == 0)
+        return cur - ptr;
+      ++cur;
+    }
+    return npos;
+  }
+  size_type rfind(char c, size_type pos = npos) const {
+    if (len == 0)
+      return npos;
+    for (size_type i = pos < len ? pos + 1 : len; i-- != 0;)
+      if (ptr[i] == c)
+        return i;
+    return npos;
+  }
+  bool contains(char c) const { return find(c) != npos; }
+  bool contains(string_view s) const { return find(s) != npos; }
+
+  /*************** 修改视图本身 ************/
+  void remove_prefix(size_type n) {
+    ptr += n;
+    len -= n;
+  }
+  void remove_suffix(size_type n) { len -= n; }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(string_view &x, string_view &y) {
+    string_view tmp = x;
+    x = y;
+    y = tmp;
+  }
+  friend bool operator==(string_view x, string_view y) {
+    return x.len == y.len && (x.len == 0 || std::memcmp(x.ptr, y.ptr, x.len) == 0);
+  }
+  friend bool operator!=(string_view x, string_view y) { return !(x == y); }
+  friend bool operator<(string_view x, string_view y) { return x.compare(y) < 0; }
+  friend bool operator>(string_view x, string_view y) { return y < x; }
+  friend bool operator<=(string_view x, string_view y) { return !(y < x); }
+  friend bool operator>=(string_view x, string_view y) { return !(x < y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_STRING_VIEW_H_
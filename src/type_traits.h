@@ -6,6 +6,33 @@ namespace TinySTL {
 struct __true_type {};
 struct __false_type {};
 
+// 条件成立时才有 type，用于在重载决议中排除模板
+template<bool Cond, typename T = void>
+struct __enable_if {};
+template<typename T>
+struct __enable_if<true, T> {
+  typedef T type;
+};
+
+template<typename T, typename U>
+struct __is_same_type {
+  static const bool value = false;
+};
+template<typename T>
+struct __is_same_type<T, T> {
+  static const bool value = true;
+};
+
+// 编译期的 bool 转成 __true_type、__false_type，用于标签分派
+template<bool B>
+struct __bool_type {
+  typedef __false_type type;
+};
+template<>
+struct __bool_type<true> {
+  typedef __true_type type;
+};
+
 template<typename T>
 struct __type_traits {
   typedef __false_type has_trivial_default_constructor;
@@ -169,6 +196,13 @@ struct __type_traits<double> {
   typedef __false_type is_integer;
 };
 
+// 可以按位搬移的类型：memcpy 到新地址、旧对象不再析构，等价于"拷贝构造 + 析构旧对象"。
+// POD 都满足；不持有指向自身的指针的类（例如 vector、string）也满足，特化为 __true_type 即可
+template<typename T>
+struct __is_relocatable {
+  typedef typename __type_traits<T>::is_POD_type type;
+};
+
 }
 
 #endif //TINYSTL_SRC_TYPE_TRAITS_H_
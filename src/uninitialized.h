@@ -56,7 +56,7 @@ template<typename ForwardIterator, typename T>
 inline void
 __uninitialized_fill_aux(ForwardIterator first, ForwardIterator last, const T &x, __true_type) {
   // 出口一：fill：memset || assignment operator
-  fill(first, last, x);
+  TinySTL::fill(first, last, x);
 }
 template<typename ForwardIterator, typename T>
 inline void
@@ -79,7 +79,7 @@ template<typename ForwardIterator, typename Size, typename T>
 inline ForwardIterator
 __uninitialized_fill_n_aux(ForwardIterator first, Size n, const T &x, __true_type) {
   // 出口一：fill_n：memset || assignment operator
-  return fill_n(first, n, x);
+  return TinySTL::fill_n(first, n, x);
 }
 
 template<typename ForwardIterator, typename Size, typename T>
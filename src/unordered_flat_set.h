@@ -0,0 +1,100 @@
+#ifndef TINYSTL_SRC_UNORDERED_FLAT_SET_H_
+#define TINYSTL_SRC_UNORDERED_FLAT_SET_H_
+
+/**
+ * 开放寻址的哈希表 set，实现见 __flat_hash_table.h。
+ * 接口和 std::unordered_set 基本一致，区别同 unordered_flat_map。
+ */
+
+#include <functional>
+
+#include "__flat_hash_table.h"
+#include "allocator.h"
+#include "functional.h"
+#include "hash.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+template<typename Key, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>,
+    typename Alloc = allocator<Key>>
+class unordered_flat_set {
+ protected:
+  using table_type = __flat_hash_table<Key, Key, identity<Key>, Hash, KeyEqual, Alloc>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = typename table_type::size_type;
+  using difference_type = typename table_type::difference_type;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  // 元素就是 key，不允许通过迭代器修改
+  using iterator = typename table_type::const_iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+ protected:
+  table_type table;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit unordered_flat_set(size_type bucket_count = 0, const hasher &hf = hasher(),
+                              const key_equal &eq = key_equal()) : table(bucket_count, hf, eq) {}
+  template<typename InputIterator>
+  unordered_flat_set(InputIterator first, InputIterator last, size_type bucket_count = 0,
+                     const hasher &hf = hasher(), const key_equal &eq = key_equal()) : table(bucket_count, hf, eq) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return table.size(); }
+  bool empty() const { return table.empty(); }
+  size_type bucket_count() const { return table.bucket_count(); }
+  float load_factor() const { return table.load_factor(); }
+  float max_load_factor() const { return table.max_load_factor(); }
+  hasher hash_function() const { return table.hash_function(); }
+  key_equal key_eq() const { return table.key_eq_function(); }
+
+  const_iterator begin() const { return table.begin(); }
+  const_iterator end() const { return table.end(); }
+  const_iterator cbegin() const { return table.begin(); }
+  const_iterator cend() const { return table.end(); }
+  const_iterator find(const key_type &key) const { return table.find(key); }
+  size_type count(const key_type &key) const { return table.count(key); }
+  bool contains(const key_type &key) const { return table.count(key) != 0; }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  const_iterator find(const K &key) const { return table.find(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  size_type count(const K &key) const { return table.count(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  bool contains(const K &key) const { return table.count(key) != 0; }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) {
+    auto res = table.insert(val);
+    return pair<iterator, bool>(res.first, res.second);
+  }
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) { table.insert(first, last); }
+  iterator erase(const_iterator pos) { return table.erase(pos); }
+  size_type erase(const key_type &key) { return table.erase_key(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  size_type erase(const K &key) { return table.erase_key(key); }
+  void clear() { table.clear(); }
+
+  /*************** 容量 ************/
+  void reserve(size_type n) { table.reserve(n); }
+  void rehash(size_type n) { table.rehash(n); }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(unordered_flat_set &x, unordered_flat_set &y) { swap(x.table, y.table); }
+  friend bool operator==(const unordered_flat_set &x, const unordered_flat_set &y) { return x.table == y.table; }
+  friend bool operator!=(const unordered_flat_set &x, const unordered_flat_set &y) { return !(x == y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_UNORDERED_FLAT_SET_H_
@@ -0,0 +1,134 @@
+#ifndef TINYSTL_SRC_UNORDERED_MAP_H_
+#define TINYSTL_SRC_UNORDERED_MAP_H_
+
+/**
+ * 拉链法的哈希表 map，实现见 __hashtable.h。
+ * 接口和 std::unordered_map 基本一致。元素存放在单独的节点里，rehash 不会使指针、引用失效；
+ * 需要更快的查找、不需要指针稳定时用 unordered_flat_map。
+ */
+
+#include <functional>
+#include <stdexcept>
+
+#include "__hashtable.h"
+#include "allocator.h"
+#include "functional.h"
+#include "hash.h"
+#include "utility.h"
+
+namespace TinySTL {
+
+template<typename Key, typename T, typename Hash = hash<Key>, typename KeyEqual = equal_to<Key>,
+    typename Alloc = allocator<pair<const Key, T>>>
+class unordered_map {
+ protected:
+  using table_type = __hashtable<pair<const Key, T>, Key, select1st<pair<const Key, T>>, Hash, KeyEqual, Alloc>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = pair<const Key, T>;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = typename table_type::size_type;
+  using difference_type = typename table_type::difference_type;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using iterator = typename table_type::iterator;
+  using const_iterator = typename table_type::const_iterator;
+
+ protected:
+  table_type table;
+
+ public:
+  /**** 生命周期：使用编译器生成的拷贝、移动、析构 ****/
+  explicit unordered_map(size_type bucket_count = 0, const hasher &hf = hasher(),
+                              const key_equal &eq = key_equal()) : table(bucket_count, hf, eq) {}
+  template<typename InputIterator>
+  unordered_map(InputIterator first, InputIterator last, size_type bucket_count = 0,
+                     const hasher &hf = hasher(), const key_equal &eq = key_equal()) : table(bucket_count, hf, eq) {
+    insert(first, last);
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const { return table.size(); }
+  bool empty() const { return table.empty(); }
+  size_type bucket_count() const { return table.bucket_count(); }
+  size_type bucket_size(size_type n) const { return table.bucket_size(n); }
+  float load_factor() const { return table.load_factor(); }
+  float max_load_factor() const { return table.max_load_factor(); }
+  hasher hash_function() const { return table.hash_function(); }
+  key_equal key_eq() const { return table.key_eq_function(); }
+
+  const_iterator begin() const { return table.begin(); }
+  const_iterator end() const { return table.end(); }
+  const_iterator cbegin() const { return table.begin(); }
+  const_iterator cend() const { return table.end(); }
+  const_iterator find(const key_type &key) const { return table.find(key); }
+  size_type count(const key_type &key) const { return table.count(key); }
+  bool contains(const key_type &key) const { return table.count(key) != 0; }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  const_iterator find(const K &key) const { return table.find(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  size_type count(const K &key) const { return table.count(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  bool contains(const K &key) const { return table.count(key) != 0; }
+  const mapped_type &at(const key_type &key) const {
+    auto it = table.find(key);
+    if (it == table.end())
+      throw std::out_of_range("unordered_map::at");
+    return it->second;
+  }
+
+  /*************** 访问元素 ************/
+  iterator begin() { return table.begin(); }
+  iterator end() { return table.end(); }
+  iterator find(const key_type &key) { return table.find(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  iterator find(const K &key) { return table.find(key); }
+  mapped_type &at(const key_type &key) {
+    auto it = table.find(key);
+    if (it == table.end())
+      throw std::out_of_range("unordered_map::at");
+    return it->second;
+  }
+  mapped_type &operator[](const key_type &key) { return table.try_emplace(key).first->second; }
+
+  /*************** 插入删除 ************/
+  pair<iterator, bool> insert(const value_type &val) { return table.insert(val); }
+  // 整个区间最多 rehash 一次
+  template<typename InputIterator>
+  void insert(InputIterator first, InputIterator last) { table.insert(first, last); }
+  /// key 不存在时才构造 mapped_type(args...)
+  template<typename... Args>
+  pair<iterator, bool> try_emplace(const key_type &key, Args &&... args) {
+    return table.try_emplace(key, TinySTL::forward<Args>(args)...);
+  }
+  pair<iterator, bool> insert_or_assign(const key_type &key, const mapped_type &obj) {
+    auto res = table.try_emplace(key, obj);
+    if (!res.second)
+      res.first->second = obj;
+    return res;
+  }
+  iterator erase(iterator pos) { return table.erase(pos); }
+  iterator erase(const_iterator pos) { return table.erase(pos); }
+  size_type erase(const key_type &key) { return table.erase_key(key); }
+  template<typename K, typename H = Hash, typename E = KeyEqual, typename = typename __transparent_lookup<H, E>::type>
+  size_type erase(const K &key) { return table.erase_key(key); }
+  void clear() { table.clear(); }
+
+  /*************** 容量 ************/
+  void max_load_factor(float ml) { table.max_load_factor(ml); }
+  void reserve(size_type n) { table.reserve(n); }
+  void rehash(size_type n) { table.rehash(n); }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(unordered_map &x, unordered_map &y) { swap(x.table, y.table); }
+  friend bool operator==(const unordered_map &x, const unordered_map &y) { return x.table == y.table; }
+  friend bool operator!=(const unordered_map &x, const unordered_map &y) { return !(x == y); }
+};
+
+}
+
+#endif //TINYSTL_SRC_UNORDERED_MAP_H_
@@ -0,0 +1,386 @@
+#ifndef TINYSTL_SRC_UNROLLED_LIST_H_
+#define TINYSTL_SRC_UNROLLED_LIST_H_
+
+/**
+ * 展开链表（unrolled linked list）：每个节点存放一小段连续的元素，并记录当前个数。
+ * 遍历时大部分 ++ 只是下标加一，缓存友好；在迭代器附近插入、删除只需要在一个节点内移动元素，
+ * 节点满了就对半拆分，节点过空就和后继合并。
+ * 注意：插入、删除会使同一节点（以及被拆分、合并的节点）上的迭代器失效。
+ */
+
+#include "algorithm.h"
+#include "allocator.h"
+#include "iterator.h"
+#include "uninitialized.h"
+
+namespace TinySTL {
+
+namespace UnrolledListAux {
+// 节点的目标字节数，与 __alloc 的 MAXBYTES 一致，这样小元素的节点都能落在 free-list 里
+const size_t __node_bytes = 128;
+// 元素太大时至少也要存这么多个，否则就退化成普通链表了
+const size_t __min_node_cap = 4;
+/// 一个节点可以存几个元素
+inline constexpr size_t __node_cap(size_t element_size, size_t header_size) {
+  return (__node_bytes - header_size) / element_size > __min_node_cap ?
+         (__node_bytes - header_size) / element_size :
+         __min_node_cap;
+}
+}
+
+// 只包含链接和元素个数的节点基类，哨兵节点直接内嵌在 unrolled_list 对象中
+struct __unrolled_list_node_base {
+  __unrolled_list_node_base *prev;
+  __unrolled_list_node_base *next;
+  size_t count;
+
+  __unrolled_list_node_base() : prev(this), next(this), count(0) {}
+};
+
+template<typename T>
+struct __unrolled_list_node : public __unrolled_list_node_base {
+  static constexpr size_t capacity =
+      UnrolledListAux::__node_cap(sizeof(T), sizeof(__unrolled_list_node_base));
+
+  // 只是一块原始空间，元素 [0, count) 已构造
+  alignas(T) unsigned char buf[capacity * sizeof(T)];
+
+  T *data() { return reinterpret_cast<T *>(buf); }
+};
+
+template<typename T>
+constexpr size_t __unrolled_list_node<T>::capacity;
+
+template<typename T, typename Ref, typename Ptr>
+struct __unrolled_list_iterator : public iterator<bidirectional_iterator_tag, T> {
+  using value_type = T;
+  using reference = Ref;
+  using pointer = Ptr;
+  using self_type = __unrolled_list_iterator<T, Ref, Ptr>;
+  using link_ptr = __unrolled_list_node_base *;
+  using node_ptr = __unrolled_list_node<T> *;
+
+  template<typename T1, typename Alloc>
+  friend
+  class unrolled_list;
+
+ private:
+  link_ptr node;
+  size_t index;
+
+ public:
+  __unrolled_list_iterator() : node(nullptr), index(0) {}
+  __unrolled_list_iterator(link_ptr n, size_t i) : node(n), index(i) {}
+
+  friend bool operator==(const self_type &lhs, const self_type &rhs) {
+    return lhs.node == rhs.node && lhs.index == rhs.index;
+  }
+  friend bool operator!=(const self_type &lhs, const self_type &rhs) { return !(lhs == rhs); }
+  reference operator*() const { return static_cast<node_ptr>(node)->data()[index]; }
+  pointer operator->() const { return &(operator*()); }
+  self_type &operator++() {
+    if (++index == node->count) {
+      node = node->next;
+      index = 0;
+    }
+    return *this;
+  }
+  self_type &operator--() {
+    if (index == 0) {
+      node = node->prev;
+      index = node->count;
+    }
+    --index;
+    return *this;
+  }
+  self_type operator++(int) {
+    self_type tmp = *this;
+    ++(*this);
+    return tmp;
+  }
+  self_type operator--(int) {
+    self_type tmp = *this;
+    --(*this);
+    return tmp;
+  }
+};
+
+template<typename T, typename Alloc = allocator<__unrolled_list_node<T>>>
+class unrolled_list {
+ protected:
+  using node = __unrolled_list_node<T>;
+  using node_ptr = node *;
+  using link_ptr = __unrolled_list_node_base *;
+
+ public:
+  using value_type = T;
+  using iterator = __unrolled_list_iterator<T, T &, T *>;
+  using const_iterator = __unrolled_list_iterator<T, const T &, const T *>;
+  using reference = T &;
+  using const_reference = const T &;
+  using size_type = size_t;
+
+  // 单个节点能包含多少个元素
+  static constexpr size_type node_capacity = node::capacity;
+
+ protected:
+  using data_allocator = Alloc;
+  // 循环双向链表，哨兵内嵌，不存元素
+  __unrolled_list_node_base dumpy_head;
+  size_type element_count;
+
+ public:
+  /**** 生命周期：ctor、copy ctor、copy assignment、move ctor、move assignment、dtor ****/
+  unrolled_list() noexcept : dumpy_head(), element_count(0) {}
+  explicit unrolled_list(size_type n, const value_type &val = value_type()) : unrolled_list() {
+    typedef typename __type_traits<size_type>::is_integer is_integer;
+    ctor_aux(n, val, is_integer());
+  }
+  template<typename InputIterator>
+  unrolled_list(InputIterator first, InputIterator last) : unrolled_list() {
+    typedef typename __type_traits<InputIterator>::is_integer is_integer;
+    ctor_aux(first, last, is_integer());
+  }
+  // Rule of five
+  unrolled_list(const unrolled_list &x) : unrolled_list(x.begin(), x.end()) {}
+  unrolled_list(unrolled_list &&x) noexcept : unrolled_list() { swap(*this, x); }
+  unrolled_list &operator=(unrolled_list x) {
+    swap(*this, x);
+    return *this;
+  }
+  ~unrolled_list() { clear(); }
+
+  /*************** public const 成员函数 ************/
+  const_iterator begin() const { return const_iterator(dumpy_head.next, 0); }
+  const_iterator end() const { return const_iterator(head(), 0); }
+  size_type size() const { return element_count; }
+  bool empty() const { return element_count == 0; }
+  const_reference front() const { return first_node()->data()[0]; }
+  const_reference back() const { return last_node()->data()[last_node()->count - 1]; }
+
+  /*************** public 成员函数 ************/
+  iterator begin() { return iterator(dumpy_head.next, 0); }
+  iterator end() { return iterator(head(), 0); }
+  reference front() { return first_node()->data()[0]; }
+  reference back() { return last_node()->data()[last_node()->count - 1]; }
+
+  /*************** 插入删除操作相关 ************/
+  void push_back(const value_type &val) {
+    link_ptr tail = dumpy_head.prev;
+    if (tail == head() || tail->count == node_capacity) {
+      tail = link_node_before(head());
+      // 新节点还是空的，构造失败时要摘掉，否则 back() 会访问空节点
+      try {
+        data_allocator::construct(static_cast<node_ptr>(tail)->data(), val);
+      } catch (...) {
+        unlink_and_delete_node(static_cast<node_ptr>(tail));
+        throw;
+      }
+    } else {
+      data_allocator::construct(static_cast<node_ptr>(tail)->data() + tail->count, val);
+    }
+    ++tail->count;
+    ++element_count;
+  }
+  void push_front(const value_type &val) { insert(begin(), val); }
+  void pop_back() { erase(--end()); }
+  void pop_front() { erase(begin()); }
+
+  // 在 position 之前插入，返回指向新元素的迭代器
+  iterator insert(iterator position, const value_type &val) {
+    if (position.node == head()) {
+      push_back(val);
+      return --end();
+    }
+    link_ptr cur = position.node;
+    size_type index = position.index;
+    if (cur->count == node_capacity) {
+      link_ptr prev = cur->prev;
+      if (index == 0 && prev != head() && prev->count < node_capacity) {
+        // 插在节点开头且前驱还有空间，直接追加到前驱末尾
+        cur = prev;
+        index = prev->count;
+      } else {
+        // 节点满了，对半拆分
+        link_ptr next = split_node(cur);
+        if (index > cur->count) {
+          index -= cur->count;
+          cur = next;
+        }
+      }
+    }
+    insert_in_node(static_cast<node_ptr>(cur), index, val);
+    ++element_count;
+    return iterator(cur, index);
+  }
+  void insert(iterator position, size_type n, const value_type &val) {
+    typedef typename __type_traits<size_type>::is_integer is_integer;
+    insert_aux(position, n, val, is_integer());
+  }
+  template<typename InputIterator>
+  void insert(iterator position, InputIterator first, InputIterator last) {
+    typedef typename __type_traits<InputIterator>::is_integer is_integer;
+    insert_aux(position, first, last, is_integer());
+  }
+
+  // 返回被删除元素的下一个元素
+  iterator erase(iterator position) {
+    node_ptr cur = static_cast<node_ptr>(position.node);
+    size_type index = position.index;
+    T *data = cur->data();
+    TinySTL::copy(data + index + 1, data + cur->count, data + index);
+    data_allocator::destroy(data + cur->count - 1);
+    --cur->count;
+    --element_count;
+
+    if (cur->count == 0) {
+      link_ptr next = cur->next;
+      unlink_and_delete_node(cur);
+      return iterator(next, 0);
+    }
+    // 节点过空时把后继并进来，保证相邻两个节点的平均占用率不低于一半
+    link_ptr next = cur->next;
+    if (cur->count < node_capacity / 2 && next != head() && cur->count + next->count <= node_capacity)
+      merge_next_node(cur);
+    if (index < cur->count)
+      return iterator(cur, index);
+    return iterator(cur->next, 0);
+  }
+  iterator erase(iterator first, iterator last) {
+    // 一次删除一个元素，last 所在节点可能因为移动而失效，所以用剩余个数来控制循环
+    auto n = TinySTL::distance(first, last);
+    for (; n > 0; --n)
+      first = erase(first);
+    return first;
+  }
+  void clear() {
+    link_ptr cur = dumpy_head.next;
+    while (cur != head()) {
+      link_ptr next = cur->next;
+      node_ptr p = static_cast<node_ptr>(cur);
+      data_allocator::destroy(p->data(), p->data() + p->count);
+      data_allocator::deallocate(p);
+      cur = next;
+    }
+    dumpy_head.prev = head();
+    dumpy_head.next = head();
+    element_count = 0;
+  }
+
+ public:
+  /*************** 我的朋友 ************/
+  friend void swap(unrolled_list &x, unrolled_list &y) noexcept { x.swap_head(y); }
+  friend bool operator==(const unrolled_list &x, const unrolled_list &y) {
+    if (x.size() != y.size())
+      return false;
+    auto b1 = x.begin(), b2 = y.begin();
+    auto e1 = x.end();
+    for (; b1 != e1; ++b1, ++b2) {
+      if (*b1 != *b2)
+        return false;
+    }
+    return true;
+  }
+  friend bool operator!=(const unrolled_list &x, const unrolled_list &y) { return !(x == y); }
+
+  /*************** 辅助函数 ************/
+ protected:
+  link_ptr head() { return &dumpy_head; }
+  link_ptr head() const { return const_cast<link_ptr>(&dumpy_head); }
+  node_ptr first_node() const { return static_cast<node_ptr>(dumpy_head.next); }
+  node_ptr last_node() const { return static_cast<node_ptr>(dumpy_head.prev); }
+
+  void swap_head(unrolled_list &y) noexcept {
+    using TinySTL::swap;
+    swap(dumpy_head.prev, y.dumpy_head.prev);
+    swap(dumpy_head.next, y.dumpy_head.next);
+    swap(element_count, y.element_count);
+    relink_head(&y.dumpy_head);
+    y.relink_head(&dumpy_head);
+  }
+  // 交换之后，首尾节点还指向旧的哨兵 old_head，把它们改回自己的哨兵
+  void relink_head(link_ptr old_head) noexcept {
+    if (dumpy_head.next == old_head) {
+      dumpy_head.prev = head();
+      dumpy_head.next = head();
+    } else {
+      dumpy_head.next->prev = head();
+      dumpy_head.prev->next = head();
+    }
+  }
+  void ctor_aux(size_type n, const value_type &val, __true_type) {
+    for (; n > 0; --n)
+      push_back(val);
+  }
+  template<typename InputIterator>
+  void ctor_aux(InputIterator first, InputIterator last, __false_type) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+  // insert 返回新元素的位置，++ 之后就是原来 position 指向的元素
+  void insert_aux(iterator position, size_type n, const value_type &val, __true_type) {
+    for (; n > 0; --n)
+      position = ++insert(position, val);
+  }
+  template<typename InputIterator>
+  void insert_aux(iterator position, InputIterator first, InputIterator last, __false_type) {
+    for (; first != last; ++first)
+      position = ++insert(position, *first);
+  }
+
+  // 仅申请空间并链接到 position 之前，不构造元素
+  link_ptr link_node_before(link_ptr position) {
+    node_ptr p = data_allocator::allocate();
+    p->count = 0;
+    p->prev = position->prev;
+    p->next = position;
+    position->prev->next = p;
+    position->prev = p;
+    return p;
+  }
+  void unlink_and_delete_node(node_ptr p) {
+    p->prev->next = p->next;
+    p->next->prev = p->prev;
+    data_allocator::deallocate(p);
+  }
+  // 节点内 [index, count) 右移一位，再在 index 处放入 val。调用者保证节点未满
+  void insert_in_node(node_ptr p, size_type index, const value_type &val) {
+    T *data = p->data();
+    if (index == p->count) {
+      data_allocator::construct(data + index, val);
+    } else {
+      data_allocator::construct(data + p->count, data[p->count - 1]);
+      TinySTL::copy_backward(data + index, data + p->count - 1, data + p->count);
+      data[index] = val;
+    }
+    ++p->count;
+  }
+  // 把 p 的后一半元素移动到新节点，返回新节点
+  link_ptr split_node(link_ptr p) {
+    node_ptr from = static_cast<node_ptr>(p);
+    node_ptr to = static_cast<node_ptr>(link_node_before(p->next));
+    size_type half = from->count / 2;
+    T *first = from->data() + half, *last = from->data() + from->count;
+    TinySTL::uninitialized_copy(first, last, to->data());
+    data_allocator::destroy(first, last);
+    to->count = from->count - half;
+    from->count = half;
+    return to;
+  }
+  // 把 p 的后继节点的元素都移动到 p 末尾，并释放后继
+  void merge_next_node(node_ptr p) {
+    node_ptr next = static_cast<node_ptr>(p->next);
+    T *first = next->data(), *last = next->data() + next->count;
+    TinySTL::uninitialized_copy(first, last, p->data() + p->count);
+    data_allocator::destroy(first, last);
+    p->count += next->count;
+    unlink_and_delete_node(next);
+  }
+};
+
+template<typename T, typename Alloc>
+constexpr typename unrolled_list<T, Alloc>::size_type unrolled_list<T, Alloc>::node_capacity;
+
+}
+
+#endif //TINYSTL_SRC_UNROLLED_LIST_H_
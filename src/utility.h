@@ -0,0 +1,137 @@
+#ifndef TINYSTL_SRC_UTILITY_H_
+#define TINYSTL_SRC_UTILITY_H_
+
+/**
+ * pair、move、forward，以及容器内部用的 __compressed_pair。
+ */
+
+namespace TinySTL {
+
+/***************** [move/forward] *********************/
+template<typename T>
+struct __remove_reference {
+  typedef T type;
+};
+template<typename T>
+struct __remove_reference<T &> {
+  typedef T type;
+};
+template<typename T>
+struct __remove_reference<T &&> {
+  typedef T type;
+};
+
+template<typename T>
+inline typename __remove_reference<T>::type &&
+move(T &&x) noexcept {
+  return static_cast<typename __remove_reference<T>::type &&>(x);
+}
+
+template<typename T>
+inline T &&
+forward(typename __remove_reference<T>::type &x) noexcept {
+  return static_cast<T &&>(x);
+}
+template<typename T>
+inline T &&
+forward(typename __remove_reference<T>::type &&x) noexcept {
+  return static_cast<T &&>(x);
+}
+
+/***************** [pair] *********************/
+// 分别构造 pair 的两个成员：first 拷贝自 key，second 由其余参数直接构造
+struct __piecewise_construct_t {};
+const __piecewise_construct_t __piecewise_construct{};
+
+template<typename T1, typename T2>
+struct pair {
+  typedef T1 first_type;
+  typedef T2 second_type;
+
+  T1 first;
+  T2 second;
+
+  pair() : first(), second() {}
+  pair(const T1 &a, const T2 &b) : first(a), second(b) {}
+  // 右值参数移动进来，只能移动的 T2（例如 unique_ptr）也能构造
+  template<typename U1, typename U2>
+  pair(U1 &&a, U2 &&b) : first(TinySTL::forward<U1>(a)), second(TinySTL::forward<U2>(b)) {}
+  // try_emplace 用：second 原地构造，不必先构造一个临时的 T2 再拷贝；没有参数时值初始化
+  template<typename... Args>
+  pair(__piecewise_construct_t, const T1 &a, Args &&... args) : first(a), second(TinySTL::forward<Args>(args)...) {}
+  // 允许 pair<Key, T> 转换为 pair<const Key, T>
+  template<typename U1, typename U2>
+  pair(const pair<U1, U2> &p) : first(p.first), second(p.second) {}
+  template<typename U1, typename U2>
+  pair(pair<U1, U2> &&p) : first(TinySTL::move(p.first)), second(TinySTL::move(p.second)) {}
+};
+
+template<typename T1, typename T2>
+inline pair<T1, T2>
+make_pair(const T1 &a, const T2 &b) {
+  return pair<T1, T2>(a, b);
+}
+
+template<typename T1, typename T2>
+inline bool
+operator==(const pair<T1, T2> &x, const pair<T1, T2> &y) {
+  return x.first == y.first && x.second == y.second;
+}
+template<typename T1, typename T2>
+inline bool
+operator!=(const pair<T1, T2> &x, const pair<T1, T2> &y) {
+  return !(x == y);
+}
+template<typename T1, typename T2>
+inline bool
+operator<(const pair<T1, T2> &x, const pair<T1, T2> &y) {
+  return x.first < y.first || (!(y.first < x.first) && x.second < y.second);
+}
+
+/***************** [__compressed_pair] *********************/
+/**
+ * 容器用来存放比较函数、哈希函数等可能为空的成员。空类作为成员也要占 1 字节，再加上对齐，
+ * 一个 less<int> 会让 priority_queue<int> 从 24 字节变成 32 字节；改为私有继承后由空基类优化（EBO）省掉。
+ * final 类不能被继承，仍然作为成员存放。
+ * Index 区分两个相同类型的元素，避免重复继承同一个基类。
+ */
+template<typename T, int Index, bool = __is_empty(T) && !__is_final(T)>
+struct __compressed_element {
+  T value;
+
+  __compressed_element() : value() {}
+  template<typename U>
+  explicit __compressed_element(U &&x) : value(TinySTL::forward<U>(x)) {}
+  T &get() { return value; }
+  const T &get() const { return value; }
+};
+
+template<typename T, int Index>
+struct __compressed_element<T, Index, true> : private T {
+  __compressed_element() : T() {}
+  template<typename U>
+  explicit __compressed_element(U &&x) : T(TinySTL::forward<U>(x)) {}
+  T &get() { return *this; }
+  const T &get() const { return *this; }
+};
+
+template<typename T1, typename T2>
+class __compressed_pair : private __compressed_element<T1, 0>, private __compressed_element<T2, 1> {
+ private:
+  using first_base = __compressed_element<T1, 0>;
+  using second_base = __compressed_element<T2, 1>;
+
+ public:
+  __compressed_pair() : first_base(), second_base() {}
+  template<typename U1, typename U2>
+  __compressed_pair(U1 &&a, U2 &&b) : first_base(TinySTL::forward<U1>(a)), second_base(TinySTL::forward<U2>(b)) {}
+
+  T1 &first() { return first_base::get(); }
+  const T1 &first() const { return first_base::get(); }
+  T2 &second() { return second_base::get(); }
+  const T2 &second() const { return second_base::get(); }
+};
+
+}
+
+#endif //TINYSTL_SRC_UTILITY_H_
@@ -1,9 +1,14 @@
 #ifndef TINYSTL_SRC_VECTOR_H_
 #define TINYSTL_SRC_VECTOR_H_
 
+#include <cstring>
+#include <type_traits>
+
 #include "allocator.h"
 #include "algorithm.h"
+#include "type_traits.h"
 #include "uninitialized.h"
+#include "utility.h"
 
 namespace TinySTL {
 
@@ -72,11 +77,12 @@ class vector {
   void reserve(size_type n) {
     if (n <= capacity()) return;
     iterator new_start = data_allocator::allocate(n);
-    iterator new_finish = TinySTL::uninitialized_copy(begin(), end(), new_start);
-    destroy_and_deallocate_all();
-    start = new_start;
-    finish = new_finish;
-    end_of_storage = new_start + n;
+    try {
+      relocate_storage(finish, new_start, n, 0);
+    } catch (...) {
+      data_allocator::deallocate(new_start, n);
+      throw;
+    }
   }
 
   /*************** 访问元素相关 ************/
@@ -109,6 +115,24 @@ class vector {
       insert(end(), val);
     }
   }
+  // 移动构造新元素；需要扩容时先在新空间上构造（val 可能指向旧元素），再把旧元素搬过去
+  void push_back(value_type &&val) {
+    if (finish != end_of_storage) {
+      new(static_cast<void *>(finish)) T(TinySTL::move(val));
+      ++finish;
+      return;
+    }
+    size_type new_cap = get_new_capacity(1);
+    iterator new_start = data_allocator::allocate(new_cap);
+    iterator new_position = new_start + size();
+    try {
+      new(static_cast<void *>(new_position)) T(TinySTL::move(val));
+    } catch (...) {
+      data_allocator::deallocate(new_start, new_cap);
+      throw;
+    }
+    relocate_or_release(finish, new_start, new_cap, new_position, 1);
+  }
   void pop_back() {
     --finish;
     data_allocator::destroy(finish);
@@ -127,11 +151,13 @@ class vector {
   iterator erase(iterator position) { return erase(position, position + 1); }
  public:
   /*************** 我的朋友 ************/
+  // 按执行策略构造、resize（见 vector_parallel.h），需要直接操作未初始化的空间
+  friend struct __vector_parallel;
   friend void swap(vector &x, vector &y) {
-    using TinySTL::swap;
-    swap(x.start, y.start);
-    swap(x.finish, y.finish);
-    swap(x.end_of_storage, y.end_of_storage);
+    // 限定名调用，避免 T 来自 std 时 ADL 找到 std::swap 产生歧义
+    TinySTL::swap(x.start, y.start);
+    TinySTL::swap(x.finish, y.finish);
+    TinySTL::swap(x.end_of_storage, y.end_of_storage);
   }
   friend bool operator==(const vector &lhs, const vector &rhs) {
     if (lhs.size() != rhs.size())
@@ -157,38 +183,92 @@ class vector {
     }
   }
 
-  // TODO: 这里应该使用move
+  // 先在新空间的空位上构造新元素（val、first 可能指向旧元素），再把旧元素搬过去；抛出异常时释放新空间
   void reallocate_and_fill_n(iterator fill_position, size_type n, const value_type &val) {
     size_type new_cap = get_new_capacity(n);
-
     iterator new_start = data_allocator::allocate(new_cap);
-    iterator new_end_of_storage = new_start + new_cap;
-    iterator new_finish = TinySTL::uninitialized_copy(begin(), fill_position, new_start);
-    new_finish = TinySTL::uninitialized_fill_n(new_finish, n, val);
-    new_finish = TinySTL::uninitialized_copy(fill_position, end(), new_finish);
-
-    destroy_and_deallocate_all();
-
-    start = new_start;
-    finish = new_finish;
-    end_of_storage = new_end_of_storage;
+    iterator new_position = new_start + (fill_position - start);
+    try {
+      TinySTL::uninitialized_fill_n(new_position, n, val);
+    } catch (...) {
+      data_allocator::deallocate(new_start, new_cap);
+      throw;
+    }
+    relocate_or_release(fill_position, new_start, new_cap, new_position, n);
   }
   template<typename InputIterator>
   void reallocate_and_copy(iterator fill_position, InputIterator first, InputIterator last) {
-    auto need_storage = TinySTL::distance(first, last);
-    auto new_cap = get_new_capacity(need_storage);
-
+    size_type need_storage = TinySTL::distance(first, last);
+    size_type new_cap = get_new_capacity(need_storage);
     iterator new_start = data_allocator::allocate(new_cap);
-    iterator new_end_of_storage = new_start + new_cap;
-    iterator new_finish = TinySTL::uninitialized_copy(begin(), fill_position, new_start);
-    new_finish = TinySTL::uninitialized_copy(first, last, new_finish);
-    new_finish = TinySTL::uninitialized_copy(fill_position, end(), new_finish);
-
-    destroy_and_deallocate_all();
-
+    iterator new_position = new_start + (fill_position - start);
+    try {
+      TinySTL::uninitialized_copy(first, last, new_position);
+    } catch (...) {
+      data_allocator::deallocate(new_start, new_cap);
+      throw;
+    }
+    relocate_or_release(fill_position, new_start, new_cap, new_position, need_storage);
+  }
+  // 新元素 [new_position, new_position + n) 已经构造好，搬移旧元素失败时析构新元素、释放新空间
+  void relocate_or_release(iterator position, iterator new_start, size_type new_cap,
+                           iterator new_position, size_type n) {
+    try {
+      relocate_storage(position, new_start, new_cap, n);
+    } catch (...) {
+      data_allocator::destroy(new_position, new_position + n);
+      data_allocator::deallocate(new_start, new_cap);
+      throw;
+    }
+  }
+  /**
+   * 把旧元素搬到新空间 new_start（容量 new_cap），position 及之后的元素再往后空出 gap 个位置，然后释放旧空间。
+   * 可以按位搬移的类型（见 __is_relocatable）直接 memcpy，旧元素不再析构；
+   * 其他类型移动构造（移动可能抛出异常时拷贝构造）后析构旧元素。
+   */
+  void relocate_storage(iterator position, iterator new_start, size_type new_cap, size_type gap) {
+    relocate_storage_aux(position, new_start, gap, typename __is_relocatable<T>::type());
+    size_type n = size() + gap;
+    if (capacity() != 0)
+      data_allocator::deallocate(start, capacity());
     start = new_start;
-    finish = new_finish;
-    end_of_storage = new_end_of_storage;
+    finish = new_start + n;
+    end_of_storage = new_start + new_cap;
+  }
+  void relocate_storage_aux(iterator position, iterator new_start, size_type gap, __true_type) {
+    size_type head = position - start, tail = finish - position;
+    if (head != 0)
+      std::memcpy(static_cast<void *>(new_start), static_cast<const void *>(start), head * sizeof(T));
+    if (tail != 0)
+      std::memcpy(static_cast<void *>(new_start + head + gap), static_cast<const void *>(position), tail * sizeof(T));
+  }
+  void relocate_storage_aux(iterator position, iterator new_start, size_type gap, __false_type) {
+    typedef typename __bool_type<std::is_nothrow_move_constructible<T>::value>::type nothrow_move;
+    iterator new_position = relocate_range(begin(), position, new_start, nothrow_move());
+    try {
+      relocate_range(position, end(), new_position + gap, nothrow_move());
+    } catch (...) {
+      data_allocator::destroy(new_start, new_position);
+      throw;
+    }
+    data_allocator::destroy(start, finish);
+  }
+  // 移动构造不抛异常时移动；否则拷贝，失败时析构已拷贝的元素，旧元素保持不变
+  static iterator relocate_range(iterator first, iterator last, iterator result, __true_type) {
+    for (; first != last; ++first, ++result)
+      new(static_cast<void *>(result)) T(TinySTL::move(*first));
+    return result;
+  }
+  static iterator relocate_range(iterator first, iterator last, iterator result, __false_type) {
+    iterator cur = result;
+    try {
+      for (; first != last; ++first, ++cur)
+        data_allocator::construct(cur, *first);
+    } catch (...) {
+      data_allocator::destroy(result, cur);
+      throw;
+    }
+    return cur;
   }
   template<typename InputIterator>
   void allocate_and_copy(InputIterator first, InputIterator last) {
@@ -263,6 +343,12 @@ void vector<T, Alloc>::insert_aux(iterator position, InputIterator first, InputI
   }
 }
 
+// 只持有指向堆内存的指针，vector<vector<T>> 扩容时可以直接 memcpy
+template<typename T, typename Alloc>
+struct __is_relocatable<vector<T, Alloc>> {
+  typedef __true_type type;
+};
+
 }
 
 #endif //TINYSTL_SRC_VECTOR_H_
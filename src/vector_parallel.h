@@ -0,0 +1,93 @@
+#ifndef TINYSTL_SRC_VECTOR_PARALLEL_H_
+#define TINYSTL_SRC_VECTOR_PARALLEL_H_
+
+/**
+ * 按执行策略初始化 vector：
+ *
+ *   auto v = make_vector<double>(execution::first_touch, n, 0.0);
+ *   resize(execution::par, v, 2 * n, 1.0);
+ *
+ * 不是 vector 的成员，单独放在这里，只有用到执行策略的代码才会引入 parallel_algorithm.h 和 scheduler.h（<thread>、<mutex> 等）；
+ * 没有包含本文件时直接编译失败，而不是链接时找不到定义。
+ * 只有 POD 元素才按策略并行初始化：非 POD 元素的拷贝构造可能经由 __alloc 申请内存，而 __alloc 不是线程安全的。
+ */
+
+#include "parallel_algorithm.h"
+#include "vector.h"
+
+namespace TinySTL {
+
+// 非 POD 元素退化为 seq
+template<typename ExecutionPolicy>
+inline const ExecutionPolicy &__vector_policy(const ExecutionPolicy &policy, __true_type) { return policy; }
+template<typename ExecutionPolicy>
+inline const execution::sequenced_policy &__vector_policy(const ExecutionPolicy &, __false_type) {
+  return execution::seq;
+}
+
+// vector 的友元，直接在未初始化的空间上按策略构造元素
+struct __vector_parallel {
+  template<typename T, typename Alloc, typename ExecutionPolicy>
+  static void fill_init(vector<T, Alloc> &v, const ExecutionPolicy &policy, size_t n, const T &value) {
+    typedef typename __type_traits<T>::is_POD_type is_POD;
+    T *start = Alloc::allocate(n);
+    try {
+      TinySTL::uninitialized_fill_n(TinySTL::__vector_policy(policy, is_POD()), start, n, value);
+    } catch (...) {
+      if (n != 0)
+        Alloc::deallocate(start, n);
+      throw;
+    }
+    v.start = start;
+    v.finish = start + n;
+    v.end_of_storage = v.finish;
+  }
+
+  template<typename T, typename Alloc, typename ExecutionPolicy>
+  static void resize(vector<T, Alloc> &v, const ExecutionPolicy &policy, size_t new_size, const T &x) {
+    if (new_size <= v.size()) {
+      v.erase(v.begin() + new_size, v.end());
+      return;
+    }
+    typedef typename __type_traits<T>::is_POD_type is_POD;
+    auto &&real_policy = TinySTL::__vector_policy(policy, is_POD());
+    size_t n = new_size - v.size();
+    if (v.left_storage() < n) {
+      size_t new_cap = v.get_new_capacity(n);
+      T *new_start = Alloc::allocate(new_cap);
+      T *new_finish;
+      try {
+        new_finish = TinySTL::uninitialized_copy(real_policy, v.begin(), v.end(), new_start);
+      } catch (...) {
+        Alloc::deallocate(new_start, new_cap);
+        throw;
+      }
+      v.destroy_and_deallocate_all();
+      v.start = new_start;
+      v.finish = new_finish;
+      v.end_of_storage = new_start + new_cap;
+    }
+    v.finish = TinySTL::uninitialized_fill_n(real_policy, v.finish, n, x);
+  }
+};
+
+/// 按执行策略构造 n 个 value 的 vector，例如 make_vector<double>(execution::first_touch, n, 0.0)，见 execution.h
+template<typename T, typename Alloc = allocator<T>, typename ExecutionPolicy>
+inline __enable_if_policy<ExecutionPolicy, vector<T, Alloc>>
+make_vector(const ExecutionPolicy &policy, size_t n, const typename vector<T, Alloc>::value_type &value) {
+  vector<T, Alloc> v;
+  __vector_parallel::fill_init(v, policy, n, value);
+  return v;
+}
+
+/// 新增的元素按执行策略初始化；需要扩容时，旧元素也按该策略拷贝到新空间
+template<typename ExecutionPolicy, typename T, typename Alloc>
+inline __enable_if_policy<ExecutionPolicy>
+resize(const ExecutionPolicy &policy, vector<T, Alloc> &v, typename vector<T, Alloc>::size_type new_size,
+       const typename vector<T, Alloc>::value_type &x) {
+  __vector_parallel::resize(v, policy, new_size, x);
+}
+
+}
+
+#endif //TINYSTL_SRC_VECTOR_PARALLEL_H_
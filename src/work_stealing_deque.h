@@ -0,0 +1,157 @@
+#ifndef TINYSTL_SRC_WORK_STEALING_DEQUE_H_
+#define TINYSTL_SRC_WORK_STEALING_DEQUE_H_
+
+/**
+ * Chase-Lev 工作窃取双端队列（按 Lê 等人的 C11 内存模型版本实现）。
+ * 拥有者线程在底部（bottom）push、pop，像栈一样后进先出；其他线程在顶部（top）steal，先进先出。
+ * 只有队列里剩最后一个元素时，拥有者和窃取者才会在 top 上 CAS 竞争。
+ * 元素存放在可增长的环形数组里，满了之后由拥有者换成两倍大小的新数组。
+ *
+ * 注意：
+ *  1. T 必须是可平凡拷贝的小类型（通常是任务指针），槽位是 std::atomic<T>。
+ *  2. push_bottom、pop_bottom 只能由拥有者线程调用，steal 可以由任意线程调用。
+ *  3. 窃取者可能还在读旧数组，所以换下来的旧数组不立即释放，挂在链表上直到析构。
+ *  4. 数组用 new/delete 申请而不是 __alloc：后者不是线程安全的，而扩容发生在工作线程上。
+ *  5. size()、empty() 在并发时只是一个瞬时的近似值。
+ */
+
+#include <atomic>
+#include <cstddef>
+
+#include "__concurrent.h"
+
+namespace TinySTL {
+
+namespace WorkStealingAux {
+// 初始容量，必须是 2 的幂
+const ptrdiff_t __initial_capacity = 64;
+}
+
+// 环形数组，下标对容量取模
+template<typename T>
+class __ws_array {
+ public:
+  ptrdiff_t capacity;
+  ptrdiff_t mask;
+  std::atomic<T> *slots;
+  __ws_array *retired; // 被它替换掉的旧数组
+
+ public:
+  explicit __ws_array(ptrdiff_t cap) :
+      capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]), retired(nullptr) {}
+  __ws_array(const __ws_array &) = delete;
+  __ws_array &operator=(const __ws_array &) = delete;
+  ~__ws_array() { delete[] slots; }
+
+  T get(ptrdiff_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+  void put(ptrdiff_t i, T val) { slots[i & mask].store(val, std::memory_order_relaxed); }
+  // 拷贝 [top, bottom) 到两倍大小的新数组
+  __ws_array *grow(ptrdiff_t top, ptrdiff_t bottom) const {
+    __ws_array *res = new __ws_array(capacity * 2);
+    for (ptrdiff_t i = top; i != bottom; ++i)
+      res->put(i, get(i));
+    return res;
+  }
+};
+
+template<typename T>
+class work_stealing_deque {
+ public:
+  using value_type = T;
+  using size_type = size_t;
+
+ protected:
+  using array_type = __ws_array<T>;
+
+ protected:
+  // 下标只增不减（pop_bottom 会先减再恢复），用有符号数方便比较
+  alignas(__cache_line_size) std::atomic<ptrdiff_t> top;
+  alignas(__cache_line_size) std::atomic<ptrdiff_t> bottom;
+  std::atomic<array_type *> array;
+
+ public:
+  /**** 生命周期：不可拷贝、不可移动 ****/
+  explicit work_stealing_deque(ptrdiff_t capacity = WorkStealingAux::__initial_capacity) :
+      top(0), bottom(0) {
+    ptrdiff_t cap = 2;
+    while (cap < capacity)
+      cap <<= 1;
+    array.store(new array_type(cap), std::memory_order_relaxed);
+  }
+  work_stealing_deque(const work_stealing_deque &) = delete;
+  work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+  ~work_stealing_deque() {
+    array_type *a = array.load(std::memory_order_relaxed);
+    while (a != nullptr) {
+      array_type *next = a->retired;
+      delete a;
+      a = next;
+    }
+  }
+
+  /*************** public const 成员函数 ************/
+  size_type size() const {
+    ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+    ptrdiff_t t = top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<size_type>(b - t) : 0;
+  }
+  bool empty() const { return size() == 0; }
+  size_type capacity() const { return array.load(std::memory_order_relaxed)->capacity; }
+
+  /*************** 拥有者 ************/
+  void push_bottom(T val) {
+    ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+    ptrdiff_t t = top.load(std::memory_order_acquire);
+    array_type *a = array.load(std::memory_order_relaxed);
+    if (b - t > a->capacity - 1) {
+      array_type *bigger = a->grow(t, b);
+      bigger->retired = a;
+      array.store(bigger, std::memory_order_release);
+      a = bigger;
+    }
+    a->put(b, val);
+    // release：窃取者 acquire 读到新的 bottom 后，一定能看到槽位和任务本身的内容
+    bottom.store(b + 1, std::memory_order_release);
+  }
+  bool pop_bottom(T &val) {
+    ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+    array_type *a = array.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    // 先让窃取者看到减小的 bottom，再读 top
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptrdiff_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+      // 队列已空
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    val = a->get(b);
+    if (t == b) {
+      // 最后一个元素，和窃取者竞争
+      bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return won;
+    }
+    return true;
+  }
+
+  /*************** 窃取者 ************/
+  // 队列为空或者 CAS 失败（被别人抢走）都返回 false
+  bool steal(T &val) {
+    ptrdiff_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    ptrdiff_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+      return false;
+    array_type *a = array.load(std::memory_order_acquire);
+    T res = a->get(t);
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      return false;
+    val = res;
+    return true;
+  }
+};
+
+}
+
+#endif //TINYSTL_SRC_WORK_STEALING_DEQUE_H_
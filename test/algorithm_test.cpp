@@ -57,5 +57,20 @@ TEST(HeapTEST, heap) {
   EXPECT_TRUE(TinySTL::Test::container_equal(v1, v2));
 }
 
+// 包括重复元素、空区间、所有长度的边界情况
+TEST(BoundTest, LowerUpperBound) {
+  for (int n = 0; n < 40; ++n) {
+    std::vector<int> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(i / 3 * 2);
+    for (int val = -1; val <= n; ++val) {
+      EXPECT_EQ(TinySTL::lower_bound(v.begin(), v.end(), val) - v.begin(),
+                std::lower_bound(v.begin(), v.end(), val) - v.begin());
+      EXPECT_EQ(TinySTL::upper_bound(v.begin(), v.end(), val) - v.begin(),
+                std::upper_bound(v.begin(), v.end(), val) - v.begin());
+    }
+  }
+}
+
 }
 }
@@ -0,0 +1,230 @@
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/btree_map.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename Map, typename StdMap>
+bool ordered_map_equal(const Map &m, const StdMap &std_m) {
+  if (m.size() != std_m.size())
+    return false;
+  auto it = m.begin();
+  for (auto std_it = std_m.begin(); std_it != std_m.end(); ++std_it, ++it) {
+    if (it == m.end() || it->first != std_it->first || it->second != std_it->second)
+      return false;
+  }
+  return it == m.end();
+}
+
+TEST(BtreeMapTest, InsertFindErase) {
+  btree_map<int, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.find(1) == m.end());
+  EXPECT_EQ(m.erase(1), 0);
+
+  // 逆序插入，每次都插在最左边
+  for (int i = 999; i >= 0; --i)
+    EXPECT_TRUE(m.insert(TinySTL::make_pair(i, i * 2)).second);
+  EXPECT_FALSE(m.insert(TinySTL::make_pair(5, 0)).second);
+  EXPECT_EQ(m.size(), 1000);
+  EXPECT_GT(m.height(), 1);
+  int expect = 0;
+  for (auto it = m.begin(); it != m.end(); ++it, ++expect)
+    EXPECT_EQ(it->first, expect);
+  EXPECT_EQ(expect, 1000);
+  EXPECT_EQ(m.at(10), 20);
+  EXPECT_THROW(m.at(1000), std::out_of_range);
+
+  // 边遍历边删除
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 2 == 0)
+      it = m.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(m.size(), 500);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.count(i), i % 2);
+  for (int i = 1; i < 1000; i += 2)
+    EXPECT_EQ(m.erase(i), 1);
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.height(), 0);
+  EXPECT_TRUE(m.begin() == m.end());
+}
+
+TEST(BtreeMapTest, Bounds) {
+  btree_map<int, int> m;
+  for (int i = 0; i < 1000; ++i)
+    m[i * 10] = i;
+  EXPECT_EQ(m.lower_bound(55)->first, 60);
+  EXPECT_EQ(m.lower_bound(60)->first, 60);
+  EXPECT_EQ(m.upper_bound(60)->first, 70);
+  EXPECT_EQ(m.lower_bound(-1)->first, 0);
+  EXPECT_TRUE(m.lower_bound(9991) == m.end());
+  EXPECT_TRUE(m.upper_bound(9990) == m.end());
+  auto range = m.equal_range(500);
+  EXPECT_EQ(range.first->first, 500);
+  EXPECT_EQ(range.second->first, 510);
+
+  // 区间遍历 [100, 200)
+  int sum = 0;
+  for (auto it = m.lower_bound(100); it != m.lower_bound(200); ++it)
+    sum += it->second;
+  EXPECT_EQ(sum, 10 + 11 + 12 + 13 + 14 + 15 + 16 + 17 + 18 + 19);
+
+  // 反向遍历
+  int expect = 999;
+  for (auto it = m.end(); it != m.begin(); --expect) {
+    --it;
+    EXPECT_EQ(it->second, expect);
+  }
+  EXPECT_EQ(expect, -1);
+}
+
+// 随机插入、删除、查找，和 std::map 对比，包括遍历顺序
+TEST(BtreeMapTest, Random) {
+  std::mt19937 gen(11);
+  btree_map<int, std::string> m;
+  std::map<int, std::string> std_m;
+  for (int round = 0; round < 100000; ++round) {
+    int key = static_cast<int>(gen() % 3000);
+    switch (gen() % 5) {
+      case 0:
+      case 1:m[key] = std::to_string(round);
+        std_m[key] = std::to_string(round);
+        break;
+      case 2:
+      case 3:EXPECT_EQ(m.erase(key), std_m.erase(key));
+        break;
+      default: {
+        auto it = m.lower_bound(key);
+        auto std_it = std_m.lower_bound(key);
+        EXPECT_EQ(it == m.end(), std_it == std_m.end());
+        if (std_it != std_m.end()) {
+          EXPECT_EQ(it->first, std_it->first);
+        }
+        break;
+      }
+    }
+  }
+  EXPECT_TRUE(ordered_map_equal(m, std_m));
+  while (!std_m.empty()) {
+    EXPECT_EQ(m.erase(std_m.begin()->first), 1);
+    std_m.erase(std_m.begin());
+  }
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(BtreeMapTest, AssignSorted) {
+  for (int n : {0, 1, 10, 100, 1000, 12345}) {
+    std::vector<pair<int, int>> v;
+    for (int i = 0; i < n; ++i)
+      v.push_back(TinySTL::make_pair(i * 2, i));
+    btree_map<int, int> m;
+    m[-1] = -1;
+    m.assign_sorted(v.begin(), v.end());
+    EXPECT_EQ(m.size(), n);
+    int expect = 0;
+    for (auto it = m.begin(); it != m.end(); ++it, ++expect)
+      EXPECT_EQ(it->first, expect * 2);
+    EXPECT_EQ(expect, n);
+    // 建好的树可以正常插入、删除
+    for (int i = 0; i < n; ++i)
+      EXPECT_TRUE(m.insert(TinySTL::make_pair(i * 2 + 1, i)).second);
+    for (int i = 0; i < n; ++i)
+      EXPECT_EQ(m.erase(i * 2), 1);
+    EXPECT_EQ(m.size(), n);
+    expect = 0;
+    for (auto it = m.begin(); it != m.end(); ++it, ++expect)
+      EXPECT_EQ(it->first, expect * 2 + 1);
+  }
+}
+
+TEST(BtreeMapTest, Merge) {
+  btree_map<int, int> m1, m2;
+  for (int i = 0; i < 1000; i += 2)
+    m1[i] = 1;
+  for (int i = 0; i < 1000; i += 3)
+    m2[i] = 2;
+  m1.merge(m2);
+  EXPECT_EQ(m1.size(), 500 + 334 - 167);
+  EXPECT_EQ(m2.size(), 167);
+  for (auto it = m2.begin(); it != m2.end(); ++it)
+    EXPECT_EQ(it->first % 6, 0);
+  EXPECT_EQ(m1[3], 2);
+  EXPECT_EQ(m1[6], 1);
+}
+
+TEST(BtreeMapTest, MoveOnlyMapped) {
+  // mapped_type 由参数原地构造，merge 时移动而不是拷贝
+  btree_map<int, std::unique_ptr<int>> m1, m2;
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_TRUE(m1.try_emplace(i, new int(i)).second);
+  for (int i = 0; i < 1000; i += 3)
+    EXPECT_TRUE(m2.emplace(i, std::unique_ptr<int>(new int(-i))).second);
+  std::unique_ptr<int> seven(new int(7));
+  EXPECT_FALSE(m1.try_emplace(0, std::move(seven)).second);
+  EXPECT_NE(seven, nullptr);
+  EXPECT_TRUE(m1.try_emplace(1001).second);
+  EXPECT_EQ(m1[1001], nullptr);
+  EXPECT_TRUE(m1.insert(btree_map<int, std::unique_ptr<int>>::value_type(1003, nullptr)).second);
+  m1.merge(m2);
+  EXPECT_EQ(m1.size(), 500 + 334 - 167 + 2);
+  EXPECT_EQ(m2.size(), 167);
+  // key 已存在的元素留在 source，没有被移走
+  for (auto it = m2.begin(); it != m2.end(); ++it)
+    EXPECT_EQ(*it->second, -it->first);
+  EXPECT_EQ(*m1[3], -3);
+  EXPECT_EQ(*m1[6], 6);
+
+  btree_map<int, std::string> s;
+  EXPECT_TRUE(s.try_emplace(1, 3, 'x').second);
+  EXPECT_EQ(s[1], "xxx");
+}
+
+TEST(BtreeMapTest, CopyMoveSwap) {
+  btree_map<std::string, int> m1, m2;
+  for (int i = 0; i < 1000; ++i)
+    m1[std::to_string(i)] = i;
+  auto m3 = m1;
+  EXPECT_TRUE(m3 == m1);
+  m3["0"] = -1;
+  EXPECT_TRUE(m3 != m1);
+  m2 = m1;
+  auto m4 = TinySTL::move(m2);
+  EXPECT_TRUE(m4 == m1);
+  EXPECT_TRUE(m2.empty());
+  swap(m3, m4);
+  EXPECT_EQ(m4["0"], -1);
+  EXPECT_EQ(m3["0"], 0);
+  EXPECT_GT(m1.bytes_used(), 0);
+}
+
+TEST(BtreeMapTest, Life) {
+  CountLife::set_zero_all();
+  {
+    btree_map<int, CountLife> m;
+    for (int i = 0; i < 2000; ++i)
+      m[i];
+    for (int i = 0; i < 2000; i += 3)
+      m.erase(i);
+    auto copy = m;
+    copy.clear();
+    for (auto it = m.begin(); it != m.end();)
+      it = m.erase(it);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+}
+}
@@ -0,0 +1,59 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/btree_set.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 元素很小，节点很宽，树高很低
+TEST(BtreeSetTest, Random) {
+  std::mt19937 gen(5);
+  btree_set<int> s;
+  std::set<int> std_s;
+  for (int round = 0; round < 200000; ++round) {
+    int key = static_cast<int>(gen() % 20000);
+    if (gen() % 2)
+      EXPECT_EQ(s.insert(key).second, std_s.insert(key).second);
+    else
+      EXPECT_EQ(s.erase(key), std_s.erase(key));
+  }
+  EXPECT_TRUE(container_equal(s, std_s));
+
+  std::vector<int> v(std_s.begin(), std_s.end());
+  btree_set<int> bulk;
+  bulk.assign_sorted(v.begin(), v.end());
+  EXPECT_TRUE(bulk == s);
+  EXPECT_LE(bulk.bytes_used(), s.bytes_used());
+}
+
+// 元素很大，每个节点只有最少的 3 个元素，分裂、合并最频繁
+struct Big {
+  int key;
+  char payload[200];
+  bool operator<(const Big &x) const { return key < x.key; }
+  bool operator==(const Big &x) const { return key == x.key; }
+  bool operator!=(const Big &x) const { return key != x.key; }
+};
+
+TEST(BtreeSetTest, BigElements) {
+  std::mt19937 gen(9);
+  btree_set<Big> s;
+  std::set<Big> std_s;
+  for (int round = 0; round < 50000; ++round) {
+    Big b;
+    b.key = static_cast<int>(gen() % 2000);
+    if (gen() % 2)
+      EXPECT_EQ(s.insert(b).second, std_s.insert(b).second);
+    else
+      EXPECT_EQ(s.erase(b), std_s.erase(b));
+  }
+  EXPECT_TRUE(container_equal(s, std_s));
+}
+
+}
+}
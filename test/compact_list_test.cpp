@@ -0,0 +1,164 @@
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../src/compact_list.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename T>
+using stdL = std::list<T>;
+
+template<typename T>
+using tsCL = TinySTL::compact_list<T>;
+
+TEST(CompactListTest, NodeSize) {
+  // 32 位下标，每个元素 12 字节
+  EXPECT_EQ(sizeof(__compact_list_node<uint32_t>), 12);
+}
+
+TEST(CompactListTest, Ctor) {
+  stdL<int> l1(10, 8);
+  tsCL<int> l2(10, 8);
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+
+  int arr[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  stdL<int> l3(std::begin(arr), std::end(arr));
+  tsCL<int> l4(std::begin(arr), std::end(arr));
+  EXPECT_TRUE(TinySTL::Test::container_equal(l3, l4));
+
+  auto l5(l4);
+  EXPECT_TRUE(l5 == l4);
+  auto l6(std::move(l5));
+  EXPECT_TRUE(l5.empty());
+  EXPECT_TRUE(TinySTL::Test::container_equal(l3, l6));
+  l5 = l2;
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l5));
+}
+
+TEST(CompactListTest, RandomInsertErase) {
+  std::mt19937 rd(7);
+  stdL<std::string> l1;
+  tsCL<std::string> l2;
+  for (auto round = 0; round != 3000; ++round) {
+    auto pos = l1.empty() ? 0 : rd() % (l1.size() + 1);
+    auto it1 = l1.begin();
+    auto it2 = l2.begin();
+    for (auto i = pos; i != 0; --i) {
+      ++it1;
+      ++it2;
+    }
+    if (rd() % 3 != 0 || it1 == l1.end()) {
+      auto val = std::to_string(round);
+      it1 = l1.insert(it1, val);
+      it2 = l2.insert(it2, val);
+      EXPECT_EQ(*it1, *it2);
+    } else {
+      it1 = l1.erase(it1);
+      it2 = l2.erase(it2);
+      EXPECT_EQ(it1 == l1.end(), it2 == l2.end());
+    }
+  }
+  EXPECT_EQ(l1.size(), l2.size());
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  // 删除的节点被复用，节点池不会无限增长
+  EXPECT_LT(l2.capacity(), 3000);
+
+  l2.compact();
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  l1.reverse();
+  l2.reverse();
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  l1.push_front("front");
+  l2.push_front("front");
+  l1.push_back("back");
+  l2.push_back("back");
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  EXPECT_EQ(l1.front(), l2.front());
+  EXPECT_EQ(l1.back(), l2.back());
+}
+
+TEST(CompactListTest, Compact) {
+  tsCL<int> l;
+  for (auto i = 0; i != 100; ++i)
+    l.push_front(i);
+  l.remove_if([](int n) { return n % 3 == 0; });
+  l.compact();
+  // compact 之后节点按遍历顺序连续存放
+  EXPECT_EQ(l.capacity(), l.size());
+  const int *prev = nullptr;
+  for (auto &x : l) {
+    if (prev != nullptr) {
+      EXPECT_EQ(reinterpret_cast<const char *>(&x) - reinterpret_cast<const char *>(prev),
+                sizeof(__compact_list_node<int>));
+    }
+    prev = &x;
+  }
+  auto it = l.end();
+  --it;
+  EXPECT_EQ(*it, 1);
+}
+
+TEST(CompactListTest, PopRemove) {
+  int arr[] = {17, 89, 7, 14, 89, 0, 1, 4};
+  stdL<int> l1(std::begin(arr), std::end(arr));
+  tsCL<int> l2(std::begin(arr), std::end(arr));
+  l1.remove(89);
+  l2.remove(89);
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  l1.pop_front();
+  l2.pop_front();
+  l1.pop_back();
+  l2.pop_back();
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  l2.clear();
+  EXPECT_TRUE(l2.empty());
+  EXPECT_TRUE(l2.begin() == l2.end());
+  l2.push_back(1);
+  EXPECT_EQ(l2.front(), 1);
+}
+
+TEST(CompactListTest, EraseDestroys) {
+  auto res = std::make_shared<int>(1);
+  tsCL<std::shared_ptr<int>> l;
+  for (auto i = 0; i != 10; ++i)
+    l.push_back(res);
+  EXPECT_EQ(res.use_count(), 11);
+  // 删除时立即析构，不等节点被复用
+  l.pop_front();
+  l.erase(l.begin(), ++(++l.begin()));
+  EXPECT_EQ(res.use_count(), 8);
+  // 复用空闲节点、扩容、拷贝、compact 都不会多出或丢掉元素
+  for (auto i = 0; i != 20; ++i)
+    l.push_back(res);
+  EXPECT_EQ(res.use_count(), 28);
+  auto l2 = l;
+  EXPECT_EQ(res.use_count(), 55);
+  l2.remove_if([](const std::shared_ptr<int> &) { return true; });
+  EXPECT_EQ(res.use_count(), 28);
+  l.compact();
+  EXPECT_EQ(res.use_count(), 28);
+  l.clear();
+  EXPECT_EQ(res.use_count(), 1);
+
+  CountLife::set_zero_all();
+  {
+    tsCL<CountLife> l3;
+    for (auto i = 0; i != 100; ++i)
+      l3.push_back(CountLife());
+    l3.remove_if([](const CountLife &) { return true; });
+    EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+    for (auto i = 0; i != 50; ++i)
+      l3.push_front(CountLife());
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+}
+}
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <deque>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -140,6 +142,230 @@ tsDQ<int> getDeque(int n) {
   return tsDQ<int>(test_case.begin(), test_case.end());
 }
 
+// 跨越多个 bucket、且首尾都不在 bucket 边界上
+template<typename T, typename Gen>
+void fillBoth(stdDQ<T> &dq1, tsDQ<T> &dq2, int n, Gen gen) {
+  for (int i = 0; i < n; ++i) {
+    dq1.push_back(gen(i));
+    dq2.push_back(gen(i));
+  }
+  for (int i = 0; i < n / 3; ++i) {
+    dq1.push_front(gen(-i));
+    dq2.push_front(gen(-i));
+  }
+}
+
+TEST(DequeTest, SegmentedCopy) {
+  stdDQ<int> dq1;
+  tsDQ<int> dq2;
+  fillBoth(dq1, dq2, 3000, [](int i) { return i; });
+  int n = static_cast<int>(dq1.size());
+
+  // deque -> 原生指针
+  std::vector<int> v1(n), v2(n);
+  std::copy(dq1.begin() + 7, dq1.end() - 5, v1.begin());
+  auto res = TinySTL::copy(dq2.begin() + 7, dq2.end() - 5, v2.data());
+  EXPECT_EQ(res, v2.data() + (n - 12));
+  EXPECT_TRUE(container_equal(v1, v2));
+
+  // 原生指针 -> deque
+  for (int i = 0; i < n; ++i)
+    v1[i] = v2[i] = -i;
+  std::copy(v1.begin(), v1.begin() + 2000, dq1.begin() + 300);
+  auto it = TinySTL::copy(v2.data(), v2.data() + 2000, dq2.begin() + 300);
+  EXPECT_TRUE(it == dq2.begin() + 2300);
+  EXPECT_TRUE(container_equal(dq1, dq2));
+
+  // deque -> deque，两边的 bucket 边界错开
+  stdDQ<int> dq3(n, 0);
+  tsDQ<int> dq4(n, 0);
+  std::copy(dq1.begin() + 1, dq1.end(), dq3.begin() + 0);
+  it = TinySTL::copy(dq2.begin() + 1, dq2.end(), dq4.begin());
+  EXPECT_TRUE(it == dq4.end() - 1);
+  EXPECT_TRUE(container_equal(dq3, dq4));
+
+  // 同一个 deque 内重叠区间向后平移
+  std::copy_backward(dq1.begin(), dq1.end() - 333, dq1.end());
+  it = TinySTL::copy_backward(dq2.begin(), dq2.end() - 333, dq2.end());
+  EXPECT_TRUE(it == dq2.begin() + 333);
+  EXPECT_TRUE(container_equal(dq1, dq2));
+
+  // 非平凡类型
+  stdDQ<std::string> dq5;
+  tsDQ<std::string> dq6;
+  fillBoth(dq5, dq6, 200, [](int i) { return std::to_string(i); });
+  std::copy_backward(dq5.begin() + 3, dq5.begin() + 150, dq5.end() - 2);
+  TinySTL::copy_backward(dq6.begin() + 3, dq6.begin() + 150, dq6.end() - 2);
+  EXPECT_TRUE(container_equal(dq5, dq6));
+  tsDQ<std::string> dq7(dq6.begin(), dq6.end());
+  EXPECT_TRUE(dq7 == dq6);
+}
+
+TEST(DequeTest, SegmentedFillEqual) {
+  stdDQ<char> dq1;
+  tsDQ<char> dq2;
+  fillBoth(dq1, dq2, 5000, [](int i) { return static_cast<char>(i); });
+  std::fill(dq1.begin() + 10, dq1.end() - 10, 'x');
+  TinySTL::fill(dq2.begin() + 10, dq2.end() - 10, 'x');
+  EXPECT_TRUE(container_equal(dq1, dq2));
+  std::fill_n(dq1.begin() + 1, 3000, 'y');
+  auto it = TinySTL::fill_n(dq2.begin() + 1, 3000, 'y');
+  EXPECT_TRUE(it == dq2.begin() + 3001);
+  EXPECT_TRUE(container_equal(dq1, dq2));
+
+  tsDQ<int> dq3(3000, 1);
+  tsDQ<int> dq4(dq3);
+  dq4.push_front(1);
+  dq4.pop_back();
+  EXPECT_TRUE(dq3 == dq4);
+  EXPECT_TRUE(TinySTL::equal(dq3.begin() + 5, dq3.end(), dq4.begin() + 5));
+  dq4[2999] = 2;
+  EXPECT_FALSE(dq3 == dq4);
+  EXPECT_TRUE(TinySTL::equal(dq3.begin(), dq3.end() - 1, dq4.begin()));
+  dq4.pop_back();
+  EXPECT_FALSE(dq3 == dq4);
+
+  std::vector<int> v(3000, 1);
+  EXPECT_TRUE(TinySTL::equal(v.data(), v.data() + v.size(), dq3.begin()));
+  v[1500] = 0;
+  EXPECT_FALSE(TinySTL::equal(dq3.begin(), dq3.end(), v.data()));
+}
+
+TEST(DequeTest, BucketSize) {
+  static_assert(tsDQ<int>::iterator::bucket_cap() == 256, "");
+  static_assert(tsDQ<char[24]>::iterator::bucket_cap() == 32, "");
+  static_assert(tsDQ<char[2000]>::iterator::bucket_cap() == 1, "");
+  // 100 字节最多放 25 个 int，向下取整为 16
+  static_assert(TinySTL::deque<int, 100>::iterator::bucket_cap() == 16, "");
+
+  stdDQ<int> dq1;
+  TinySTL::deque<int, 100> dq2;
+  for (int i = 0; i < 500; ++i) {
+    dq1.push_back(i);
+    dq2.push_back(i);
+    dq1.push_front(-i);
+    dq2.push_front(-i);
+  }
+  EXPECT_TRUE(container_equal(dq1, dq2));
+  int n = static_cast<int>(dq1.size());
+  for (int i = 0; i < n; i += 7)
+    EXPECT_EQ(dq1[i], dq2[i]);
+  // 跨 bucket 的正向、反向偏移
+  auto it = dq2.begin() + 3;
+  for (int step : {1, 15, 16, 17, 100, -1, -16, -17, -90}) {
+    auto pos = (it - dq2.begin()) + step;
+    if (pos < 0 || pos >= n)
+      continue;
+    it += step;
+    EXPECT_EQ(*it, dq1[pos]);
+    EXPECT_EQ(it - dq2.begin(), pos);
+  }
+}
+
+TEST(DequeTest, SpareBucket) {
+  const int cap = static_cast<int>(tsDQ<int>::iterator::bucket_cap());
+  tsDQ<int> dq;
+  for (int i = 0; i < 2 * cap; ++i)
+    dq.push_back(i);
+  const int *first_bucket = &dq.front();
+  // 第一个 bucket 被 pop 空之后进入缓存
+  for (int i = 0; i < cap; ++i)
+    dq.pop_front();
+  // 再写满一个 bucket，下一个 bucket 应该复用刚才那个
+  for (int i = 0; i < cap + 1; ++i)
+    dq.push_back(i);
+  EXPECT_EQ(&dq.back(), first_bucket);
+  EXPECT_EQ(dq.size(), 2 * cap + 1);
+  EXPECT_EQ(dq.front(), cap);
+
+  // 队列式使用：稳定状态下只在几个 bucket 之间轮转
+  stdDQ<int> dq1;
+  tsDQ<int> dq2;
+  for (int i = 0; i < 100 * cap; ++i) {
+    dq1.push_back(i);
+    dq2.push_back(i);
+    if (i % 3 != 0) {
+      dq1.pop_front();
+      dq2.pop_front();
+    }
+  }
+  EXPECT_TRUE(container_equal(dq1, dq2));
+  dq2.shrink_to_fit();
+  dq2.clear();
+  dq2.shrink_to_fit();
+  EXPECT_TRUE(dq2.empty());
+}
+
+template<typename T, typename Gen>
+void insertEraseRandomly(Gen gen) {
+  std::mt19937 rnd(7);
+  stdDQ<T> dq1;
+  tsDQ<T> dq2;
+  for (int i = 0; i < 300; ++i) {
+    dq1.push_back(gen(i));
+    dq2.push_back(gen(i));
+  }
+  for (int round = 0; round < 400; ++round) {
+    int size = static_cast<int>(dq1.size());
+    int pos = static_cast<int>(rnd() % (size + 1));
+    int n = static_cast<int>(rnd() % 3 == 0 ? rnd() % 700 : rnd() % 5);
+    // libstdc++ 在中间插入 0 个元素时会对元素自我移动赋值，所以插入时至少插入一个
+    switch (rnd() % 5) {
+      case 0: {
+        auto it1 = dq1.insert(dq1.begin() + pos, gen(round));
+        auto it2 = dq2.insert(dq2.begin() + pos, gen(round));
+        EXPECT_EQ(it1 - dq1.begin(), it2 - dq2.begin());
+        break;
+      }
+      case 1:
+        dq1.insert(dq1.begin() + pos, n + 1, gen(-round));
+        dq2.insert(dq2.begin() + pos, n + 1, gen(-round));
+        break;
+      case 2: {
+        std::vector<T> v;
+        for (int i = 0; i < n + 1; ++i)
+          v.push_back(gen(i * round));
+        dq1.insert(dq1.begin() + pos, v.begin(), v.end());
+        dq2.insert(dq2.begin() + pos, v.begin(), v.end());
+        break;
+      }
+      case 3:
+        if (pos != size) {
+          auto it1 = dq1.erase(dq1.begin() + pos);
+          auto it2 = dq2.erase(dq2.begin() + pos);
+          EXPECT_EQ(it1 - dq1.begin(), it2 - dq2.begin());
+        }
+        break;
+      default: {
+        int last = pos + static_cast<int>(rnd() % (size - pos + 1));
+        auto it1 = dq1.erase(dq1.begin() + pos, dq1.begin() + last);
+        auto it2 = dq2.erase(dq2.begin() + pos, dq2.begin() + last);
+        EXPECT_EQ(it1 - dq1.begin(), it2 - dq2.begin());
+        break;
+      }
+    }
+    ASSERT_EQ(dq1.size(), dq2.size());
+    ASSERT_TRUE(container_equal(dq1, dq2));
+  }
+}
+
+TEST(DequeTest, InsertErase) {
+  insertEraseRandomly<int>([](int i) { return i; });
+  insertEraseRandomly<std::string>([](int i) { return std::to_string(i); });
+
+  stdDQ<int> dq1{1, 2, 3};
+  tsDQ<int> dq2(dq1.begin(), dq1.end());
+  // 整数参数走 n 个 val 的版本
+  dq1.insert(dq1.begin() + 1, 3, 9);
+  dq2.insert(dq2.begin() + 1, 3, 9);
+  EXPECT_TRUE(container_equal(dq1, dq2));
+  dq2.insert(dq2.begin() + 2, 0, 5);
+  EXPECT_TRUE(container_equal(dq1, dq2));
+  dq1.erase(dq1.begin(), dq1.end());
+  dq2.erase(dq2.begin(), dq2.end());
+  EXPECT_TRUE(dq2.empty());
+}
+
 TEST(DequeTest, Move) {
   auto test_case(getDeque(100));
   EXPECT_TRUE(test_case.size() == 100);
@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/eytzinger_index.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 对所有区间长度 0..max_n（含重复元素），查找每个元素和每个空隙，结果和 std::lower_bound/upper_bound 一致
+template<typename Index, typename Compare = std::less<int>>
+void check_index(size_t max_n, Compare comp = Compare()) {
+  std::mt19937 gen(static_cast<unsigned>(max_n));
+  for (size_t n = 0; n <= max_n; ++n) {
+    std::vector<int> sorted(n);
+    for (auto &x : sorted)
+      x = static_cast<int>(gen() % (n * 2 + 1)) * 2;
+    std::sort(sorted.begin(), sorted.end(), comp);
+    vector<int> v;
+    for (auto x : sorted)
+      v.push_back(x);
+    Index index(v);
+    ASSERT_EQ(index.size(), n);
+    for (int key = -3; key <= static_cast<int>(n) * 4 + 3; ++key) {
+      size_t lower = std::lower_bound(sorted.begin(), sorted.end(), key, comp) - sorted.begin();
+      size_t upper = std::upper_bound(sorted.begin(), sorted.end(), key, comp) - sorted.begin();
+      ASSERT_EQ(index.lower_bound(key), lower) << "n=" << n << " key=" << key;
+      ASSERT_EQ(index.upper_bound(key), upper) << "n=" << n << " key=" << key;
+      ASSERT_EQ(index.contains(key), lower != upper);
+    }
+  }
+}
+
+TEST(EytzingerIndexTest, Bound) {
+  check_index<eytzinger_index<int>>(300);
+  check_index<eytzinger_index<int, std::greater<int>>>(100, std::greater<int>());
+  eytzinger_index<int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.lower_bound(1), 0);
+  EXPECT_FALSE(empty.contains(1));
+}
+
+TEST(BlockedIndexTest, Bound) {
+  check_index<blocked_index<int>>(600);
+  // 小节点让树变高，覆盖多层的补位
+  check_index<blocked_index<int, less<int>, 2>>(300);
+  check_index<blocked_index<int, less<int>, 3>>(300);
+  check_index<blocked_index<int, std::greater<int>, 4>>(100, std::greater<int>());
+  EXPECT_EQ((blocked_index<int, less<int>, 2>(vector<int>(100, 1)).height()), 5);
+  blocked_index<int> empty;
+  EXPECT_EQ(empty.upper_bound(1), 0);
+  EXPECT_FALSE(empty.contains(1));
+}
+
+TEST(EytzingerIndexTest, CopyStrings) {
+  vector<std::string> v;
+  for (int i = 100; i < 400; ++i)
+    v.push_back(std::to_string(i));
+  eytzinger_index<std::string> e(v);
+  blocked_index<std::string> b(v.begin(), v.end());
+  auto e2 = e;
+  auto b2 = b;
+  e = eytzinger_index<std::string>();
+  b = blocked_index<std::string>();
+  EXPECT_TRUE(e.empty());
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(e2.lower_bound(v[i]), i);
+    EXPECT_EQ(b2.lower_bound(v[i]), i);
+  }
+  EXPECT_EQ(e2.lower_bound("9"), 300);
+  EXPECT_EQ(b2.upper_bound("0"), 0);
+}
+
+}
+}
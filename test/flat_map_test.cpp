@@ -0,0 +1,267 @@
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/flat_map.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename Map, typename StdMap>
+bool map_equal(const Map &m, const StdMap &std_m) {
+  if (m.size() != std_m.size())
+    return false;
+  auto std_it = std_m.begin();
+  for (auto it = m.begin(); it != m.end(); ++it, ++std_it)
+    if (it->first != std_it->first || it->second != std_it->second)
+      return false;
+  return true;
+}
+
+TEST(FlatMapTest, InsertFindErase) {
+  flat_map<int, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.find(1) == m.end());
+  EXPECT_EQ(m.erase(1), 0);
+
+  for (int i = 999; i >= 0; --i) {
+    auto res = m.insert(TinySTL::make_pair(i, i * 2));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->first, i);
+  }
+  EXPECT_FALSE(m.insert(TinySTL::make_pair(5, 0)).second);
+  EXPECT_EQ(m.size(), 1000);
+  EXPECT_EQ(m.end() - m.begin(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(m.at(i), i * 2);
+    EXPECT_EQ(m.keys()[i], i);
+    EXPECT_EQ(m.values()[i], i * 2);
+  }
+  EXPECT_FALSE(m.contains(1000));
+  EXPECT_THROW(m.at(1000), std::out_of_range);
+  EXPECT_TRUE(m.lower_bound(-1) == m.begin());
+  EXPECT_TRUE(m.upper_bound(999) == m.end());
+  EXPECT_EQ(m.upper_bound(10)->first, 11);
+
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_EQ(m.erase(i), 1);
+  EXPECT_EQ(m.size(), 500);
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 3 == 0)
+      it = m.erase(it);
+    else
+      ++it;
+  }
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.count(i), i % 2 == 1 && i % 3 != 0 ? 1 : 0);
+
+  // 通过迭代器修改 value
+  for (auto it = m.begin(); it != m.end(); ++it)
+    it->second = -1;
+  for (auto v : m.values())
+    EXPECT_EQ(v, -1);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(FlatMapTest, Subscript) {
+  flat_map<std::string, int> m;
+  std::map<std::string, int> std_m;
+  const char *words[] = {"d", "b", "c", "a", "d", "b", "a"};
+  for (auto w : words) {
+    ++m[w];
+    ++std_m[w];
+  }
+  EXPECT_TRUE(map_equal(m, std_m));
+}
+
+// 批量插入：和逐个插入 std::map 的结果一致，重复 key 保留先出现的，已有 key 不覆盖
+TEST(FlatMapTest, BulkInsert) {
+  std::mt19937 gen(42);
+  flat_map<int, int> m;
+  std::map<int, int> std_m;
+  for (int round = 0; round < 50; ++round) {
+    std::vector<pair<int, int>> batch;
+    size_t len = gen() % 200;
+    for (size_t i = 0; i != len; ++i)
+      batch.push_back(TinySTL::make_pair(static_cast<int>(gen() % 3000), round * 1000 + static_cast<int>(i)));
+    m.insert(batch.begin(), batch.end());
+    for (auto &p : batch)
+      std_m.insert(std::make_pair(p.first, p.second));
+    ASSERT_TRUE(map_equal(m, std_m));
+  }
+
+  std::vector<pair<int, int>> sorted;
+  for (int i = 0; i < 100; ++i)
+    sorted.push_back(TinySTL::make_pair(i, i));
+  flat_map<int, int> m2(sorted.begin(), sorted.end());
+  EXPECT_EQ(m2.size(), 100);
+  m2.insert(sorted.begin(), sorted.end());
+  EXPECT_EQ(m2.size(), 100);
+  m2.insert(sorted.begin(), sorted.begin());
+  EXPECT_EQ(m2.size(), 100);
+}
+
+// 随机插入、删除、查找，和 std::map 对比
+TEST(FlatMapTest, Random) {
+  std::mt19937 gen(7);
+  flat_map<int, int> m;
+  std::map<int, int> std_m;
+  for (int round = 0; round < 20000; ++round) {
+    int key = static_cast<int>(gen() % 2000);
+    switch (gen() % 4) {
+      case 0:
+      case 1:EXPECT_EQ(m.insert(TinySTL::make_pair(key, round)).second, std_m.insert(std::make_pair(key, round)).second);
+        break;
+      case 2:EXPECT_EQ(m.erase(key), std_m.erase(key));
+        break;
+      default: {
+        auto it = m.lower_bound(key);
+        auto std_it = std_m.lower_bound(key);
+        EXPECT_EQ(it == m.end(), std_it == std_m.end());
+        if (it != m.end() && std_it != std_m.end()) {
+          EXPECT_EQ(it->first, std_it->first);
+        }
+        break;
+      }
+    }
+  }
+  EXPECT_TRUE(map_equal(m, std_m));
+}
+
+TEST(FlatMapTest, ReserveCopySwap) {
+  flat_map<std::string, std::string> m1, m2;
+  m1.reserve(100);
+  EXPECT_GE(m1.capacity(), 100);
+  EXPECT_GE(m1.values().capacity(), 100);
+  for (int i = 0; i < 100; ++i)
+    m1[std::to_string(i)] = std::string(i, 'x');
+  auto m3 = m1;
+  EXPECT_TRUE(m3 == m1);
+  m3["0"] = "changed";
+  EXPECT_TRUE(m3 != m1);
+  m2 = m1;
+  EXPECT_TRUE(m2 == m1);
+  swap(m3, m2);
+  EXPECT_EQ(m2["0"], "changed");
+  EXPECT_EQ(m3["0"], "");
+  const auto &cm = m1;
+  EXPECT_EQ(cm.find("10")->second, std::string(10, 'x'));
+  EXPECT_TRUE(cm.find("zzz") == cm.end());
+}
+
+TEST(FlatMapTest, Life) {
+  CountLife::set_zero_all();
+  {
+    flat_map<int, CountLife> m;
+    for (int i = 0; i < 200; ++i)
+      m[i];
+    for (int i = 0; i < 200; i += 3)
+      m.erase(i);
+    std::vector<pair<int, CountLife>> batch(100);
+    for (int i = 0; i < 100; ++i)
+      batch[i].first = i * 5;
+    m.insert(batch.begin(), batch.end());
+    auto copy = m;
+    copy.clear();
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+
+// 拷贝构造到第 limit 次时抛出异常；移动构造、移动赋值可能抛出异常，批量插入走拷贝归并
+struct FlatThrowOnCopy {
+  static int copies;
+  static int limit;
+  int val;
+  explicit FlatThrowOnCopy(int v = 0) : val(v) {}
+  FlatThrowOnCopy(const FlatThrowOnCopy &x) : val(x.val) {
+    if (++copies == limit)
+      throw std::runtime_error("copy");
+  }
+  FlatThrowOnCopy(FlatThrowOnCopy &&x) : val(x.val) {}
+  FlatThrowOnCopy &operator=(const FlatThrowOnCopy &) = default;
+  FlatThrowOnCopy &operator=(FlatThrowOnCopy &&x) {
+    val = x.val;
+    return *this;
+  }
+};
+int FlatThrowOnCopy::copies = 0;
+int FlatThrowOnCopy::limit = 0;
+
+TEST(FlatMapTest, BulkInsertThrow) {
+  std::vector<pair<int, FlatThrowOnCopy>> batch;
+  for (int i = 99; i > 0; i -= 2)
+    batch.push_back(TinySTL::make_pair(i, FlatThrowOnCopy(i)));
+  auto make_map = []() {
+    flat_map<int, FlatThrowOnCopy> m;
+    for (int i = 0; i < 100; i += 2)
+      m.insert(TinySTL::make_pair(i, FlatThrowOnCopy(i)));
+    return m;
+  };
+  // 先数出一次成功的批量插入要拷贝多少次
+  auto m = make_map();
+  FlatThrowOnCopy::copies = 0;
+  m.insert(batch.begin(), batch.end());
+  int total = FlatThrowOnCopy::copies;
+  ASSERT_EQ(m.size(), 100);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(m.begin()[i].second.val, i);
+  // 追加、扩容、归并时拷贝抛出异常（最后一次拷贝发生在归并中）：都恢复原样
+  for (int limit : {1, total / 4, total / 2, total}) {
+    auto m2 = make_map();
+    FlatThrowOnCopy::copies = 0;
+    FlatThrowOnCopy::limit = limit;
+    EXPECT_THROW(m2.insert(batch.begin(), batch.end()), std::runtime_error);
+    FlatThrowOnCopy::limit = 0;
+    ASSERT_EQ(m2.size(), 50);
+    ASSERT_EQ(m2.values().size(), 50);
+    for (int i = 0; i < 100; i += 2)
+      EXPECT_EQ(m2.at(i).val, i);
+  }
+}
+
+// 统计拷贝构造次数，移动不抛异常
+struct FlatCopyCount {
+  static int copies;
+  int val;
+  explicit FlatCopyCount(int v = 0) : val(v) {}
+  FlatCopyCount(const FlatCopyCount &x) : val(x.val) { ++copies; }
+  FlatCopyCount(FlatCopyCount &&x) noexcept : val(x.val) {}
+  FlatCopyCount &operator=(const FlatCopyCount &) = default;
+  FlatCopyCount &operator=(FlatCopyCount &&x) noexcept {
+    val = x.val;
+    return *this;
+  }
+};
+int FlatCopyCount::copies = 0;
+
+TEST(FlatMapTest, BulkInsertMoves) {
+  flat_map<int, FlatCopyCount> m;
+  for (int i = 0; i < 1000; i += 2)
+    m.insert(TinySTL::make_pair(i, FlatCopyCount(i)));
+  m.reserve(2000);
+  std::vector<pair<int, FlatCopyCount>> batch;
+  for (int i = 999; i > 0; i -= 2) {
+    batch.push_back(TinySTL::make_pair(i, FlatCopyCount(i)));
+    batch.push_back(TinySTL::make_pair(i, FlatCopyCount(-i)));
+  }
+  FlatCopyCount::copies = 0;
+  m.insert(batch.begin(), batch.end());
+  // 每个新元素只在追加时拷贝一次，排序、归并都是移动
+  EXPECT_EQ(FlatCopyCount::copies, static_cast<int>(batch.size()));
+  ASSERT_EQ(m.size(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(m.begin()[i].first, i);
+    EXPECT_EQ(m.begin()[i].second.val, i);
+  }
+}
+
+}
+}
@@ -0,0 +1,87 @@
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/flat_set.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+TEST(FlatSetTest, InsertFindErase) {
+  flat_set<int> s;
+  EXPECT_TRUE(s.empty());
+  EXPECT_TRUE(s.find(1) == s.end());
+  EXPECT_EQ(s.erase(1), 0);
+  for (int i = 999; i >= 0; --i)
+    EXPECT_TRUE(s.insert(i).second);
+  EXPECT_FALSE(s.insert(5).second);
+  EXPECT_EQ(s.size(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(s[i], i);
+    EXPECT_TRUE(s.contains(i));
+  }
+  EXPECT_EQ(*s.upper_bound(10), 11);
+  EXPECT_TRUE(s.lower_bound(1000) == s.end());
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_EQ(s.erase(i), 1);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(s.count(i), i % 2);
+  s.clear();
+  EXPECT_TRUE(s.empty());
+}
+
+TEST(FlatSetTest, BulkInsert) {
+  std::mt19937 gen(42);
+  flat_set<int> s;
+  std::set<int> std_s;
+  for (int round = 0; round < 50; ++round) {
+    std::vector<int> batch;
+    size_t len = gen() % 200;
+    for (size_t i = 0; i != len; ++i)
+      batch.push_back(static_cast<int>(gen() % 3000));
+    s.insert(batch.begin(), batch.end());
+    std_s.insert(batch.begin(), batch.end());
+    ASSERT_TRUE(container_equal(s, std_s));
+  }
+  flat_set<int> s2(std_s.begin(), std_s.end());
+  EXPECT_TRUE(s2 == s);
+}
+
+TEST(FlatSetTest, CopySwap) {
+  flat_set<std::string> s1, s2;
+  s1.reserve(100);
+  EXPECT_GE(s1.capacity(), 100);
+  for (int i = 0; i < 100; ++i)
+    s1.insert(std::to_string(i));
+  auto s3 = s1;
+  EXPECT_TRUE(s3 == s1);
+  s3.erase("0");
+  EXPECT_TRUE(s3 != s1);
+  swap(s3, s2);
+  EXPECT_EQ(s2.size(), 99);
+  EXPECT_TRUE(s3.empty());
+}
+
+TEST(FlatSetTest, TransparentCompare) {
+  EXPECT_EQ(sizeof(flat_set<int>), sizeof(vector<int>));
+  EXPECT_EQ(sizeof(flat_set<int, greater<int>>), sizeof(vector<int>));
+
+  flat_set<int, greater<>> s;
+  for (int i = 0; i < 100; ++i)
+    s.insert(i);
+  EXPECT_EQ(*s.begin(), 99);
+  EXPECT_TRUE(s.contains(42));
+  // less<void> 的两个参数可以是不同类型
+  less<> lt;
+  EXPECT_TRUE(lt(1, 2.5));
+  EXPECT_TRUE(lt(std::string("abc"), "abd"));
+  EXPECT_TRUE(equal_to<>()(std::string("abc"), "abc"));
+  EXPECT_TRUE(greater<>()(3.5, 3));
+}
+
+}
+}
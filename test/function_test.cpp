@@ -0,0 +1,135 @@
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../src/function.h"
+#include "../src/vector.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+static int add(int a, int b) { return a + b; }
+
+// 统计移动构造次数：内联存放时移动 function 会移动可调用对象，放在堆上时只移动指针
+struct MoveCounter {
+  static int moves;
+  char payload[16];
+  MoveCounter() = default;
+  MoveCounter(const MoveCounter &) = default;
+  MoveCounter(MoveCounter &&) noexcept { ++moves; }
+  int operator()() const { return 7; }
+};
+int MoveCounter::moves = 0;
+
+struct BigCounter : MoveCounter {
+  char more[64];
+};
+
+TEST(FunctionTest, Invoke) {
+  function<int(int, int)> f;
+  EXPECT_FALSE(f);
+  EXPECT_TRUE(f == nullptr);
+  EXPECT_THROW(f(1, 2), std::bad_function_call);
+  f = add;
+  EXPECT_TRUE(f != nullptr);
+  EXPECT_EQ(f(1, 2), 3);
+  int base = 10;
+  f = [base](int a, int b) { return base + a * b; };
+  EXPECT_EQ(f(2, 3), 16);
+  f = nullptr;
+  EXPECT_FALSE(f);
+
+  // 返回值转换、忽略返回值、引用参数
+  function<long(int)> widen = [](int x) { return x * 2; };
+  EXPECT_EQ(widen(21), 42L);
+  int calls = 0;
+  function<void(int &)> inc = [&calls](int &x) {
+    ++calls;
+    return ++x;
+  };
+  int x = 1;
+  inc(x);
+  EXPECT_EQ(x, 2);
+  EXPECT_EQ(calls, 1);
+  function<std::string(const std::string &)> upper = [](const std::string &s) { return s + "!"; };
+  EXPECT_EQ(upper("hi"), "hi!");
+  EXPECT_EQ(sizeof(function<void()>), 64);
+}
+
+TEST(FunctionTest, InlineAndHeap) {
+  MoveCounter::moves = 0;
+  function<int()> small = MoveCounter();
+  int after_ctor = MoveCounter::moves;
+  function<int()> moved = TinySTL::move(small);
+  EXPECT_EQ(MoveCounter::moves, after_ctor + 1);
+  EXPECT_FALSE(small);
+  EXPECT_EQ(moved(), 7);
+
+  function<int()> big = BigCounter();
+  after_ctor = MoveCounter::moves;
+  function<int()> big_moved = TinySTL::move(big);
+  EXPECT_EQ(MoveCounter::moves, after_ctor);
+  EXPECT_EQ(big_moved(), 7);
+
+  // 内联存储调大后同样的对象可以内联
+  function<int(), 96> wide = BigCounter();
+  after_ctor = MoveCounter::moves;
+  function<int(), 96> wide_moved = TinySTL::move(wide);
+  EXPECT_EQ(MoveCounter::moves, after_ctor + 1);
+  EXPECT_EQ(sizeof(wide), 112);
+}
+
+TEST(FunctionTest, CopySwapLife) {
+  CountLife::set_zero_all();
+  {
+    CountLife life;
+    std::string tag(40, 't');
+    function<size_t()> f = [life, tag]() { return tag.size(); };
+    function<size_t()> g = f;
+    function<size_t()> h = [] { return static_cast<size_t>(1); };
+    EXPECT_EQ(g(), 40);
+    swap(g, h);
+    EXPECT_EQ(g(), 1);
+    EXPECT_EQ(h(), 40);
+    g = h;
+    h = nullptr;
+    EXPECT_EQ(g(), 40);
+    vector<function<size_t()>> tasks;
+    for (int i = 0; i < 100; ++i)
+      tasks.push_back(i % 2 ? f : function<size_t()>([i] { return static_cast<size_t>(i); }));
+    size_t sum = 0;
+    for (auto &task : tasks)
+      sum += task();
+    EXPECT_EQ(sum, 50 * 40 + 49 * 50);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+TEST(UniqueFunctionTest, MoveOnly) {
+  std::unique_ptr<int> p(new int(5));
+  unique_function<int(int)> f = [p = std::move(p)](int x) { return *p + x; };
+  EXPECT_EQ(f(1), 6);
+  unique_function<int(int)> g = TinySTL::move(f);
+  EXPECT_FALSE(f);
+  EXPECT_EQ(g(2), 7);
+  f = TinySTL::move(g);
+  EXPECT_EQ(f(3), 8);
+  swap(f, g);
+  EXPECT_TRUE(f == nullptr);
+  EXPECT_EQ(g(4), 9);
+
+  // 放不进内联存储的只能移动对象
+  std::unique_ptr<int> q(new int(1));
+  char pad[100] = {3};
+  unique_function<int()> big = [q = std::move(q), pad]() { return *q + pad[0]; };
+  unique_function<int()> big2 = TinySTL::move(big);
+  EXPECT_EQ(big2(), 4);
+  unique_function<int()> from_function = function<int()>([] { return 1; });
+  EXPECT_EQ(from_function(), 1);
+}
+
+}
+}
@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/hash.h"
+#include "../src/unordered_flat_set.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+std::string random_bytes(size_t n, std::mt19937 &rng) {
+  std::string s(n, '\0');
+  for (size_t i = 0; i < n; ++i)
+    s[i] = static_cast<char>(rng());
+  return s;
+}
+
+TEST(HashTest, Deterministic) {
+  std::mt19937 rng(1);
+  for (size_t n = 0; n < 2100; n += (n < 300 ? 1 : 37)) {
+    std::string s = random_bytes(n, rng);
+    std::string copy = s;
+    EXPECT_EQ(hash_bytes(s.data(), n), hash_bytes(copy.data(), n));
+    EXPECT_EQ(hash_bytes(s.data(), n, 7), hash_bytes(copy.data(), n, 7));
+    EXPECT_EQ(hash<std::string>()(s), hash<string>()(string(s.data(), n)));
+    EXPECT_EQ(hash<std::string>()(s), hash<string_view>()(string_view(s.data(), n)));
+  }
+  EXPECT_EQ(hash<int>()(42), hash<int>()(42));
+  EXPECT_EQ(hash<double>()(0.0), hash<double>()(-0.0));
+  EXPECT_EQ(hash<float>()(0.0f), hash<float>()(-0.0f));
+  EXPECT_NE(hash<double>()(1.0), hash<double>()(-1.0));
+}
+
+// 每个长度下，改动任意一个字节、换一个 seed 都会改变结果
+TEST(HashTest, EveryByteMatters) {
+  std::mt19937 rng(2);
+  for (size_t n = 1; n < 2100; n += (n < 300 ? 1 : 37)) {
+    std::string s = random_bytes(n, rng);
+    uint64_t h = hash_bytes(s.data(), n);
+    EXPECT_NE(h, hash_bytes(s.data(), n, 1));
+    EXPECT_NE(h, hash_bytes(s.data(), n - 1));
+    for (size_t i = 0; i < n; i += (n < 64 ? 1 : n / 16)) {
+      s[i] ^= 1;
+      EXPECT_NE(h, hash_bytes(s.data(), n)) << "len " << n << " byte " << i;
+      s[i] ^= 1;
+    }
+  }
+}
+
+// SSE2 和标量两条路径的结果必须相同
+TEST(HashTest, LongPathMatchesScalar) {
+  std::mt19937 rng(3);
+  for (size_t n = HashAux::__long_threshold + 1; n < 5000; n += 13) {
+    std::string s = random_bytes(n, rng);
+    const unsigned char *p = reinterpret_cast<const unsigned char *>(s.data());
+    EXPECT_EQ(__hash_bytes_long(p, n, 0), __hash_bytes_long_scalar(p, n, 0));
+    EXPECT_EQ(__hash_bytes_long(p, n, 99), __hash_bytes_long_scalar(p, n, 99));
+  }
+}
+
+// 结构化的 key 之间不应有碰撞，低 16 位的分布也不应退化
+TEST(HashTest, Collisions) {
+  const size_t n = 100000;
+  std::unordered_set<size_t> full;
+  std::vector<size_t> buckets(1 << 16);
+  for (size_t i = 0; i < n; ++i) {
+    size_t h = hash<uint64_t>()(i << 20);
+    full.insert(h);
+    ++buckets[h & 0xFFFF];
+  }
+  EXPECT_EQ(full.size(), n);
+  size_t max_bucket = 0;
+  for (size_t c : buckets)
+    max_bucket = c > max_bucket ? c : max_bucket;
+  EXPECT_LT(max_bucket, 16);
+
+  full.clear();
+  for (size_t i = 0; i < n; ++i)
+    full.insert(hash<std::string>()("https://example.com/item/" + std::to_string(i)));
+  EXPECT_EQ(full.size(), n);
+}
+
+TEST(HashTest, PairAndTuple) {
+  hash<pair<int, int>> hp;
+  EXPECT_EQ(hp(TinySTL::make_pair(1, 2)), hp(TinySTL::make_pair(1, 2)));
+  EXPECT_NE(hp(TinySTL::make_pair(1, 2)), hp(TinySTL::make_pair(2, 1)));
+
+  hash<std::tuple<int, std::string, double>> ht;
+  std::tuple<int, std::string, double> t(1, "abc", 2.5);
+  EXPECT_EQ(ht(t), ht(std::make_tuple(1, std::string("abc"), 2.5)));
+  EXPECT_NE(ht(t), ht(std::make_tuple(1, std::string("abd"), 2.5)));
+  EXPECT_NE(hash<std::tuple<>>()(std::tuple<>()), ht(t));
+
+  std::unordered_set<size_t> seen;
+  for (int i = 0; i < 300; ++i)
+    for (int j = 0; j < 300; ++j)
+      seen.insert(hp(TinySTL::make_pair(i, j)));
+  EXPECT_EQ(seen.size(), 300u * 300u);
+}
+
+TEST(HashTest, HashMany) {
+  std::vector<int> keys;
+  for (int i = 0; i < 1000; ++i)
+    keys.push_back(i * 7);
+  std::vector<size_t> out(keys.size());
+  hash_many(keys.data(), keys.size(), out.data());
+  for (size_t i = 0; i < keys.size(); ++i)
+    EXPECT_EQ(out[i], hash<int>()(keys[i]));
+
+  std::vector<std::string> words = {"a", "bb", "ccc"};
+  std::vector<size_t> out2(words.size());
+  hash_many(words.begin(), words.end(), out2.data(), hash<std::string>());
+  for (size_t i = 0; i < words.size(); ++i)
+    EXPECT_EQ(out2[i], hash<std::string>()(words[i]));
+}
+
+// 哈希表的默认哈希函数，以及分批预取的区间插入
+TEST(HashTest, FlatSetRangeInsert) {
+  std::vector<std::string> words;
+  for (int i = 0; i < 5000; ++i)
+    words.push_back("key" + std::to_string(i % 3000));
+  unordered_flat_set<std::string> s;
+  s.insert(words.begin(), words.end());
+  std::unordered_set<std::string> std_s(words.begin(), words.end());
+  EXPECT_EQ(s.size(), std_s.size());
+  for (const auto &w : std_s)
+    EXPECT_TRUE(s.contains(w));
+}
+
+}
+}
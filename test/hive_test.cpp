@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/hive.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 遍历结果排序后和期望的元素集合比较
+template<typename Hive>
+std::vector<typename Hive::value_type> sorted_elements(const Hive &h) {
+  std::vector<typename Hive::value_type> v;
+  for (auto &x : h)
+    v.push_back(x);
+  std::sort(v.begin(), v.end());
+  return v;
+}
+
+TEST(HiveTest, InsertErase) {
+  hive<int> h;
+  EXPECT_TRUE(h.empty());
+  EXPECT_TRUE(h.begin() == h.end());
+  std::vector<hive<int>::iterator> its;
+  for (int i = 0; i < 100; ++i)
+    its.push_back(h.insert(i));
+  EXPECT_EQ(h.size(), 100);
+  EXPECT_GE(h.capacity(), 100);
+  // 没有删除时按插入顺序遍历
+  int expected = 0;
+  for (int x : h)
+    EXPECT_EQ(x, expected++);
+
+  // 删除偶数，其余元素的迭代器、地址不变
+  std::vector<int *> addrs;
+  for (auto it : its)
+    addrs.push_back(&*it);
+  for (int i = 0; i < 100; i += 2)
+    h.erase(its[i]);
+  EXPECT_EQ(h.size(), 50);
+  for (int i = 1; i < 100; i += 2) {
+    EXPECT_EQ(*its[i], i);
+    EXPECT_EQ(&*its[i], addrs[i]);
+  }
+  for (int x : h)
+    EXPECT_EQ(x % 2, 1);
+
+  // 空位被复用，不增加容量
+  size_t cap = h.capacity();
+  for (int i = 0; i < 50; ++i)
+    h.insert(1000 + i);
+  EXPECT_EQ(h.capacity(), cap);
+  EXPECT_EQ(h.size(), 100);
+}
+
+TEST(HiveTest, Random) {
+  std::mt19937 gen(1);
+  hive<int> h;
+  std::vector<pair<hive<int>::iterator, int>> live;
+  for (int i = 0; i < 30000; ++i) {
+    if (live.empty() || gen() % 5 < 3) {
+      int v = static_cast<int>(gen() % 100000);
+      live.push_back(TinySTL::make_pair(h.insert(v), v));
+    } else {
+      size_t j = gen() % live.size();
+      h.erase(live[j].first);
+      live[j] = live.back();
+      live.pop_back();
+    }
+    if (i % 3000 == 0) {
+      for (auto &p : live)
+        ASSERT_EQ(*p.first, p.second);
+    }
+  }
+  ASSERT_EQ(h.size(), live.size());
+  std::vector<int> expected;
+  for (auto &p : live)
+    expected.push_back(p.second);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(sorted_elements(h), expected);
+  EXPECT_EQ(static_cast<size_t>(TinySTL::distance(h.begin(), h.end())), h.size());
+
+  // 反向遍历得到同样的元素
+  std::vector<int> backward;
+  for (auto it = h.end(); it != h.begin();)
+    backward.push_back(*--it);
+  std::sort(backward.begin(), backward.end());
+  EXPECT_EQ(backward, expected);
+
+  // 全部删除后块都被释放
+  for (auto it = h.begin(); it != h.end();)
+    it = h.erase(it);
+  EXPECT_TRUE(h.empty());
+  EXPECT_EQ(h.capacity(), 0);
+  EXPECT_TRUE(h.begin() == h.end());
+}
+
+TEST(HiveTest, EraseWhileIterating) {
+  hive<int> h;
+  for (int i = 0; i < 1000; ++i)
+    h.insert(i);
+  for (auto it = h.begin(); it != h.end();) {
+    if (*it % 3 != 0)
+      it = h.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(h.size(), 334);
+  // iterator 可以转换为 const_iterator，反之不行
+  static_assert(std::is_convertible<hive<int>::iterator, hive<int>::const_iterator>::value, "");
+  static_assert(!std::is_convertible<hive<int>::const_iterator, hive<int>::iterator>::value, "");
+  hive<int>::const_iterator cit = h.begin();
+  EXPECT_EQ(*cit, 0);
+  int expected = 0;
+  for (int x : h) {
+    EXPECT_EQ(x, expected);
+    expected += 3;
+  }
+}
+
+TEST(HiveTest, CopySwapLife) {
+  CountLife::set_zero_all();
+  {
+    hive<CountLife> h1, h2;
+    std::vector<hive<CountLife>::iterator> its;
+    for (int i = 0; i < 200; ++i)
+      its.push_back(h1.insert(CountLife()));
+    for (int i = 0; i < 200; i += 3)
+      h1.erase(its[i]);
+    auto h3 = h1;
+    EXPECT_EQ(h3.size(), h1.size());
+    swap(h2, h3);
+    EXPECT_TRUE(h3.empty());
+    EXPECT_EQ(h2.size(), h1.size());
+    h3 = h2;
+    h1.clear();
+    EXPECT_TRUE(h1.empty());
+    h1.emplace();
+    EXPECT_EQ(h1.size(), 1);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+
+  hive<std::string> s1;
+  for (int i = 0; i < 100; ++i)
+    s1.insert(std::to_string(i));
+  hive<std::string> s2 = s1;
+  EXPECT_TRUE(s1 == s2);
+  s2.erase(s2.begin());
+  EXPECT_TRUE(s1 != s2);
+}
+
+}
+}
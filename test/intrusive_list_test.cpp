@@ -0,0 +1,183 @@
+#include <list>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/intrusive_list.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 同一个对象同时挂在两个链表上
+struct Conn {
+  int id;
+  intrusive_list_hook lru_hook;
+  intrusive_list_hook run_hook;
+
+  explicit Conn(int i = 0) : id(i) {}
+  bool operator<(const Conn &x) const { return id < x.id; }
+  bool operator==(const Conn &x) const { return id == x.id; }
+  bool operator!=(const Conn &x) const { return id != x.id; }
+};
+
+using LruList = TinySTL::intrusive_list<Conn, &Conn::lru_hook>;
+using RunList = TinySTL::intrusive_list<Conn, &Conn::run_hook>;
+
+template<typename List>
+std::vector<int> ids(const List &l) {
+  std::vector<int> res;
+  for (auto &c : l)
+    res.push_back(c.id);
+  return res;
+}
+
+TEST(IntrusiveListTest, MultiMembership) {
+  std::vector<Conn> conns;
+  for (auto i = 0; i != 5; ++i)
+    conns.emplace_back(i);
+  LruList lru;
+  RunList run;
+  for (auto &c : conns) {
+    lru.push_back(c);
+    run.push_front(c);
+  }
+  EXPECT_EQ(ids(lru), (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(ids(run), (std::vector<int>{4, 3, 2, 1, 0}));
+  EXPECT_EQ(lru.size(), 5);
+  EXPECT_EQ(&lru.front(), &run.back());
+
+  // O(1) 从任意位置摘除，只影响对应的链表
+  conns[2].lru_hook.unlink();
+  LruList::remove(conns[4]);
+  EXPECT_FALSE(conns[2].lru_hook.is_linked());
+  EXPECT_TRUE(conns[2].run_hook.is_linked());
+  EXPECT_EQ(ids(lru), (std::vector<int>{0, 1, 3}));
+  EXPECT_EQ(ids(run), (std::vector<int>{4, 3, 2, 1, 0}));
+
+  // 移到 LRU 末尾
+  auto it = LruList::iterator_to(conns[0]);
+  lru.splice(lru.end(), lru, it);
+  EXPECT_EQ(ids(lru), (std::vector<int>{1, 3, 0}));
+
+  lru.clear();
+  run.clear();
+  EXPECT_TRUE(lru.empty());
+  EXPECT_FALSE(conns[1].lru_hook.is_linked());
+}
+
+TEST(IntrusiveListTest, InsertErase) {
+  std::vector<Conn> conns;
+  for (auto i = 0; i != 10; ++i)
+    conns.emplace_back(i);
+  LruList l;
+  for (auto &c : conns)
+    l.push_back(c);
+  auto it = l.begin();
+  ++it;
+  it = l.erase(it);
+  EXPECT_EQ(it->id, 2);
+  it = l.insert(it, conns[1]);
+  EXPECT_EQ(it->id, 1);
+  auto last = it;
+  for (auto i = 0; i != 3; ++i)
+    ++last;
+  l.erase(it, last);
+  EXPECT_EQ(ids(l), (std::vector<int>{0, 4, 5, 6, 7, 8, 9}));
+  l.pop_front();
+  l.pop_back();
+  EXPECT_EQ(ids(l), (std::vector<int>{4, 5, 6, 7, 8}));
+  l.remove_if([](const Conn &c) { return c.id % 2 == 0; });
+  EXPECT_EQ(ids(l), (std::vector<int>{5, 7}));
+}
+
+TEST(IntrusiveListTest, SpliceMergeReverseSort) {
+  std::vector<Conn> conns;
+  for (auto i = 0; i != 10; ++i)
+    conns.emplace_back(i);
+  LruList l1, l2;
+  for (auto i = 0; i != 10; ++i) {
+    if (i % 2 == 0)
+      l1.push_back(conns[i]);
+    else
+      l2.push_back(conns[i]);
+  }
+  l1.merge(l2);
+  EXPECT_TRUE(l2.empty());
+  EXPECT_EQ(ids(l1), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  l1.reverse();
+  EXPECT_EQ(ids(l1), (std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+
+  auto first = l1.begin();
+  auto last = first;
+  for (auto i = 0; i != 4; ++i)
+    ++last;
+  l2.splice(l2.end(), l1, first, last);
+  EXPECT_EQ(ids(l1), (std::vector<int>{5, 4, 3, 2, 1, 0}));
+  EXPECT_EQ(ids(l2), (std::vector<int>{9, 8, 7, 6}));
+  l1.splice(l1.begin(), l2);
+  EXPECT_EQ(l1.size(), 10);
+
+  l1.sort();
+  EXPECT_EQ(ids(l1), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+  l1.sort([](const Conn &x, const Conn &y) { return y.id < x.id; });
+  EXPECT_EQ(ids(l1), (std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+}
+
+TEST(IntrusiveListTest, SpliceSelf) {
+  std::vector<Conn> conns;
+  for (auto i = 1; i != 4; ++i)
+    conns.emplace_back(i);
+  LruList l;
+  for (auto &c : conns)
+    l.push_back(c);
+  // 移到自己的位置或自己之后的位置：不变
+  auto p = l.begin();
+  ++p;
+  l.splice(p, l, p);
+  EXPECT_EQ(ids(l), (std::vector<int>{1, 2, 3}));
+  auto next = p;
+  ++next;
+  l.splice(next, l, p);
+  EXPECT_EQ(ids(l), (std::vector<int>{1, 2, 3}));
+  l.splice(l.begin(), l);
+  EXPECT_EQ(ids(l), (std::vector<int>{1, 2, 3}));
+  // 同一个链表内移动一个元素
+  l.splice(l.begin(), l, p);
+  EXPECT_EQ(ids(l), (std::vector<int>{2, 1, 3}));
+  l.splice(l.end(), l, l.begin());
+  EXPECT_EQ(ids(l), (std::vector<int>{1, 3, 2}));
+  EXPECT_EQ(l.size(), 3);
+}
+
+TEST(IntrusiveListTest, MoveSwap) {
+  std::vector<Conn> conns;
+  for (auto i = 0; i != 4; ++i)
+    conns.emplace_back(i);
+  LruList l1, l2;
+  l1.push_back(conns[0]);
+  l1.push_back(conns[1]);
+  l2.push_back(conns[2]);
+
+  swap(l1, l2);
+  EXPECT_EQ(ids(l1), (std::vector<int>{2}));
+  EXPECT_EQ(ids(l2), (std::vector<int>{0, 1}));
+
+  LruList l3(std::move(l2));
+  EXPECT_TRUE(l2.empty());
+  EXPECT_EQ(ids(l3), (std::vector<int>{0, 1}));
+  l3.push_back(conns[3]);
+  EXPECT_EQ(&l3.back(), &conns[3]);
+
+  // 对象析构时 hook 自动从链表中摘除
+  {
+    Conn tmp(100);
+    l3.push_front(tmp);
+    EXPECT_EQ(l3.size(), 4);
+  }
+  EXPECT_EQ(ids(l3), (std::vector<int>{0, 1, 3}));
+}
+
+}
+}
@@ -1,6 +1,7 @@
 #include <random>
 #include <list>
 #include <string>
+#include <utility>
 
 #include <gtest/gtest.h>
 
@@ -202,6 +203,62 @@ TEST(ListTest, Splice) {
   l2.splice(it2, l6, l6.begin(), l6.end());
   EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
 }
+TEST(ListTest, SizeAfterOps) {
+  int arr[] = {0, 1, 3, 5, 9}, arr2[] = {2, 4, 6, 7, 8};
+  tsL<int> l1(std::begin(arr), std::end(arr)), l2(std::begin(arr2), std::end(arr2));
+  EXPECT_EQ(l1.size(), 5);
+
+  l1.splice(l1.end(), l2, l2.begin());
+  EXPECT_EQ(l1.size(), 6);
+  EXPECT_EQ(l2.size(), 4);
+
+  auto first = l2.begin(), last = l2.end();
+  ++first;
+  l1.splice(l1.begin(), l2, first, last);
+  EXPECT_EQ(l1.size(), 9);
+  EXPECT_EQ(l2.size(), 1);
+
+  l1.sort();
+  l1.merge(l2);
+  EXPECT_EQ(l1.size(), 10);
+  EXPECT_EQ(l2.size(), 0);
+  EXPECT_TRUE(l2.empty());
+
+  l1.remove(4);
+  l1.remove_if([](int n) { return n % 2 == 0; });
+  EXPECT_EQ(l1.size(), static_cast<size_t>(TinySTL::distance(l1.begin(), l1.end())));
+
+  l1.splice(l1.begin(), l2);
+  l2.splice(l2.begin(), l1);
+  EXPECT_EQ(l1.size(), 0);
+  EXPECT_EQ(l2.size(), 5);
+  l2.clear();
+  EXPECT_EQ(l2.size(), 0);
+}
+TEST(ListTest, Move) {
+  static_assert(noexcept(tsL<int>()), "default ctor should be noexcept");
+  static_assert(noexcept(tsL<int>(std::declval<tsL<int> &&>())), "move ctor should be noexcept");
+
+  // 哨兵节点不再带 T，空 list 和移动构造都不会构造元素
+  CountLife::set_zero_all();
+  tsL<CountLife> l1;
+  tsL<CountLife> l2(std::move(l1));
+  EXPECT_EQ(CountLife::get_ctor_cnt(), 0);
+  EXPECT_EQ(CountLife::get_copy_ctor_cnt(), 0);
+
+  tsL<int> l3(10, 1);
+  tsL<int> l4(std::move(l3));
+  EXPECT_TRUE(l3.empty());
+  EXPECT_EQ(l4.size(), 10);
+  l3.push_back(2);
+  EXPECT_EQ(l3.size(), 1);
+
+  swap(l3, l4);
+  EXPECT_EQ(l3.size(), 10);
+  EXPECT_EQ(l4.size(), 1);
+  EXPECT_EQ(l4.front(), 2);
+  EXPECT_EQ(TinySTL::distance(l3.begin(), l3.end()), 10);
+}
 TEST(ListTest, OperatorEq) {
   tsL<int> l1(10, 2), l2(10, 1), l3(10, 2);
   EXPECT_TRUE(TinySTL::Test::container_equal(l1, l3));
@@ -1,6 +1,10 @@
+#include <cstdlib>
+
 #include <gtest/gtest.h>
 
 int main(int argc, char **argv) {
+  // 全局调度器至少用 4 个线程，单核机器上也能覆盖到并行算法的并行路径
+  setenv("TINYSTL_NUM_THREADS", "4", 0);
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,94 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/mpmc_queue.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+TEST(MpmcQueueTest, SingleThread) {
+  mpmc_queue<std::string> q(5);
+  EXPECT_EQ(q.capacity(), 8);
+  EXPECT_TRUE(q.empty());
+  std::string val;
+  EXPECT_FALSE(q.try_pop(val));
+  // 多转几圈，检查序号的回绕
+  for (int round = 0; round < 10; ++round) {
+    for (int i = 0; i < 8; ++i)
+      EXPECT_TRUE(q.try_push(std::to_string(round * 8 + i)));
+    EXPECT_FALSE(q.try_push("full"));
+    EXPECT_EQ(q.size(), 8);
+    for (int i = 0; i < 8; ++i) {
+      EXPECT_TRUE(q.try_pop(val));
+      EXPECT_EQ(val, std::to_string(round * 8 + i));
+    }
+  }
+  auto stats = q.stats();
+  EXPECT_EQ(stats.push_full, 10);
+  EXPECT_EQ(stats.pop_empty, 1);
+  EXPECT_EQ(stats.push_retries, 0);
+  q.reset_stats();
+  EXPECT_EQ(q.stats().push_full, 0);
+}
+
+TEST(MpmcQueueTest, Life) {
+  CountLife::set_zero_all();
+  {
+    mpmc_queue<CountLife> q(16);
+    CountLife val;
+    for (int i = 0; i < 10; ++i)
+      q.push(val);
+    for (int i = 0; i < 4; ++i)
+      q.pop(val);
+  }
+  // 析构时剩下的元素也要析构
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+TEST(MpmcQueueTest, ManyThreads) {
+  const int producers = 4;
+  const int consumers = 4;
+  const int per_producer = 20000;
+  mpmc_queue<int> q(64);
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&q, p] {
+      for (int i = 0; i < per_producer; ++i)
+        q.push(p * per_producer + i);
+    });
+  }
+  std::vector<long long> sums(consumers, 0);
+  std::vector<int> ordered(consumers, 1);
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&q, &sums, &ordered, c] {
+      // 同一个生产者的元素，每个消费者看到的顺序是递增的
+      std::vector<int> last(producers, -1);
+      for (int i = 0; i < producers * per_producer / consumers; ++i) {
+        int val;
+        q.pop(val);
+        sums[c] += val;
+        int p = val / per_producer;
+        if (val <= last[p])
+          ordered[c] = 0;
+        last[p] = val;
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  long long total = 0;
+  for (int c = 0; c < consumers; ++c) {
+    total += sums[c];
+    EXPECT_TRUE(ordered[c]);
+  }
+  long long n = producers * per_producer;
+  EXPECT_EQ(total, n * (n - 1) / 2);
+  EXPECT_TRUE(q.empty());
+}
+
+}
+}
@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/list.h"
+#include "../src/parallel_algorithm.h"
+#include "../src/string.h"
+#include "../src/vector.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 超过 __min_parallel_size，保证走并行路径
+const size_t kParallelN = 300007;
+
+TEST(AlgorithmTest, Sort) {
+  std::mt19937 rng(7);
+  for (size_t n : {0, 1, 2, 15, 17, 1000}) {
+    std::vector<int> v1(n), v2;
+    for (auto &x : v1)
+      x = static_cast<int>(rng() % 100);
+    v2 = v1;
+    std::sort(v1.begin(), v1.end());
+    TinySTL::sort(v2.begin(), v2.end());
+    EXPECT_TRUE(container_equal(v1, v2));
+  }
+  // 降序，以及大量重复元素
+  std::vector<std::string> s1(500), s2;
+  for (auto &x : s1)
+    x = std::to_string(rng() % 10);
+  s2 = s1;
+  std::sort(s1.begin(), s1.end(), std::greater<std::string>());
+  TinySTL::sort(s2.begin(), s2.end(), std::greater<std::string>());
+  EXPECT_TRUE(container_equal(s1, s2));
+}
+
+TEST(AlgorithmTest, SortHeapWithCompare) {
+  std::vector<int> v1{5, 1, 4, 2, 3, 9, 0}, v2(v1);
+  std::make_heap(v1.begin(), v1.end(), std::greater<int>());
+  std::sort_heap(v1.begin(), v1.end(), std::greater<int>());
+  TinySTL::make_heap(v2.begin(), v2.end(), std::greater<int>());
+  TinySTL::sort_heap(v2.begin(), v2.end(), std::greater<int>());
+  EXPECT_TRUE(container_equal(v1, v2));
+}
+
+TEST(ParallelAlgorithmTest, Sort) {
+  std::mt19937 rng(42);
+  std::vector<unsigned> v1(kParallelN);
+  for (auto &x : v1)
+    x = rng();
+  TinySTL::vector<unsigned> v2(v1.begin(), v1.end());
+  std::vector<unsigned> v3(v1);
+  std::sort(v1.begin(), v1.end());
+  TinySTL::sort(execution::par, v2.begin(), v2.end());
+  TinySTL::sort(execution::par_unseq, v3.begin(), v3.end(), std::greater<unsigned>());
+  EXPECT_TRUE(container_equal(v1, v2));
+  EXPECT_TRUE(std::is_sorted(v3.begin(), v3.end(), std::greater<unsigned>()));
+  // 全部相等，划分退化时也要正确
+  TinySTL::vector<int> same(kParallelN, 3);
+  TinySTL::sort(execution::par, same.begin(), same.end());
+  EXPECT_TRUE(std::all_of(same.begin(), same.end(), [](int x) { return x == 3; }));
+}
+
+TEST(ParallelAlgorithmTest, FillCopy) {
+  TinySTL::vector<int> v1(kParallelN, 0);
+  TinySTL::fill(execution::par, v1.begin(), v1.end(), 7);
+  EXPECT_TRUE(std::all_of(v1.begin(), v1.end(), [](int x) { return x == 7; }));
+  EXPECT_EQ(TinySTL::fill_n(execution::par, v1.begin(), 1000, 1), v1.begin() + 1000);
+  EXPECT_EQ(v1[999], 1);
+  EXPECT_EQ(v1[1000], 7);
+
+  std::vector<std::string> s1(kParallelN / 10);
+  for (size_t i = 0; i != s1.size(); ++i)
+    s1[i] = std::to_string(i);
+  std::vector<std::string> s2(s1.size());
+  EXPECT_EQ(TinySTL::copy(execution::par, s1.begin(), s1.end(), s2.begin()), s2.end());
+  EXPECT_TRUE(container_equal(s1, s2));
+
+  // 非随机访问迭代器：退化为串行
+  TinySTL::list<int> l(10, 0);
+  TinySTL::fill(execution::par, l.begin(), l.end(), 3);
+  std::vector<int> v2(10);
+  TinySTL::copy(execution::par, l.begin(), l.end(), v2.begin());
+  EXPECT_EQ(std::accumulate(v2.begin(), v2.end(), 0), 30);
+}
+
+TEST(ParallelAlgorithmTest, ForEachTransformReduce) {
+  TinySTL::vector<long long> v(kParallelN);
+  for (size_t i = 0; i != v.size(); ++i)
+    v[i] = static_cast<long long>(i);
+  TinySTL::for_each(execution::par, v.begin(), v.end(), [](long long &x) { x *= 2; });
+  long long n = kParallelN;
+  EXPECT_EQ(TinySTL::reduce(execution::par, v.begin(), v.end()), n * (n - 1));
+  EXPECT_EQ(TinySTL::reduce(execution::seq, v.begin(), v.end(), 5LL), n * (n - 1) + 5);
+
+  TinySTL::vector<long long> w(kParallelN);
+  TinySTL::transform(execution::par, v.begin(), v.end(), w.begin(), [](long long x) { return x + 1; });
+  EXPECT_EQ(TinySTL::reduce(execution::par_unseq, w.begin(), w.end(), 0LL), n * (n - 1) + n);
+  TinySTL::transform(execution::par, v.begin(), v.end(), w.begin(), w.begin(),
+                     [](long long x, long long y) { return y - x; });
+  EXPECT_TRUE(std::all_of(w.begin(), w.end(), [](long long x) { return x == 1; }));
+  // 结果类型和元素类型不同
+  auto max = TinySTL::reduce(execution::par, v.begin(), v.end(), 0.0,
+                             [](double x, double y) { return x > y ? x : y; });
+  EXPECT_EQ(max, 2.0 * (n - 1));
+}
+
+TEST(ParallelAlgorithmTest, MakeHeap) {
+  std::mt19937 rng(1);
+  for (size_t n : {size_t(0), size_t(1), size_t(100), kParallelN}) {
+    std::vector<int> v(n);
+    for (auto &x : v)
+      x = static_cast<int>(rng() % 1000);
+    TinySTL::make_heap(execution::par, v.begin(), v.end());
+    EXPECT_TRUE(std::is_heap(v.begin(), v.end()));
+    TinySTL::make_heap(execution::par, v.begin(), v.end(), std::greater<int>());
+    EXPECT_TRUE(std::is_heap(v.begin(), v.end(), std::greater<int>()));
+  }
+}
+
+TEST(ParallelAlgorithmTest, Uninitialized) {
+  // CountLife 的计数不是线程安全的，这里用 std::string 检查非 POD 类型的构造
+  size_t n = kParallelN / 10;
+  std::string val(40, 'x');
+  auto p = static_cast<std::string *>(::operator new(n * sizeof(std::string)));
+  TinySTL::uninitialized_fill(execution::par, p, p + n, val);
+  auto q = static_cast<std::string *>(::operator new(n * sizeof(std::string)));
+  EXPECT_EQ(TinySTL::uninitialized_copy(execution::par, p, p + n, q), q + n);
+  EXPECT_TRUE(std::all_of(q, q + n, [&val](const std::string &s) { return s == val; }));
+  __construct::destroy(p, p + n);
+  EXPECT_EQ(TinySTL::uninitialized_fill_n(execution::par, p, n, std::string("y")), p + n);
+  EXPECT_EQ(p[n - 1], "y");
+  __construct::destroy(p, p + n);
+  __construct::destroy(q, q + n);
+  ::operator delete(p);
+  ::operator delete(q);
+
+  int *raw = static_cast<int *>(::operator new(kParallelN * sizeof(int)));
+  TinySTL::uninitialized_fill_n(execution::par, raw, kParallelN, 9);
+  EXPECT_TRUE(std::all_of(raw, raw + kParallelN, [](int x) { return x == 9; }));
+  ::operator delete(raw);
+}
+
+TEST(ParallelAlgorithmTest, FirstTouchBoundary) {
+  const size_t page = ParallelAux::__page_size;
+  // malloc 返回的地址通常在页内偏移 16 字节，块的边界要按绝对地址对齐到页，而不是相对 first
+  for (uintptr_t base : {uintptr_t(page * 100 + 16), uintptr_t(page * 7), uintptr_t(page * 3 + 4000)}) {
+    for (size_t elem_size : {size_t(8), size_t(24)}) {
+      const size_t len = 100003, parts = 7;
+      size_t prev = 0;
+      EXPECT_EQ(__first_touch_boundary(base, len, elem_size, parts, 0), 0);
+      EXPECT_EQ(__first_touch_boundary(base, len, elem_size, parts, parts), len);
+      for (size_t p = 1; p != parts; ++p) {
+        size_t k = __first_touch_boundary(base, len, elem_size, parts, p);
+        EXPECT_GE(k, prev);
+        uintptr_t addr = base + k * elem_size;
+        // 边界是页首之后的第一个元素
+        EXPECT_LT(addr % page, elem_size);
+        if (page % elem_size == 0 && base % elem_size == 0) {
+          EXPECT_EQ(addr % page, 0);
+        }
+        prev = k;
+      }
+    }
+  }
+}
+
+TEST(ParallelAlgorithmTest, FirstTouchFillPerWorker) {
+  // 第 p 块由第 p 个工作线程写入，按同样的划分用 on_each_worker 扫描时线程一一对应
+  scheduler sched(4);
+  size_t parts = sched.worker_count();
+  size_t n = kParallelN;
+  double *p = static_cast<double *>(::operator new(n * sizeof(double)));
+  __first_touch_fill_static(p, n, 2.5, sched);
+  EXPECT_TRUE(std::all_of(p, p + n, [](double x) { return x == 2.5; }));
+  uintptr_t base = reinterpret_cast<uintptr_t>(p);
+  std::vector<std::thread::id> ids(parts);
+  std::vector<double> sums(parts, 0);
+  on_each_worker([&](size_t w) {
+    ids[w] = std::this_thread::get_id();
+    size_t lo = __first_touch_boundary(base, n, sizeof(double), parts, w);
+    size_t hi = __first_touch_boundary(base, n, sizeof(double), parts, w + 1);
+    sums[w] = std::accumulate(p + lo, p + hi, 0.0);
+  }, sched);
+  EXPECT_EQ(std::accumulate(sums.begin(), sums.end(), 0.0), 2.5 * n);
+  for (size_t w = 0; w != parts; ++w)
+    EXPECT_NE(ids[w], std::this_thread::get_id());
+  ::operator delete(p);
+}
+
+TEST(ParallelAlgorithmTest, NonPodFallsBackToSerial) {
+  // string、vector 的拷贝会经由 __alloc 申请内存，__alloc 不是线程安全的，这些类型只能串行
+  static_assert(std::is_same<decltype(__run_parallel(execution::par, static_cast<string *>(nullptr))),
+                             __false_type>::value, "non-POD elements must not run in parallel");
+  static_assert(std::is_same<decltype(__run_parallel(execution::par, static_cast<int *>(nullptr))),
+                             __true_type>::value, "POD elements run in parallel");
+
+  size_t n = kParallelN;
+  string val(40, 'x');
+  TinySTL::vector<string> s1(n);
+  TinySTL::fill(execution::par, s1.begin(), s1.end(), val);
+  TinySTL::vector<string> s2(n);
+  TinySTL::copy(execution::par, s1.begin(), s1.end(), s2.begin());
+  EXPECT_TRUE(std::all_of(s2.begin(), s2.end(), [&val](const string &s) { return s == val; }));
+  for (size_t i = 0; i != n; ++i)
+    s1[i] = string(30, static_cast<char>('a' + i % 26));
+  TinySTL::sort(execution::par, s1.begin(), s1.end());
+  EXPECT_TRUE(std::is_sorted(s1.begin(), s1.end()));
+  auto p = static_cast<string *>(::operator new(n * sizeof(string)));
+  TinySTL::uninitialized_copy(execution::par, s1.begin(), s1.end(), p);
+  EXPECT_TRUE(std::equal(s1.begin(), s1.end(), p));
+  __construct::destroy(p, p + n);
+  TinySTL::uninitialized_fill_n(execution::par, p, n, val);
+  EXPECT_EQ(p[n - 1], val);
+  __construct::destroy(p, p + n);
+  ::operator delete(p);
+
+  TinySTL::vector<TinySTL::vector<int>> v1(n), v2(n);
+  TinySTL::vector<int> inner(20, 5);
+  TinySTL::fill(execution::par, v1.begin(), v1.end(), inner);
+  TinySTL::transform(execution::par, v1.begin(), v1.end(), v2.begin(), [](const TinySTL::vector<int> &x) {
+    TinySTL::vector<int> y(x);
+    y.push_back(6);
+    return y;
+  });
+  EXPECT_TRUE(std::all_of(v2.begin(), v2.end(), [](const TinySTL::vector<int> &x) {
+    return x.size() == 21 && x[0] == 5 && x[20] == 6;
+  }));
+}
+
+}
+}
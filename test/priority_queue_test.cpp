@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <queue>
 #include <vector>
 #include <string>
@@ -77,5 +78,35 @@ TEST(PriorityQueueTest, Swap) {
   TinySTL::swap(foo, bar);
   EXPECT_TRUE(foo.size() == 2 && bar.size() == 3);
 }
+
+// 带状态的比较函数：按到 center 的距离排序
+struct DistanceGreater {
+  int center;
+  bool operator()(int x, int y) const { return std::abs(x - center) > std::abs(y - center); }
+};
+
+TEST(PriorityQueueTest, Footprint) {
+  // 空的比较函数不占空间
+  EXPECT_EQ(sizeof(tsPQ<int>), sizeof(vector<int>));
+  EXPECT_EQ(sizeof(priority_queue<int, vector<int>, greater<>>), sizeof(vector<int>));
+
+  // 有状态的比较函数照常保存、拷贝、交换
+  int arr[] = {1, 9, 4, 6, 5};
+  priority_queue<int, vector<int>, DistanceGreater> pq(std::begin(arr), std::end(arr), DistanceGreater{5});
+  EXPECT_GT(sizeof(pq), sizeof(vector<int>));
+  EXPECT_EQ(pq.top(), 5);
+  auto copy = pq;
+  pq.pop();
+  EXPECT_TRUE(pq.top() == 4 || pq.top() == 6);
+  EXPECT_EQ(copy.top(), 5);
+  priority_queue<int, vector<int>, DistanceGreater> other(DistanceGreater{0});
+  other.push(3);
+  other.push(-1);
+  swap(other, copy);
+  EXPECT_EQ(other.top(), 5);
+  EXPECT_EQ(copy.top(), -1);
+  copy.push(8);
+  EXPECT_EQ(copy.top(), -1);
+}
 }
 }
@@ -0,0 +1,135 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <gtest/gtest.h>
+
+#include "../src/scheduler.h"
+
+namespace TinySTL {
+namespace Test {
+
+static long fib(int n, scheduler &sched) {
+  if (n < 2)
+    return n;
+  if (n < 12)
+    return fib(n - 1, sched) + fib(n - 2, sched);
+  long x, y;
+  task_group g(sched);
+  g.spawn([&x, n, &sched] { x = fib(n - 1, sched); });
+  y = fib(n - 2, sched);
+  g.sync();
+  return x + y;
+}
+
+TEST(SchedulerTest, SpawnSync) {
+  for (size_t threads : {1, 2, 4}) {
+    scheduler sched(threads);
+    EXPECT_EQ(sched.size(), threads);
+    EXPECT_EQ(fib(22, sched), 17711);
+  }
+  EXPECT_EQ(fib(20, scheduler::instance()), 6765);
+}
+
+TEST(SchedulerTest, ManyTasksFromOutside) {
+  // 超过公共队列容量的任务会在提交线程上直接执行
+  scheduler sched(2);
+  std::atomic<int> count(0);
+  task_group g(sched);
+  for (int i = 0; i < 5000; ++i)
+    g.spawn([&count] { count.fetch_add(1); });
+  g.sync();
+  EXPECT_EQ(count.load(), 5000);
+}
+
+TEST(SchedulerTest, ParallelFor) {
+  scheduler sched(4);
+  std::vector<int> v(100000, 0);
+  parallel_for(size_t(0), v.size(), [&v](size_t lo, size_t hi) {
+    for (size_t i = lo; i != hi; ++i)
+      v[i] += static_cast<int>(i % 7);
+  }, size_t(0), sched);
+  long sum = 0, expected = 0;
+  for (size_t i = 0; i != v.size(); ++i) {
+    sum += v[i];
+    expected += i % 7;
+  }
+  EXPECT_EQ(sum, expected);
+
+  // 指定粒度，检查子区间恰好覆盖整个区间
+  std::atomic<int> covered(0), chunks(0);
+  parallel_for(-50, 950, [&covered, &chunks](int lo, int hi) {
+    EXPECT_LE(hi - lo, 16);
+    covered.fetch_add(hi - lo);
+    chunks.fetch_add(1);
+  }, 16, sched);
+  EXPECT_EQ(covered.load(), 1000);
+  EXPECT_GE(chunks.load(), 1000 / 16);
+  parallel_for(5, 5, [](int, int) { FAIL(); });
+}
+
+TEST(SchedulerTest, OnEachWorker) {
+  for (size_t threads : {1, 2, 4}) {
+    scheduler sched(threads);
+    size_t n = threads == 1 ? 1 : threads - 1;
+    EXPECT_EQ(sched.worker_count(), threads - 1);
+    // 同一个编号两轮都在同一个线程上执行，且不在调用线程上
+    std::vector<std::thread::id> ids(n), again(n);
+    std::vector<int> calls(n, 0);
+    std::atomic<int> wrong_cpu(0);
+    on_each_worker([&](size_t i) {
+      ids[i] = std::this_thread::get_id();
+      ++calls[i];
+#if defined(__linux__)
+      if (threads > 1 && sched.worker_cpu(i) >= 0 && sched_getcpu() != sched.worker_cpu(i))
+        wrong_cpu.fetch_add(1);
+#endif
+    }, sched);
+    // 中间插入一些可窃取的任务
+    std::atomic<int> count(0);
+    parallel_for(0, 1000, [&count](int lo, int hi) { count.fetch_add(hi - lo); }, 1, sched);
+    EXPECT_EQ(count.load(), 1000);
+    on_each_worker([&](size_t i) {
+      again[i] = std::this_thread::get_id();
+      ++calls[i];
+    }, sched);
+    for (size_t i = 0; i != n; ++i) {
+      EXPECT_EQ(calls[i], 2);
+      EXPECT_EQ(ids[i], again[i]);
+      if (threads > 1) {
+        EXPECT_NE(ids[i], std::this_thread::get_id());
+      }
+    }
+    for (size_t i = 0; i + 1 < n; ++i)
+      EXPECT_NE(ids[i], ids[i + 1]);
+    EXPECT_EQ(wrong_cpu.load(), 0);
+  }
+}
+
+TEST(SchedulerTest, Exception) {
+  scheduler sched(2);
+  task_group g(sched);
+  std::atomic<int> count(0);
+  for (int i = 0; i < 10; ++i) {
+    g.spawn([&count, i] {
+      count.fetch_add(1);
+      if (i == 3)
+        throw std::runtime_error("task failed");
+    });
+  }
+  EXPECT_THROW(g.sync(), std::runtime_error);
+  // 其他任务照常执行完，之后 group 可以继续使用
+  EXPECT_EQ(count.load(), 10);
+  g.spawn([&count] { count.fetch_add(1); });
+  EXPECT_NO_THROW(g.sync());
+  EXPECT_EQ(count.load(), 11);
+}
+
+}
+}
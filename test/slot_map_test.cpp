@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/slot_map.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+TEST(SlotMapTest, InsertFindErase) {
+  slot_map<std::string> m;
+  EXPECT_TRUE(m.empty());
+  auto a = m.insert("a");
+  auto b = m.insert("b");
+  auto c = m.insert("c");
+  EXPECT_EQ(m.size(), 3);
+  EXPECT_EQ(m[a], "a");
+  EXPECT_EQ(m.at(c), "c");
+  EXPECT_TRUE(a != b);
+
+  // 删除 a 后最后一个元素 c 搬到前面，b、c 的 key 不受影响
+  EXPECT_EQ(m.erase(a), 1);
+  EXPECT_EQ(m.erase(a), 0);
+  EXPECT_FALSE(m.contains(a));
+  EXPECT_TRUE(m.find(a) == m.end());
+  EXPECT_THROW(m.at(a), std::out_of_range);
+  EXPECT_EQ(m[b], "b");
+  EXPECT_EQ(m[c], "c");
+  EXPECT_EQ(*m.begin(), "c");
+
+  // 复用 a 的 slot，旧 key 依然无效
+  auto d = m.insert("d");
+  EXPECT_EQ(d.index, a.index);
+  EXPECT_NE(d.generation, a.generation);
+  EXPECT_FALSE(m.contains(a));
+  EXPECT_EQ(m[d], "d");
+
+  // 没有发放过的 key
+  EXPECT_FALSE(m.contains(slot_map<std::string>::key_type{100, 1}));
+  EXPECT_FALSE(m.contains(slot_map<std::string>::key_type{d.index, d.generation + 1}));
+}
+
+TEST(SlotMapTest, Random) {
+  std::mt19937 gen(1);
+  slot_map<int> m;
+  std::vector<pair<slot_map<int>::key_type, int>> live;
+  std::vector<slot_map<int>::key_type> dead;
+  for (int i = 0; i < 20000; ++i) {
+    if (live.empty() || gen() % 3 != 0) {
+      int v = static_cast<int>(gen());
+      live.push_back(TinySTL::make_pair(m.insert(v), v));
+    } else {
+      size_t j = gen() % live.size();
+      EXPECT_EQ(m.erase(live[j].first), 1);
+      dead.push_back(live[j].first);
+      live[j] = live.back();
+      live.pop_back();
+    }
+  }
+  ASSERT_EQ(m.size(), live.size());
+  for (auto &p : live)
+    ASSERT_EQ(m.at(p.first), p.second);
+  for (auto &k : dead)
+    ASSERT_FALSE(m.contains(k));
+  // 遍历和 key_of 一一对应
+  for (auto it = m.begin(); it != m.end(); ++it)
+    ASSERT_EQ(m.find(m.key_of(it)), it);
+
+  std::vector<int> values(m.begin(), m.end()), expected;
+  for (auto &p : live)
+    expected.push_back(p.second);
+  std::sort(values.begin(), values.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_EQ(values, expected);
+}
+
+TEST(SlotMapTest, EraseWhileIterating) {
+  slot_map<int> m;
+  for (int i = 0; i < 100; ++i)
+    m.insert(i);
+  for (auto it = m.begin(); it != m.end();) {
+    if (*it % 2 == 0)
+      it = m.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(m.size(), 50);
+  for (int x : m)
+    EXPECT_EQ(x % 2, 1);
+}
+
+TEST(SlotMapTest, CopySwapLife) {
+  CountLife::set_zero_all();
+  {
+    slot_map<CountLife> m1, m2;
+    std::vector<slot_map<CountLife>::key_type> keys;
+    for (int i = 0; i < 50; ++i)
+      keys.push_back(m1.insert(CountLife()));
+    for (int i = 0; i < 50; i += 3)
+      m1.erase(keys[i]);
+    auto m3 = m1;
+    EXPECT_EQ(m3.size(), m1.size());
+    for (int i = 1; i < 50; i += 3)
+      EXPECT_TRUE(m3.contains(keys[i]));
+    swap(m2, m3);
+    EXPECT_TRUE(m3.empty());
+    EXPECT_EQ(m2.size(), m1.size());
+    m1.clear();
+    EXPECT_TRUE(m1.empty());
+    EXPECT_FALSE(m1.contains(keys[1]));
+    EXPECT_TRUE(m2.contains(keys[1]));
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+}
+}
@@ -0,0 +1,178 @@
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/soa_vector.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+using Row3 = std::tuple<int, double, char>;
+using Row4 = std::tuple<char, uint16_t, double, int>;
+
+TEST(SoaVectorTest, PushBackAndAccess) {
+  soa_vector<int, double, char> v;
+  std::vector<Row3> expected;
+  EXPECT_TRUE(v.empty());
+  for (int i = 0; i < 1000; ++i) {
+    v.push_back(i, i * 0.5, static_cast<char>('a' + i % 26));
+    expected.push_back(std::make_tuple(i, i * 0.5, static_cast<char>('a' + i % 26)));
+  }
+  ASSERT_EQ(v.size(), expected.size());
+  EXPECT_GE(v.capacity(), v.size());
+  for (size_t i = 0; i != v.size(); ++i) {
+    EXPECT_EQ(v[i].get<0>(), std::get<0>(expected[i]));
+    EXPECT_EQ(v[i].get<1>(), std::get<1>(expected[i]));
+    EXPECT_EQ(Row3(v[i]), expected[i]);
+  }
+
+  // 按列遍历
+  auto col = v.column<1>();
+  EXPECT_EQ(col.size(), v.size());
+  double sum = 0, expected_sum = 0;
+  for (double x : col)
+    sum += x;
+  for (auto &t : expected)
+    expected_sum += std::get<1>(t);
+  EXPECT_EQ(sum, expected_sum);
+
+  // 通过列和行代理修改
+  for (int &x : v.column<0>())
+    x *= 2;
+  v[3] = std::make_tuple(-1, -1.0, 'z');
+  v[4].get<2>() = 'y';
+  v[5] = v[3];
+  EXPECT_EQ(v[1].get<0>(), 2);
+  EXPECT_EQ(Row3(v[3]), Row3(-1, -1.0, 'z'));
+  EXPECT_EQ(Row3(v[5]), Row3(-1, -1.0, 'z'));
+  EXPECT_EQ(v.at(4).get<2>(), 'y');
+  EXPECT_THROW(v.at(v.size()), std::out_of_range);
+
+  v.pop_back();
+  EXPECT_EQ(v.size(), 999);
+  EXPECT_EQ(v.back().get<0>(), 998 * 2);
+  v.clear();
+  EXPECT_TRUE(v.empty());
+}
+
+TEST(SoaVectorTest, ColumnAlignment) {
+  soa_vector<char, uint16_t, double, int> v;
+  for (int n : {1, 17, 100, 1000}) {
+    v.reserve(n);
+    EXPECT_GE(v.capacity(), static_cast<size_t>(n));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<0>()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<1>()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<2>()) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data<3>()) % 64, 0);
+  }
+  // reserve 不改变内容
+  for (int i = 0; i < 100; ++i)
+    v.push_back(std::make_tuple(static_cast<char>(i), static_cast<uint16_t>(i), i * 1.0, -i));
+  size_t cap = v.capacity();
+  v.reserve(cap * 4);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(Row4(v[i]), Row4(static_cast<char>(i), static_cast<uint16_t>(i), i * 1.0, -i));
+}
+
+TEST(SoaVectorTest, NonTrivialColumns) {
+  CountLife::set_zero_all();
+  {
+    soa_vector<std::string, CountLife, int> v;
+    for (int i = 0; i < 500; ++i)
+      v.push_back(std::to_string(i), CountLife(), i);
+    for (int i = 0; i < 500; ++i) {
+      EXPECT_EQ(v[i].get<0>(), std::to_string(i));
+      EXPECT_EQ(v[i].get<2>(), i);
+    }
+    v.pop_back();
+    auto v2 = v;
+    EXPECT_EQ(v2.size(), 499);
+    EXPECT_EQ(v2[498].get<0>(), "498");
+    soa_vector<std::string, CountLife, int> v3;
+    swap(v2, v3);
+    EXPECT_TRUE(v2.empty());
+    EXPECT_EQ(v3.size(), 499);
+    v2 = std::move(v3);
+    EXPECT_EQ(v2[10].get<0>(), "10");
+    v.clear();
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+
+// 拷贝构造到第 limit 次时抛出异常，并统计存活的对象
+struct SoaThrowOnCopy {
+  static int copies;
+  static int limit;
+  static int alive;
+  int val;
+  explicit SoaThrowOnCopy(int v) : val(v) { ++alive; }
+  SoaThrowOnCopy(const SoaThrowOnCopy &x) : val(x.val) {
+    if (++copies == limit)
+      throw std::runtime_error("copy");
+    ++alive;
+  }
+  SoaThrowOnCopy &operator=(const SoaThrowOnCopy &) = default;
+  ~SoaThrowOnCopy() { --alive; }
+};
+int SoaThrowOnCopy::copies = 0;
+int SoaThrowOnCopy::limit = 0;
+int SoaThrowOnCopy::alive = 0;
+
+TEST(SoaVectorTest, ReserveThrow) {
+  {
+    soa_vector<std::string, SoaThrowOnCopy, int> v;
+    for (int i = 0; i < 100; ++i)
+      v.push_back(std::to_string(i), SoaThrowOnCopy(i), i);
+    EXPECT_EQ(SoaThrowOnCopy::alive, 100);
+    // 扩容时第二列拷贝到一半抛出异常：已拷贝的元素被析构，内容不变
+    SoaThrowOnCopy::copies = 0;
+    SoaThrowOnCopy::limit = 50;
+    size_t cap = v.capacity();
+    EXPECT_THROW(v.reserve(cap * 2), std::runtime_error);
+    SoaThrowOnCopy::limit = 0;
+    EXPECT_EQ(SoaThrowOnCopy::alive, 100);
+    EXPECT_EQ(v.capacity(), cap);
+    ASSERT_EQ(v.size(), 100);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(v[i].get<0>(), std::to_string(i));
+      EXPECT_EQ(v[i].get<1>().val, i);
+    }
+  }
+  EXPECT_EQ(SoaThrowOnCopy::alive, 0);
+}
+
+
+// 统计拷贝构造次数，移动构造不抛异常
+struct SoaCopyCount {
+  static int copies;
+  int val;
+  explicit SoaCopyCount(int v) : val(v) {}
+  SoaCopyCount(const SoaCopyCount &x) : val(x.val) { ++copies; }
+  SoaCopyCount(SoaCopyCount &&x) noexcept : val(x.val) {}
+  SoaCopyCount &operator=(const SoaCopyCount &) = default;
+};
+int SoaCopyCount::copies = 0;
+
+TEST(SoaVectorTest, RelocateByMove) {
+  soa_vector<SoaCopyCount, std::string> v;
+  SoaCopyCount::copies = 0;
+  for (int i = 0; i < 100; ++i)
+    v.push_back(SoaCopyCount(i), std::to_string(i));
+  int pushed = SoaCopyCount::copies;
+  // 扩容时移动旧元素，不再拷贝
+  v.reserve(v.capacity() * 4);
+  EXPECT_EQ(SoaCopyCount::copies, pushed);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(v[i].get<0>().val, i);
+    EXPECT_EQ(v[i].get<1>(), std::to_string(i));
+  }
+}
+
+}
+}
@@ -0,0 +1,151 @@
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/queue.h"
+#include "../src/spsc_ring_buffer.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+TEST(SpscRingBufferTest, Capacity) {
+  spsc_ring_buffer<int> rb1(5);
+  EXPECT_EQ(rb1.capacity(), 8);
+  spsc_ring_buffer<int> rb2;
+  EXPECT_EQ(rb2.capacity(), 1024);
+  EXPECT_TRUE(rb2.empty());
+
+  for (int i = 0; i < 8; ++i)
+    EXPECT_TRUE(rb1.try_push(i));
+  EXPECT_FALSE(rb1.try_push(8));
+  EXPECT_TRUE(rb1.full());
+  int val = -1;
+  EXPECT_TRUE(rb1.try_pop(val));
+  EXPECT_EQ(val, 0);
+  EXPECT_TRUE(rb1.try_push(8));
+  EXPECT_EQ(rb1.size(), 8);
+}
+
+TEST(SpscRingBufferTest, WrapAround) {
+  std::queue<std::string> q1;
+  spsc_ring_buffer<std::string> rb(4);
+  for (int i = 0; i < 100; ++i) {
+    q1.push(std::to_string(i));
+    rb.push_back(std::to_string(i));
+    if (i % 3 != 0) {
+      EXPECT_EQ(q1.front(), rb.front());
+      q1.pop();
+      rb.pop_front();
+    }
+    if (rb.full()) {
+      while (!q1.empty()) {
+        EXPECT_EQ(q1.front(), rb.front());
+        q1.pop();
+        rb.pop_front();
+      }
+    }
+  }
+  EXPECT_EQ(q1.size(), rb.size());
+}
+
+TEST(SpscRingBufferTest, Batch) {
+  spsc_ring_buffer<int> rb(16);
+  std::vector<int> in(40), out(40);
+  for (int i = 0; i < 40; ++i)
+    in[i] = i;
+  // 先让下标走到中间，之后的批量操作会跨过数组末尾
+  EXPECT_EQ(rb.push_n(in.data(), 10), 10);
+  EXPECT_EQ(rb.pop_n(out.data(), 10), 10);
+  EXPECT_EQ(rb.push_n(in.data(), 40), 16);
+  EXPECT_EQ(rb.pop_n(out.data(), 5), 5);
+  EXPECT_EQ(rb.push_n(in.data() + 16, 24), 5);
+  EXPECT_EQ(rb.pop_n(out.data() + 5, 40), 16);
+  EXPECT_TRUE(rb.empty());
+  for (int i = 0; i < 21; ++i)
+    EXPECT_EQ(out[i], i);
+}
+
+TEST(SpscRingBufferTest, Life) {
+  CountLife::set_zero_all();
+  {
+    spsc_ring_buffer<CountLife> rb(8);
+    CountLife val;
+    for (int i = 0; i < 5; ++i)
+      rb.push_back(val);
+    rb.pop_front();
+    auto rb2(rb);
+    EXPECT_TRUE(rb2.size() == 4);
+    std::vector<CountLife> out(3);
+    EXPECT_EQ(rb2.pop_n(out.begin(), 3), 3);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+TEST(SpscRingBufferTest, AsQueue) {
+  queue<int, spsc_ring_buffer<int>> q1;
+  std::queue<int> q2;
+  for (int i = 0; i < 500; ++i) {
+    q1.push(i);
+    q2.push(i);
+    if (i % 2) {
+      q1.pop();
+      q2.pop();
+    }
+  }
+  EXPECT_EQ(q1.size(), q2.size());
+  EXPECT_EQ(q1.front(), q2.front());
+  auto q3(q1);
+  EXPECT_TRUE(q1 == q3);
+  q3.pop();
+  EXPECT_TRUE(q1 != q3);
+  auto q4(std::move(q3));
+  EXPECT_EQ(q4.size(), q1.size() - 1);
+}
+
+TEST(SpscRingBufferTest, TwoThreads) {
+  const int n = 200000;
+  spsc_ring_buffer<int> rb(256);
+  std::thread producer([&rb] {
+    int batch[7];
+    int i = 0;
+    while (i < n) {
+      if (i % 3 == 0) {
+        rb.push_back(i++);
+      } else {
+        int len = 0;
+        for (; len < 7 && i + len < n; ++len)
+          batch[len] = i + len;
+        int pushed = static_cast<int>(rb.push_n(batch, len));
+        if (pushed == 0)
+          std::this_thread::yield();
+        i += pushed;
+      }
+    }
+  });
+  int expected = 0;
+  bool ordered = true;
+  int out[16];
+  while (expected < n) {
+    int val;
+    if (expected % 2 == 0 && rb.try_pop(val)) {
+      ordered = ordered && val == expected;
+      ++expected;
+    } else {
+      auto len = rb.pop_n(out, 16);
+      for (size_t k = 0; k < len; ++k)
+        ordered = ordered && out[k] == expected++;
+      if (len == 0)
+        std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(rb.empty());
+}
+
+}
+}
@@ -0,0 +1,158 @@
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/string.h"
+#include "../src/vector.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+static std::string to_std(const string &s) { return std::string(s.data(), s.size()); }
+
+TEST(StringViewTest, SliceFindCompare) {
+  const char *text = "hello, tiny world";
+  string_view sv(text);
+  EXPECT_EQ(sv.size(), 17);
+  EXPECT_EQ(sv.substr(7, 4), "tiny");
+  EXPECT_EQ(sv.substr(12).data(), text + 12);
+  EXPECT_THROW(sv.substr(18), std::out_of_range);
+  EXPECT_EQ(sv.find('o'), 4);
+  EXPECT_EQ(sv.find('o', 5), 13);
+  EXPECT_EQ(sv.rfind('o'), 13);
+  EXPECT_EQ(sv.rfind('o', 12), 4);
+  EXPECT_EQ(sv.find('z'), string_view::npos);
+  EXPECT_EQ(sv.find("tiny"), 7);
+  EXPECT_EQ(sv.find("world", 14), string_view::npos);
+  EXPECT_EQ(sv.find(""), 0);
+  EXPECT_EQ(sv.find("", 17), 17);
+  EXPECT_EQ(sv.find("", 18), string_view::npos);
+  EXPECT_EQ(sv.find("ld"), 15);
+  EXPECT_EQ(sv.find("ldx"), string_view::npos);
+  EXPECT_TRUE(sv.starts_with("hello"));
+  EXPECT_TRUE(sv.ends_with("world"));
+  EXPECT_FALSE(sv.ends_with("hello, tiny world!"));
+
+  EXPECT_TRUE(string_view("abc") < string_view("abd"));
+  EXPECT_TRUE(string_view("ab") < string_view("abc"));
+  EXPECT_TRUE(string_view() == string_view(""));
+  EXPECT_EQ(string_view("abc").compare("abc"), 0);
+  sv.remove_prefix(7);
+  sv.remove_suffix(6);
+  EXPECT_EQ(sv, "tiny");
+}
+
+TEST(StringTest, ShortAndLong) {
+  string empty;
+  EXPECT_EQ(sizeof(string), 24);
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.capacity(), 23);
+  EXPECT_STREQ(empty.c_str(), "");
+
+  // 跨过短模式上限，每个长度都检查内容和结尾的 '\0'
+  std::string expect;
+  string s;
+  for (int i = 0; i < 300; ++i) {
+    char c = static_cast<char>('a' + i % 26);
+    s.push_back(c);
+    expect.push_back(c);
+    ASSERT_EQ(s.size(), expect.size());
+    ASSERT_STREQ(s.c_str(), expect.c_str());
+    ASSERT_GE(s.capacity(), s.size());
+  }
+  string s23(23, 'x');
+  EXPECT_EQ(s23.capacity(), 23);
+  EXPECT_EQ(to_std(s23), std::string(23, 'x'));
+  EXPECT_EQ(s23.c_str()[23], '\0');
+  s23.push_back('y');
+  EXPECT_GT(s23.capacity(), 23);
+  EXPECT_EQ(to_std(s23), std::string(23, 'x') + "y");
+  s23.pop_back();
+  s23.shrink_to_fit();
+  EXPECT_EQ(s23.capacity(), 23);
+  EXPECT_EQ(to_std(s23), std::string(23, 'x'));
+}
+
+TEST(StringTest, Modify) {
+  string s("key");
+  s += "_";
+  s.append(3, '0');
+  s += string_view("suffix-that-makes-it-long");
+  EXPECT_EQ(s, "key_000suffix-that-makes-it-long");
+  EXPECT_TRUE(s.starts_with("key_"));
+  EXPECT_EQ(s.find("that"), 14);
+  EXPECT_EQ(s.substr(4, 3), "000");
+
+  s.insert(3, "[ins]");
+  EXPECT_EQ(s, "key[ins]_000suffix-that-makes-it-long");
+  s.erase(3, 5);
+  EXPECT_EQ(s, "key_000suffix-that-makes-it-long");
+  s.erase(7);
+  EXPECT_EQ(s, "key_000");
+  EXPECT_THROW(s.erase(8), std::out_of_range);
+
+  // 追加、插入自身的一部分
+  s.append(s.data(), s.size());
+  EXPECT_EQ(s, "key_000key_000");
+  s.append(s);
+  s.append(s);
+  EXPECT_EQ(s.size(), 56);
+  s.insert(0, s.view().substr(0, 4));
+  EXPECT_TRUE(s.starts_with("key_key_000"));
+
+  s.resize(5);
+  EXPECT_EQ(s, "key_k");
+  s.resize(8, '!');
+  EXPECT_EQ(s, "key_k!!!");
+  s.clear();
+  EXPECT_TRUE(s.empty());
+
+  std::vector<char> chars = {'a', 'b', 'c'};
+  EXPECT_EQ(string(chars.begin(), chars.end()), "abc");
+  EXPECT_EQ(string("ab") + "cd" + 'e', "abcde");
+  EXPECT_EQ("x" + string("y"), "xy");
+}
+
+TEST(StringTest, CopyMoveCompare) {
+  string a("short"), b(string(40, 'L'));
+  string c = a, d = b;
+  EXPECT_TRUE(c == a && d == b);
+  string e = TinySTL::move(d);
+  EXPECT_TRUE(d.empty());
+  EXPECT_EQ(e, b);
+  swap(a, e);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(e, "short");
+  a = "now short";
+  EXPECT_EQ(a, "now short");
+  a = b;
+  EXPECT_EQ(a, b);
+  EXPECT_TRUE(string("abc") < string("abd"));
+  EXPECT_TRUE(string("abc") >= string("ab"));
+  EXPECT_TRUE("abc" != string("ab"));
+  EXPECT_EQ(a.at(0), 'L');
+  EXPECT_THROW(a.at(40), std::out_of_range);
+}
+
+// vector<string> 扩容时按位搬移，不拷贝字符
+TEST(StringTest, VectorRelocate) {
+  vector<string> v;
+  std::vector<std::string> expect;
+  for (int i = 0; i < 1000; ++i) {
+    std::string s = std::to_string(i) + std::string(i % 40, '#');
+    v.push_back(string(s.c_str()));
+    expect.push_back(s);
+  }
+  v.insert(v.begin() + 10, 100, string(30, 'i'));
+  expect.insert(expect.begin() + 10, 100, std::string(30, 'i'));
+  v.erase(v.begin(), v.begin() + 5);
+  expect.erase(expect.begin(), expect.begin() + 5);
+  ASSERT_EQ(v.size(), expect.size());
+  for (size_t i = 0; i != v.size(); ++i)
+    EXPECT_EQ(to_std(v[i]), expect[i]);
+}
+
+}
+}
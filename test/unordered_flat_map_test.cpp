@@ -0,0 +1,232 @@
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "../src/unordered_flat_map.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+// 按 key 逐个比较，不依赖遍历顺序
+template<typename Map, typename StdMap>
+bool map_equal(const Map &m, const StdMap &std_m) {
+  if (m.size() != std_m.size())
+    return false;
+  size_t n = 0;
+  for (auto it = m.begin(); it != m.end(); ++it, ++n) {
+    auto std_it = std_m.find(it->first);
+    if (std_it == std_m.end() || std_it->second != it->second)
+      return false;
+  }
+  return n == std_m.size();
+}
+
+TEST(UnorderedFlatMapTest, InsertFindErase) {
+  unordered_flat_map<int, int> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.bucket_count(), 0);
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.find(1) == m.end());
+  EXPECT_EQ(m.erase(1), 0);
+
+  for (int i = 0; i < 1000; ++i) {
+    auto res = m.insert(make_pair(i, i * 2));
+    EXPECT_TRUE(res.second);
+    EXPECT_EQ(res.first->first, i);
+  }
+  EXPECT_FALSE(m.insert(make_pair(5, 0)).second);
+  EXPECT_EQ(m.size(), 1000);
+  EXPECT_LE(m.load_factor(), m.max_load_factor());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(m.at(i), i * 2);
+    EXPECT_TRUE(m.contains(i));
+  }
+  EXPECT_FALSE(m.contains(1000));
+  EXPECT_THROW(m.at(1000), std::out_of_range);
+
+  for (int i = 0; i < 1000; i += 2)
+    EXPECT_EQ(m.erase(i), 1);
+  EXPECT_EQ(m.size(), 500);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.count(i), i % 2);
+
+  // 边遍历边删除
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 3 == 0)
+      it = m.erase(it);
+    else
+      ++it;
+  }
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.count(i), i % 2 == 1 && i % 3 != 0 ? 1 : 0);
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_NE(m.bucket_count(), 0);
+}
+
+TEST(UnorderedFlatMapTest, Subscript) {
+  unordered_flat_map<std::string, int> m;
+  std::unordered_map<std::string, int> std_m;
+  const char *words[] = {"a", "b", "c", "a", "d", "b", "a"};
+  for (auto w : words) {
+    ++m[w];
+    ++std_m[w];
+  }
+  EXPECT_TRUE(map_equal(m, std_m));
+  EXPECT_FALSE(m.try_emplace("a", 100).second);
+  EXPECT_EQ(m["a"], 3);
+  EXPECT_TRUE(m.try_emplace("e", 100).second);
+  EXPECT_EQ(m["e"], 100);
+  EXPECT_FALSE(m.insert_or_assign("e", 7).second);
+  EXPECT_EQ(m["e"], 7);
+}
+
+TEST(UnorderedFlatMapTest, TryEmplaceArgs) {
+  // mapped_type 由参数原地构造：多个参数、没有参数、只能移动的类型
+  unordered_flat_map<int, std::string> m;
+  EXPECT_TRUE(m.try_emplace(1, 3, 'x').second);
+  EXPECT_TRUE(m.try_emplace(2).second);
+  EXPECT_FALSE(m.try_emplace(1, 5, 'y').second);
+  EXPECT_EQ(m[1], "xxx");
+  EXPECT_EQ(m[2], "");
+
+  unordered_flat_map<int, std::unique_ptr<int>> p;
+  for (int i = 0; i != 100; ++i)
+    EXPECT_TRUE(p.try_emplace(i, new int(i)).second);
+  EXPECT_TRUE(p.try_emplace(100).second);
+  EXPECT_EQ(p[100], nullptr);
+  for (int i = 0; i != 100; ++i)
+    EXPECT_EQ(*p[i], i);
+}
+
+// 随机插入、删除、查找，和 std::unordered_map 对比
+TEST(UnorderedFlatMapTest, Random) {
+  std::mt19937 gen(42);
+  unordered_flat_map<int, int> m;
+  std::unordered_map<int, int> std_m;
+  for (int round = 0; round < 100000; ++round) {
+    int key = static_cast<int>(gen() % 5000);
+    switch (gen() % 4) {
+      case 0:
+      case 1:EXPECT_EQ(m.insert(make_pair(key, round)).second, std_m.insert(std::make_pair(key, round)).second);
+        break;
+      case 2:EXPECT_EQ(m.erase(key), std_m.erase(key));
+        break;
+      default:EXPECT_EQ(m.count(key), std_m.count(key));
+        break;
+    }
+  }
+  EXPECT_TRUE(map_equal(m, std_m));
+}
+
+// 反复插入、删除同一批 key：墓碑不能无限累积，表也不能无限扩容
+TEST(UnorderedFlatMapTest, Tombstones) {
+  unordered_flat_map<int, int> m;
+  m.reserve(100);
+  size_t buckets = m.bucket_count();
+  for (int round = 0; round < 1000; ++round) {
+    for (int i = 0; i < 100; ++i)
+      m.insert(make_pair(round * 100 + i, i));
+    for (int i = 0; i < 100; ++i)
+      EXPECT_EQ(m.erase(round * 100 + i), 1);
+  }
+  EXPECT_TRUE(m.empty());
+  // 墓碑占满额度时可能扩容一次，之后只会原地重建
+  EXPECT_LE(m.bucket_count(), buckets * 2 + 1);
+  for (int i = 0; i < 100000; ++i)
+    EXPECT_EQ(m.count(i), 0);
+}
+
+TEST(UnorderedFlatMapTest, ReserveRehash) {
+  unordered_flat_map<int, int> m;
+  m.reserve(1000);
+  size_t buckets = m.bucket_count();
+  EXPECT_GE(buckets * 7 / 8, 1000);
+  for (int i = 0; i < 1000; ++i)
+    m[i] = i;
+  EXPECT_EQ(m.bucket_count(), buckets);
+
+  m.rehash(10000);
+  EXPECT_GE(m.bucket_count(), 10000);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.at(i), i);
+  // 不会缩到放不下现有元素
+  m.rehash(1);
+  EXPECT_GE(m.bucket_count() * 7 / 8, 1000);
+  EXPECT_EQ(m.size(), 1000);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.at(i), i);
+
+  m.clear();
+  m.rehash(0);
+  EXPECT_EQ(m.bucket_count(), 0);
+}
+
+TEST(UnorderedFlatMapTest, CopyMoveSwap) {
+  unordered_flat_map<std::string, std::string> m1, m2;
+  for (int i = 0; i < 100; ++i)
+    m1[std::to_string(i)] = std::string(i, 'x');
+  auto m3 = m1;
+  EXPECT_TRUE(m3 == m1);
+  m3["0"] = "changed";
+  EXPECT_TRUE(m3 != m1);
+  m2 = m1;
+  EXPECT_TRUE(m2 == m1);
+  auto m4 = TinySTL::move(m2);
+  EXPECT_TRUE(m4 == m1);
+  EXPECT_TRUE(m2.empty());
+  swap(m3, m4);
+  EXPECT_EQ(m4["0"], "changed");
+  EXPECT_EQ(m3["0"], "");
+}
+
+TEST(UnorderedFlatMapTest, Life) {
+  CountLife::set_zero_all();
+  {
+    unordered_flat_map<int, CountLife> m;
+    for (int i = 0; i < 200; ++i)
+      m[i];
+    for (int i = 0; i < 200; i += 3)
+      m.erase(i);
+    auto copy = m;
+    copy.clear();
+    m.rehash(1000);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+// 用 const char * 查找 std::string，不构造临时 string
+struct StringHash {
+  typedef void is_transparent;
+  size_t operator()(const std::string &s) const { return std::hash<std::string>()(s); }
+  size_t operator()(const char *s) const { return std::hash<std::string>()(s); }
+};
+struct StringEqual {
+  typedef void is_transparent;
+  template<typename A, typename B>
+  bool operator()(const A &a, const B &b) const { return std::string(a) == b; }
+};
+
+TEST(UnorderedFlatMapTest, Transparent) {
+  unordered_flat_map<std::string, int, StringHash, StringEqual> m;
+  m["apple"] = 1;
+  m["banana"] = 2;
+  const char *apple = "apple";
+  EXPECT_EQ(m.find(apple)->second, 1);
+  EXPECT_TRUE(m.contains("banana"));
+  EXPECT_EQ(m.count("cherry"), 0);
+  EXPECT_EQ(m.erase("banana"), 1);
+  EXPECT_EQ(m.size(), 1);
+  m.erase(m.begin());
+  EXPECT_TRUE(m.empty());
+}
+
+}
+}
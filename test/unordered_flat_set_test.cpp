@@ -0,0 +1,60 @@
+#include <random>
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include "../src/unordered_flat_set.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename Set, typename StdSet>
+bool set_equal(const Set &s, const StdSet &std_s) {
+  if (s.size() != std_s.size())
+    return false;
+  size_t n = 0;
+  for (auto it = s.begin(); it != s.end(); ++it, ++n) {
+    if (std_s.count(*it) == 0)
+      return false;
+  }
+  return n == std_s.size();
+}
+
+TEST(UnorderedFlatSetTest, Random) {
+  std::mt19937 gen(7);
+  unordered_flat_set<std::string> s;
+  std::unordered_set<std::string> std_s;
+  for (int round = 0; round < 50000; ++round) {
+    std::string key = std::to_string(gen() % 3000);
+    switch (gen() % 3) {
+      case 0:EXPECT_EQ(s.insert(key).second, std_s.insert(key).second);
+        break;
+      case 1:EXPECT_EQ(s.erase(key), std_s.erase(key));
+        break;
+      default:EXPECT_EQ(s.contains(key), std_s.count(key) == 1);
+        break;
+    }
+  }
+  EXPECT_TRUE(set_equal(s, std_s));
+
+  unordered_flat_set<std::string> copy(s.begin(), s.end());
+  EXPECT_TRUE(copy == s);
+  copy.erase(copy.begin());
+  EXPECT_TRUE(copy != s);
+}
+
+TEST(UnorderedFlatSetTest, BigKeys) {
+  // 连续的整数 key，检查哈希值打散之后的探测长度不会退化
+  unordered_flat_set<long long> s;
+  for (long long i = 0; i < 200000; ++i)
+    s.insert(i << 20);
+  EXPECT_EQ(s.size(), 200000);
+  for (long long i = 0; i < 200000; ++i)
+    EXPECT_TRUE(s.contains(i << 20));
+  EXPECT_FALSE(s.contains(1));
+}
+
+}
+}
@@ -0,0 +1,185 @@
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/unordered_map.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename Map, typename StdMap>
+bool unordered_map_equal(const Map &m, const StdMap &std_m) {
+  if (m.size() != std_m.size())
+    return false;
+  size_t n = 0;
+  for (auto it = m.begin(); it != m.end(); ++it, ++n) {
+    auto std_it = std_m.find(it->first);
+    if (std_it == std_m.end() || std_it->second != it->second)
+      return false;
+  }
+  return n == std_m.size();
+}
+
+TEST(UnorderedMapTest, InsertFindErase) {
+  unordered_map<int, std::string> m;
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+  EXPECT_TRUE(m.find(1) == m.end());
+  EXPECT_EQ(m.erase(1), 0);
+
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_TRUE(m.insert(TinySTL::make_pair(i, std::to_string(i))).second);
+  EXPECT_FALSE(m.insert(TinySTL::make_pair(5, std::string())).second);
+  EXPECT_EQ(m.size(), 1000);
+  EXPECT_LE(m.load_factor(), m.max_load_factor());
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.at(i), std::to_string(i));
+  EXPECT_THROW(m.at(1000), std::out_of_range);
+
+  for (auto it = m.begin(); it != m.end();) {
+    if (it->first % 2 == 0)
+      it = m.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(m.size(), 500);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.count(i), i % 2);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.begin() == m.end());
+}
+
+TEST(UnorderedMapTest, Random) {
+  std::mt19937 gen(3);
+  unordered_map<int, int> m;
+  std::unordered_map<int, int> std_m;
+  for (int round = 0; round < 100000; ++round) {
+    int key = static_cast<int>(gen() % 5000);
+    switch (gen() % 4) {
+      case 0:EXPECT_EQ(m.insert(TinySTL::make_pair(key, round)).second, std_m.insert(std::make_pair(key, round)).second);
+        break;
+      case 1:m[key] += round;
+        std_m[key] += round;
+        break;
+      case 2:EXPECT_EQ(m.erase(key), std_m.erase(key));
+        break;
+      default:EXPECT_EQ(m.count(key), std_m.count(key));
+        break;
+    }
+  }
+  EXPECT_TRUE(unordered_map_equal(m, std_m));
+}
+
+// rehash 只重新挂链，元素地址不变
+TEST(UnorderedMapTest, PointerStability) {
+  unordered_map<int, int> m;
+  std::vector<const int *> addrs;
+  for (int i = 0; i < 10000; ++i)
+    addrs.push_back(&(m[i] = i));
+  EXPECT_GE(m.bucket_count(), 10000);
+  for (int i = 0; i < 10000; ++i)
+    EXPECT_EQ(&m[i], addrs[i]);
+  m.rehash(100000);
+  for (int i = 0; i < 10000; ++i)
+    EXPECT_EQ(&m.at(i), addrs[i]);
+}
+
+TEST(UnorderedMapTest, TryEmplaceArgs) {
+  // mapped_type 由参数原地构造：多个参数、没有参数、只能移动的类型
+  unordered_map<int, std::string> m;
+  EXPECT_TRUE(m.try_emplace(1, 3, 'x').second);
+  EXPECT_TRUE(m.try_emplace(2).second);
+  EXPECT_FALSE(m.try_emplace(1, 5, 'y').second);
+  EXPECT_EQ(m[1], "xxx");
+  EXPECT_EQ(m[2], "");
+
+  unordered_map<int, std::unique_ptr<int>> p;
+  for (int i = 0; i != 100; ++i)
+    EXPECT_TRUE(p.try_emplace(i, new int(i)).second);
+  EXPECT_TRUE(p.try_emplace(100).second);
+  EXPECT_EQ(p[100], nullptr);
+  for (int i = 0; i != 100; ++i)
+    EXPECT_EQ(*p[i], i);
+}
+
+TEST(UnorderedMapTest, ReserveAndLoadFactor) {
+  unordered_map<int, int> m;
+  m.reserve(1000);
+  size_t buckets = m.bucket_count();
+  EXPECT_GE(buckets, 1000);
+  EXPECT_EQ(buckets & (buckets - 1), 0);
+  for (int i = 0; i < 1000; ++i)
+    m[i] = i;
+  EXPECT_EQ(m.bucket_count(), buckets);
+
+  // 调小负载因子会立即扩容
+  m.max_load_factor(0.25f);
+  EXPECT_LE(m.load_factor(), 0.25f);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(m.at(i), i);
+  size_t total = 0;
+  for (size_t i = 0; i != m.bucket_count(); ++i)
+    total += m.bucket_size(i);
+  EXPECT_EQ(total, 1000);
+}
+
+// 区间插入：先按区间长度 reserve，过程中不再 rehash
+TEST(UnorderedMapTest, BulkInsert) {
+  std::vector<pair<int, int>> v;
+  for (int i = 0; i < 5000; ++i)
+    v.push_back(TinySTL::make_pair(i % 4000, i));
+  unordered_map<int, int> m;
+  m[-1] = -1;
+  const int *first = &m[-1];
+  m.insert(v.begin(), v.end());
+  EXPECT_EQ(m.size(), 4001);
+  EXPECT_EQ(&m[-1], first);
+  EXPECT_GE(m.bucket_count() * m.max_load_factor(), 5001);
+  for (int i = 0; i < 4000; ++i)
+    EXPECT_EQ(m.at(i), i);
+
+  unordered_map<int, int> copy(m.begin(), m.end());
+  EXPECT_TRUE(copy == m);
+}
+
+TEST(UnorderedMapTest, CopyMoveSwap) {
+  unordered_map<std::string, int> m1, m2;
+  for (int i = 0; i < 100; ++i)
+    m1[std::to_string(i)] = i;
+  auto m3 = m1;
+  EXPECT_TRUE(m3 == m1);
+  m3["0"] = -1;
+  EXPECT_TRUE(m3 != m1);
+  m2 = m1;
+  auto m4 = TinySTL::move(m2);
+  EXPECT_TRUE(m4 == m1);
+  EXPECT_TRUE(m2.empty());
+  swap(m3, m4);
+  EXPECT_EQ(m4["0"], -1);
+  EXPECT_EQ(m3["0"], 0);
+}
+
+TEST(UnorderedMapTest, Life) {
+  CountLife::set_zero_all();
+  {
+    unordered_map<int, CountLife> m;
+    for (int i = 0; i < 200; ++i)
+      m[i];
+    for (int i = 0; i < 200; i += 3)
+      m.erase(i);
+    auto copy = m;
+    copy.clear();
+    m.rehash(1000);
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+}
+}
@@ -0,0 +1,194 @@
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../src/unrolled_list.h"
+#include "test_utils.h"
+
+namespace TinySTL {
+namespace Test {
+
+template<typename T>
+using stdL = std::list<T>;
+
+template<typename T>
+using tsUL = TinySTL::unrolled_list<T>;
+
+TEST(UnrolledListTest, NodeSize) {
+  // 小元素的节点刚好落在 __alloc 的 free-list 里
+  EXPECT_LE(sizeof(__unrolled_list_node<int>), 128);
+  EXPECT_GT(tsUL<int>::node_capacity, 16);
+  EXPECT_GE(tsUL<std::string>::node_capacity, 4);
+}
+
+TEST(UnrolledListTest, Ctor) {
+  stdL<int> l1(100, 8);
+  tsUL<int> l2(100, 8);
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  EXPECT_EQ(l2.size(), 100);
+
+  int arr[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+  stdL<int> l3(std::begin(arr), std::end(arr));
+  tsUL<int> l4(std::begin(arr), std::end(arr));
+  EXPECT_TRUE(TinySTL::Test::container_equal(l3, l4));
+
+  auto l5(l4);
+  EXPECT_TRUE(l5 == l4);
+  auto l6(std::move(l5));
+  EXPECT_TRUE(l5.empty());
+  EXPECT_TRUE(TinySTL::Test::container_equal(l3, l6));
+  l5 = l2;
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l5));
+}
+
+TEST(UnrolledListTest, PushPop) {
+  stdL<std::string> l1;
+  tsUL<std::string> l2;
+  for (auto i = 0; i != 200; ++i) {
+    l1.push_front(std::to_string(i));
+    l2.push_front(std::to_string(i));
+    l1.push_back(std::to_string(-i));
+    l2.push_back(std::to_string(-i));
+  }
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  EXPECT_EQ(l1.front(), l2.front());
+  EXPECT_EQ(l1.back(), l2.back());
+  for (auto i = 0; i != 150; ++i) {
+    l1.pop_back();
+    l2.pop_back();
+    l1.pop_front();
+    l2.pop_front();
+  }
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+  EXPECT_EQ(l1.size(), l2.size());
+}
+
+TEST(UnrolledListTest, RandomInsertErase) {
+  std::mt19937 rd(42);
+  stdL<std::string> l1;
+  tsUL<std::string> l2;
+  for (auto round = 0; round != 5000; ++round) {
+    auto pos = l1.empty() ? 0 : rd() % (l1.size() + 1);
+    auto it1 = l1.begin();
+    auto it2 = l2.begin();
+    for (auto i = pos; i != 0; --i) {
+      ++it1;
+      ++it2;
+    }
+    if (rd() % 3 != 0 || it1 == l1.end()) {
+      auto val = std::to_string(round);
+      it1 = l1.insert(it1, val);
+      it2 = l2.insert(it2, val);
+      EXPECT_EQ(*it1, *it2);
+    } else {
+      it1 = l1.erase(it1);
+      it2 = l2.erase(it2);
+      EXPECT_EQ(it1 == l1.end(), it2 == l2.end());
+      if (it1 != l1.end()) {
+        EXPECT_EQ(*it1, *it2);
+      }
+    }
+  }
+  EXPECT_EQ(l1.size(), l2.size());
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+
+  // 反向遍历
+  auto rit1 = l1.end();
+  auto rit2 = l2.end();
+  while (rit1 != l1.begin()) {
+    --rit1;
+    --rit2;
+    EXPECT_EQ(*rit1, *rit2);
+  }
+  EXPECT_TRUE(rit2 == l2.begin());
+}
+
+TEST(UnrolledListTest, InsertRangeErase) {
+  stdL<int> l1(10, 0);
+  tsUL<int> l2(10, 0);
+  int arr[] = {1, 2, 3, 4, 5};
+  auto it1 = l1.begin();
+  auto it2 = l2.begin();
+  ++it1;
+  ++it2;
+  l1.insert(it1, std::begin(arr), std::end(arr));
+  l2.insert(it2, std::begin(arr), std::end(arr));
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+
+  l1.insert(l1.end(), 100, 7);
+  l2.insert(l2.end(), 100, 7);
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+
+  it1 = l1.begin();
+  it2 = l2.begin();
+  for (auto i = 0; i != 3; ++i) {
+    ++it1;
+    ++it2;
+  }
+  auto last1 = it1;
+  auto last2 = it2;
+  for (auto i = 0; i != 50; ++i) {
+    ++last1;
+    ++last2;
+  }
+  l1.erase(it1, last1);
+  l2.erase(it2, last2);
+  EXPECT_TRUE(TinySTL::Test::container_equal(l1, l2));
+
+  l2.clear();
+  EXPECT_TRUE(l2.empty());
+  EXPECT_TRUE(l2.begin() == l2.end());
+}
+
+TEST(UnrolledListTest, LifeCycle) {
+  CountLife::set_zero_all();
+  {
+    tsUL<CountLife> l;
+    for (auto i = 0; i != 100; ++i)
+      l.insert(l.begin(), CountLife());
+    for (auto i = 0; i != 50; ++i)
+      l.erase(l.begin());
+  }
+  EXPECT_EQ(CountLife::ctorsubdtor(), 0);
+}
+
+// 拷贝构造到第 limit 次时抛出异常
+struct ThrowOnCopy {
+  static int copies;
+  static int limit;
+  int val;
+  explicit ThrowOnCopy(int v) : val(v) {}
+  ThrowOnCopy(const ThrowOnCopy &x) : val(x.val) {
+    if (++copies == limit)
+      throw std::runtime_error("copy");
+  }
+};
+int ThrowOnCopy::copies = 0;
+int ThrowOnCopy::limit = 0;
+
+TEST(UnrolledListTest, PushBackThrow) {
+  tsUL<ThrowOnCopy> l;
+  ThrowOnCopy::copies = 0;
+  ThrowOnCopy::limit = static_cast<int>(tsUL<ThrowOnCopy>::node_capacity) + 1;
+  // 前一个节点刚好装满，抛出异常的是新节点里的第一个元素
+  for (int i = 0; i != ThrowOnCopy::limit - 1; ++i)
+    l.push_back(ThrowOnCopy(i));
+  EXPECT_THROW(l.push_back(ThrowOnCopy(-1)), std::runtime_error);
+  EXPECT_EQ(l.size(), static_cast<size_t>(ThrowOnCopy::limit - 1));
+  EXPECT_EQ(l.back().val, ThrowOnCopy::limit - 2);
+  EXPECT_EQ(static_cast<size_t>(TinySTL::distance(l.begin(), l.end())), l.size());
+  // 空列表中第一次 push_back 就失败
+  tsUL<ThrowOnCopy> l2;
+  ThrowOnCopy::copies = 0;
+  ThrowOnCopy::limit = 1;
+  EXPECT_THROW(l2.push_back(ThrowOnCopy(0)), std::runtime_error);
+  EXPECT_TRUE(l2.empty());
+  EXPECT_TRUE(l2.begin() == l2.end());
+  ThrowOnCopy::limit = 0;
+}
+
+}
+}
@@ -1,10 +1,13 @@
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <array>
 
 #include <gtest/gtest.h>
 
+#include "../src/string.h"
 #include "../src/vector.h"
+#include "../src/vector_parallel.h"
 #include "test_utils.h"
 
 namespace TinySTL {
@@ -33,6 +36,39 @@ TEST(VectorTest, Ctor) {
   EXPECT_TRUE(container_equal(v5, v6));
 }
 
+TEST(VectorTest, PolicyCtorAndResize) {
+  EXPECT_GE(scheduler::numa_nodes(), 1);
+  // 超过并行算法的串行阈值，单个 NUMA 节点的机器上 first_touch 等同于 par
+  const size_t n = 100003;
+  auto v1 = make_vector<double>(execution::first_touch, n, 1.5);
+  auto v2 = make_vector<double>(execution::par, n, 1.5);
+  auto v3 = make_vector<double>(execution::seq, n, 1.5);
+  stdVec<double> v4(n, 1.5);
+  EXPECT_TRUE(container_equal(v1, v4));
+  EXPECT_TRUE(v1 == v2 && v2 == v3);
+
+  auto s1 = make_vector<std::string>(execution::first_touch, 100, "abc");
+  resize(execution::first_touch, s1, n, "de");
+  stdVec<std::string> s2(100, "abc");
+  s2.resize(n, "de");
+  EXPECT_TRUE(container_equal(s1, s2));
+  resize(execution::par, s1, 10, "x");
+  s2.resize(10, "x");
+  EXPECT_TRUE(container_equal(s1, s2));
+  resize(execution::par, s1, 20, "x");
+  s2.resize(20, "x");
+  EXPECT_TRUE(container_equal(s1, s2));
+
+  // 长 string 的拷贝经由 __alloc 申请内存，只能串行构造
+  TinySTL::string long_str(40, 'x');
+  auto s3 = make_vector<TinySTL::string>(execution::par, n, long_str);
+  resize(execution::first_touch, s3, 2 * n, long_str);
+  EXPECT_EQ(s3.size(), 2 * n);
+  EXPECT_TRUE(std::all_of(s3.begin(), s3.end(), [&long_str](const TinySTL::string &s) { return s == long_str; }));
+  auto s4 = make_vector<tsVec<int>>(execution::par, n, tsVec<int>(3, 1));
+  EXPECT_EQ(s4[n - 1][2], 1);
+}
+
 TEST(VectorTest, CCtorAndAssgin) {
   stdVec<int> temp1(10, 0);
   tsVec<int> temp2(10, 0);
@@ -138,6 +174,50 @@ TEST(VectorTest, String) {
   EXPECT_TRUE(TinySTL::Test::container_equal(v1, v2));
 }
 
+// vector 可以按位搬移：vector<vector<T>> 扩容、中间插入时直接 memcpy 内层 vector
+TEST(VectorTest, Relocate) {
+  tsVec<tsVec<int>> v1;
+  stdVec<stdVec<int>> v2;
+  for (int i = 0; i < 100; ++i) {
+    v1.push_back(tsVec<int>(i, i));
+    v2.push_back(stdVec<int>(i, i));
+  }
+  v1.insert(v1.begin() + 50, 30, tsVec<int>(3, -1));
+  v2.insert(v2.begin() + 50, 30, stdVec<int>(3, -1));
+  v1.reserve(1000);
+  ASSERT_EQ(v1.size(), v2.size());
+  for (size_t i = 0; i != v1.size(); ++i)
+    EXPECT_TRUE(container_equal(v1[i], v2[i]));
+}
+
+// 统计拷贝构造次数，移动构造不抛异常
+struct VecCopyCount {
+  static int copies;
+  int val;
+  explicit VecCopyCount(int v) : val(v) {}
+  VecCopyCount(const VecCopyCount &x) : val(x.val) { ++copies; }
+  VecCopyCount(VecCopyCount &&x) noexcept : val(x.val) {}
+  VecCopyCount &operator=(const VecCopyCount &) = default;
+};
+int VecCopyCount::copies = 0;
+
+TEST(VectorTest, RelocateByMove) {
+  tsVec<VecCopyCount> v;
+  VecCopyCount x(7);
+  VecCopyCount::copies = 0;
+  for (int i = 0; i < 100; ++i)
+    v.push_back(x);
+  v.reserve(1000);
+  // 扩容时移动旧元素，只有 push_back 本身拷贝
+  EXPECT_EQ(VecCopyCount::copies, 100);
+  for (int i = 0; i < 1000; ++i)
+    v.push_back(VecCopyCount(7));
+  EXPECT_EQ(VecCopyCount::copies, 100);
+  EXPECT_EQ(v.size(), 1100);
+  for (auto &e : v)
+    EXPECT_EQ(e.val, 7);
+}
+
 TEST(VectorTest, Insert) {
   stdVec<int> v1;
   tsVec<int> v2;
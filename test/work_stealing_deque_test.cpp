@@ -0,0 +1,76 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../src/work_stealing_deque.h"
+
+namespace TinySTL {
+namespace Test {
+
+TEST(WorkStealingDequeTest, SingleThread) {
+  work_stealing_deque<int> d(4);
+  EXPECT_TRUE(d.empty());
+  int val;
+  EXPECT_FALSE(d.pop_bottom(val));
+  EXPECT_FALSE(d.steal(val));
+  // 超过初始容量，触发扩容
+  for (int i = 0; i < 100; ++i)
+    d.push_bottom(i);
+  EXPECT_EQ(d.size(), 100);
+  EXPECT_GE(d.capacity(), 100);
+  // 底部后进先出，顶部先进先出
+  EXPECT_TRUE(d.pop_bottom(val));
+  EXPECT_EQ(val, 99);
+  EXPECT_TRUE(d.steal(val));
+  EXPECT_EQ(val, 0);
+  for (int i = 98; i >= 1; --i) {
+    EXPECT_TRUE(d.pop_bottom(val));
+    EXPECT_EQ(val, i);
+  }
+  EXPECT_FALSE(d.pop_bottom(val));
+  EXPECT_TRUE(d.empty());
+}
+
+TEST(WorkStealingDequeTest, Thieves) {
+  const int n = 100000;
+  const int thieves = 3;
+  work_stealing_deque<int> d;
+  std::vector<std::atomic<int>> seen(n);
+  for (auto &s : seen)
+    s.store(0);
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < thieves; ++k) {
+    threads.emplace_back([&d, &seen, &done] {
+      int val;
+      while (!done.load()) {
+        if (d.steal(val))
+          seen[val].fetch_add(1);
+        else
+          std::this_thread::yield();
+      }
+    });
+  }
+  // 拥有者边放边取，让最后一个元素上的竞争尽量多地出现
+  int val;
+  for (int i = 0; i < n; ++i) {
+    d.push_bottom(i);
+    if (i % 3 == 0 && d.pop_bottom(val))
+      seen[val].fetch_add(1);
+  }
+  while (d.pop_bottom(val))
+    seen[val].fetch_add(1);
+  done.store(true);
+  for (auto &t : threads)
+    t.join();
+  // 每个元素恰好被取走一次
+  int wrong = 0;
+  for (int i = 0; i < n; ++i)
+    wrong += seen[i].load() != 1;
+  EXPECT_EQ(wrong, 0);
+}
+
+}
+}